@@ -0,0 +1,697 @@
+/**
+ * Columnar Appointment Archive Implementation
+ * 
+ * Write: rows are buffered one block at a time as five int columns. When
+ * the block is full, each column is measured under every transform that
+ * applies, the one needing the fewest bits per row wins, and the packed
+ * bytes are written and described in the in-memory index. The index and
+ * the footer follow the last block. The file is written as "<path>.tmp",
+ * fsynced and renamed over the old archive.
+ * 
+ * Scan: the file is mapped and the footer and index are verified. Each
+ * block is then skipped (its ranges miss the query), passed on whole (its
+ * ranges lie inside the query) or filtered row by row after decoding the
+ * filter columns. A column is checksummed and unpacked only when needed.
+ * 
+ * Time Complexity:
+ * - write: O(n), three passes over each column of a block
+ * - scan: O(b) index checks for b blocks, O(rows) per decoded column
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdint.h>
+#include <string.h>
+#include "archive.h"
+#include "crc32.h"
+#include "mapfile.h"
+#include "file_io.h"
+
+#ifdef _WIN32
+#include <io.h>
+#define archive_fsync(file) _commit(_fileno(file))
+#else
+#include <unistd.h>
+#define archive_fsync(file) fsync(fileno(file))
+#endif
+
+static const unsigned char archive_magic[4] = { 'R', 'A', 'R', 'C' };
+
+// Column positions (bit k of ArchiveQuery.columns is column k)
+#define ARCHIVE_ID 0
+#define ARCHIVE_PATIENT 1
+#define ARCHIVE_DOCTOR 2
+#define ARCHIVE_START 3
+#define ARCHIVE_END 4
+
+// Column transforms
+#define ARCHIVE_PLAIN 0
+#define ARCHIVE_DELTA 1
+#define ARCHIVE_FROM_START 2
+
+// Widest bit width a single 8-byte read can unpack at any bit offset
+#define ARCHIVE_MAX_WIDTH 57
+
+/**
+ * Encoding of one column of one block
+ */
+typedef struct {
+    uint32_t length;      // Packed bytes + 8 padding bytes
+    uint32_t crc;         // CRC-32 of those bytes
+    int64_t reference;    // Frame of reference (smallest transformed value)
+    int32_t base;         // First value (delta transform)
+    int transform;        // ARCHIVE_PLAIN, ARCHIVE_DELTA or ARCHIVE_FROM_START
+    int width;            // Bits per row
+} ArchiveColumnInfo;
+
+/**
+ * Block index entry
+ */
+typedef struct {
+    uint64_t offset;
+    uint32_t count;
+    int32_t min_start;
+    int32_t max_start;
+    int32_t min_doctor;
+    int32_t max_doctor;
+    ArchiveColumnInfo columns[ARCHIVE_COLUMN_COUNT];
+} ArchiveBlockInfo;
+
+/**
+ * Archive being written
+ */
+typedef struct {
+    FILE* file;
+    const char* path;
+    char tmp_path[520];
+    int* columns[ARCHIVE_COLUMN_COUNT];   // ARCHIVE_BLOCK_RECORDS rows each
+    int count;                            // Rows buffered for the current block
+    unsigned char* packed;                // Scratch for one encoded column
+    unsigned char* index;                 // Index entries of the written blocks
+    size_t index_capacity;                // Entries index has room for
+    uint32_t block_count;
+    uint64_t offset;                      // Bytes written so far
+    uint64_t record_count;
+    int failed;
+} ArchiveWriter;
+
+/**
+ * Internal helpers: Little-endian encoding
+ */
+static void archive_put_u32(unsigned char* p, uint32_t v) {
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+}
+
+static void archive_put_u64(unsigned char* p, uint64_t v) {
+    archive_put_u32(p, (uint32_t)v);
+    archive_put_u32(p + 4, (uint32_t)(v >> 32));
+}
+
+static uint32_t archive_get_u32(const unsigned char* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t archive_get_u64(const unsigned char* p) {
+    return (uint64_t)archive_get_u32(p) | ((uint64_t)archive_get_u32(p + 4) << 32);
+}
+
+/**
+ * Internal helper: Bits needed to store values 0..range
+ */
+static int archive_bit_width(uint64_t range) {
+    int width = 0;
+    while (range != 0) {
+        width++;
+        range >>= 1;
+    }
+    return width;
+}
+
+/**
+ * Internal helper: Transformed value of row i
+ */
+static int64_t archive_transform(int transform, const int* values, const int* start, int i) {
+    if (transform == ARCHIVE_DELTA) {
+        return (i > 0) ? (int64_t)values[i] - values[i - 1] : 0;
+    }
+    if (transform == ARCHIVE_FROM_START) {
+        return (int64_t)values[i] - start[i];
+    }
+    return values[i];
+}
+
+/**
+ * Internal helper: Encodes and writes one column of the buffered block
+ * @return: 1 on success, 0 on a write error
+ */
+static int archive_write_column(ArchiveWriter* writer, int column, ArchiveColumnInfo* info) {
+    const int* values = writer->columns[column];
+    const int* start = writer->columns[ARCHIVE_START];
+    int count = writer->count;
+
+    // Pick the transform with the narrowest frame of reference
+    int transforms = (column == ARCHIVE_END) ? 3 : 2;
+    info->width = 65;
+    for (int transform = 0; transform < transforms; transform++) {
+        int64_t min = archive_transform(transform, values, start, 0);
+        int64_t max = min;
+        for (int i = 1; i < count; i++) {
+            int64_t value = archive_transform(transform, values, start, i);
+            if (value < min) {
+                min = value;
+            }
+            if (value > max) {
+                max = value;
+            }
+        }
+        int width = archive_bit_width((uint64_t)(max - min));
+        if (width < info->width) {
+            info->width = width;
+            info->transform = transform;
+            info->reference = min;
+        }
+    }
+    info->base = values[0];
+
+    // Pack little-endian, lowest bits first
+    unsigned char* out = writer->packed;
+    size_t used = 0;
+    uint64_t pending = 0;
+    int pending_bits = 0;
+    if (info->width > 0) {
+        for (int i = 0; i < count; i++) {
+            uint64_t value = (uint64_t)(archive_transform(info->transform, values, start, i) -
+                                        info->reference);
+            pending |= value << pending_bits;
+            pending_bits += info->width;
+            if (pending_bits >= 64) {
+                archive_put_u64(out + used, pending);
+                used += 8;
+                pending_bits -= 64;
+                pending = (pending_bits > 0) ? value >> (info->width - pending_bits) : 0;
+            }
+        }
+    }
+    while (pending_bits > 0) {
+        out[used++] = (unsigned char)pending;
+        pending >>= 8;
+        pending_bits -= 8;
+    }
+    memset(out + used, 0, 8); // Lets the reader load 8 bytes at any row
+    used += 8;
+
+    info->length = (uint32_t)used;
+    info->crc = crc32_update(0, out, used);
+    return fwrite(out, 1, used, writer->file) == used;
+}
+
+/**
+ * Internal helper: Writes the buffered rows as one block and indexes it
+ */
+static void archive_flush_block(ArchiveWriter* writer) {
+    if (writer->count == 0 || writer->failed) {
+        return;
+    }
+
+    ArchiveBlockInfo block;
+    memset(&block, 0, sizeof(block));
+    block.offset = writer->offset;
+    block.count = (uint32_t)writer->count;
+    block.min_start = block.max_start = writer->columns[ARCHIVE_START][0];
+    block.min_doctor = block.max_doctor = writer->columns[ARCHIVE_DOCTOR][0];
+    for (int i = 1; i < writer->count; i++) {
+        int start = writer->columns[ARCHIVE_START][i];
+        int doctor = writer->columns[ARCHIVE_DOCTOR][i];
+        if (start < block.min_start) {
+            block.min_start = start;
+        }
+        if (start > block.max_start) {
+            block.max_start = start;
+        }
+        if (doctor < block.min_doctor) {
+            block.min_doctor = doctor;
+        }
+        if (doctor > block.max_doctor) {
+            block.max_doctor = doctor;
+        }
+    }
+
+    for (int column = 0; column < ARCHIVE_COLUMN_COUNT; column++) {
+        if (!archive_write_column(writer, column, &block.columns[column])) {
+            writer->failed = 1;
+            return;
+        }
+        writer->offset += block.columns[column].length;
+    }
+
+    // Grow the index by doubling
+    if (writer->block_count == writer->index_capacity) {
+        size_t capacity = (writer->index_capacity > 0) ? writer->index_capacity * 2 : 64;
+        unsigned char* index = (unsigned char*)realloc(writer->index,
+                                                       capacity * ARCHIVE_INDEX_ENTRY_SIZE);
+        if (index == NULL) {
+            writer->failed = 1;
+            return;
+        }
+        writer->index = index;
+        writer->index_capacity = capacity;
+    }
+
+    unsigned char* entry = writer->index + (size_t)writer->block_count * ARCHIVE_INDEX_ENTRY_SIZE;
+    memset(entry, 0, ARCHIVE_INDEX_ENTRY_SIZE);
+    archive_put_u64(entry, block.offset);
+    archive_put_u32(entry + 8, block.count);
+    archive_put_u32(entry + 12, (uint32_t)block.min_start);
+    archive_put_u32(entry + 16, (uint32_t)block.max_start);
+    archive_put_u32(entry + 20, (uint32_t)block.min_doctor);
+    archive_put_u32(entry + 24, (uint32_t)block.max_doctor);
+    for (int column = 0; column < ARCHIVE_COLUMN_COUNT; column++) {
+        const ArchiveColumnInfo* info = &block.columns[column];
+        unsigned char* p = entry + 32 + column * 24;
+        archive_put_u32(p, info->length);
+        archive_put_u32(p + 4, info->crc);
+        archive_put_u64(p + 8, (uint64_t)info->reference);
+        archive_put_u32(p + 16, (uint32_t)info->base);
+        p[20] = (unsigned char)info->transform;
+        p[21] = (unsigned char)info->width;
+    }
+
+    writer->block_count++;
+    writer->record_count += (uint64_t)writer->count;
+    writer->count = 0;
+}
+
+/**
+ * Internal helper: Opens "<path>.tmp" and allocates the block buffers
+ * @return: 1 on success, 0 on failure
+ */
+static int archive_writer_open(ArchiveWriter* writer, const char* path) {
+    memset(writer, 0, sizeof(*writer));
+    if (path == NULL || strlen(path) + 5 > sizeof(writer->tmp_path)) {
+        return 0;
+    }
+    snprintf(writer->tmp_path, sizeof(writer->tmp_path), "%s.tmp", path);
+    writer->path = path;
+
+    int ok = 1;
+    for (int column = 0; column < ARCHIVE_COLUMN_COUNT; column++) {
+        writer->columns[column] = (int*)malloc(ARCHIVE_BLOCK_RECORDS * sizeof(int));
+        ok = ok && writer->columns[column] != NULL;
+    }
+    // Worst case 64 bits per row, plus the padding
+    writer->packed = (unsigned char*)malloc((size_t)ARCHIVE_BLOCK_RECORDS * 8 + 16);
+    ok = ok && writer->packed != NULL;
+    writer->file = ok ? fopen(writer->tmp_path, "wb") : NULL;
+
+    unsigned char header[8];
+    memcpy(header, archive_magic, 4);
+    archive_put_u32(header + 4, ARCHIVE_VERSION);
+    if (writer->file == NULL || fwrite(header, 1, sizeof(header), writer->file) != sizeof(header)) {
+        if (writer->file != NULL) {
+            fclose(writer->file);
+            remove(writer->tmp_path);
+        }
+        for (int column = 0; column < ARCHIVE_COLUMN_COUNT; column++) {
+            free(writer->columns[column]);
+        }
+        free(writer->packed);
+        return 0;
+    }
+    writer->offset = sizeof(header);
+    return 1;
+}
+
+/**
+ * Internal helper: Buffers one appointment, writing a block when full
+ */
+static void archive_writer_add(ArchiveWriter* writer, const Appointment* appointment) {
+    int row = writer->count++;
+    writer->columns[ARCHIVE_ID][row] = appointment->appointment_id;
+    writer->columns[ARCHIVE_PATIENT][row] = appointment->patient_id;
+    writer->columns[ARCHIVE_DOCTOR][row] = appointment->doctor_id;
+    writer->columns[ARCHIVE_START][row] = appointment->start_time;
+    writer->columns[ARCHIVE_END][row] = appointment->end_time;
+    if (writer->count == ARCHIVE_BLOCK_RECORDS) {
+        archive_flush_block(writer);
+    }
+}
+
+/**
+ * Internal helper: Writes the last block, the index and the footer, then
+ * installs the file (or removes it when anything failed)
+ * @param commit: 0 to discard the archive
+ * @return: 1 on success, 0 on failure
+ */
+static int archive_writer_close(ArchiveWriter* writer, int commit) {
+    archive_flush_block(writer);
+
+    size_t index_size = (size_t)writer->block_count * ARCHIVE_INDEX_ENTRY_SIZE;
+    unsigned char footer[ARCHIVE_FOOTER_SIZE];
+    archive_put_u32(footer, ARCHIVE_BLOCK_RECORDS);
+    archive_put_u32(footer + 4, writer->block_count);
+    archive_put_u64(footer + 8, writer->record_count);
+    archive_put_u64(footer + 16, writer->offset);
+    archive_put_u32(footer + 24, crc32_update(0, writer->index, index_size));
+    archive_put_u32(footer + 28, crc32_update(0, footer, ARCHIVE_FOOTER_SIZE - 4));
+
+    int ok = commit && !writer->failed &&
+             (index_size == 0 || fwrite(writer->index, 1, index_size, writer->file) == index_size) &&
+             fwrite(footer, 1, sizeof(footer), writer->file) == sizeof(footer) &&
+             fflush(writer->file) == 0 && archive_fsync(writer->file) == 0;
+    if (fclose(writer->file) != 0) {
+        ok = 0;
+    }
+    if (ok) {
+        // rename does not replace on Windows
+#ifdef _WIN32
+        remove(writer->path);
+#endif
+        ok = rename(writer->tmp_path, writer->path) == 0;
+    }
+    if (!ok) {
+        remove(writer->tmp_path);
+    }
+
+    for (int column = 0; column < ARCHIVE_COLUMN_COUNT; column++) {
+        free(writer->columns[column]);
+    }
+    free(writer->packed);
+    free(writer->index);
+    return ok;
+}
+
+/**
+ * Writes appointments to an archive
+ * Time Complexity: O(n)
+ * 
+ * @param path: Archive path
+ * @param appointments: Appointment pointer array (NULL entries skipped)
+ * @param count: Array length
+ * @return: 1 on success, 0 on failure
+ */
+int archive_write(const char* path, Appointment** appointments, int count) {
+    if (appointments == NULL && count > 0) {
+        return 0;
+    }
+
+    ArchiveWriter writer;
+    if (!archive_writer_open(&writer, path)) {
+        return 0;
+    }
+    for (int i = 0; i < count; i++) {
+        if (appointments[i] != NULL) {
+            archive_writer_add(&writer, appointments[i]);
+        }
+    }
+    return archive_writer_close(&writer, 1);
+}
+
+/**
+ * Internal helper: CSV visitor feeding the writer
+ */
+static int archive_add_visited(const Appointment* appointment, void* context) {
+    ArchiveWriter* writer = (ArchiveWriter*)context;
+    archive_writer_add(writer, appointment);
+    return !writer->failed;
+}
+
+/**
+ * Converts an appointments CSV file into an archive
+ * Time Complexity: O(n), one block in memory
+ * 
+ * @param path: Archive path
+ * @param csv_path: Appointments CSV path
+ * @param records: Receives the number of archived appointments (may be NULL)
+ * @return: 1 on success, 0 on failure
+ */
+int archive_write_csv(const char* path, const char* csv_path, long long* records) {
+    if (records != NULL) {
+        *records = 0;
+    }
+
+    ArchiveWriter writer;
+    if (csv_path == NULL || !archive_writer_open(&writer, path)) {
+        return 0;
+    }
+    int read = visit_appointments_csv(csv_path, archive_add_visited, &writer, NULL);
+    long long written = (long long)writer.record_count + writer.count;
+    if (!archive_writer_close(&writer, read)) {
+        return 0;
+    }
+    if (records != NULL) {
+        *records = written;
+    }
+    return 1;
+}
+
+/**
+ * Fills a query that returns the given columns of every row
+ * Time Complexity: O(1)
+ * 
+ * @param query: Query to fill
+ * @param columns: ARCHIVE_COLUMN_* flags
+ */
+void archive_query_init(ArchiveQuery* query, int columns) {
+    if (query == NULL) {
+        return;
+    }
+    query->columns = columns & ARCHIVE_COLUMN_ALL;
+    query->min_start_time = 0;
+    query->max_start_time = 1439;
+    query->doctor_id = 0;
+}
+
+/**
+ * Internal helper: Parses and bounds-checks one index entry
+ * @return: 1 if the entry describes a block inside [8, index_offset), 0 otherwise
+ */
+static int archive_read_entry(const unsigned char* entry, uint64_t index_offset,
+                              uint32_t block_records, ArchiveBlockInfo* block) {
+    block->offset = archive_get_u64(entry);
+    block->count = archive_get_u32(entry + 8);
+    block->min_start = (int32_t)archive_get_u32(entry + 12);
+    block->max_start = (int32_t)archive_get_u32(entry + 16);
+    block->min_doctor = (int32_t)archive_get_u32(entry + 20);
+    block->max_doctor = (int32_t)archive_get_u32(entry + 24);
+    if (block->count == 0 || block->count > block_records || block->offset < 8) {
+        return 0;
+    }
+
+    uint64_t end = block->offset;
+    for (int column = 0; column < ARCHIVE_COLUMN_COUNT; column++) {
+        const unsigned char* p = entry + 32 + column * 24;
+        ArchiveColumnInfo* info = &block->columns[column];
+        info->length = archive_get_u32(p);
+        info->crc = archive_get_u32(p + 4);
+        info->reference = (int64_t)archive_get_u64(p + 8);
+        info->base = (int32_t)archive_get_u32(p + 16);
+        info->transform = p[20];
+        info->width = p[21];
+
+        uint64_t packed = ((uint64_t)block->count * (uint64_t)info->width + 7) / 8;
+        if (info->width > ARCHIVE_MAX_WIDTH || info->transform > ARCHIVE_FROM_START ||
+            (info->transform == ARCHIVE_FROM_START && column != ARCHIVE_END) ||
+            info->length < packed + 8) {
+            return 0;
+        }
+        end += info->length;
+    }
+    return end <= index_offset;
+}
+
+/**
+ * Internal helper: Verifies and unpacks one column
+ * @param data: First packed byte
+ * @param start: Decoded start_time column (ARCHIVE_FROM_START only)
+ * @param out: Receives count values
+ * @return: 1 on success, 0 if the checksum does not match
+ */
+static int archive_decode_column(const unsigned char* data, const ArchiveColumnInfo* info,
+                                 int count, const int* start, int* out) {
+    if (crc32_update(0, data, info->length) != info->crc) {
+        return 0;
+    }
+
+    // Values wrap modulo 2^32, so deltas between any two ints come out exact
+    uint32_t reference = (uint32_t)info->reference;
+    if (info->width == 0) {
+        for (int i = 0; i < count; i++) {
+            out[i] = (int)reference;
+        }
+    } else {
+        uint64_t mask = ((uint64_t)1 << info->width) - 1;
+        uint64_t bit = 0;
+        for (int i = 0; i < count; i++) {
+            uint64_t word = archive_get_u64(data + (bit >> 3));
+            out[i] = (int)(reference + (uint32_t)((word >> (bit & 7)) & mask));
+            bit += (uint64_t)info->width;
+        }
+    }
+
+    if (info->transform == ARCHIVE_DELTA) {
+        uint32_t value = (uint32_t)info->base;
+        for (int i = 0; i < count; i++) {
+            value += (uint32_t)out[i];
+            out[i] = (int)value;
+        }
+    } else if (info->transform == ARCHIVE_FROM_START) {
+        for (int i = 0; i < count; i++) {
+            out[i] = (int)((uint32_t)start[i] + (uint32_t)out[i]);
+        }
+    }
+    return 1;
+}
+
+/**
+ * Scans an archive, handing the matching rows of each block to the visitor
+ * Time Complexity: O(b) for the index, O(rows) per decoded column
+ * 
+ * @param path: Archive path
+ * @param query: Columns and filters
+ * @param visitor: Called once per block with matching rows
+ * @param context: Passed to the visitor
+ * @param report: Receives the result (may be NULL)
+ * @return: 1 if the scan finished or the visitor stopped, 0 on failure
+ */
+int archive_scan(const char* path, const ArchiveQuery* query, ArchiveVisitor visitor,
+                 void* context, ArchiveScanReport* report) {
+    ArchiveScanReport result;
+    memset(&result, 0, sizeof(result));
+    if (report != NULL) {
+        *report = result;
+    }
+    if (path == NULL || query == NULL || visitor == NULL) {
+        return 0;
+    }
+
+    MappedFile map;
+    if (!mapfile_open(&map, path)) {
+        return 0;
+    }
+    const unsigned char* data = (const unsigned char*)map.data;
+    if (map.size < 8 + ARCHIVE_FOOTER_SIZE || memcmp(data, archive_magic, 4) != 0 ||
+        archive_get_u32(data + 4) != ARCHIVE_VERSION) {
+        mapfile_close(&map);
+        return 0;
+    }
+
+    // Footer and index must be intact before any block is trusted
+    const unsigned char* footer = data + map.size - ARCHIVE_FOOTER_SIZE;
+    uint32_t block_records = archive_get_u32(footer);
+    uint32_t block_count = archive_get_u32(footer + 4);
+    uint64_t index_offset = archive_get_u64(footer + 16);
+    if (crc32_update(0, footer, ARCHIVE_FOOTER_SIZE - 4) != archive_get_u32(footer + 28) ||
+        block_records == 0 || block_records > ARCHIVE_MAX_BLOCK_RECORDS ||
+        index_offset < 8 || index_offset > map.size - ARCHIVE_FOOTER_SIZE ||
+        (uint64_t)block_count * ARCHIVE_INDEX_ENTRY_SIZE != map.size - ARCHIVE_FOOTER_SIZE - index_offset ||
+        crc32_update(0, data + index_offset, (size_t)block_count * ARCHIVE_INDEX_ENTRY_SIZE) !=
+            archive_get_u32(footer + 24)) {
+        mapfile_close(&map);
+        return 0;
+    }
+
+    int* columns[ARCHIVE_COLUMN_COUNT];
+    int ok = 1;
+    for (int column = 0; column < ARCHIVE_COLUMN_COUNT; column++) {
+        columns[column] = (int*)malloc((size_t)block_records * sizeof(int));
+        ok = ok && columns[column] != NULL;
+    }
+
+    int wanted = query->columns & ARCHIVE_COLUMN_ALL;
+    result.blocks = block_count;
+    for (uint32_t b = 0; ok && b < block_count; b++) {
+        ArchiveBlockInfo block;
+        if (!archive_read_entry(data + index_offset + (size_t)b * ARCHIVE_INDEX_ENTRY_SIZE,
+                                index_offset, block_records, &block)) {
+            ok = 0;
+            break;
+        }
+
+        // Skip blocks whose ranges miss the query
+        if (block.max_start < query->min_start_time || block.min_start > query->max_start_time ||
+            (query->doctor_id != 0 &&
+             (query->doctor_id < block.min_doctor || query->doctor_id > block.max_doctor))) {
+            result.blocks_skipped++;
+            continue;
+        }
+
+        // Filter rows only when the block straddles a query bound
+        int filter_start = block.min_start < query->min_start_time ||
+                           block.max_start > query->max_start_time;
+        int filter_doctor = query->doctor_id != 0 &&
+                            (block.min_doctor != query->doctor_id || block.max_doctor != query->doctor_id);
+        int needed = wanted;
+        if (filter_start) {
+            needed |= ARCHIVE_COLUMN_START;
+        }
+        if (filter_doctor) {
+            needed |= ARCHIVE_COLUMN_DOCTOR;
+        }
+        if ((needed & ARCHIVE_COLUMN_END) && block.columns[ARCHIVE_END].transform == ARCHIVE_FROM_START) {
+            needed |= ARCHIVE_COLUMN_START;
+        }
+
+        int count = (int)block.count;
+        uint64_t offset = block.offset;
+        for (int column = 0; ok && column < ARCHIVE_COLUMN_COUNT; column++) {
+            if (needed & (1 << column)) {
+                ok = archive_decode_column(data + offset, &block.columns[column], count,
+                                           columns[ARCHIVE_START], columns[column]);
+            }
+            offset += block.columns[column].length;
+        }
+        if (!ok) {
+            break; // Corrupt column
+        }
+        result.rows_scanned += count;
+
+        int matched = count;
+        if (filter_start || filter_doctor) {
+            matched = 0;
+            for (int i = 0; i < count; i++) {
+                if ((filter_start && (columns[ARCHIVE_START][i] < query->min_start_time ||
+                                      columns[ARCHIVE_START][i] > query->max_start_time)) ||
+                    (filter_doctor && columns[ARCHIVE_DOCTOR][i] != query->doctor_id)) {
+                    continue;
+                }
+                // Compact in place (matched <= i, so row i is read before it can be overwritten)
+                for (int column = 0; column < ARCHIVE_COLUMN_COUNT; column++) {
+                    if (wanted & (1 << column)) {
+                        columns[column][matched] = columns[column][i];
+                    }
+                }
+                matched++;
+            }
+        }
+        if (matched == 0) {
+            continue;
+        }
+
+        ArchiveBatch batch;
+        batch.count = matched;
+        batch.appointment_id = (wanted & ARCHIVE_COLUMN_ID) ? columns[ARCHIVE_ID] : NULL;
+        batch.patient_id = (wanted & ARCHIVE_COLUMN_PATIENT) ? columns[ARCHIVE_PATIENT] : NULL;
+        batch.doctor_id = (wanted & ARCHIVE_COLUMN_DOCTOR) ? columns[ARCHIVE_DOCTOR] : NULL;
+        batch.start_time = (wanted & ARCHIVE_COLUMN_START) ? columns[ARCHIVE_START] : NULL;
+        batch.end_time = (wanted & ARCHIVE_COLUMN_END) ? columns[ARCHIVE_END] : NULL;
+        result.rows_matched += matched;
+        if (!visitor(&batch, context)) {
+            result.stopped = 1;
+            break;
+        }
+    }
+
+    for (int column = 0; column < ARCHIVE_COLUMN_COUNT; column++) {
+        free(columns[column]);
+    }
+    mapfile_close(&map);
+    if (report != NULL) {
+        *report = result;
+    }
+    return ok;
+}
@@ -0,0 +1,153 @@
+#ifndef ARCHIVE_H
+#define ARCHIVE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "appointment.h"
+
+/**
+ * Columnar Appointment Archive
+ *
+ * Compressed, read-only store for historical appointments, meant for
+ * analytics scans rather than for the live system. Appointments are cut
+ * into blocks of ARCHIVE_BLOCK_RECORDS rows (file order is kept); inside a
+ * block every field is stored as its own column, bit-packed around a
+ * frame of reference. Each column picks the smallest of:
+ *   plain       value - reference
+ *   delta       (value - previous value) - reference, from a base value
+ *               (dense IDs and sorted times pack into 0-1 bits per row)
+ *   from start  (end_time - start_time) - reference (end_time only)
+ *
+ * A block index at the end of the file stores, per block, the start_time
+ * and doctor_id ranges and the location, encoding and CRC-32 of each
+ * column. A scan skips blocks whose ranges miss the query without touching
+ * them, and decodes only the columns it asked for (plus the ones its
+ * filter needs).
+ *
+ * File layout (all integers little-endian):
+ *   "RARC" magic (4 bytes), version (u32)
+ *   blocks: the five columns of each block back to back; a column is
+ *     ceil(count * width / 8) packed bytes followed by 8 zero bytes
+ *   index: one ARCHIVE_INDEX_ENTRY_SIZE entry per block
+ *     offset (u64), count (u32), min/max start_time (i32 x2),
+ *     min/max doctor_id (i32 x2), reserved (u32), then per column:
+ *     length (u32), CRC-32 (u32), reference (i64), base (i32),
+ *     transform (u8), bit width (u8), reserved (u16)
+ *   footer (ARCHIVE_FOOTER_SIZE bytes): block size (u32), block count (u32),
+ *     record count (u64), index offset (u64), index CRC-32 (u32),
+ *     footer CRC-32 (u32, over the preceding footer bytes)
+ */
+
+/**
+ * Default archive path
+ */
+#define ARCHIVE_DEFAULT_PATH "data/appointments.arc"
+
+/**
+ * Format version, rows per block and fixed sizes
+ */
+#define ARCHIVE_VERSION 1
+#define ARCHIVE_BLOCK_RECORDS 65536
+#define ARCHIVE_MAX_BLOCK_RECORDS (1 << 20)
+#define ARCHIVE_COLUMN_COUNT 5
+#define ARCHIVE_INDEX_ENTRY_SIZE (32 + ARCHIVE_COLUMN_COUNT * 24)
+#define ARCHIVE_FOOTER_SIZE 32
+
+/**
+ * Columns (bit flags for ArchiveQuery.columns)
+ */
+typedef enum {
+    ARCHIVE_COLUMN_ID = 1 << 0,
+    ARCHIVE_COLUMN_PATIENT = 1 << 1,
+    ARCHIVE_COLUMN_DOCTOR = 1 << 2,
+    ARCHIVE_COLUMN_START = 1 << 3,
+    ARCHIVE_COLUMN_END = 1 << 4,
+    ARCHIVE_COLUMN_ALL = (1 << ARCHIVE_COLUMN_COUNT) - 1
+} ArchiveColumn;
+
+/**
+ * Scan parameters
+ */
+typedef struct {
+    int columns;          // ARCHIVE_COLUMN_* flags to return
+    int min_start_time;   // Only rows with min_start_time <= start_time <= max_start_time
+    int max_start_time;
+    int doctor_id;        // Only rows of this doctor (0 = any)
+} ArchiveQuery;
+
+/**
+ * Rows handed to the visitor (at most one block; reader-owned, valid during the call)
+ * Columns that were not requested are NULL
+ */
+typedef struct {
+    int count;
+    const int* appointment_id;
+    const int* patient_id;
+    const int* doctor_id;
+    const int* start_time;
+    const int* end_time;
+} ArchiveBatch;
+
+/**
+ * Batch callback: return 1 to continue, 0 to stop the scan
+ */
+typedef int (*ArchiveVisitor)(const ArchiveBatch* batch, void* context);
+
+/**
+ * Result of a scan
+ */
+typedef struct {
+    long long blocks;          // Blocks in the file
+    long long blocks_skipped;  // Blocks skipped through the index
+    long long rows_scanned;    // Rows in decoded blocks
+    long long rows_matched;    // Rows handed to the visitor
+    int stopped;               // 1 if the visitor stopped the scan
+} ArchiveScanReport;
+
+/**
+ * Archive Operations
+ * Time Complexity: O(n) write, O(rows in matching blocks) scan
+ */
+
+/**
+ * Writes appointments to an archive atomically ("<path>.tmp", fsync, rename)
+ * NULL entries are skipped
+ * @param path: Archive path
+ * @param appointments: Appointment pointer array
+ * @param count: Array length
+ * @return: 1 on success, 0 on failure (an existing archive is left intact)
+ */
+int archive_write(const char* path, Appointment** appointments, int count);
+
+/**
+ * Converts an appointments CSV file into an archive, streaming (one block
+ * in memory, so the CSV may be larger than RAM)
+ * @param path: Archive path
+ * @param csv_path: Appointments CSV path
+ * @param records: Receives the number of archived appointments (may be NULL)
+ * @return: 1 on success, 0 on failure
+ */
+int archive_write_csv(const char* path, const char* csv_path, long long* records);
+
+/**
+ * Fills a query that returns the given columns of every row
+ * @param query: Query to fill
+ * @param columns: ARCHIVE_COLUMN_* flags
+ */
+void archive_query_init(ArchiveQuery* query, int columns);
+
+/**
+ * Scans an archive, handing the matching rows of each block to the visitor
+ * Every column read is checked against its CRC-32
+ * @param path: Archive path
+ * @param query: Columns and filters
+ * @param visitor: Called once per block with matching rows
+ * @param context: Passed to the visitor
+ * @param report: Receives the result (may be NULL)
+ * @return: 1 if the scan finished or the visitor stopped, 0 if the file is
+ *          missing or corrupt or memory ran out
+ */
+int archive_scan(const char* path, const ArchiveQuery* query, ArchiveVisitor visitor,
+                 void* context, ArchiveScanReport* report);
+
+#endif // ARCHIVE_H
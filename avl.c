@@ -193,7 +193,8 @@ static int check_conflict_in_subtree(AVLNode* node, int doctor_id,
 
 /**
  * Helper function: Recursive insert into AVL tree
- * Time Complexity: O(log n) for insertion + O(n) for conflict check in worst case
+ * Conflicts are checked once by avl_insert, not at every level
+ * Time Complexity: O(log n)
  * 
  * @param node: Root of subtree
  * @param appointment: Appointment to insert
@@ -220,15 +221,6 @@ static AVLNode* avl_insert_recursive(AVLNode* node, Appointment* appointment,
         return new_node;
     }
 
-    // Check for conflict before inserting
-    // This ensures we don't insert conflicting appointments
-    if (check_conflict_in_subtree(node, doctor_id, 
-                                  appointment->start_time, 
-                                  appointment->end_time)) {
-        *inserted = 0; // Conflict detected
-        return node; // Return unchanged tree
-    }
-
     // Insert based on start_time (tree key)
     if (appointment->start_time < node->appointment->start_time) {
         node->left = avl_insert_recursive(node->left, appointment, doctor_id, inserted);
@@ -287,6 +279,14 @@ int avl_insert(AVLTree* tree, Appointment* appointment, int doctor_id) {
         return 0;
     }
 
+    // Check for conflict once over the whole tree before inserting
+    // (any subtree checked during descent is part of this scan)
+    if (check_conflict_in_subtree(tree->root, doctor_id,
+                                  appointment->start_time,
+                                  appointment->end_time)) {
+        return 0; // Conflict detected
+    }
+
     int inserted = 0;
     tree->root = avl_insert_recursive(tree->root, appointment, doctor_id, &inserted);
 
@@ -498,6 +498,35 @@ Appointment* avl_delete(AVLTree* tree, int appointment_id) {
     return deleted_appointment;
 }
 
+/**
+ * Deletes a known appointment from AVL tree using its start_time (tree key)
+ * Callers that already hold the appointment pointer avoid the full
+ * traversal of avl_delete
+ * Time Complexity: O(log n)
+ * 
+ * @param tree: Pointer to AVL tree
+ * @param appointment: Appointment to delete (must still have its indexed start_time)
+ * @return: Pointer to deleted appointment, NULL if not in tree
+ */
+Appointment* avl_delete_appointment(AVLTree* tree, Appointment* appointment) {
+    if (tree == NULL || appointment == NULL) {
+        return NULL;
+    }
+
+    // Start times are unique in the tree, so the key identifies one node
+    AVLNode* node = tree->root;
+    while (node != NULL && node->appointment->start_time != appointment->start_time) {
+        node = (appointment->start_time < node->appointment->start_time) ? node->left : node->right;
+    }
+    if (node == NULL || node->appointment != appointment) {
+        return NULL; // Not found
+    }
+
+    tree->root = avl_delete_by_time(tree->root, appointment->start_time);
+    tree->size--;
+    return appointment;
+}
+
 /**
  * Helper function: Recursive search by appointment_id
  * Time Complexity: O(log n) average, O(n) worst case if tree is unbalanced
@@ -688,3 +717,109 @@ void avl_destroy(AVLTree* tree) {
     tree->size = 0;
 }
 
+/**
+ * Helper function: Builds a balanced subtree from sorted[low..high]
+ * The middle element becomes the root, so heights differ by at most one
+ * Time Complexity: O(n)
+ * 
+ * @param sorted: Appointments in increasing start_time order
+ * @param low: First index of the range
+ * @param high: Last index of the range
+ * @param failed: Set to 1 if a node could not be allocated
+ * @return: Root of the subtree, NULL for an empty range or on failure
+ */
+static AVLNode* avl_build_recursive(Appointment** sorted, int low, int high, int* failed) {
+    if (low > high) {
+        return NULL;
+    }
+
+    int middle = low + (high - low) / 2;
+    AVLNode* node = (AVLNode*)malloc(sizeof(AVLNode));
+    if (node == NULL) {
+        *failed = 1;
+        return NULL;
+    }
+    node->appointment = sorted[middle];
+    node->left = avl_build_recursive(sorted, low, middle - 1, failed);
+    node->right = avl_build_recursive(sorted, middle + 1, high, failed);
+    avl_update_height(node);
+    return node;
+}
+
+/**
+ * Builds a balanced tree from appointments sorted by start_time
+ * Used when the order was saved from an existing tree, so no conflict
+ * checks and no rotations are needed
+ * Time Complexity: O(n)
+ * 
+ * @param tree: Pointer to an empty AVL tree
+ * @param sorted: Appointments in strictly increasing start_time order
+ * @param count: Number of appointments
+ * @return: 1 on success, 0 if the tree is not empty, the order is invalid
+ *          or memory ran out (the tree is left empty)
+ */
+int avl_build_sorted(AVLTree* tree, Appointment** sorted, int count) {
+    if (tree == NULL || tree->root != NULL || count < 0 || (count > 0 && sorted == NULL)) {
+        return 0;
+    }
+
+    // Duplicate or unordered keys would break the search order
+    for (int i = 0; i < count; i++) {
+        if (sorted[i] == NULL ||
+            (i > 0 && sorted[i - 1]->start_time >= sorted[i]->start_time)) {
+            return 0;
+        }
+    }
+
+    int failed = 0;
+    AVLNode* root = avl_build_recursive(sorted, 0, count - 1, &failed);
+    if (failed) {
+        avl_destroy_recursive(root);
+        return 0;
+    }
+
+    tree->root = root;
+    tree->size = count;
+    return 1;
+}
+
+/**
+ * Helper function: In-order copy of a subtree
+ * Time Complexity: O(n)
+ * 
+ * @param node: Root of subtree
+ * @param out: Output array
+ * @param capacity: Size of out
+ * @param count: Number of entries written so far (updated)
+ */
+static void avl_collect_inorder(const AVLNode* node, Appointment** out, int capacity, int* count) {
+    if (node == NULL || *count >= capacity) {
+        return;
+    }
+
+    avl_collect_inorder(node->left, out, capacity, count);
+    if (*count < capacity) {
+        out[(*count)++] = node->appointment;
+    }
+    avl_collect_inorder(node->right, out, capacity, count);
+}
+
+/**
+ * Copies the appointments in start_time order
+ * Time Complexity: O(n)
+ * 
+ * @param tree: Pointer to AVL tree
+ * @param out: Array with room for capacity pointers
+ * @param capacity: Size of out
+ * @return: Number of appointments written (at most capacity)
+ */
+int avl_to_sorted_array(const AVLTree* tree, Appointment** out, int capacity) {
+    if (tree == NULL || out == NULL || capacity <= 0) {
+        return 0;
+    }
+
+    int count = 0;
+    avl_collect_inorder(tree->root, out, capacity, &count);
+    return count;
+}
+
@@ -81,6 +81,15 @@ int avl_has_conflict(AVLTree* tree, int doctor_id, int start_time, int end_time)
  */
 Appointment* avl_delete(AVLTree* tree, int appointment_id);
 
+/**
+ * Deletes a known appointment using its start_time (tree key)
+ * O(log n) alternative to avl_delete when the pointer is at hand
+ * @param tree: Pointer to AVL tree
+ * @param appointment: Appointment to delete
+ * @return: Pointer to deleted appointment, NULL if not in tree
+ */
+Appointment* avl_delete_appointment(AVLTree* tree, Appointment* appointment);
+
 /**
  * Searches for an appointment by appointment_id
  * @param tree: Pointer to AVL tree
@@ -109,6 +118,26 @@ int avl_is_empty(const AVLTree* tree);
  */
 void avl_destroy(AVLTree* tree);
 
+/**
+ * Builds a balanced tree from appointments sorted by start_time in O(n)
+ * No conflict checks: the order must come from an existing tree
+ * @param tree: Pointer to an empty AVL tree
+ * @param sorted: Appointments in strictly increasing start_time order
+ * @param count: Number of appointments
+ * @return: 1 on success, 0 if the tree is not empty, the order is invalid
+ *          or memory ran out
+ */
+int avl_build_sorted(AVLTree* tree, Appointment** sorted, int count);
+
+/**
+ * Copies the appointments in start_time order (in-order traversal)
+ * @param tree: Pointer to AVL tree
+ * @param out: Array with room for capacity pointers
+ * @param capacity: Size of out
+ * @return: Number of appointments written (at most capacity)
+ */
+int avl_to_sorted_array(const AVLTree* tree, Appointment** out, int capacity);
+
 /**
  * Internal helper functions for AVL balancing
  */
@@ -4,12 +4,12 @@
 
 echo "GTK3 ile derleme baslatiyor..."
 
-gcc -Wall -Wextra -std=c99 -g \
+gcc -Wall -Wextra -std=c11 -g \
   main.c gui.c \
   patient.c doctor.c appointment.c \
-  avl.c heap.c queue.c stack.c \
-  file_io.c sort_search.c menu.c \
-  -o randevu_sistemi.exe \
+  avl.c heap.c waitlist.c intmap.c vector.c journal.c \
+  mapfile.c snapshot.c archive.c integrity.c registry.c import.c idalloc.c file_io.c statelog.c crc32.c wal.c thread.c checkpoint.c sort_search.c menu.c intake.c scheduler.c \
+  -pthread -o randevu_sistemi.exe \
   `pkg-config --cflags --libs gtk+-3.0`
 
 if [ $? -eq 0 ]; then
@@ -0,0 +1,791 @@
+/**
+ * Background Checkpointer Implementation
+ * 
+ * One snapshot buffer, one worker thread
+ * - checkpoint_maybe/request copy the live records into the buffer (if the
+ *   worker is idle) and wake the worker
+ * - With a lazy registry only the overlay records and the removed IDs are
+ *   copied; the worker streams the unchanged records from the old snapshot
+ *   file (only the worker replaces that file, so it is stable meanwhile)
+ * - The worker stages the CSV files and the binary snapshot, commits the
+ *   marker, installs the files and truncates the write-ahead log
+ * 
+ * Every file goes through "<file>.tmp" + fsync + rename, and the CSV writer
+ * and the snapshot stage advance a shared row counter for checkpoint_progress
+ * 
+ * Time Complexity:
+ * - capture: O(n) copies on the mutating thread; O(k + h) with a lazy
+ *   registry (overlay records and removed IDs)
+ * - write: O(n) CSV formatting and snapshot encoding, 5 fsyncs and an O(k)
+ *   log rewrite in the background
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <limits.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+#include "checkpoint.h"
+#include "file_io.h"
+#include "snapshot.h"
+#include "wal.h"
+#include "thread.h"
+
+#ifdef _WIN32
+#include <io.h>
+#define checkpoint_fsync(file) _commit(_fileno(file))
+#else
+#include <unistd.h>
+#define checkpoint_fsync(file) fsync(fileno(file))
+#endif
+
+static const unsigned char checkpoint_magic[4] = { 'R', 'C', 'K', 'P' };
+
+// Files covered by a checkpoint, in write order (three CSVs, then the snapshot)
+#define CHECKPOINT_FILE_COUNT 4
+#define CHECKPOINT_SNAPSHOT_FILE 3
+static const char* const checkpoint_file_paths[CHECKPOINT_FILE_COUNT] = {
+    PATIENTS_CSV_PATH, DOCTORS_CSV_PATH, APPOINTMENTS_CSV_PATH, SNAPSHOT_DEFAULT_PATH
+};
+
+/**
+ * Captured records (copied by value)
+ * With a lazy registry, patients/doctors hold the overlay until the worker
+ * merges the snapshot records in front of it
+ */
+typedef struct {
+    Patient* patients;
+    int patient_count;
+    Doctor* doctors;
+    int doctor_count;
+    Appointment* appointments;
+    int appointment_count;
+    Appointment* tree;            // AVL tree contents in start_time order
+    int tree_count;
+    unsigned long long lsn;       // LSN the copy was taken at
+    int lazy;                     // 1 if the snapshot records still have to be merged
+    char source[260];             // Registry snapshot to merge from
+    IntMap hidden_patients;       // Registry IDs removed since that snapshot
+    IntMap hidden_doctors;
+    int source_patients;          // Record counts of that snapshot (merge buffer size)
+    int source_doctors;
+} CheckpointSnapshot;
+
+// Process-wide checkpointer (guarded by checkpoint_lock while running)
+static ThreadMutex checkpoint_lock;
+static ThreadCond checkpoint_work;
+static ThreadCond checkpoint_done;           // Broadcast when a write finishes
+static Thread checkpoint_thread;
+static int checkpoint_running = 0;
+static int checkpoint_stopping = 0;
+static int checkpoint_busy = 0;              // Snapshot handed to the worker
+static JournalContext checkpoint_context;
+static long long checkpoint_interval = CHECKPOINT_DEFAULT_INTERVAL;
+static unsigned long long checkpoint_requested_lsn = 0; // LSN of the last capture
+static char checkpoint_path[512];
+static CheckpointSnapshot checkpoint_snapshot;
+static CheckpointStats checkpoint_statistics;
+static long long checkpoint_write_start = 0;  // Start of the running write
+static long long checkpoint_write_total = 0;  // Records the running write covers
+static atomic_llong checkpoint_rows_written;  // Advanced by the CSV writer and the snapshot stage
+
+/**
+ * Internal helper: Builds "<path><suffix>"
+ * @return: 1 on success, 0 if the result does not fit
+ */
+static int checkpoint_path_with(char* out, size_t size, const char* path, const char* suffix) {
+    if (strlen(path) + strlen(suffix) + 1 > size) {
+        return 0;
+    }
+    snprintf(out, size, "%s%s", path, suffix);
+    return 1;
+}
+
+/**
+ * Internal helper: 1 if a file exists
+ */
+static int checkpoint_file_exists(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return 0;
+    }
+    fclose(file);
+    return 1;
+}
+
+/**
+ * Internal helper: Renames a file over another
+ * @return: 1 on success, 0 on failure
+ */
+static int checkpoint_replace(const char* from, const char* to) {
+#ifdef _WIN32
+    // rename does not replace on Windows; remove + rename would leave no file
+    // at all if the process died in between
+    return MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return rename(from, to) == 0;
+#endif
+}
+
+/**
+ * Internal helper: Reads the snapshot LSN from the marker file
+ * @return: Snapshot LSN, 0 if the marker is missing or invalid
+ */
+static unsigned long long checkpoint_read_marker(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return 0;
+    }
+
+    unsigned char marker[16];
+    unsigned long long lsn = 0;
+    if (fread(marker, 1, sizeof(marker), file) == sizeof(marker) &&
+        memcmp(marker, checkpoint_magic, 4) == 0 &&
+        ((uint32_t)marker[4] | ((uint32_t)marker[5] << 8) |
+         ((uint32_t)marker[6] << 16) | ((uint32_t)marker[7] << 24)) == CHECKPOINT_VERSION) {
+        for (int i = 7; i >= 0; i--) {
+            lsn = (lsn << 8) | marker[8 + i];
+        }
+    }
+    fclose(file);
+    return lsn;
+}
+
+/**
+ * Internal helper: Atomically replaces the marker file (the commit point)
+ * @return: 1 on success, 0 on failure
+ */
+static int checkpoint_write_marker(const char* path, unsigned long long lsn) {
+    char tmp_path[520];
+    if (!checkpoint_path_with(tmp_path, sizeof(tmp_path), path, ".tmp")) {
+        return 0;
+    }
+
+    unsigned char marker[16];
+    memcpy(marker, checkpoint_magic, 4);
+    for (int i = 0; i < 4; i++) {
+        marker[4 + i] = (unsigned char)((uint32_t)CHECKPOINT_VERSION >> (8 * i));
+    }
+    for (int i = 0; i < 8; i++) {
+        marker[8 + i] = (unsigned char)(lsn >> (8 * i));
+    }
+
+    FILE* file = fopen(tmp_path, "wb");
+    if (file == NULL) {
+        return 0;
+    }
+    int ok = fwrite(marker, 1, sizeof(marker), file) == sizeof(marker) &&
+             fflush(file) == 0 && checkpoint_fsync(file) == 0;
+    if (fclose(file) != 0 || !ok || !checkpoint_replace(tmp_path, path)) {
+        remove(tmp_path);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Internal helper: Builds a pointer array over one captured table
+ * (the save functions take pointer arrays)
+ * @param table: 0 patients, 1 doctors, 2 appointments, 3 tree order
+ * @return: Array to free, NULL if memory ran out
+ */
+static void** checkpoint_table_pointers(int table, const CheckpointSnapshot* snapshot, int* count) {
+    *count = (table == 0) ? snapshot->patient_count
+           : (table == 1) ? snapshot->doctor_count
+           : (table == 2) ? snapshot->appointment_count
+           : snapshot->tree_count;
+    void** records = (void**)malloc((*count > 0 ? *count : 1) * sizeof(void*));
+    if (records == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < *count; i++) {
+        records[i] = (table == 0) ? (void*)&snapshot->patients[i]
+                   : (table == 1) ? (void*)&snapshot->doctors[i]
+                   : (table == 2) ? (void*)&snapshot->appointments[i]
+                   : (void*)&snapshot->tree[i];
+    }
+    return records;
+}
+
+/**
+ * Internal helper: Writes the staged binary snapshot (fsynced by snapshot_save)
+ * @return: 1 on success, 0 on failure
+ */
+static int checkpoint_stage_snapshot(const char* stage_path, const CheckpointSnapshot* snapshot) {
+    int counts[4];
+    void** tables[4];
+    int ok = 1;
+    for (int table = 0; table < 4; table++) {
+        tables[table] = checkpoint_table_pointers(table, snapshot, &counts[table]);
+        ok = ok && tables[table] != NULL;
+    }
+
+    ok = ok && snapshot_save(stage_path, snapshot->lsn,
+                             (Patient**)tables[0], counts[0],
+                             (Doctor**)tables[1], counts[1],
+                             (Appointment**)tables[2], counts[2],
+                             (Appointment**)tables[3], counts[3]);
+    if (ok) {
+        atomic_fetch_add(&checkpoint_rows_written, (long long)counts[0] + counts[1] + counts[2]);
+    }
+    for (int table = 0; table < 4; table++) {
+        free(tables[table]);
+    }
+    return ok;
+}
+
+/**
+ * Internal helper: Writes and fsyncs one staged file
+ * @param file: Index into checkpoint_file_paths
+ * @return: 1 on success, 0 on failure
+ */
+static int checkpoint_stage_file(int file, const CheckpointSnapshot* snapshot) {
+    char stage_path[520];
+    if (!checkpoint_path_with(stage_path, sizeof(stage_path), checkpoint_file_paths[file],
+                              CHECKPOINT_STAGE_SUFFIX)) {
+        return 0;
+    }
+    if (file == CHECKPOINT_SNAPSHOT_FILE) {
+        return checkpoint_stage_snapshot(stage_path, snapshot);
+    }
+
+    int count;
+    void** records = checkpoint_table_pointers(file, snapshot, &count);
+    if (records == NULL) {
+        return 0;
+    }
+
+    // The save functions write "<stage>.tmp", fsync it and rename it into place
+    remove(stage_path); // A stale staged file must not pass for this one
+    int saved = (file == 0) ? save_patients_to_csv(stage_path, (Patient**)records, count)
+              : (file == 1) ? save_doctors_to_csv(stage_path, (Doctor**)records, count)
+              : save_appointments_to_csv(stage_path, (Appointment**)records, count);
+    free(records);
+
+    // save_* returns 0 for an empty table as well; only a successful save creates the file
+    return saved == count && (count > 0 || checkpoint_file_exists(stage_path));
+}
+
+/**
+ * Snapshot merge state: records of the old snapshot that were neither
+ * removed nor replaced by the overlay are appended to a growing buffer
+ */
+typedef struct {
+    const IntMap* hidden;     // IDs removed since the old snapshot
+    IntMap overlay_ids;       // IDs of the captured overlay records
+    unsigned char* records;   // Merged records
+    int count;
+    int capacity;
+    size_t record_size;
+    int failed;               // Memory ran out
+} CheckpointMerge;
+
+/**
+ * Internal helper: Appends one snapshot record unless it is removed or shadowed
+ * @return: 1 to continue, 0 if memory ran out
+ */
+static int checkpoint_merge_record(CheckpointMerge* merge, int id, const void* record) {
+    if (intmap_contains(merge->hidden, id) || intmap_contains(&merge->overlay_ids, id)) {
+        return 1;
+    }
+    if (merge->count == merge->capacity) {
+        int capacity = (merge->capacity <= INT_MAX / 2) ? merge->capacity * 2 : 0;
+        unsigned char* records = (capacity > 0)
+            ? (unsigned char*)realloc(merge->records, (size_t)capacity * merge->record_size) : NULL;
+        if (records == NULL) {
+            merge->failed = 1;
+            return 0;
+        }
+        merge->records = records;
+        merge->capacity = capacity;
+    }
+    memcpy(merge->records + (size_t)merge->count * merge->record_size, record, merge->record_size);
+    merge->count++;
+    return 1;
+}
+
+static int checkpoint_merge_patient(const Patient* patient, void* context) {
+    return checkpoint_merge_record((CheckpointMerge*)context, patient->id, patient);
+}
+
+static int checkpoint_merge_doctor(const Doctor* doctor, void* context) {
+    return checkpoint_merge_record((CheckpointMerge*)context, doctor->id, doctor);
+}
+
+/**
+ * Internal helper: Puts the old snapshot's unchanged records in front of the
+ * captured overlay of one table (same order as registry_visit_*)
+ * @param table: 0 patients, 1 doctors
+ * @return: 1 on success, 0 if the snapshot cannot be read or memory ran out
+ */
+static int checkpoint_merge_table(CheckpointSnapshot* snapshot, int table) {
+    void** overlay = (table == 0) ? (void**)&snapshot->patients : (void**)&snapshot->doctors;
+    int* overlay_count = (table == 0) ? &snapshot->patient_count : &snapshot->doctor_count;
+
+    CheckpointMerge merge;
+    memset(&merge, 0, sizeof(merge));
+    merge.hidden = (table == 0) ? &snapshot->hidden_patients : &snapshot->hidden_doctors;
+    merge.record_size = (table == 0) ? sizeof(Patient) : sizeof(Doctor);
+    merge.capacity = ((table == 0) ? snapshot->source_patients : snapshot->source_doctors) +
+                     *overlay_count + 1;
+    merge.records = (unsigned char*)malloc((size_t)merge.capacity * merge.record_size);
+    intmap_init(&merge.overlay_ids);
+    int ok = merge.records != NULL && intmap_reserve(&merge.overlay_ids, *overlay_count);
+    for (int i = 0; ok && i < *overlay_count; i++) {
+        int id = (table == 0) ? snapshot->patients[i].id : snapshot->doctors[i].id;
+        ok = intmap_put(&merge.overlay_ids, id, snapshot);
+    }
+    if (ok) {
+        ok = (table == 0)
+            ? snapshot_visit_patients(snapshot->source, checkpoint_merge_patient, &merge)
+            : snapshot_visit_doctors(snapshot->source, checkpoint_merge_doctor, &merge);
+        ok = ok && !merge.failed;
+    }
+
+    // Overlay after the snapshot records (the buffer was sized for it)
+    if (ok && merge.capacity - merge.count < *overlay_count) {
+        unsigned char* records = (unsigned char*)realloc(
+            merge.records, ((size_t)merge.count + (size_t)*overlay_count) * merge.record_size);
+        ok = records != NULL;
+        if (ok) {
+            merge.records = records;
+        }
+    }
+    intmap_destroy(&merge.overlay_ids);
+    if (!ok) {
+        free(merge.records);
+        return 0;
+    }
+    memcpy(merge.records + (size_t)merge.count * merge.record_size, *overlay,
+           (size_t)*overlay_count * merge.record_size);
+    free(*overlay);
+    *overlay = merge.records;
+    *overlay_count += merge.count;
+    return 1;
+}
+
+/**
+ * Internal helper: Completes a lazy capture with the old snapshot's records
+ * (checkpointer thread) and updates the progress total
+ * @return: 1 on success, 0 on failure
+ */
+static int checkpoint_merge_snapshot(CheckpointSnapshot* snapshot) {
+    if (!snapshot->lazy) {
+        return 1;
+    }
+    if (!checkpoint_merge_table(snapshot, 0) || !checkpoint_merge_table(snapshot, 1)) {
+        return 0;
+    }
+    snapshot->lazy = 0;
+
+    thread_mutex_lock(&checkpoint_lock);
+    checkpoint_write_total = 2 * ((long long)snapshot->patient_count + snapshot->doctor_count +
+                                  snapshot->appointment_count);
+    thread_mutex_unlock(&checkpoint_lock);
+    return 1;
+}
+
+/**
+ * Internal helper: Writes a captured snapshot (checkpointer thread)
+ * @return: 1 on success, 0 on failure (the previous checkpoint stays valid)
+ */
+static int checkpoint_write(CheckpointSnapshot* snapshot) {
+    char stage_path[520];
+
+    // Log records up to the snapshot LSN must be durable before the marker
+    // moves past them, or a crash could leave the log behind the snapshot
+    if (!wal_wait_durable(snapshot->lsn)) {
+        return 0;
+    }
+    if (!checkpoint_merge_snapshot(snapshot)) {
+        return 0;
+    }
+
+    for (int file = 0; file < CHECKPOINT_FILE_COUNT; file++) {
+        if (!checkpoint_stage_file(file, snapshot)) {
+            return 0;
+        }
+    }
+    if (!checkpoint_write_marker(checkpoint_path, snapshot->lsn)) {
+        return 0;
+    }
+
+    // Committed: from here on recovery rolls the staged files forward
+    int ok = 1;
+    for (int file = 0; file < CHECKPOINT_FILE_COUNT; file++) {
+        checkpoint_path_with(stage_path, sizeof(stage_path), checkpoint_file_paths[file],
+                             CHECKPOINT_STAGE_SUFFIX);
+        ok = checkpoint_replace(stage_path, checkpoint_file_paths[file]) && ok;
+    }
+    return ok && wal_truncate(snapshot->lsn);
+}
+
+/**
+ * Internal helper: Checkpointer thread
+ */
+static void checkpoint_loop(void* arg) {
+    (void)arg;
+    thread_mutex_lock(&checkpoint_lock);
+    for (;;) {
+        while (!checkpoint_busy && !checkpoint_stopping) {
+            thread_cond_wait(&checkpoint_work, &checkpoint_lock);
+        }
+        if (!checkpoint_busy) {
+            break; // Stopping with nothing in flight
+        }
+        thread_mutex_unlock(&checkpoint_lock);
+
+        // The snapshot buffer belongs to this thread while busy is set
+        int ok = checkpoint_write(&checkpoint_snapshot);
+        long long elapsed = thread_now_us() - checkpoint_write_start;
+
+        thread_mutex_lock(&checkpoint_lock);
+        if (ok) {
+            checkpoint_statistics.checkpoints++;
+            checkpoint_statistics.last_lsn = checkpoint_snapshot.lsn;
+            checkpoint_statistics.last_write_us = elapsed;
+            checkpoint_statistics.last_records = checkpoint_write_total;
+        } else {
+            checkpoint_statistics.failures++;
+        }
+        checkpoint_busy = 0;
+        thread_cond_broadcast(&checkpoint_done);
+    }
+    thread_mutex_unlock(&checkpoint_lock);
+}
+
+/**
+ * Internal helper: Copies the live records into the snapshot buffer
+ * Called with the worker idle, so the buffer is not shared. With a lazy
+ * registry only the overlay and the removed IDs are copied (see
+ * checkpoint_merge_snapshot)
+ * @return: 1 on success, 0 if memory ran out
+ */
+static int checkpoint_capture(void) {
+    const JournalContext* ctx = &checkpoint_context;
+    CheckpointSnapshot* snapshot = &checkpoint_snapshot;
+
+    // Buffers follow the live counts (+1 so an empty table still allocates)
+    Patient* patients = (Patient*)realloc(snapshot->patients,
+                                          ((size_t)ctx->patients->count + 1) * sizeof(Patient));
+    if (patients == NULL) {
+        return 0;
+    }
+    snapshot->patients = patients;
+    Doctor* doctors = (Doctor*)realloc(snapshot->doctors,
+                                       ((size_t)ctx->doctors->count + 1) * sizeof(Doctor));
+    if (doctors == NULL) {
+        return 0;
+    }
+    snapshot->doctors = doctors;
+    Appointment* appointments = (Appointment*)realloc(snapshot->appointments,
+                                                      (ctx->appointments->count + 1) * sizeof(Appointment));
+    if (appointments == NULL) {
+        return 0;
+    }
+    snapshot->appointments = appointments;
+    Appointment* tree = (Appointment*)realloc(snapshot->tree,
+                                              (avl_size(ctx->avl_tree) + 1) * sizeof(Appointment));
+    Appointment** tree_order = (Appointment**)malloc((avl_size(ctx->avl_tree) + 1) * sizeof(Appointment*));
+    if (tree != NULL) {
+        snapshot->tree = tree;
+    }
+    if (tree == NULL || tree_order == NULL) {
+        free(tree_order);
+        return 0;
+    }
+
+    snapshot->lazy = ctx->registry != NULL;
+    if (snapshot->lazy) {
+        if (!intmap_copy(&snapshot->hidden_patients, &ctx->registry->hidden_patients) ||
+            !intmap_copy(&snapshot->hidden_doctors, &ctx->registry->hidden_doctors)) {
+            free(tree_order);
+            return 0;
+        }
+        strcpy(snapshot->source, ctx->registry->path); // Same buffer size
+        snapshot->source_patients = ctx->registry->patient_count;
+        snapshot->source_doctors = ctx->registry->doctor_count;
+    }
+
+    snapshot->patient_count = 0;
+    for (int i = 0; i < ctx->patients->count; i++) {
+        if (ctx->patients->items[i] != NULL) {
+            snapshot->patients[snapshot->patient_count++] = *ctx->patients->items[i];
+        }
+    }
+    snapshot->doctor_count = 0;
+    for (int i = 0; i < ctx->doctors->count; i++) {
+        if (ctx->doctors->items[i] != NULL) {
+            snapshot->doctors[snapshot->doctor_count++] = *ctx->doctors->items[i];
+        }
+    }
+    snapshot->appointment_count = 0;
+    for (int i = 0; i < ctx->appointments->count; i++) {
+        if (ctx->appointments->items[i] != NULL) {
+            snapshot->appointments[snapshot->appointment_count++] = *ctx->appointments->items[i];
+        }
+    }
+    // Tree order lets startup skip the rebuild (stored as copies like the rest)
+    snapshot->tree_count = avl_to_sorted_array(ctx->avl_tree, tree_order, avl_size(ctx->avl_tree));
+    for (int i = 0; i < snapshot->tree_count; i++) {
+        snapshot->tree[i] = *tree_order[i];
+    }
+    free(tree_order);
+    snapshot->lsn = wal_last_lsn();
+    return 1;
+}
+
+/**
+ * Finishes or discards an interrupted checkpoint
+ * Time Complexity: O(1)
+ * 
+ * @param path: Marker file path
+ * @param wal_path: Write-ahead log path
+ * @return: LSN the CSV snapshot was taken at
+ */
+unsigned long long checkpoint_recover(const char* path, const char* wal_path) {
+    if (path == NULL || wal_path == NULL) {
+        return 0;
+    }
+
+    unsigned long long marker_lsn = checkpoint_read_marker(path);
+    unsigned long long base_lsn = 0;
+    wal_read_base_lsn(wal_path, &base_lsn);
+    int committed = marker_lsn > base_lsn;
+
+    char stage_path[520];
+    char partial_path[528];
+    for (int file = 0; file < CHECKPOINT_FILE_COUNT; file++) {
+        if (!checkpoint_path_with(stage_path, sizeof(stage_path), checkpoint_file_paths[file],
+                                  CHECKPOINT_STAGE_SUFFIX)) {
+            continue;
+        }
+        // A save cut off before its rename leaves "<stage>.tmp" behind
+        if (checkpoint_path_with(partial_path, sizeof(partial_path), stage_path, ".tmp")) {
+            remove(partial_path);
+        }
+        if (!checkpoint_file_exists(stage_path)) {
+            continue; // Never staged, or already installed
+        }
+
+        if (committed) {
+            checkpoint_replace(stage_path, checkpoint_file_paths[file]);
+        } else {
+            remove(stage_path);
+        }
+    }
+    return marker_lsn;
+}
+
+/**
+ * Starts the checkpointer thread
+ * Time Complexity: O(1)
+ * 
+ * @param path: Marker file path
+ * @param context: Live structures to snapshot
+ * @param interval: Logged records between checkpoints
+ * @return: 1 on success, 0 on failure
+ */
+int checkpoint_start(const char* path, const JournalContext* context, long long interval) {
+    if (path == NULL || context == NULL || strlen(path) >= sizeof(checkpoint_path)) {
+        return 0;
+    }
+
+    checkpoint_stop();
+    strcpy(checkpoint_path, path);
+    checkpoint_context = *context;
+    checkpoint_interval = interval;
+    checkpoint_requested_lsn = wal_last_lsn();
+    checkpoint_stopping = 0;
+    checkpoint_busy = 0;
+    memset(&checkpoint_statistics, 0, sizeof(checkpoint_statistics));
+    atomic_store(&checkpoint_rows_written, 0);
+    set_csv_save_progress(&checkpoint_rows_written);
+
+    thread_mutex_init(&checkpoint_lock);
+    thread_cond_init(&checkpoint_work);
+    thread_cond_init(&checkpoint_done);
+    if (!thread_start(&checkpoint_thread, checkpoint_loop, NULL)) {
+        set_csv_save_progress(NULL);
+        thread_cond_destroy(&checkpoint_done);
+        thread_cond_destroy(&checkpoint_work);
+        thread_mutex_destroy(&checkpoint_lock);
+        return 0;
+    }
+    checkpoint_running = 1;
+    return 1;
+}
+
+/**
+ * Starts a checkpoint now unless one is running
+ * Time Complexity: O(n) capture
+ * 
+ * @return: 1 if a checkpoint was started, 0 otherwise
+ */
+int checkpoint_request(void) {
+    if (!checkpoint_running || !wal_is_open()) {
+        return 0;
+    }
+
+    thread_mutex_lock(&checkpoint_lock);
+    int idle = !checkpoint_busy;
+    thread_mutex_unlock(&checkpoint_lock);
+    if (!idle) {
+        return 0; // Next call retries once the running checkpoint is done
+    }
+
+    long long start = thread_now_us();
+    if (!checkpoint_capture()) {
+        return 0;
+    }
+    long long elapsed = thread_now_us() - start;
+
+    thread_mutex_lock(&checkpoint_lock);
+    checkpoint_statistics.last_capture_us = elapsed;
+    checkpoint_requested_lsn = checkpoint_snapshot.lsn;
+    checkpoint_write_start = thread_now_us();
+    // A lazy capture holds only the overlay; the worker sets the exact total after merging
+    checkpoint_write_total = 2 * ((long long)checkpoint_snapshot.patient_count +
+                                  checkpoint_snapshot.doctor_count +
+                                  checkpoint_snapshot.appointment_count);
+    if (checkpoint_snapshot.lazy) {
+        checkpoint_write_total += 2 * ((long long)checkpoint_snapshot.source_patients +
+                                       checkpoint_snapshot.source_doctors);
+    }
+    atomic_store(&checkpoint_rows_written, 0);
+    checkpoint_busy = 1;
+    thread_cond_signal(&checkpoint_work);
+    thread_mutex_unlock(&checkpoint_lock);
+    return 1;
+}
+
+/**
+ * Starts a checkpoint if the interval and the log ratio are reached
+ * Time Complexity: O(1), O(n) capture when it triggers
+ * 
+ * @return: 1 if a checkpoint was started, 0 otherwise
+ */
+int checkpoint_maybe(void) {
+    if (!checkpoint_running || checkpoint_interval <= 0) {
+        return 0;
+    }
+
+    // A rewrite of n records waits for n / ratio changes (amortized O(1) per change)
+    const JournalContext* ctx = &checkpoint_context;
+    unsigned long long records = (unsigned long long)registry_patient_count(ctx->registry, ctx->patients) +
+                                 (unsigned long long)registry_doctor_count(ctx->registry, ctx->doctors) +
+                                 (unsigned long long)ctx->appointments->count;
+    unsigned long long threshold = records / CHECKPOINT_LOG_RATIO;
+    if (threshold < (unsigned long long)checkpoint_interval) {
+        threshold = (unsigned long long)checkpoint_interval;
+    }
+    if (wal_last_lsn() - checkpoint_requested_lsn < threshold) {
+        return 0;
+    }
+    return checkpoint_request();
+}
+
+/**
+ * Returns checkpoint statistics
+ * Time Complexity: O(1)
+ * 
+ * @param stats: Receives the statistics
+ */
+void checkpoint_stats(CheckpointStats* stats) {
+    if (stats == NULL) {
+        return;
+    }
+    if (checkpoint_running) {
+        thread_mutex_lock(&checkpoint_lock);
+        *stats = checkpoint_statistics;
+        thread_mutex_unlock(&checkpoint_lock);
+    } else {
+        *stats = checkpoint_statistics;
+    }
+}
+
+/**
+ * Returns the progress of the running checkpoint
+ * Time Complexity: O(1)
+ * 
+ * @param progress: Receives the progress
+ */
+void checkpoint_progress(CheckpointProgress* progress) {
+    if (progress == NULL) {
+        return;
+    }
+    memset(progress, 0, sizeof(*progress));
+    if (!checkpoint_running) {
+        progress->elapsed_us = checkpoint_statistics.last_write_us;
+        return;
+    }
+
+    thread_mutex_lock(&checkpoint_lock);
+    progress->active = checkpoint_busy;
+    if (checkpoint_busy) {
+        progress->records_total = checkpoint_write_total;
+        progress->records_done = atomic_load(&checkpoint_rows_written);
+        progress->elapsed_us = thread_now_us() - checkpoint_write_start;
+    } else {
+        progress->elapsed_us = checkpoint_statistics.last_write_us;
+    }
+    thread_mutex_unlock(&checkpoint_lock);
+
+    // A failed file leaves its partial count behind; never report past the total
+    if (progress->records_done > progress->records_total) {
+        progress->records_done = progress->records_total;
+    }
+}
+
+/**
+ * Waits up to timeout_us for the running checkpoint to finish
+ * Time Complexity: O(1) plus the wait
+ * 
+ * @param timeout_us: Longest wait in microseconds
+ * @return: 1 if no checkpoint is running, 0 on timeout
+ */
+int checkpoint_wait(long long timeout_us) {
+    if (!checkpoint_running) {
+        return 1;
+    }
+
+    thread_mutex_lock(&checkpoint_lock);
+    if (checkpoint_busy) {
+        thread_cond_timedwait(&checkpoint_done, &checkpoint_lock, timeout_us);
+    }
+    int idle = !checkpoint_busy;
+    thread_mutex_unlock(&checkpoint_lock);
+    return idle;
+}
+
+/**
+ * Waits for a running checkpoint and stops the checkpointer thread
+ * Time Complexity: O(1) plus the running checkpoint
+ */
+void checkpoint_stop(void) {
+    if (!checkpoint_running) {
+        return;
+    }
+
+    thread_mutex_lock(&checkpoint_lock);
+    checkpoint_stopping = 1;
+    thread_cond_signal(&checkpoint_work);
+    thread_mutex_unlock(&checkpoint_lock);
+    thread_join(&checkpoint_thread);
+    checkpoint_running = 0;
+    set_csv_save_progress(NULL);
+
+    thread_cond_destroy(&checkpoint_done);
+    thread_cond_destroy(&checkpoint_work);
+    thread_mutex_destroy(&checkpoint_lock);
+    free(checkpoint_snapshot.patients);
+    free(checkpoint_snapshot.doctors);
+    free(checkpoint_snapshot.appointments);
+    free(checkpoint_snapshot.tree);
+    intmap_destroy(&checkpoint_snapshot.hidden_patients);
+    intmap_destroy(&checkpoint_snapshot.hidden_doctors);
+    memset(&checkpoint_snapshot, 0, sizeof(checkpoint_snapshot));
+}
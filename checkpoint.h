@@ -0,0 +1,150 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "journal.h"
+
+/**
+ * Background Checkpointer
+ *
+ * Keeps write-ahead log replay bounded: once enough records are logged, a
+ * consistent snapshot of patients, doctors and appointments is written to
+ * the CSV files and the binary snapshot (snapshot.h), and the log is
+ * truncated up to the LSN the snapshot was taken at.
+ *
+ * The log is the incremental save (one record per changed record); a
+ * checkpoint is its compaction. It waits for CHECKPOINT_DEFAULT_INTERVAL
+ * records and for at least 1/CHECKPOINT_LOG_RATIO as many records as the
+ * dataset holds, so each rewrite of n records is paid for by n/ratio
+ * changes: saving costs O(ratio) record writes per change however large
+ * the dataset grows, and replay stays below 1/ratio of a full load.
+ *
+ * - Capture (mutating thread, between operations): records are copied by
+ *   value together with the current LSN - a memcpy, no I/O
+ * - Write (checkpointer thread): each CSV and the binary snapshot is staged
+ *   as "<file>.ckpt" and fsynced, the marker file then records the snapshot LSN (commit point),
+ *   the staged files are renamed into place and the log is truncated.
+ *   Bookings continue meanwhile; only log commits wait for the truncation.
+ *   Every file is written to "<file>.tmp" and renamed, so a crash never
+ *   leaves a truncated file behind; checkpoint_progress reports how far the
+ *   write has got
+ * - Recovery (startup, before the CSVs are loaded): a marker LSN newer than
+ *   the log's base LSN means a committed checkpoint did not finish, so its
+ *   staged files are renamed into place; otherwise staged files belong to
+ *   an uncommitted checkpoint and are removed
+ *
+ * Marker file layout (little-endian): "RCKP" magic (4 bytes) + version (u32)
+ * + snapshot LSN (u64)
+ *
+ * The checkpointer is a single process-wide instance, like the logs.
+ */
+
+/**
+ * Default marker file path
+ */
+#define CHECKPOINT_DEFAULT_PATH "data/checkpoint.dat"
+
+/**
+ * Logged records between checkpoints (minimum), and the dataset-to-log
+ * ratio that also has to be reached
+ */
+#define CHECKPOINT_DEFAULT_INTERVAL 1000
+#define CHECKPOINT_LOG_RATIO 4
+
+/**
+ * Suggested polling interval for progress reports (checkpoint_wait timeout)
+ */
+#define CHECKPOINT_PROGRESS_US 250000
+
+/**
+ * Marker format version and staged file suffix
+ */
+#define CHECKPOINT_VERSION 1
+#define CHECKPOINT_STAGE_SUFFIX ".ckpt"
+
+/**
+ * Checkpoint Statistics
+ */
+typedef struct {
+    int checkpoints;               // Completed checkpoints
+    int failures;                  // Checkpoints that could not be written
+    unsigned long long last_lsn;   // LSN of the last completed checkpoint
+    long long last_capture_us;     // Last capture time (mutating thread)
+    long long last_write_us;       // Last write + truncate time (checkpointer thread)
+    long long last_records;        // Records written by the last checkpoint (all files)
+} CheckpointStats;
+
+/**
+ * Progress of the running checkpoint
+ * Each record is written twice: once to its CSV file, once to the snapshot
+ */
+typedef struct {
+    int active;                    // 1 while a checkpoint is being written
+    long long records_done;        // Records written so far
+    long long records_total;       // Records the checkpoint writes
+    long long elapsed_us;          // Time since the write started (last write time when idle)
+} CheckpointProgress;
+
+/**
+ * Checkpoint Operations
+ * Time Complexity: O(n) capture on the mutating thread, O(n) write in the background
+ */
+
+/**
+ * Finishes or discards an interrupted checkpoint (call before loading the CSVs)
+ * @param path: Marker file path
+ * @param wal_path: Write-ahead log path
+ * @return: LSN the CSV snapshot was taken at (0 if no checkpoint was ever written)
+ */
+unsigned long long checkpoint_recover(const char* path, const char* wal_path);
+
+/**
+ * Starts the checkpointer thread
+ * @param path: Marker file path
+ * @param context: Live structures to snapshot (must outlive checkpoint_stop)
+ * @param interval: Minimum logged records between checkpoints (<= 0 disables automatic checkpoints)
+ * @return: 1 on success, 0 on failure
+ */
+int checkpoint_start(const char* path, const JournalContext* context, long long interval);
+
+/**
+ * Starts a checkpoint if the interval and the log ratio are reached and none is running
+ * Must be called from the thread that mutates the structures, between operations
+ * @return: 1 if a checkpoint was started, 0 otherwise
+ */
+int checkpoint_maybe(void);
+
+/**
+ * Starts a checkpoint now unless one is running
+ * Must be called from the thread that mutates the structures, between operations
+ * @return: 1 if a checkpoint was started, 0 otherwise
+ */
+int checkpoint_request(void);
+
+/**
+ * Returns checkpoint statistics
+ * @param stats: Receives the statistics
+ */
+void checkpoint_stats(CheckpointStats* stats);
+
+/**
+ * Returns the progress of the running checkpoint (safe from any thread)
+ * @param progress: Receives the progress
+ */
+void checkpoint_progress(CheckpointProgress* progress);
+
+/**
+ * Waits up to timeout_us for the running checkpoint to finish
+ * @param timeout_us: Longest wait in microseconds
+ * @return: 1 if no checkpoint is running (any more), 0 on timeout
+ */
+int checkpoint_wait(long long timeout_us);
+
+/**
+ * Waits for a running checkpoint and stops the checkpointer thread
+ * Call before wal_close
+ */
+void checkpoint_stop(void);
+
+#endif // CHECKPOINT_H
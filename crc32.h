@@ -0,0 +1,25 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * CRC-32 (IEEE 802.3, reflected polynomial 0xEDB88320)
+ *
+ * Shared checksum of the write-ahead log, the binary snapshot and the
+ * appointment archive. Lookup tables are compile-time constants, so the
+ * function needs no initialization and is safe to call from any thread.
+ */
+
+/**
+ * Continues a CRC-32 over a byte range
+ * crc32_update(crc32_update(0, a, n), b, m) equals the CRC of a then b
+ * @param crc: CRC of the preceding bytes (0 to start)
+ * @param data: Bytes to add (NULL: crc is returned unchanged)
+ * @param length: Number of bytes
+ * @return: CRC of the preceding bytes followed by data
+ */
+uint32_t crc32_update(uint32_t crc, const void* data, size_t length);
+
+#endif // CRC32_H
@@ -2,7 +2,10 @@
  * Dosya G/Ç İşlemleri Uygulaması
  * 
  * CSV dosyalarından veri yükleme ve kaydetme işlemleri
- * Sadece stdio.h fonksiyonları kullanılmıştır
+ * Randevular bellek eşlemeli (mmap) dosyadan, kopyasız olarak okunur;
+ * eşleme yapılamazsa akışlı okuyucuya dönülür. Akışlı okuyucu sabit bir
+ * tamponla çalışır ve her kaydı bir ziyaretçiye verir (visit_*_csv);
+ * hasta ve doktor yükleyicileri de bu ziyaretçilerin üzerine kuruludur
  * 
  * CSV Formatı:
  * - patients.csv: id,name,age
@@ -12,7 +15,23 @@
  * Zaman Formatı: HH:MM (örn: "09:30", "14:45")
  */
 
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <limits.h>
 #include "file_io.h"
+#include "idalloc.h"
+#include "mapfile.h"
+#include "thread.h"
+
+#ifdef _WIN32
+#include <io.h>
+#define csv_fsync(file) _commit(_fileno(file))
+#else
+#include <unistd.h>
+#define csv_fsync(file) fsync(fileno(file))
+#endif
 
 /**
  * Yardımcı Fonksiyon: CSV satırından alanları ayırır
@@ -128,76 +147,526 @@ void format_time_string(int minutes, char* buffer) {
 }
 
 /**
- * CSV dosyasından hastaları yükler
+ * Toplu CSV Yazıcı
  * 
- * CSV Formatı: id,name,age
- * İlk satır header olabilir (otomatik atlanır)
+ * Üç save_*_to_csv fonksiyonu satırları fprintf yerine büyük bir tampona
+ * elle biçimlendirir: tamsayılar elle yazılan itoa ile, saatler önceden
+ * hesaplanmış 1440 girdilik "HH:MM" tablosundan kopyalanır. Tampon dolunca
+ * tek fwrite ile diske aktarılır; biçim dizgisi hiç çözümlenmez.
  * 
- * @param filename: Hastalar CSV dosyasının yolu
- * @param patients: Yüklenen hastaları saklamak için dizi (önceden ayrılmış olmalı)
- * @param max_count: Yüklenecek maksimum hasta sayısı
- * @return: Başarıyla yüklenen hasta sayısı
+ * Yazım atomiktir: satırlar "<dosya>.tmp" dosyasına yazılır, fsync edilir
+ * ve hedefin üzerine yeniden adlandırılır. Yazım yarıda kesilirse (çökme,
+ * disk dolu) eski dosya olduğu gibi kalır.
+ */
+
+#define CSV_WRITE_BUFFER (256 * 1024)
+
+// "HH:MM" tablosu (derleme zamanında üretilir, paylaşılan durum yok)
+#define CSV_HHMM(h, m) { (char)('0' + (h) / 10), (char)('0' + (h) % 10), ':', \
+                         (char)('0' + (m) / 10), (char)('0' + (m) % 10) }
+#define CSV_HHMM_TENS(h, t) CSV_HHMM(h, (t) * 10 + 0), CSV_HHMM(h, (t) * 10 + 1), \
+    CSV_HHMM(h, (t) * 10 + 2), CSV_HHMM(h, (t) * 10 + 3), CSV_HHMM(h, (t) * 10 + 4), \
+    CSV_HHMM(h, (t) * 10 + 5), CSV_HHMM(h, (t) * 10 + 6), CSV_HHMM(h, (t) * 10 + 7), \
+    CSV_HHMM(h, (t) * 10 + 8), CSV_HHMM(h, (t) * 10 + 9)
+#define CSV_HHMM_HOUR(h) CSV_HHMM_TENS(h, 0), CSV_HHMM_TENS(h, 1), CSV_HHMM_TENS(h, 2), \
+    CSV_HHMM_TENS(h, 3), CSV_HHMM_TENS(h, 4), CSV_HHMM_TENS(h, 5)
+
+// İsteğe bağlı ilerleme sayacı (yazılan satırlar, tampon boşaltıldıkça eklenir)
+static atomic_llong* csv_save_progress = NULL;
+
+static const char csv_time_table[1440][5] = {
+    CSV_HHMM_HOUR(0), CSV_HHMM_HOUR(1), CSV_HHMM_HOUR(2), CSV_HHMM_HOUR(3),
+    CSV_HHMM_HOUR(4), CSV_HHMM_HOUR(5), CSV_HHMM_HOUR(6), CSV_HHMM_HOUR(7),
+    CSV_HHMM_HOUR(8), CSV_HHMM_HOUR(9), CSV_HHMM_HOUR(10), CSV_HHMM_HOUR(11),
+    CSV_HHMM_HOUR(12), CSV_HHMM_HOUR(13), CSV_HHMM_HOUR(14), CSV_HHMM_HOUR(15),
+    CSV_HHMM_HOUR(16), CSV_HHMM_HOUR(17), CSV_HHMM_HOUR(18), CSV_HHMM_HOUR(19),
+    CSV_HHMM_HOUR(20), CSV_HHMM_HOUR(21), CSV_HHMM_HOUR(22), CSV_HHMM_HOUR(23)
+};
+
+/**
+ * CSV yazıcı durumu
+ */
+typedef struct {
+    FILE* file;
+    const char* path;     // Hedef dosya
+    char tmp_path[520];   // Yazılan geçici dosya ("<hedef>.tmp")
+    char* buffer;         // CSV_WRITE_BUFFER bayt
+    size_t used;          // Tamponda bekleyen bayt sayısı
+    int rows;             // Yazılan kayıt satırları
+    int reported;         // İlerleme sayacına eklenmiş satırlar
+    int failed;           // Bir yazma hatası oldu mu
+} CsvWriter;
+
+/**
+ * Yardımcı Fonksiyon: Geçici dosyayı yazmak için açar ve tamponu ayırır
+ * @return: 1 başarılı, 0 dosya açılamadı veya bellek yetmedi
  */
-int load_patients_from_csv(const char* filename, Patient** patients, int max_count) {
-    if (filename == NULL || patients == NULL || max_count <= 0) {
+static int csv_writer_open(CsvWriter* writer, const char* filename) {
+    if (strlen(filename) + 5 > sizeof(writer->tmp_path)) {
         return 0;
     }
+    snprintf(writer->tmp_path, sizeof(writer->tmp_path), "%s.tmp", filename);
+    writer->path = filename;
+    writer->used = 0;
+    writer->rows = 0;
+    writer->reported = 0;
+    writer->failed = 0;
+    writer->buffer = (char*)malloc(CSV_WRITE_BUFFER);
+    writer->file = (writer->buffer != NULL) ? fopen(writer->tmp_path, "w") : NULL;
+    if (writer->file == NULL) {
+        free(writer->buffer);
+        return 0; // Dosya açılamadı
+    }
+    return 1;
+}
+
+/**
+ * Yardımcı Fonksiyon: Tampondaki baytları dosyaya aktarır ve ilerlemeyi bildirir
+ */
+static void csv_writer_flush(CsvWriter* writer) {
+    if (writer->used > 0 && fwrite(writer->buffer, 1, writer->used, writer->file) != writer->used) {
+        writer->failed = 1;
+    }
+    writer->used = 0;
+    if (csv_save_progress != NULL && writer->rows > writer->reported) {
+        atomic_fetch_add(csv_save_progress, (long long)(writer->rows - writer->reported));
+        writer->reported = writer->rows;
+    }
+}
+
+/**
+ * Yardımcı Fonksiyon: Tamponda en az room bayt yer açar
+ * (room, CSV_WRITE_BUFFER'dan küçük olmalı)
+ */
+static void csv_writer_reserve(CsvWriter* writer, size_t room) {
+    if (writer->used + room > CSV_WRITE_BUFFER) {
+        csv_writer_flush(writer);
+    }
+}
+
+/**
+ * Yardımcı Fonksiyon: Metni (en fazla max_length bayt) ve ardından ayırıcıyı yazar
+ */
+static void csv_writer_put_string(CsvWriter* writer, const char* text, size_t max_length, char separator) {
+    const char* nul = (const char*)memchr(text, '\0', max_length);
+    size_t length = (nul != NULL) ? (size_t)(nul - text) : max_length;
+    csv_writer_reserve(writer, length + 1);
+    memcpy(writer->buffer + writer->used, text, length);
+    writer->used += length;
+    writer->buffer[writer->used++] = separator;
+}
+
+/**
+ * Yardımcı Fonksiyon: Tamsayıyı ondalık olarak ve ardından ayırıcıyı yazar
+ * (elle yazılmış itoa; INT_MIN dahil tüm değerler)
+ */
+static void csv_writer_put_int(CsvWriter* writer, int value, char separator) {
+    char digits[12];
+    int length = 0;
+    unsigned int magnitude = (value < 0) ? 0u - (unsigned int)value : (unsigned int)value;
+    do {
+        digits[length++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+
+    csv_writer_reserve(writer, (size_t)length + 2);
+    char* out = writer->buffer + writer->used;
+    if (value < 0) {
+        *out++ = '-';
+    }
+    while (length > 0) {
+        *out++ = digits[--length];
+    }
+    *out++ = separator;
+    writer->used = (size_t)(out - writer->buffer);
+}
+
+/**
+ * Yardımcı Fonksiyon: Dakikayı "HH:MM" olarak ve ardından ayırıcıyı yazar
+ * Aralık dışı değerler format_time_string gibi "00:00" yazılır
+ */
+static void csv_writer_put_time(CsvWriter* writer, int minutes, char separator) {
+    if (minutes < 0 || minutes > 1439) {
+        minutes = 0;
+    }
+    csv_writer_reserve(writer, 6);
+    memcpy(writer->buffer + writer->used, csv_time_table[minutes], 5);
+    writer->used += 5;
+    writer->buffer[writer->used++] = separator;
+}
+
+/**
+ * Yardımcı Fonksiyon: Bir kayıt satırının bittiğini işaretler
+ */
+static void csv_writer_end_row(CsvWriter* writer) {
+    writer->rows++;
+}
+
+/**
+ * Yardımcı Fonksiyon: Kalan baytları yazar, fsync eder ve geçici dosyayı
+ * hedefin üzerine taşır (hata olursa geçici dosya silinir, hedef değişmez)
+ * @return: 1 başarılı, 0 bir yazma hatası oldu
+ */
+static int csv_writer_close(CsvWriter* writer) {
+    csv_writer_flush(writer);
+    if (fflush(writer->file) != 0 || csv_fsync(writer->file) != 0) {
+        writer->failed = 1;
+    }
+    if (fclose(writer->file) != 0) {
+        writer->failed = 1;
+    }
+    free(writer->buffer);
+
+    if (!writer->failed) {
+        // rename Windows'ta var olan dosyanın üzerine yazmaz
+#ifdef _WIN32
+        remove(writer->path);
+#endif
+        writer->failed = rename(writer->tmp_path, writer->path) != 0;
+    }
+    if (writer->failed) {
+        remove(writer->tmp_path);
+    }
+    return !writer->failed;
+}
 
-    FILE* file = fopen(filename, "r");
+/**
+ * Kayıt ilerleme sayacını ayarlar
+ * Zaman Karmaşıklığı: O(1)
+ * 
+ * @param rows: Yazılan satırların ekleneceği sayaç (NULL = bildirme)
+ */
+void set_csv_save_progress(atomic_llong* rows) {
+    csv_save_progress = rows;
+}
+
+/**
+ * Yardımcı Fonksiyon: Dosya boyutundan kayıt sayısını tahmin eder
+ * Vektöre yükleme öncesi bir kez yer ayırmak için kullanılır (tahmin
+ * küçük kalırsa vektör yine büyür, büyükse yalnızca işaretçi yeri harcanır)
+ * 
+ * @param filename: Dosya yolu
+ * @param bytes_per_record: Ortalama satır uzunluğu tahmini
+ * @return: Tahmini kayıt sayısı (dosya açılamazsa 0)
+ */
+static int estimate_record_count(const char* filename, int bytes_per_record) {
+    FILE* file = fopen(filename, "rb");
     if (file == NULL) {
-        // Dosya yoksa veya açılamazsa, boş dizi döndür (hata değil)
+        return 0;
+    }
+    long size = (fseek(file, 0, SEEK_END) == 0) ? ftell(file) : -1;
+    fclose(file);
+    if (size <= 0) {
         return 0;
     }
 
-    char line[500];
-    int count = 0;
-    int is_first_line = 1;
-    char fields[3][200];
+    long estimate = size / bytes_per_record + 1;
+    return (estimate > INT_MAX / 2) ? INT_MAX / 2 : (int)estimate;
+}
 
-    // Dosyayı satır satır oku
-    while (fgets(line, sizeof(line), file) != NULL && count < max_count) {
-        // İlk satırı atla (header olabilir)
-        if (is_first_line) {
-            // Header kontrolü: "id" veya sayısal değer içeriyor mu?
-            if (strstr(line, "id") != NULL || strstr(line, "ID") != NULL) {
-                is_first_line = 0;
-                continue; // Header satırını atla
+/**
+ * Yardımcı Fonksiyon: [start, end) satırında text geçiyor mu
+ */
+static int span_contains(const char* start, const char* end, const char* text) {
+    size_t length = strlen(text);
+    for (const char* p = start; p + length <= end; p++) {
+        if (memcmp(p, text, length) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Akışlı CSV okuyucu
+ * 
+ * Dosya sabit boyutlu (CSV_VISIT_BUFFER) bir tampona parça parça okunur;
+ * satırlar tampon içinde işaretçi çifti olarak verilir, yarım kalan satır
+ * tamponun başına taşınıp tamamlanır. Bellek kullanımı dosya boyutundan
+ * bağımsızdır. Tampona sığmayan satırlar geçersiz sayılıp atlanır.
+ */
+typedef struct {
+    FILE* file;
+    char* buffer;     // CSV_VISIT_BUFFER bayt
+    size_t start;     // Okunmamış ilk bayt
+    size_t end;       // Tampondaki geçerli baytların sonu
+    int eof;          // Dosyanın sonuna gelindi
+    int discard;      // Tampona sığmayan satırın kalanı atlanıyor
+    int failed;       // Bir okuma hatası oldu mu
+} CsvReader;
+
+/**
+ * Yardımcı Fonksiyon: Dosyayı okumak için açar ve tamponu ayırır
+ * @return: 1 başarılı, 0 dosya açılamadı veya bellek yetmedi
+ */
+static int csv_reader_open(CsvReader* reader, const char* filename) {
+    memset(reader, 0, sizeof(*reader));
+    reader->buffer = (char*)malloc(CSV_VISIT_BUFFER);
+    reader->file = (reader->buffer != NULL) ? fopen(filename, "rb") : NULL;
+    if (reader->file == NULL) {
+        free(reader->buffer);
+        return 0; // Dosya açılamadı
+    }
+    return 1;
+}
+
+/**
+ * Yardımcı Fonksiyon: Sıradaki satırı verir ("\r\n" sonu kırpılır)
+ * Satır bir sonraki çağrıya kadar geçerlidir
+ * 
+ * @param line: Satırın ilk baytı
+ * @param line_end: Satırın bittiği bayt (dahil değil)
+ * @return: 1 satır okundu, -1 tampona sığmayan satır atlandı, 0 dosya bitti
+ */
+static int csv_reader_next(CsvReader* reader, const char** line, const char** line_end) {
+    for (;;) {
+        char* data = reader->buffer + reader->start;
+        size_t available = reader->end - reader->start;
+        char* newline = (available > 0) ? (char*)memchr(data, '\n', available) : NULL;
+
+        if (reader->discard) {
+            // Uzun satırın kalanını yeni satıra kadar at
+            if (newline != NULL) {
+                reader->start = (size_t)(newline + 1 - reader->buffer);
+                reader->discard = 0;
+                return -1;
             }
-            is_first_line = 0;
+            reader->start = reader->end;
+            if (reader->eof) {
+                reader->discard = 0;
+                return -1;
+            }
+        } else if (newline != NULL || (reader->eof && available > 0)) {
+            char* end = (newline != NULL) ? newline : data + available;
+            reader->start = (newline != NULL) ? (size_t)(newline + 1 - reader->buffer) : reader->end;
+            if (end > data && end[-1] == '\r') {
+                end--;
+            }
+            *line = data;
+            *line_end = end;
+            return 1;
+        } else if (available == CSV_VISIT_BUFFER) {
+            reader->start = reader->end; // Satır tampona sığmıyor
+            reader->discard = 1;
+            continue;
+        }
+        if (reader->eof) {
+            return 0;
         }
 
-        // CSV satırını parse et
-        int field_count = parse_csv_line(line, fields, 3);
-        if (field_count < 3) {
-            continue; // Geçersiz satır, atla
+        // Yarım satırı tamponun başına taşı ve tamponu doldur
+        memmove(reader->buffer, reader->buffer + reader->start, reader->end - reader->start);
+        reader->end -= reader->start;
+        reader->start = 0;
+        size_t read = fread(reader->buffer + reader->end, 1, CSV_VISIT_BUFFER - reader->end,
+                            reader->file);
+        reader->end += read;
+        if (read == 0) {
+            reader->eof = 1;
+            reader->failed = ferror(reader->file) != 0;
         }
+    }
+}
 
-        // Alanları dönüştür ve hasta oluştur
-        int id = atoi(fields[0]);
-        int age = atoi(fields[2]);
+/**
+ * Yardımcı Fonksiyon: Dosyayı kapatır ve tamponu bırakır
+ * @return: 1 başarılı, 0 bir okuma hatası oldu
+ */
+static int csv_reader_close(CsvReader* reader) {
+    fclose(reader->file);
+    free(reader->buffer);
+    return !reader->failed;
+}
 
-        // Geçerlilik kontrolü
-        if (id <= 0 || age < 0 || age > 150) {
-            continue; // Geçersiz veri, atla
+/**
+ * Ziyaretçi fonksiyonları (türüne göre yalnızca biri kullanılır)
+ */
+typedef struct {
+    PatientVisitor patient;
+    DoctorVisitor doctor;
+    AppointmentVisitor appointment;
+    void* context;
+} CsvVisitorSet;
+
+/**
+ * Bir satırı parse edip ziyaretçiye veren fonksiyon
+ * @return: 1 devam, 0 ziyaretçi durdurdu, -1 geçersiz satır
+ */
+typedef int (*CsvRowHandler)(const char* start, const char* end, const CsvVisitorSet* visitors);
+
+/**
+ * Yardımcı Fonksiyon: Dosyayı satır satır okuyup her satırı işleyiciye verir
+ * İlk satır "id" içeriyorsa header sayılıp atlanır, boş satırlar sessizce atlanır
+ * 
+ * @param filename: CSV dosyasının yolu
+ * @param handle_row: Satır işleyici
+ * @param visitors: Ziyaretçi ve bağlamı
+ * @param report: Sonucun yazılacağı yapı (NULL olabilir)
+ * @return: 1 dosya sonuna kadar okundu veya ziyaretçi durdurdu, 0 açma/okuma hatası
+ */
+static int csv_visit(const char* filename, CsvRowHandler handle_row,
+                     const CsvVisitorSet* visitors, CsvVisitReport* report) {
+    CsvVisitReport result;
+    memset(&result, 0, sizeof(result));
+    if (report != NULL) {
+        *report = result;
+    }
+
+    CsvReader reader;
+    if (filename == NULL || !csv_reader_open(&reader, filename)) {
+        return 0;
+    }
+
+    const char* start;
+    const char* end;
+    long long line_number = 0;
+    int status;
+    while ((status = csv_reader_next(&reader, &start, &end)) != 0) {
+        line_number++;
+
+        // İlk satırı atla (header olabilir)
+        if (line_number == 1 && status > 0 &&
+            (span_contains(start, end, "id") || span_contains(start, end, "ID"))) {
+            continue;
+        }
+        if (status > 0 && end == start) {
+            continue; // Boş satır
         }
 
-        // Hasta oluştur
-        Patient* patient = (Patient*)malloc(sizeof(Patient));
-        if (patient == NULL) {
-            continue; // Bellek hatası, atla
+        if (status > 0) {
+            status = handle_row(start, end, visitors);
+        }
+        if (status < 0) {
+            // Geçersiz satır, atla (ilkinin yerini hatırla)
+            if (result.skipped == 0) {
+                result.first_skipped = line_number;
+            }
+            result.skipped++;
+            continue;
         }
 
-        patient->id = id;
-        strncpy(patient->name, fields[1], sizeof(patient->name) - 1);
-        patient->name[sizeof(patient->name) - 1] = '\0';
-        patient->age = age;
+        result.visited++;
+        if (status == 0) {
+            result.stopped = 1;
+            break;
+        }
+    }
 
-        patients[count] = patient;
-        count++;
+    int ok = csv_reader_close(&reader);
+    if (report != NULL) {
+        *report = result;
     }
+    return ok || result.stopped;
+}
 
-    fclose(file);
-    return count;
+/**
+ * Yardımcı Fonksiyon: Bir hasta satırını parse edip doğrular
+ * 
+ * @param start: Satırın ilk baytı
+ * @param end: Satırın bittiği bayt (dahil değil)
+ * @param patient: Hastanın yazılacağı yapı
+ * @return: 1 geçerli satır, 0 geçersiz satır
+ */
+static int parse_patient_row(const char* start, const char* end, Patient* patient) {
+    char line[500];
+    char fields[3][200];
+    size_t length = (size_t)(end - start);
+    if (length >= sizeof(line)) {
+        return 0; // Çok uzun satır
+    }
+    memcpy(line, start, length);
+    line[length] = '\0';
+
+    // CSV satırını parse et
+    if (parse_csv_line(line, fields, 3) < 3) {
+        return 0;
+    }
+
+    // Alanları dönüştür
+    int id = atoi(fields[0]);
+    int age = atoi(fields[2]);
+
+    // Geçerlilik kontrolü
+    if (id <= 0 || age < 0 || age > 150) {
+        return 0;
+    }
+
+    patient->id = id;
+    strncpy(patient->name, fields[1], sizeof(patient->name) - 1);
+    patient->name[sizeof(patient->name) - 1] = '\0';
+    patient->age = age;
+    return 1;
+}
+
+/**
+ * Yardımcı Fonksiyon: Hasta satırı işleyicisi
+ */
+static int visit_patient_row(const char* start, const char* end, const CsvVisitorSet* visitors) {
+    Patient patient;
+    if (!parse_patient_row(start, end, &patient)) {
+        return -1;
+    }
+    return visitors->patient(&patient, visitors->context) ? 1 : 0;
+}
+
+/**
+ * CSV dosyasındaki her hastayı ziyaretçiye verir
+ * 
+ * CSV Formatı: id,name,age
+ * İlk satır header olabilir (otomatik atlanır)
+ * 
+ * @param filename: Hastalar CSV dosyasının yolu
+ * @param visitor: Her geçerli hasta için çağrılır (0 döndürürse okuma durur)
+ * @param context: Ziyaretçiye verilen bağlam
+ * @param report: Sonucun yazılacağı yapı (NULL olabilir)
+ * @return: 1 başarılı, 0 dosya açılamadı veya okunamadı
+ */
+int visit_patients_csv(const char* filename, PatientVisitor visitor, void* context,
+                       CsvVisitReport* report) {
+    if (visitor == NULL) {
+        return 0;
+    }
+    CsvVisitorSet visitors = { visitor, NULL, NULL, context };
+    return csv_visit(filename, visit_patient_row, &visitors, report);
+}
+
+/**
+ * Yardımcı Fonksiyon: Ziyaret edilen hastanın kopyasını vektöre ekler
+ */
+static int append_patient(const Patient* patient, void* context) {
+    Patient* copy = (Patient*)malloc(sizeof(Patient));
+    if (copy == NULL) {
+        return 1; // Bellek hatası, atla
+    }
+    *copy = *patient;
+    if (!patient_vector_push((PatientVector*)context, copy)) {
+        free(copy); // Bellek hatası, atla
+    }
+    return 1;
+}
+
+/**
+ * CSV dosyasından hastaları yükler
+ * 
+ * CSV Formatı: id,name,age
+ * İlk satır header olabilir (otomatik atlanır)
+ * 
+ * @param filename: Hastalar CSV dosyasının yolu
+ * @param patients: Yüklenen hastaların ekleneceği vektör (gerektikçe büyür)
+ * @return: Başarıyla yüklenen hasta sayısı
+ */
+int load_patients_from_csv(const char* filename, PatientVector* patients) {
+    if (filename == NULL || patients == NULL) {
+        return 0;
+    }
+
+    // Dosya boyutundan kayıt sayısını tahmin edip bir kez yer ayır
+    patient_vector_reserve(patients, patients->count + estimate_record_count(filename, PATIENT_CSV_LINE_HINT));
+
+    // Dosya yoksa veya açılamazsa hiçbir şey eklenmez (hata değil)
+    int before = patients->count;
+    visit_patients_csv(filename, append_patient, patients, NULL);
+    return patients->count - before;
 }
 
 /**
@@ -216,100 +685,134 @@ int save_patients_to_csv(const char* filename, Patient** patients, int count) {
         return 0;
     }
 
-    FILE* file = fopen(filename, "w");
-    if (file == NULL) {
+    CsvWriter writer;
+    if (!csv_writer_open(&writer, filename)) {
         return 0; // Dosya açılamadı
     }
 
     // Header satırını yaz
-    fprintf(file, "id,name,age\n");
+    csv_writer_put_string(&writer, "id,name,age", 16, '\n');
 
     // Hastaları yaz
-    int saved = 0;
     for (int i = 0; i < count; i++) {
         if (patients[i] != NULL) {
-            fprintf(file, "%d,%s,%d\n", 
-                   patients[i]->id, 
-                   patients[i]->name, 
-                   patients[i]->age);
-            saved++;
+            csv_writer_put_int(&writer, patients[i]->id, ',');
+            csv_writer_put_string(&writer, patients[i]->name, sizeof(patients[i]->name), ',');
+            csv_writer_put_int(&writer, patients[i]->age, '\n');
+            csv_writer_end_row(&writer);
         }
     }
 
-    fclose(file);
-    return saved;
+    // Yazma hatasında hiçbir kayıt kaydedilmiş sayılmaz
+    return csv_writer_close(&writer) ? writer.rows : 0;
 }
 
 /**
- * CSV dosyasından doktorları yükler
- * 
- * CSV Formatı: id,name,department
- * İlk satır header olabilir (otomatik atlanır)
+ * Yardımcı Fonksiyon: Bir doktor satırını parse edip doğrular
  * 
- * @param filename: Doktorlar CSV dosyasının yolu
- * @param doctors: Yüklenen doktorları saklamak için dizi (önceden ayrılmış olmalı)
- * @param max_count: Yüklenecek maksimum doktor sayısı
- * @return: Başarıyla yüklenen doktor sayısı
+ * @param start: Satırın ilk baytı
+ * @param end: Satırın bittiği bayt (dahil değil)
+ * @param doctor: Doktorun yazılacağı yapı
+ * @return: 1 geçerli satır, 0 geçersiz satır
  */
-int load_doctors_from_csv(const char* filename, Doctor** doctors, int max_count) {
-    if (filename == NULL || doctors == NULL || max_count <= 0) {
-        return 0;
+static int parse_doctor_row(const char* start, const char* end, Doctor* doctor) {
+    char line[500];
+    char fields[3][200];
+    size_t length = (size_t)(end - start);
+    if (length >= sizeof(line)) {
+        return 0; // Çok uzun satır
     }
+    memcpy(line, start, length);
+    line[length] = '\0';
 
-    FILE* file = fopen(filename, "r");
-    if (file == NULL) {
-        // Dosya yoksa veya açılamazsa, boş dizi döndür (hata değil)
+    // CSV satırını parse et
+    if (parse_csv_line(line, fields, 3) < 3) {
         return 0;
     }
 
-    char line[500];
-    int count = 0;
-    int is_first_line = 1;
-    char fields[3][200];
-
-    // Dosyayı satır satır oku
-    while (fgets(line, sizeof(line), file) != NULL && count < max_count) {
-        // İlk satırı atla (header olabilir)
-        if (is_first_line) {
-            if (strstr(line, "id") != NULL || strstr(line, "ID") != NULL) {
-                is_first_line = 0;
-                continue; // Header satırını atla
-            }
-            is_first_line = 0;
-        }
-
-        // CSV satırını parse et
-        int field_count = parse_csv_line(line, fields, 3);
-        if (field_count < 3) {
-            continue; // Geçersiz satır, atla
-        }
+    // Geçerlilik kontrolü
+    int id = atoi(fields[0]);
+    if (id <= 0) {
+        return 0;
+    }
 
-        // Alanları dönüştür ve doktor oluştur
-        int id = atoi(fields[0]);
+    doctor->id = id;
+    strncpy(doctor->name, fields[1], sizeof(doctor->name) - 1);
+    doctor->name[sizeof(doctor->name) - 1] = '\0';
+    strncpy(doctor->department, fields[2], sizeof(doctor->department) - 1);
+    doctor->department[sizeof(doctor->department) - 1] = '\0';
+    return 1;
+}
 
-        // Geçerlilik kontrolü
-        if (id <= 0) {
-            continue; // Geçersiz veri, atla
-        }
+/**
+ * Yardımcı Fonksiyon: Doktor satırı işleyicisi
+ */
+static int visit_doctor_row(const char* start, const char* end, const CsvVisitorSet* visitors) {
+    Doctor doctor;
+    if (!parse_doctor_row(start, end, &doctor)) {
+        return -1;
+    }
+    return visitors->doctor(&doctor, visitors->context) ? 1 : 0;
+}
 
-        // Doktor oluştur
-        Doctor* doctor = (Doctor*)malloc(sizeof(Doctor));
-        if (doctor == NULL) {
-            continue; // Bellek hatası, atla
-        }
+/**
+ * CSV dosyasındaki her doktoru ziyaretçiye verir
+ * 
+ * CSV Formatı: id,name,department
+ * İlk satır header olabilir (otomatik atlanır)
+ * 
+ * @param filename: Doktorlar CSV dosyasının yolu
+ * @param visitor: Her geçerli doktor için çağrılır (0 döndürürse okuma durur)
+ * @param context: Ziyaretçiye verilen bağlam
+ * @param report: Sonucun yazılacağı yapı (NULL olabilir)
+ * @return: 1 başarılı, 0 dosya açılamadı veya okunamadı
+ */
+int visit_doctors_csv(const char* filename, DoctorVisitor visitor, void* context,
+                      CsvVisitReport* report) {
+    if (visitor == NULL) {
+        return 0;
+    }
+    CsvVisitorSet visitors = { NULL, visitor, NULL, context };
+    return csv_visit(filename, visit_doctor_row, &visitors, report);
+}
 
-        doctor->id = id;
-        strncpy(doctor->name, fields[1], sizeof(doctor->name) - 1);
-        doctor->name[sizeof(doctor->name) - 1] = '\0';
-        strncpy(doctor->department, fields[2], sizeof(doctor->department) - 1);
-        doctor->department[sizeof(doctor->department) - 1] = '\0';
+/**
+ * Yardımcı Fonksiyon: Ziyaret edilen doktorun kopyasını vektöre ekler
+ */
+static int append_doctor(const Doctor* doctor, void* context) {
+    Doctor* copy = (Doctor*)malloc(sizeof(Doctor));
+    if (copy == NULL) {
+        return 1; // Bellek hatası, atla
+    }
+    *copy = *doctor;
+    if (!doctor_vector_push((DoctorVector*)context, copy)) {
+        free(copy); // Bellek hatası, atla
+    }
+    return 1;
+}
 
-        doctors[count] = doctor;
-        count++;
+/**
+ * CSV dosyasından doktorları yükler
+ * 
+ * CSV Formatı: id,name,department
+ * İlk satır header olabilir (otomatik atlanır)
+ * 
+ * @param filename: Doktorlar CSV dosyasının yolu
+ * @param doctors: Yüklenen doktorların ekleneceği vektör (gerektikçe büyür)
+ * @return: Başarıyla yüklenen doktor sayısı
+ */
+int load_doctors_from_csv(const char* filename, DoctorVector* doctors) {
+    if (filename == NULL || doctors == NULL) {
+        return 0;
     }
 
-    fclose(file);
-    return count;
+    // Dosya boyutundan kayıt sayısını tahmin edip bir kez yer ayır
+    doctor_vector_reserve(doctors, doctors->count + estimate_record_count(filename, DOCTOR_CSV_LINE_HINT));
+
+    // Dosya yoksa veya açılamazsa hiçbir şey eklenmez (hata değil)
+    int before = doctors->count;
+    visit_doctors_csv(filename, append_doctor, doctors, NULL);
+    return doctors->count - before;
 }
 
 /**
@@ -328,113 +831,483 @@ int save_doctors_to_csv(const char* filename, Doctor** doctors, int count) {
         return 0;
     }
 
-    FILE* file = fopen(filename, "w");
-    if (file == NULL) {
+    CsvWriter writer;
+    if (!csv_writer_open(&writer, filename)) {
         return 0; // Dosya açılamadı
     }
 
     // Header satırını yaz
-    fprintf(file, "id,name,department\n");
+    csv_writer_put_string(&writer, "id,name,department", 32, '\n');
 
     // Doktorları yaz
-    int saved = 0;
     for (int i = 0; i < count; i++) {
         if (doctors[i] != NULL) {
-            fprintf(file, "%d,%s,%s\n", 
-                   doctors[i]->id, 
-                   doctors[i]->name, 
-                   doctors[i]->department);
-            saved++;
+            csv_writer_put_int(&writer, doctors[i]->id, ',');
+            csv_writer_put_string(&writer, doctors[i]->name, sizeof(doctors[i]->name), ',');
+            csv_writer_put_string(&writer, doctors[i]->department,
+                                  sizeof(doctors[i]->department), '\n');
+            csv_writer_end_row(&writer);
         }
     }
 
-    fclose(file);
-    return saved;
+    // Yazma hatasında hiçbir kayıt kaydedilmiş sayılmaz
+    return csv_writer_close(&writer) ? writer.rows : 0;
 }
 
 /**
- * CSV dosyasından randevuları yükler
+ * Yardımcı Fonksiyon: [start, end) aralığının başındaki ve sonundaki
+ * boşluk/sekme karakterlerini atlar (kopyalamadan)
+ */
+static void trim_span(const char** start, const char** end) {
+    while (*start < *end && (**start == ' ' || **start == '\t')) (*start)++;
+    while (*end > *start && ((*end)[-1] == ' ' || (*end)[-1] == '\t')) (*end)--;
+}
+
+/**
+ * Yardımcı Fonksiyon: Eşlenmiş baytlardan doğrudan tamsayı okur
+ * atoi'nin aksine alanın tamamı sayı olmalıdır; taşma reddedilir
  * 
- * CSV Formatı: appointment_id,patient_id,doctor_id,start_time,end_time
- * Zaman formatı: HH:MM (örn: "09:30")
- * İlk satır header olabilir (otomatik atlanır)
+ * @param start: Alanın ilk baytı
+ * @param end: Alanın bittiği bayt (dahil değil)
+ * @param value: Okunan değer
+ * @return: 1 başarılı, 0 geçersiz alan
+ */
+static int parse_int_span(const char* start, const char* end, int* value) {
+    trim_span(&start, &end);
+    int negative = 0;
+    if (start < end && (*start == '-' || *start == '+')) {
+        negative = (*start == '-');
+        start++;
+    }
+    if (start == end) {
+        return 0; // Rakam yok
+    }
+
+    long long result = 0;
+    for (const char* p = start; p < end; p++) {
+        if (*p < '0' || *p > '9') {
+            return 0; // Sayı olmayan karakter
+        }
+        result = result * 10 + (*p - '0');
+        if (result > INT_MAX) {
+            return 0; // Taşma
+        }
+    }
+
+    *value = negative ? -(int)result : (int)result;
+    return 1;
+}
+
+/**
+ * Yardımcı Fonksiyon: Eşlenmiş baytlardan "HH:MM" zamanını okur
+ * sscanf kullanmaz; saat ve dakika birer veya ikişer haneli olabilir
  * 
- * @param filename: Randevular CSV dosyasının yolu
- * @param appointments: Yüklenen randevuları saklamak için dizi (önceden ayrılmış olmalı)
- * @param max_count: Yüklenecek maksimum randevu sayısı
- * @return: Başarıyla yüklenen randevu sayısı
+ * @param start: Alanın ilk baytı
+ * @param end: Alanın bittiği bayt (dahil değil)
+ * @return: Gece yarısından itibaren dakika, hata durumunda -1
  */
-int load_appointments_from_csv(const char* filename, Appointment** appointments, int max_count) {
-    if (filename == NULL || appointments == NULL || max_count <= 0) {
-        return 0;
+static int parse_time_span(const char* start, const char* end) {
+    trim_span(&start, &end);
+    int hour = 0;
+    int minute = 0;
+    int digits = 0;
+
+    while (start < end && *start >= '0' && *start <= '9' && digits < 2) {
+        hour = hour * 10 + (*start++ - '0');
+        digits++;
+    }
+    if (digits == 0 || start == end || *start++ != ':') {
+        return -1; // Parse hatası
     }
 
-    FILE* file = fopen(filename, "r");
-    if (file == NULL) {
-        // Dosya yoksa veya açılamazsa, boş dizi döndür (hata değil)
+    digits = 0;
+    while (start < end && *start >= '0' && *start <= '9' && digits < 2) {
+        minute = minute * 10 + (*start++ - '0');
+        digits++;
+    }
+    if (digits == 0 || start != end) {
+        return -1; // Parse hatası
+    }
+
+    // Geçerlilik kontrolü
+    if (hour > 23 || minute > 59) {
+        return -1; // Geçersiz saat veya dakika
+    }
+
+    return hour * 60 + minute;
+}
+
+/**
+ * Yardımcı Fonksiyon: Bir randevu satırını yerinde parse edip doğrular
+ * Alanlar satır baytları üzerinde işaretçi çiftleri olarak kalır; hiçbir
+ * alan kopyalanmaz
+ * 
+ * @param start: Satırın ilk baytı
+ * @param end: Satırın bittiği bayt (dahil değil)
+ * @param appointment: Randevunun yazılacağı yapı
+ * @return: 1 geçerli satır, 0 geçersiz satır
+ */
+static int parse_appointment_row(const char* start, const char* end, Appointment* appointment) {
+    // Virgüllere göre 5 alanı ayır (fazlası yok sayılır)
+    const char* field_start[5];
+    const char* field_end[5];
+    int field_count = 0;
+    const char* field = start;
+    while (field_count < 5) {
+        const char* comma = (const char*)memchr(field, ',', (size_t)(end - field));
+        field_start[field_count] = field;
+        field_end[field_count] = (comma != NULL) ? comma : end;
+        field_count++;
+        if (comma == NULL) {
+            break;
+        }
+        field = comma + 1;
+    }
+
+    int appointment_id, patient_id, doctor_id;
+    if (field_count < 5 ||
+        !parse_int_span(field_start[0], field_end[0], &appointment_id) ||
+        !parse_int_span(field_start[1], field_end[1], &patient_id) ||
+        !parse_int_span(field_start[2], field_end[2], &doctor_id)) {
         return 0;
     }
+    int start_time = parse_time_span(field_start[3], field_end[3]);
+    int end_time = parse_time_span(field_start[4], field_end[4]);
 
-    char line[500];
-    int count = 0;
-    int is_first_line = 1;
-    char fields[5][200];
+    // Geçerlilik kontrolü
+    if (appointment_id <= 0 || patient_id <= 0 || doctor_id <= 0) {
+        return 0; // Geçersiz ID'ler
+    }
+
+    if (start_time < 0 || end_time < 0 || start_time >= end_time) {
+        return 0; // Geçersiz zaman aralığı
+    }
+
+    if (start_time > 1439 || end_time > 1439) {
+        return 0; // Zaman aralığı dışında
+    }
+
+    appointment->appointment_id = appointment_id;
+    appointment->patient_id = patient_id;
+    appointment->doctor_id = doctor_id;
+    appointment->start_time = start_time;
+    appointment->end_time = end_time;
+    return 1;
+}
+
+/**
+ * Yardımcı Fonksiyon: Randevunun kopyasını oluşturup vektöre ekler
+ * @return: 1 eklendi, 0 bellek hatası
+ */
+static int append_appointment(AppointmentVector* appointments, const Appointment* appointment) {
+    Appointment* copy = (Appointment*)malloc(sizeof(Appointment));
+    if (copy == NULL) {
+        return 0; // Bellek hatası
+    }
+    *copy = *appointment;
+
+    if (!appointment_vector_push(appointments, copy)) {
+        free(copy);
+        return 0; // Bellek hatası
+    }
+    return 1;
+}
+
+/**
+ * Randevu yükleme ayarları ve son yüklemenin sonucu
+ */
+static int appointment_parse_threads = 0; // 0 = işlemci başına bir iş parçacığı
+static CsvLoadReport last_appointment_load;
+
+/**
+ * Eşlenmiş dosyanın bir iş parçacığına düşen parçası
+ * Parçalar satır başlarında ayrılır; her biri kendi vektörüne parse edilir
+ */
+typedef struct {
+    const char* start;         // Parçanın ilk baytı (satır başı)
+    const char* end;           // Parçanın bittiği bayt (dahil değil)
+    int first_chunk;           // 1 ise dosyanın ilk satırı (header olabilir) bu parçada
+    AppointmentVector* out;    // Randevuların ekleneceği vektör
+    AppointmentVector records; // Parçaya ait yerel vektör (ilk parça hariç)
+    int loaded;                // Eklenen randevu sayısı
+    int lines;                 // Parçadaki satır sayısı
+    int skipped;               // Atlanan geçersiz satır sayısı
+    int first_skipped;         // Parça içinde ilk atlanan satır (1'den başlar, 0 = yok)
+    Thread thread;             // Parçayı parse eden iş parçacığı
+    int started;               // 1 ise thread başlatıldı (join gerekir)
+} AppointmentChunk;
+
+/**
+ * Yardımcı Fonksiyon: Bir parçadaki randevu satırlarını yerinde parse eder
+ * Satırlar memchr ile bulunur, alanlar eşlenmiş baytlar üzerinde işaretçi
+ * çiftleri olarak kalır; hiçbir satır veya alan kopyalanmaz
+ * 
+ * @param chunk: Parse edilecek parça (sonuçlar parçaya yazılır)
+ */
+static void parse_appointment_chunk(AppointmentChunk* chunk) {
+    // Parça boyutundan kayıt sayısını tahmin edip bir kez yer ayır
+    size_t estimate = (size_t)(chunk->end - chunk->start) / APPOINTMENT_CSV_LINE_HINT + 1;
+    appointment_vector_reserve(chunk->out, chunk->out->count +
+                               (estimate > INT_MAX / 2 ? INT_MAX / 2 : (int)estimate));
+
+    const char* p = chunk->start;
+    const char* end = chunk->end;
+    int is_first_line = chunk->first_chunk;
+
+    while (p < end) {
+        const char* newline = (const char*)memchr(p, '\n', (size_t)(end - p));
+        const char* line_end = (newline != NULL) ? newline : end;
+        const char* next = (newline != NULL) ? newline + 1 : end;
+        if (line_end > p && line_end[-1] == '\r') {
+            line_end--;
+        }
+        chunk->lines++;
 
-    // Dosyayı satır satır oku
-    while (fgets(line, sizeof(line), file) != NULL && count < max_count) {
         // İlk satırı atla (header olabilir)
         if (is_first_line) {
-            if (strstr(line, "appointment_id") != NULL || strstr(line, "id") != NULL) {
-                is_first_line = 0;
+            is_first_line = 0;
+            if (span_contains(p, line_end, "id")) {
+                p = next;
                 continue; // Header satırını atla
             }
-            is_first_line = 0;
         }
 
-        // CSV satırını parse et
-        int field_count = parse_csv_line(line, fields, 5);
-        if (field_count < 5) {
-            continue; // Geçersiz satır, atla
+        // Boş satırlar sessizce atlanır
+        if (line_end == p) {
+            p = next;
+            continue;
         }
 
-        // Alanları dönüştür
-        int appointment_id = atoi(fields[0]);
-        int patient_id = atoi(fields[1]);
-        int doctor_id = atoi(fields[2]);
-        int start_time = parse_time_string(fields[3]);
-        int end_time = parse_time_string(fields[4]);
+        Appointment appointment;
+        if (parse_appointment_row(p, line_end, &appointment) &&
+            append_appointment(chunk->out, &appointment)) {
+            chunk->loaded++;
+        } else {
+            // Geçersiz satır, atla (ilkinin yerini hatırla)
+            if (chunk->skipped == 0) {
+                chunk->first_skipped = chunk->lines;
+            }
+            chunk->skipped++;
+        }
+
+        p = next;
+    }
+}
+
+/**
+ * Yardımcı Fonksiyon: İş parçacığı giriş noktası
+ */
+static void appointment_chunk_worker(void* arg) {
+    parse_appointment_chunk((AppointmentChunk*)arg);
+}
+
+/**
+ * Yardımcı Fonksiyon: Bellek eşlemeli randevu CSV'sini paralel parse eder
+ * Dosya satır başlarında parçalara bölünür; ilk parça çağıran iş
+ * parçacığında doğrudan hedef vektöre, diğerleri kendi vektörlerine parse
+ * edilir ve sonra dosya sırasıyla hedefe eklenir. Böylece randevu sırası
+ * ve atlanan satır numaraları tek iş parçacıklı okumayla aynı kalır.
+ * 
+ * @param data: Dosyanın ilk baytı
+ * @param size: Dosya boyutu
+ * @param appointments: Yüklenen randevuların ekleneceği vektör
+ * @param report: Yükleme sonucu
+ */
+static void load_appointments_from_buffer(const char* data, size_t size,
+                                          AppointmentVector* appointments,
+                                          CsvLoadReport* report) {
+    // Parça sayısı: iş parçacığı sayısı, dosya boyutu ve üst sınırla kısıtlı
+    size_t max_chunks = size / APPOINTMENT_PARSE_CHUNK_MIN;
+    int chunk_count = (appointment_parse_threads > 0) ? appointment_parse_threads
+                                                      : thread_cpu_count();
+    if (chunk_count > APPOINTMENT_PARSE_MAX_THREADS) {
+        chunk_count = APPOINTMENT_PARSE_MAX_THREADS;
+    }
+    if ((size_t)chunk_count > max_chunks) {
+        chunk_count = (max_chunks > 0) ? (int)max_chunks : 1;
+    }
 
-        // Geçerlilik kontrolü
-        if (appointment_id <= 0 || patient_id <= 0 || doctor_id <= 0) {
-            continue; // Geçersiz ID'ler
+    AppointmentChunk chunks[APPOINTMENT_PARSE_MAX_THREADS];
+    const char* end = data + size;
+    const char* boundary = data;
+    for (int i = 0; i < chunk_count; i++) {
+        AppointmentChunk* chunk = &chunks[i];
+        memset(chunk, 0, sizeof(*chunk));
+        chunk->start = boundary;
+        chunk->first_chunk = (i == 0);
+
+        // Bölme noktasını bir sonraki satır başına kaydır
+        if (i == chunk_count - 1) {
+            boundary = end;
+        } else {
+            const char* split = data + size / (size_t)chunk_count * (size_t)(i + 1);
+            if (split < boundary) {
+                split = boundary;
+            }
+            const char* newline = (const char*)memchr(split - 1, '\n', (size_t)(end - split) + 1);
+            boundary = (newline != NULL) ? newline + 1 : end;
         }
+        chunk->end = boundary;
 
-        if (start_time < 0 || end_time < 0 || start_time >= end_time) {
-            continue; // Geçersiz zaman aralığı
+        if (i == 0) {
+            chunk->out = appointments;
+        } else {
+            appointment_vector_init(&chunk->records);
+            chunk->out = &chunk->records;
         }
+    }
 
-        if (start_time < 0 || start_time > 1439 || end_time < 0 || end_time > 1439) {
-            continue; // Zaman aralığı dışında
+    // Diğer parçaları iş parçacıklarında başlat, ilkini burada parse et
+    for (int i = 1; i < chunk_count; i++) {
+        chunks[i].started = thread_start(&chunks[i].thread, appointment_chunk_worker, &chunks[i]);
+    }
+    parse_appointment_chunk(&chunks[0]);
+    int threads = 1;
+    for (int i = 1; i < chunk_count; i++) {
+        if (chunks[i].started) {
+            thread_join(&chunks[i].thread);
+            threads++;
+        } else {
+            parse_appointment_chunk(&chunks[i]); // Thread başlatılamadı, burada parse et
         }
+    }
 
-        // Randevu oluştur
-        Appointment* appointment = (Appointment*)malloc(sizeof(Appointment));
-        if (appointment == NULL) {
-            continue; // Bellek hatası, atla
+    // Parçaları dosya sırasıyla birleştir
+    int extra = 0;
+    for (int i = 1; i < chunk_count; i++) {
+        extra += chunks[i].records.count;
+    }
+    int merged = appointment_vector_reserve(appointments, appointments->count + extra);
+
+    memset(report, 0, sizeof(*report));
+    report->threads = threads;
+    long long line_base = 0;
+    for (int i = 0; i < chunk_count; i++) {
+        AppointmentChunk* chunk = &chunks[i];
+        if (i > 0) {
+            if (merged) {
+                memcpy(appointments->items + appointments->count, chunk->records.items,
+                       (size_t)chunk->records.count * sizeof(Appointment*));
+                appointments->count += chunk->records.count;
+            } else {
+                // Bellek hatası: bu parçanın randevuları eklenemez
+                for (int j = 0; j < chunk->records.count; j++) {
+                    free(chunk->records.items[j]);
+                }
+                chunk->loaded = 0;
+            }
+            appointment_vector_destroy(&chunk->records);
         }
 
-        appointment->appointment_id = appointment_id;
-        appointment->patient_id = patient_id;
-        appointment->doctor_id = doctor_id;
-        appointment->start_time = start_time;
-        appointment->end_time = end_time;
+        report->loaded += chunk->loaded;
+        if (chunk->skipped > 0 && report->skipped == 0) {
+            report->first_skipped = line_base + chunk->first_skipped;
+        }
+        report->skipped += chunk->skipped;
+        line_base += chunk->lines;
+    }
+}
 
-        appointments[count] = appointment;
-        count++;
+/**
+ * Yardımcı Fonksiyon: Randevu satırı işleyicisi
+ */
+static int visit_appointment_row(const char* start, const char* end, const CsvVisitorSet* visitors) {
+    Appointment appointment;
+    if (!parse_appointment_row(start, end, &appointment)) {
+        return -1;
     }
+    return visitors->appointment(&appointment, visitors->context) ? 1 : 0;
+}
 
-    fclose(file);
-    return count;
+/**
+ * CSV dosyasındaki her randevuyu ziyaretçiye verir
+ * Dosya sırayla, çağıran iş parçacığında okunur
+ * 
+ * CSV Formatı: appointment_id,patient_id,doctor_id,start_time,end_time
+ * İlk satır header olabilir (otomatik atlanır)
+ * 
+ * @param filename: Randevular CSV dosyasının yolu
+ * @param visitor: Her geçerli randevu için çağrılır (0 döndürürse okuma durur)
+ * @param context: Ziyaretçiye verilen bağlam
+ * @param report: Sonucun yazılacağı yapı (NULL olabilir)
+ * @return: 1 başarılı, 0 dosya açılamadı veya okunamadı
+ */
+int visit_appointments_csv(const char* filename, AppointmentVisitor visitor, void* context,
+                           CsvVisitReport* report) {
+    if (visitor == NULL) {
+        return 0;
+    }
+    CsvVisitorSet visitors = { NULL, NULL, visitor, context };
+    return csv_visit(filename, visit_appointment_row, &visitors, report);
+}
+
+/**
+ * Yardımcı Fonksiyon: Ziyaret edilen randevuyu vektöre ekler
+ */
+static int append_visited_appointment(const Appointment* appointment, void* context) {
+    append_appointment((AppointmentVector*)context, appointment); // Bellek hatası: atla
+    return 1;
+}
+
+/**
+ * CSV dosyasından randevuları yükler
+ * 
+ * CSV Formatı: appointment_id,patient_id,doctor_id,start_time,end_time
+ * Zaman formatı: HH:MM (örn: "09:30")
+ * İlk satır header olabilir (otomatik atlanır)
+ * Dosya bellek eşlenerek kopyasız ve (büyükse) paralel parse edilir;
+ * eşleme başarısız olursa akışlı okuyucuyla okunur
+ * 
+ * @param filename: Randevular CSV dosyasının yolu
+ * @param appointments: Yüklenen randevuların ekleneceği vektör (gerektikçe büyür)
+ * @return: Başarıyla yüklenen randevu sayısı
+ */
+int load_appointments_from_csv(const char* filename, AppointmentVector* appointments) {
+    memset(&last_appointment_load, 0, sizeof(last_appointment_load));
+    if (filename == NULL || appointments == NULL) {
+        return 0;
+    }
+
+    MappedFile map;
+    if (mapfile_open(&map, filename)) {
+        load_appointments_from_buffer(map.data, map.size, appointments, &last_appointment_load);
+        mapfile_close(&map);
+        return last_appointment_load.loaded;
+    }
+
+    // Eşlenemeyen dosya (ör. normal dosya değil) akışlı okuyucuyla okunur
+    appointment_vector_reserve(appointments, appointments->count +
+                               estimate_record_count(filename, APPOINTMENT_CSV_LINE_HINT));
+    CsvVisitReport visit;
+    int before = appointments->count;
+    visit_appointments_csv(filename, append_visited_appointment, appointments, &visit);
+
+    // Dosya yoksa veya açılamazsa hiçbir şey eklenmez (hata değil)
+    last_appointment_load.loaded = appointments->count - before;
+    last_appointment_load.skipped = (int)visit.skipped;
+    last_appointment_load.first_skipped = visit.first_skipped;
+    last_appointment_load.threads = 1;
+    return last_appointment_load.loaded;
+}
+
+/**
+ * Randevu dosyalarını parse eden iş parçacığı sayısını ayarlar
+ * 
+ * @param threads: İş parçacığı sayısı, 0 = işlemci başına bir tane
+ */
+void set_appointment_parse_threads(int threads) {
+    appointment_parse_threads = (threads > 0) ? threads : 0;
+}
+
+/**
+ * Son randevu yüklemesinin sonucunu döndürür
+ * 
+ * @param report: Sonucun yazılacağı yapı
+ */
+void get_appointment_load_report(CsvLoadReport* report) {
+    if (report != NULL) {
+        *report = last_appointment_load;
+    }
 }
 
 /**
@@ -454,56 +1327,42 @@ int save_appointments_to_csv(const char* filename, Appointment** appointments, i
         return 0;
     }
 
-    FILE* file = fopen(filename, "w");
-    if (file == NULL) {
+    CsvWriter writer;
+    if (!csv_writer_open(&writer, filename)) {
         return 0; // Dosya açılamadı
     }
 
     // Header satırını yaz
-    fprintf(file, "appointment_id,patient_id,doctor_id,start_time,end_time\n");
-
-    // Randevuları yaz
-    int saved = 0;
-    char start_time_str[10];
-    char end_time_str[10];
+    csv_writer_put_string(&writer, "appointment_id,patient_id,doctor_id,start_time,end_time", 64, '\n');
 
+    // Randevuları yaz (zamanlar "HH:MM" tablosundan)
     for (int i = 0; i < count; i++) {
         if (appointments[i] != NULL) {
-            // Zamanları string formatına çevir
-            format_time_string(appointments[i]->start_time, start_time_str);
-            format_time_string(appointments[i]->end_time, end_time_str);
-
-            fprintf(file, "%d,%d,%d,%s,%s\n", 
-                   appointments[i]->appointment_id,
-                   appointments[i]->patient_id,
-                   appointments[i]->doctor_id,
-                   start_time_str,
-                   end_time_str);
-            saved++;
+            csv_writer_put_int(&writer, appointments[i]->appointment_id, ',');
+            csv_writer_put_int(&writer, appointments[i]->patient_id, ',');
+            csv_writer_put_int(&writer, appointments[i]->doctor_id, ',');
+            csv_writer_put_time(&writer, appointments[i]->start_time, ',');
+            csv_writer_put_time(&writer, appointments[i]->end_time, '\n');
+            csv_writer_end_row(&writer);
         }
     }
 
-    fclose(file);
-    return saved;
+    // Yazma hatasında hiçbir kayıt kaydedilmiş sayılmaz
+    return csv_writer_close(&writer) ? writer.rows : 0;
 }
 
 /**
  * Automatic ID Generation Implementation
- * Static counters for sequential ID generation
+ * Thin wrappers over the thread-safe allocator (idalloc.c), which keeps
+ * one atomic counter per table and persists a high-water mark
  */
 
-// Static ID counters (initialized to 0, will be updated when loading CSV)
-static int next_patient_id = 0;
-static int next_doctor_id = 0;
-static int next_appointment_id = 0;
-
 /**
  * Gets the next available patient ID and increments the counter
  * @return: Next patient ID (starts from 1)
  */
 int get_next_patient_id(void) {
-    next_patient_id++;
-    return next_patient_id;
+    return idalloc_next(IDALLOC_PATIENT);
 }
 
 /**
@@ -511,8 +1370,7 @@ int get_next_patient_id(void) {
  * @return: Next doctor ID (starts from 1)
  */
 int get_next_doctor_id(void) {
-    next_doctor_id++;
-    return next_doctor_id;
+    return idalloc_next(IDALLOC_DOCTOR);
 }
 
 /**
@@ -520,13 +1378,12 @@ int get_next_doctor_id(void) {
  * @return: Next appointment ID (starts from 1)
  */
 int get_next_appointment_id(void) {
-    next_appointment_id++;
-    return next_appointment_id;
+    return idalloc_next(IDALLOC_APPOINTMENT);
 }
 
 /**
  * Updates patient ID counter based on existing patients
- * Finds the maximum ID and sets counter to max + 1
+ * Finds the maximum ID and raises the counter to it (never lowers it)
  * @param patients: Array of patient pointers
  * @param count: Number of patients
  */
@@ -537,12 +1394,12 @@ void update_patient_id_counter(Patient** patients, int count) {
             max_id = patients[i]->id;
         }
     }
-    next_patient_id = max_id; // Next ID will be max_id + 1
+    idalloc_raise(IDALLOC_PATIENT, max_id); // Next ID will be max_id + 1
 }
 
 /**
  * Updates doctor ID counter based on existing doctors
- * Finds the maximum ID and sets counter to max + 1
+ * Finds the maximum ID and raises the counter to it (never lowers it)
  * @param doctors: Array of doctor pointers
  * @param count: Number of doctors
  */
@@ -553,12 +1410,12 @@ void update_doctor_id_counter(Doctor** doctors, int count) {
             max_id = doctors[i]->id;
         }
     }
-    next_doctor_id = max_id; // Next ID will be max_id + 1
+    idalloc_raise(IDALLOC_DOCTOR, max_id); // Next ID will be max_id + 1
 }
 
 /**
  * Updates appointment ID counter based on existing appointments
- * Finds the maximum ID and sets counter to max + 1
+ * Finds the maximum ID and raises the counter to it (never lowers it)
  * @param appointments: Array of appointment pointers
  * @param count: Number of appointments
  */
@@ -569,6 +1426,35 @@ void update_appointment_id_counter(Appointment** appointments, int count) {
             max_id = appointments[i]->appointment_id;
         }
     }
-    next_appointment_id = max_id; // Next ID will be max_id + 1
+    idalloc_raise(IDALLOC_APPOINTMENT, max_id); // Next ID will be max_id + 1
+}
+
+/**
+ * Raises the appointment ID counter to at least the given ID
+ * Used for appointments that are not in the CSV (waiting list, undo stack)
+ * and for IDs entered by the user
+ * @param appointment_id: Appointment ID already in use
+ */
+void reserve_appointment_id(int appointment_id) {
+    idalloc_raise(IDALLOC_APPOINTMENT, appointment_id); // Next ID will be appointment_id + 1
+}
+
+/**
+ * Raises the patient ID counter to at least the given ID
+ * Used for patients that stay in the snapshot (lazy loading) and for IDs
+ * entered by the user
+ * @param id: Patient ID already in use
+ */
+void reserve_patient_id(int id) {
+    idalloc_raise(IDALLOC_PATIENT, id); // Next ID will be id + 1
 }
 
+/**
+ * Raises the doctor ID counter to at least the given ID
+ * Used for doctors that stay in the snapshot (lazy loading) and for IDs
+ * entered by the user
+ * @param id: Doctor ID already in use
+ */
+void reserve_doctor_id(int id) {
+    idalloc_raise(IDALLOC_DOCTOR, id); // Next ID will be id + 1
+}
@@ -4,9 +4,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdatomic.h>
 #include "patient.h"
 #include "doctor.h"
 #include "appointment.h"
+#include "vector.h"
 
 /**
  * File I/O Operations
@@ -14,29 +16,39 @@
  */
 
 /**
- * Maximum number of records that can be loaded from CSV
+ * Average CSV line lengths, used to reserve vector space from the file size
  */
-#define MAX_RECORDS 1000
+#define PATIENT_CSV_LINE_HINT 20
+#define DOCTOR_CSV_LINE_HINT 28
+#define APPOINTMENT_CSV_LINE_HINT 20
+
+/**
+ * Default CSV snapshot paths
+ */
+#define PATIENTS_CSV_PATH "data/patients.csv"
+#define DOCTORS_CSV_PATH "data/doctors.csv"
+#define APPOINTMENTS_CSV_PATH "data/appointments.csv"
 
 /**
  * Patient File Operations
  */
 
 /**
- * Loads patients from CSV file
+ * Loads patients from CSV file (visit_patients_csv into the vector)
+ * Space is reserved once from the file size, the vector grows if needed
  * @param filename: Path to patients CSV file
- * @param patients: Array to store loaded patients (must be pre-allocated)
- * @param max_count: Maximum number of patients to load
+ * @param patients: Vector the loaded patients are appended to
  * @return: Number of patients successfully loaded
  */
-int load_patients_from_csv(const char* filename, Patient** patients, int max_count);
+int load_patients_from_csv(const char* filename, PatientVector* patients);
 
 /**
  * Saves patients to CSV file
+ * Written atomically: "<filename>.tmp" is fsynced, then renamed over filename
  * @param filename: Path to patients CSV file
  * @param patients: Array of patient pointers
  * @param count: Number of patients to save
- * @return: Number of patients successfully saved
+ * @return: Number of patients successfully saved (0 on a write error)
  */
 int save_patients_to_csv(const char* filename, Patient** patients, int count);
 
@@ -45,20 +57,21 @@ int save_patients_to_csv(const char* filename, Patient** patients, int count);
  */
 
 /**
- * Loads doctors from CSV file
+ * Loads doctors from CSV file (visit_doctors_csv into the vector)
+ * Space is reserved once from the file size, the vector grows if needed
  * @param filename: Path to doctors CSV file
- * @param doctors: Array to store loaded doctors (must be pre-allocated)
- * @param max_count: Maximum number of doctors to load
+ * @param doctors: Vector the loaded doctors are appended to
  * @return: Number of doctors successfully loaded
  */
-int load_doctors_from_csv(const char* filename, Doctor** doctors, int max_count);
+int load_doctors_from_csv(const char* filename, DoctorVector* doctors);
 
 /**
  * Saves doctors to CSV file
+ * Written atomically: "<filename>.tmp" is fsynced, then renamed over filename
  * @param filename: Path to doctors CSV file
  * @param doctors: Array of doctor pointers
  * @param count: Number of doctors to save
- * @return: Number of doctors successfully saved
+ * @return: Number of doctors successfully saved (0 on a write error)
  */
 int save_doctors_to_csv(const char* filename, Doctor** doctors, int count);
 
@@ -66,24 +79,131 @@ int save_doctors_to_csv(const char* filename, Doctor** doctors, int count);
  * Appointment File Operations
  */
 
+/**
+ * Parallel appointment parsing: the mapped file is split at line
+ * boundaries into chunks of at least APPOINTMENT_PARSE_CHUNK_MIN bytes,
+ * one per thread (up to APPOINTMENT_PARSE_MAX_THREADS)
+ */
+#define APPOINTMENT_PARSE_CHUNK_MIN (4 * 1024 * 1024)
+#define APPOINTMENT_PARSE_MAX_THREADS 16
+
+/**
+ * Result of the last appointment CSV load
+ */
+typedef struct {
+    int loaded;               // Appointments appended
+    int skipped;              // Invalid rows skipped
+    long long first_skipped;  // 1-based file line of the first skipped row (0 if none)
+    int threads;              // Threads that parsed the file
+} CsvLoadReport;
+
 /**
  * Loads appointments from CSV file
+ * Space is reserved once from the file size, the vector grows if needed
+ * Large files are parsed by several threads; records keep file order
  * @param filename: Path to appointments CSV file
- * @param appointments: Array to store loaded appointments (must be pre-allocated)
- * @param max_count: Maximum number of appointments to load
+ * @param appointments: Vector the loaded appointments are appended to
  * @return: Number of appointments successfully loaded
  */
-int load_appointments_from_csv(const char* filename, Appointment** appointments, int max_count);
+int load_appointments_from_csv(const char* filename, AppointmentVector* appointments);
+
+/**
+ * Sets the number of threads used to parse appointment files
+ * @param threads: Thread count, 0 = one per processor (default)
+ */
+void set_appointment_parse_threads(int threads);
+
+/**
+ * Returns the result of the last load_appointments_from_csv call
+ * @param report: Receives the result
+ */
+void get_appointment_load_report(CsvLoadReport* report);
 
 /**
  * Saves appointments to CSV file
+ * Written atomically: "<filename>.tmp" is fsynced, then renamed over filename
  * @param filename: Path to appointments CSV file
  * @param appointments: Array of appointment pointers
  * @param count: Number of appointments to save
- * @return: Number of appointments successfully saved
+ * @return: Number of appointments successfully saved (0 on a write error)
  */
 int save_appointments_to_csv(const char* filename, Appointment** appointments, int count);
 
+/**
+ * Sets a counter the save functions add their written rows to, in steps of
+ * one output buffer, so another thread can show progress
+ * Set it before the saving thread starts and clear it after it has stopped
+ * @param rows: Counter to add to (NULL = no progress reporting)
+ */
+void set_csv_save_progress(atomic_llong* rows);
+
+/**
+ * Streaming Record Visitors
+ *
+ * Read a CSV file through a fixed CSV_VISIT_BUFFER-byte buffer and hand
+ * each valid record to a callback, in file order, on the calling thread.
+ * Nothing is allocated per record, so memory use does not depend on the
+ * file size: records can go straight into an index, a filter or an
+ * exporter, and files larger than RAM can be scanned.
+ *
+ * Rows are validated like the load_* functions; invalid rows are counted
+ * and skipped. The record pointer is only valid during the callback.
+ * The callback returns 1 to continue, 0 to stop the scan.
+ */
+#define CSV_VISIT_BUFFER (1024 * 1024)
+
+typedef int (*PatientVisitor)(const Patient* patient, void* context);
+typedef int (*DoctorVisitor)(const Doctor* doctor, void* context);
+typedef int (*AppointmentVisitor)(const Appointment* appointment, void* context);
+
+/**
+ * Result of a visit_*_csv scan
+ */
+typedef struct {
+    long long visited;        // Records handed to the visitor
+    long long skipped;        // Invalid rows skipped
+    long long first_skipped;  // 1-based file line of the first skipped row (0 if none)
+    int stopped;              // 1 if the visitor stopped the scan
+} CsvVisitReport;
+
+/**
+ * Visits every patient in a CSV file
+ * @param filename: Path to patients CSV file
+ * @param visitor: Called once per valid patient
+ * @param context: Passed to the visitor
+ * @param report: Receives the result (may be NULL)
+ * @return: 1 if the file was read to the end or the visitor stopped,
+ *          0 if it could not be opened or read
+ */
+int visit_patients_csv(const char* filename, PatientVisitor visitor, void* context,
+                       CsvVisitReport* report);
+
+/**
+ * Visits every doctor in a CSV file
+ * @param filename: Path to doctors CSV file
+ * @param visitor: Called once per valid doctor
+ * @param context: Passed to the visitor
+ * @param report: Receives the result (may be NULL)
+ * @return: 1 if the file was read to the end or the visitor stopped,
+ *          0 if it could not be opened or read
+ */
+int visit_doctors_csv(const char* filename, DoctorVisitor visitor, void* context,
+                      CsvVisitReport* report);
+
+/**
+ * Visits every appointment in a CSV file
+ * Unlike load_appointments_from_csv the file is read sequentially, so the
+ * visitor never runs on more than one thread
+ * @param filename: Path to appointments CSV file
+ * @param visitor: Called once per valid appointment
+ * @param context: Passed to the visitor
+ * @param report: Receives the result (may be NULL)
+ * @return: 1 if the file was read to the end or the visitor stopped,
+ *          0 if it could not be opened or read
+ */
+int visit_appointments_csv(const char* filename, AppointmentVisitor visitor, void* context,
+                           CsvVisitReport* report);
+
 /**
  * Utility Functions
  */
@@ -149,5 +269,20 @@ void update_doctor_id_counter(Doctor** doctors, int count);
  */
 void update_appointment_id_counter(Appointment** appointments, int count);
 
+/**
+ * Raises the appointment ID counter so that an ID kept outside the
+ * appointment array (waiting list, undo stack) is never handed out again
+ * @param appointment_id: Appointment ID already in use
+ */
+void reserve_appointment_id(int appointment_id);
+
+/**
+ * Raises the patient / doctor ID counter so that an ID kept outside the
+ * arrays (lazily loaded snapshot records) is never handed out again
+ * @param id: Highest ID already in use
+ */
+void reserve_patient_id(int id);
+void reserve_doctor_id(int id);
+
 #endif // FILE_IO_H
 
@@ -16,6 +16,9 @@
 #include "doctor.h"
 #include "appointment.h"
 #include "file_io.h"
+#include "statelog.h"
+#include "journal.h"
+#include "checkpoint.h"
 
 /**
  * Static application data
@@ -23,6 +26,11 @@
  */
 static AppData* app_data = NULL;
 
+/**
+ * Save status line at the bottom of the main window (checkpoint progress)
+ */
+static GtkWidget* save_status_label = NULL;
+
 /**
  * Callback function for window close event
  * 
@@ -39,6 +47,44 @@ static gboolean on_window_close(GtkWidget *widget, gpointer data) {
     return FALSE;
 }
 
+/**
+ * Periodic timer: starts a background checkpoint once enough changes were logged
+ * and shows the progress of the running one (or the last one) in the status line
+ * Runs on the GTK main loop, i.e. between operations on the GUI thread
+ * 
+ * @param data: User data (unused)
+ * @return: TRUE to keep the timer
+ */
+static gboolean on_checkpoint_tick(gpointer data) {
+    (void)data;
+    scheduler_lock(app_data != NULL ? app_data->scheduler : NULL);
+    checkpoint_maybe();
+    scheduler_unlock(app_data != NULL ? app_data->scheduler : NULL);
+
+    if (save_status_label == NULL) {
+        return TRUE;
+    }
+    char status[128] = "";
+    CheckpointProgress progress;
+    checkpoint_progress(&progress);
+    if (progress.active && progress.records_total > 0) {
+        snprintf(status, sizeof(status), "Kaydediliyor: %%%lld (%lld/%lld kayit, %lld ms)",
+                 progress.records_done * 100 / progress.records_total,
+                 progress.records_done, progress.records_total, progress.elapsed_us / 1000);
+    } else {
+        CheckpointStats stats;
+        checkpoint_stats(&stats);
+        if (stats.failures > 0) {
+            snprintf(status, sizeof(status), "Uyari: %d kayit yazilamadi", stats.failures);
+        } else if (stats.checkpoints > 0) {
+            snprintf(status, sizeof(status), "Son kayit: %lld kayit, %lld ms",
+                     stats.last_records, stats.last_write_us / 1000);
+        }
+    }
+    gtk_label_set_text(GTK_LABEL(save_status_label), status);
+    return TRUE;
+}
+
 /**
  * Button callback functions
  * These functions call existing core logic functions.
@@ -67,7 +113,7 @@ static void on_add_patient_cancel(GtkWidget *widget, gpointer data) {
 static void on_add_patient_save(GtkWidget *widget, gpointer data) {
     (void)widget;
     
-    if (app_data == NULL || app_data->patients == NULL || app_data->patient_count == NULL) {
+    if (app_data == NULL || app_data->patients == NULL) {
         GtkWidget *error_dialog = gtk_message_dialog_new(
             NULL,
             GTK_DIALOG_MODAL,
@@ -128,39 +174,42 @@ static void on_add_patient_save(GtkWidget *widget, gpointer data) {
     
     // ID is auto-generated, so no need to check for duplicates
     
-    // Check maximum capacity
-    if (*(app_data->patient_count) >= MAX_RECORDS) {
+    // Create patient using existing core function
+    Patient* patient = create_patient(id, name_str, age);
+    if (patient == NULL) {
         GtkWidget *error_dialog = gtk_message_dialog_new(
             GTK_WINDOW(dialog),
             GTK_DIALOG_MODAL,
             GTK_MESSAGE_ERROR,
             GTK_BUTTONS_OK,
-            "Hata: Maksimum hasta kapasitesine ulasildi."
+            "Hata: Hasta olusturulamadi."
         );
         gtk_dialog_run(GTK_DIALOG(error_dialog));
         gtk_widget_destroy(error_dialog);
         return;
     }
     
-    // Create patient using existing core function
-    Patient* patient = create_patient(id, name_str, age);
-    if (patient == NULL) {
+    // Add patient to vector (grows as needed); structures only under the scheduler lock
+    scheduler_lock(app_data->scheduler);
+    int added = patient_vector_push(app_data->patients, patient);
+    if (added) {
+        journal_record_add_patient(app_data->journal, patient);
+    }
+    scheduler_unlock(app_data->scheduler);
+    if (!added) {
+        free_patient(patient);
         GtkWidget *error_dialog = gtk_message_dialog_new(
             GTK_WINDOW(dialog),
             GTK_DIALOG_MODAL,
             GTK_MESSAGE_ERROR,
             GTK_BUTTONS_OK,
-            "Hata: Hasta olusturulamadi."
+            "Hata: Hasta icin bellek ayrilamadi."
         );
         gtk_dialog_run(GTK_DIALOG(error_dialog));
         gtk_widget_destroy(error_dialog);
         return;
     }
     
-    // Add patient to array
-    app_data->patients[*(app_data->patient_count)] = patient;
-    (*(app_data->patient_count))++;
-    
     // Show success message
     GtkWidget *success_dialog = gtk_message_dialog_new(
         GTK_WINDOW(dialog),
@@ -305,7 +354,7 @@ static void on_add_doctor_cancel(GtkWidget *widget, gpointer data) {
 static void on_add_doctor_save(GtkWidget *widget, gpointer data) {
     (void)widget;
     
-    if (app_data == NULL || app_data->doctors == NULL || app_data->doctor_count == NULL) {
+    if (app_data == NULL || app_data->doctors == NULL) {
         GtkWidget *error_dialog = gtk_message_dialog_new(
             NULL,
             GTK_DIALOG_MODAL,
@@ -350,39 +399,42 @@ static void on_add_doctor_save(GtkWidget *widget, gpointer data) {
     
     // ID is auto-generated, so no need to validate or check for duplicates
     
-    // Check maximum capacity
-    if (*(app_data->doctor_count) >= MAX_RECORDS) {
+    // Create doctor using existing core function
+    Doctor* doctor = create_doctor(id, name_str, department_str);
+    if (doctor == NULL) {
         GtkWidget *error_dialog = gtk_message_dialog_new(
             GTK_WINDOW(dialog),
             GTK_DIALOG_MODAL,
             GTK_MESSAGE_ERROR,
             GTK_BUTTONS_OK,
-            "Hata: Maksimum doktor kapasitesine ulasildi."
+            "Hata: Doktor olusturulamadi."
         );
         gtk_dialog_run(GTK_DIALOG(error_dialog));
         gtk_widget_destroy(error_dialog);
         return;
     }
     
-    // Create doctor using existing core function
-    Doctor* doctor = create_doctor(id, name_str, department_str);
-    if (doctor == NULL) {
+    // Add doctor to vector (grows as needed); structures only under the scheduler lock
+    scheduler_lock(app_data->scheduler);
+    int added = doctor_vector_push(app_data->doctors, doctor);
+    if (added) {
+        journal_record_add_doctor(app_data->journal, doctor);
+    }
+    scheduler_unlock(app_data->scheduler);
+    if (!added) {
+        free_doctor(doctor);
         GtkWidget *error_dialog = gtk_message_dialog_new(
             GTK_WINDOW(dialog),
             GTK_DIALOG_MODAL,
             GTK_MESSAGE_ERROR,
             GTK_BUTTONS_OK,
-            "Hata: Doktor olusturulamadi."
+            "Hata: Doktor icin bellek ayrilamadi."
         );
         gtk_dialog_run(GTK_DIALOG(error_dialog));
         gtk_widget_destroy(error_dialog);
         return;
     }
     
-    // Add doctor to array
-    app_data->doctors[*(app_data->doctor_count)] = doctor;
-    (*(app_data->doctor_count))++;
-    
     // Show success message
     GtkWidget *success_dialog = gtk_message_dialog_new(
         GTK_WINDOW(dialog),
@@ -523,12 +575,13 @@ static void on_create_appointment_cancel(GtkWidget *widget, gpointer data) {
 
 /**
  * Callback for "Save" button in Create Appointment dialog
+ * Validates the input, then hands the booking to the scheduler thread
  */
 static void on_create_appointment_save(GtkWidget *widget, gpointer data) {
     (void)widget;
     
-    if (app_data == NULL || app_data->appointments == NULL || app_data->appointment_count == NULL ||
-        app_data->avl_tree == NULL || app_data->heap == NULL || app_data->queue == NULL ||
+    if (app_data == NULL || app_data->appointments == NULL ||
+        app_data->avl_tree == NULL || app_data->heap == NULL || app_data->waitlist == NULL ||
         app_data->patients == NULL || app_data->doctors == NULL) {
         GtkWidget *error_dialog = gtk_message_dialog_new(
             NULL,
@@ -550,6 +603,7 @@ static void on_create_appointment_save(GtkWidget *widget, gpointer data) {
     GtkWidget *start_time_entry = entries[3];
     GtkWidget *end_time_entry = entries[4];
     GtkWidget *dialog = entries[5];
+    GtkWidget *triage_combo = entries[6];
     
     // Get values from entries
     const char *appointment_id_str = gtk_entry_get_text(GTK_ENTRY(appointment_id_entry));
@@ -596,15 +650,11 @@ static void on_create_appointment_save(GtkWidget *widget, gpointer data) {
     
     // Appointment ID is auto-generated, so no need to check for duplicates
     
-    // Check if patient exists
-    int patient_found = 0;
-    for (int i = 0; i < *(app_data->patient_count); i++) {
-        if (app_data->patients[i] != NULL && app_data->patients[i]->id == patient_id) {
-            patient_found = 1;
-            break;
-        }
-    }
-    
+    // Check if patient and doctor exist (read under the scheduler lock, dialogs without it)
+    scheduler_lock(app_data->scheduler);
+    int patient_found = registry_find_patient(app_data->registry, app_data->patients, patient_id) != NULL;
+    int doctor_found = registry_find_doctor(app_data->registry, app_data->doctors, doctor_id) != NULL;
+    scheduler_unlock(app_data->scheduler);
     if (!patient_found) {
         GtkWidget *error_dialog = gtk_message_dialog_new(
             GTK_WINDOW(dialog),
@@ -618,15 +668,6 @@ static void on_create_appointment_save(GtkWidget *widget, gpointer data) {
         return;
     }
     
-    // Check if doctor exists
-    int doctor_found = 0;
-    for (int i = 0; i < *(app_data->doctor_count); i++) {
-        if (app_data->doctors[i] != NULL && app_data->doctors[i]->id == doctor_id) {
-            doctor_found = 1;
-            break;
-        }
-    }
-    
     if (!doctor_found) {
         GtkWidget *error_dialog = gtk_message_dialog_new(
             GTK_WINDOW(dialog),
@@ -670,123 +711,64 @@ static void on_create_appointment_save(GtkWidget *widget, gpointer data) {
         return;
     }
     
-    // Check maximum capacity
-    if (*(app_data->appointment_count) >= MAX_RECORDS) {
-        GtkWidget *error_dialog = gtk_message_dialog_new(
+    // Triage level is only asked in triage mode (combo index 0 = level 1)
+    int triage_level = WAITLIST_DEFAULT_TRIAGE;
+    if (triage_combo != NULL) {
+        triage_level = gtk_combo_box_get_active(GTK_COMBO_BOX(triage_combo)) + 1;
+    }
+    
+    // Submit to the scheduler thread, which applies the booking
+    IntakeRequest request;
+    memset(&request, 0, sizeof(request));
+    request.type = INTAKE_CREATE_APPOINTMENT;
+    request.appointment_id = appointment_id;
+    request.patient_id = patient_id;
+    request.doctor_id = doctor_id;
+    request.start_time = start_time;
+    request.end_time = end_time;
+    request.triage_level = triage_level;
+    
+    IntakeStatus status = scheduler_book(app_data->scheduler, &request, &appointment_id);
+    
+    if (status == INTAKE_APPLIED) {
+        // Added to AVL, heap, the appointment vector and the journal
+        char message[200];
+        snprintf(message, sizeof(message), 
+                "Randevu basariyla olusturuldu!\n\n"
+                "Randevu ID: %d\n"
+                "Hasta ID: %d\n"
+                "Doktor ID: %d\n"
+                "Time: %s - %s",
+                appointment_id, patient_id, doctor_id,
+                start_time_str, end_time_str);
+        
+        GtkWidget *success_dialog = gtk_message_dialog_new(
             GTK_WINDOW(dialog),
             GTK_DIALOG_MODAL,
-            GTK_MESSAGE_ERROR,
+            GTK_MESSAGE_INFO,
             GTK_BUTTONS_OK,
-            "Hata: Maksimum randevu kapasitesine ulasildi."
+            message
         );
-        gtk_dialog_run(GTK_DIALOG(error_dialog));
-        gtk_widget_destroy(error_dialog);
-        return;
-    }
-    
-    // Create appointment using existing core function
-    Appointment* appointment = create_appointment(appointment_id, patient_id, 
-                                                  doctor_id, start_time, end_time);
-    if (appointment == NULL) {
-        GtkWidget *error_dialog = gtk_message_dialog_new(
+        gtk_dialog_run(GTK_DIALOG(success_dialog));
+        gtk_widget_destroy(success_dialog);
+    } else if (status == INTAKE_WAITLISTED) {
+        // Conflict detected - added to waiting list
+        GtkWidget *warning_dialog = gtk_message_dialog_new(
             GTK_WINDOW(dialog),
             GTK_DIALOG_MODAL,
-            GTK_MESSAGE_ERROR,
+            GTK_MESSAGE_WARNING,
             GTK_BUTTONS_OK,
-            "Error: Failed to create appointment."
+            "Uyari: Zaman cakismasi tespit edildi. Doktorun bu saatte baska bir randevusu var.\n\nRandevu bekleme listesine eklendi."
         );
-        gtk_dialog_run(GTK_DIALOG(error_dialog));
-        gtk_widget_destroy(error_dialog);
-        return;
-    }
-    
-    // Check for time conflict using AVL tree
-    if (avl_has_conflict(app_data->avl_tree, doctor_id, start_time, end_time)) {
-        // Conflict detected - add to waiting queue
-        if (queue_enqueue(app_data->queue, appointment)) {
-            GtkWidget *warning_dialog = gtk_message_dialog_new(
-                GTK_WINDOW(dialog),
-                GTK_DIALOG_MODAL,
-                GTK_MESSAGE_WARNING,
-                GTK_BUTTONS_OK,
-                "Uyari: Zaman cakismasi tespit edildi. Doktorun bu saatte baska bir randevusu var.\n\nRandevu bekleme listesine eklendi."
-            );
-            gtk_dialog_run(GTK_DIALOG(warning_dialog));
-            gtk_widget_destroy(warning_dialog);
-        } else {
-            GtkWidget *error_dialog = gtk_message_dialog_new(
-                GTK_WINDOW(dialog),
-                GTK_DIALOG_MODAL,
-                GTK_MESSAGE_ERROR,
-                GTK_BUTTONS_OK,
-                "Hata: Randevu bekleme listesine eklenemedi."
-            );
-            gtk_dialog_run(GTK_DIALOG(error_dialog));
-            gtk_widget_destroy(error_dialog);
-            free_appointment(appointment);
-        }
-        
-        // Free entries array and remove from dialog data
-        free(entries);
-        g_object_set_data(G_OBJECT(dialog), "entries_array", NULL);
-        
-        // Close dialog
-        gtk_widget_destroy(dialog);
-        return;
-    }
-    
-    // No conflict - add to AVL tree and heap
-    if (avl_insert(app_data->avl_tree, appointment, doctor_id)) {
-        if (heap_insert(app_data->heap, appointment)) {
-            // Successfully added to both AVL and heap
-            app_data->appointments[*(app_data->appointment_count)] = appointment;
-            (*(app_data->appointment_count))++;
-            
-            // Show success message
-            char message[200];
-            snprintf(message, sizeof(message), 
-                    "Randevu basariyla olusturuldu!\n\n"
-                    "Randevu ID: %d\n"
-                    "Hasta ID: %d\n"
-                    "Doktor ID: %d\n"
-                    "Time: %s - %s",
-                    appointment_id, patient_id, doctor_id,
-                    start_time_str, end_time_str);
-            
-            GtkWidget *success_dialog = gtk_message_dialog_new(
-                GTK_WINDOW(dialog),
-                GTK_DIALOG_MODAL,
-                GTK_MESSAGE_INFO,
-                GTK_BUTTONS_OK,
-                message
-            );
-            gtk_dialog_run(GTK_DIALOG(success_dialog));
-            gtk_widget_destroy(success_dialog);
-        } else {
-            // Failed to add to heap - remove from AVL
-            avl_delete(app_data->avl_tree, appointment_id);
-            free_appointment(appointment);
-            
-            GtkWidget *error_dialog = gtk_message_dialog_new(
-                GTK_WINDOW(dialog),
-                GTK_DIALOG_MODAL,
-                GTK_MESSAGE_ERROR,
-                GTK_BUTTONS_OK,
-                "Hata: Randevu heap'e eklenemedi."
-            );
-            gtk_dialog_run(GTK_DIALOG(error_dialog));
-            gtk_widget_destroy(error_dialog);
-        }
+        gtk_dialog_run(GTK_DIALOG(warning_dialog));
+        gtk_widget_destroy(warning_dialog);
     } else {
-        // Failed to add to AVL
-        free_appointment(appointment);
-        
         GtkWidget *error_dialog = gtk_message_dialog_new(
             GTK_WINDOW(dialog),
             GTK_DIALOG_MODAL,
             GTK_MESSAGE_ERROR,
             GTK_BUTTONS_OK,
-            "Hata: Randevu AVL agacina eklenemedi."
+            "Hata: Randevu eklenemedi."
         );
         gtk_dialog_run(GTK_DIALOG(error_dialog));
         gtk_widget_destroy(error_dialog);
@@ -813,12 +795,13 @@ static void show_create_appointment_dialog(GtkWidget *parent) {
     GtkWidget *doctor_id_entry;
     GtkWidget *start_time_entry;
     GtkWidget *end_time_entry;
+    GtkWidget *triage_combo = NULL;
     GtkWidget *save_button;
     GtkWidget *cancel_button;
     GtkWidget *button_box;
     
     // Check if patients and doctors exist
-    if (app_data == NULL || app_data->patient_count == NULL || app_data->doctor_count == NULL) {
+    if (app_data == NULL || app_data->patients == NULL || app_data->doctors == NULL) {
         GtkWidget *error_dialog = gtk_message_dialog_new(
             GTK_WINDOW(parent),
             GTK_DIALOG_MODAL,
@@ -831,7 +814,12 @@ static void show_create_appointment_dialog(GtkWidget *parent) {
         return;
     }
     
-    if (*(app_data->patient_count) == 0) {
+    scheduler_lock(app_data->scheduler);
+    int patient_count = registry_patient_count(app_data->registry, app_data->patients);
+    int doctor_count = registry_doctor_count(app_data->registry, app_data->doctors);
+    scheduler_unlock(app_data->scheduler);
+    
+    if (patient_count == 0) {
         GtkWidget *error_dialog = gtk_message_dialog_new(
             GTK_WINDOW(parent),
             GTK_DIALOG_MODAL,
@@ -844,7 +832,7 @@ static void show_create_appointment_dialog(GtkWidget *parent) {
         return;
     }
     
-    if (*(app_data->doctor_count) == 0) {
+    if (doctor_count == 0) {
         GtkWidget *error_dialog = gtk_message_dialog_new(
             GTK_WINDOW(parent),
             GTK_DIALOG_MODAL,
@@ -918,21 +906,38 @@ static void show_create_appointment_dialog(GtkWidget *parent) {
     gtk_entry_set_placeholder_text(GTK_ENTRY(end_time_entry), "ornek: 10:00");
     gtk_grid_attach(GTK_GRID(grid), end_time_entry, 1, 4, 1, 1);
     
+    // Triage level field (only in triage mode, used if the request is waitlisted)
+    int button_row = 5;
+    if (app_data->waitlist != NULL && app_data->waitlist->mode == WAITLIST_MODE_TRIAGE) {
+        label = gtk_label_new("Triyaj Seviyesi:");
+        gtk_grid_attach(GTK_GRID(grid), label, 0, 5, 1, 1);
+        triage_combo = gtk_combo_box_text_new();
+        for (int level = 1; level <= WAITLIST_TRIAGE_LEVELS; level++) {
+            char level_str[32];
+            snprintf(level_str, sizeof(level_str), "%d - %s", level, waitlist_triage_name(level));
+            gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(triage_combo), level_str);
+        }
+        gtk_combo_box_set_active(GTK_COMBO_BOX(triage_combo), WAITLIST_DEFAULT_TRIAGE - 1);
+        gtk_grid_attach(GTK_GRID(grid), triage_combo, 1, 5, 1, 1);
+        button_row = 6;
+    }
+    
     // Create button box
     button_box = gtk_button_box_new(GTK_ORIENTATION_HORIZONTAL);
     gtk_button_box_set_layout(GTK_BUTTON_BOX(button_box), GTK_BUTTONBOX_END);
     gtk_box_set_spacing(GTK_BOX(button_box), 10);
     gtk_container_set_border_width(GTK_CONTAINER(button_box), 10);
-    gtk_grid_attach(GTK_GRID(grid), button_box, 0, 5, 2, 1);
+    gtk_grid_attach(GTK_GRID(grid), button_box, 0, button_row, 2, 1);
     
     // Store entry widgets in array for callback access (must be done before connecting signals)
-    GtkWidget **entries = (GtkWidget**)malloc(6 * sizeof(GtkWidget*));
+    GtkWidget **entries = (GtkWidget**)malloc(7 * sizeof(GtkWidget*));
     entries[0] = appointment_id_entry;
     entries[1] = patient_id_entry;
     entries[2] = doctor_id_entry;
     entries[3] = start_time_entry;
     entries[4] = end_time_entry;
     entries[5] = dialog;
+    entries[6] = triage_combo;  // NULL in FIFO mode
     
     // Store entries array in dialog object data for cleanup
     g_object_set_data(G_OBJECT(dialog), "entries_array", entries);
@@ -968,7 +973,7 @@ static void on_cancel_appointment_clicked(GtkWidget *widget, gpointer data) {
     GtkWidget *parent = GTK_WIDGET(data);
 
     if (app_data == NULL || app_data->avl_tree == NULL || app_data->heap == NULL ||
-        app_data->stack == NULL || app_data->appointments == NULL || app_data->appointment_count == NULL) {
+        app_data->journal == NULL || app_data->appointments == NULL) {
         GtkWidget *error_dialog = gtk_message_dialog_new(
             parent ? GTK_WINDOW(parent) : NULL,
             GTK_DIALOG_MODAL,
@@ -981,7 +986,10 @@ static void on_cancel_appointment_clicked(GtkWidget *widget, gpointer data) {
         return;
     }
 
-    if (*(app_data->appointment_count) == 0) {
+    scheduler_lock(app_data->scheduler);
+    int appointment_count = app_data->appointments->count;
+    scheduler_unlock(app_data->scheduler);
+    if (appointment_count == 0) {
         GtkWidget *info_dialog = gtk_message_dialog_new(
             parent ? GTK_WINDOW(parent) : NULL,
             GTK_DIALOG_MODAL,
@@ -1033,9 +1041,12 @@ static void on_cancel_appointment_clicked(GtkWidget *widget, gpointer data) {
             gtk_dialog_run(GTK_DIALOG(error_dialog));
             gtk_widget_destroy(error_dialog);
         } else {
-            // Delete from AVL tree
-            Appointment *appointment = avl_delete(app_data->avl_tree, appointment_id);
-            if (appointment == NULL) {
+            // The scheduler thread removes it from the tree, heap and array and records it for undo
+            IntakeRequest request;
+            memset(&request, 0, sizeof(request));
+            request.type = INTAKE_CANCEL_APPOINTMENT;
+            request.appointment_id = appointment_id;
+            if (scheduler_book(app_data->scheduler, &request, NULL) != INTAKE_APPLIED) {
                 GtkWidget *error_dialog = gtk_message_dialog_new(
                     GTK_WINDOW(dialog),
                     GTK_DIALOG_MODAL,
@@ -1046,40 +1057,15 @@ static void on_cancel_appointment_clicked(GtkWidget *widget, gpointer data) {
                 gtk_dialog_run(GTK_DIALOG(error_dialog));
                 gtk_widget_destroy(error_dialog);
             } else {
-                // Remove from array
-                int count = *(app_data->appointment_count);
-                for (int i = 0; i < count; i++) {
-                    if (app_data->appointments[i] != NULL &&
-                        app_data->appointments[i]->appointment_id == appointment_id) {
-                        app_data->appointments[i] = app_data->appointments[count - 1];
-                        app_data->appointments[count - 1] = NULL;
-                        (*(app_data->appointment_count))--;
-                        break;
-                    }
-                }
-
-                // Push to stack for undo
-                if (stack_push(app_data->stack, appointment)) {
-                    GtkWidget *info_dialog = gtk_message_dialog_new(
-                        GTK_WINDOW(dialog),
-                        GTK_DIALOG_MODAL,
-                        GTK_MESSAGE_INFO,
-                        GTK_BUTTONS_OK,
-                        "Randevu iptal edildi ve geri alma listesine eklendi."
-                    );
-                    gtk_dialog_run(GTK_DIALOG(info_dialog));
-                    gtk_widget_destroy(info_dialog);
-                } else {
-                    GtkWidget *warn_dialog = gtk_message_dialog_new(
-                        GTK_WINDOW(dialog),
-                        GTK_DIALOG_MODAL,
-                        GTK_MESSAGE_WARNING,
-                        GTK_BUTTONS_OK,
-                        "Randevu iptal edildi ancak geri alma listesine eklenemedi."
-                    );
-                    gtk_dialog_run(GTK_DIALOG(warn_dialog));
-                    gtk_widget_destroy(warn_dialog);
-                }
+                GtkWidget *info_dialog = gtk_message_dialog_new(
+                    GTK_WINDOW(dialog),
+                    GTK_DIALOG_MODAL,
+                    GTK_MESSAGE_INFO,
+                    GTK_BUTTONS_OK,
+                    "Randevu iptal edildi (Geri Al ile geri getirilebilir)."
+                );
+                gtk_dialog_run(GTK_DIALOG(info_dialog));
+                gtk_widget_destroy(info_dialog);
             }
         }
     }
@@ -1088,14 +1074,11 @@ static void on_cancel_appointment_clicked(GtkWidget *widget, gpointer data) {
 }
 
 /**
- * Callback for "Undo Cancel" button
+ * Undoes (direction 0) or redoes (direction 1) one journaled operation
  */
-static void on_undo_cancel_clicked(GtkWidget *widget, gpointer data) {
-    (void)widget;
-    GtkWidget *parent = GTK_WIDGET(data);
-
+static void run_journal_step(GtkWidget *parent, int direction) {
     if (app_data == NULL || app_data->avl_tree == NULL || app_data->heap == NULL ||
-        app_data->stack == NULL || app_data->appointments == NULL || app_data->appointment_count == NULL) {
+        app_data->journal == NULL || app_data->appointments == NULL) {
         GtkWidget *error_dialog = gtk_message_dialog_new(
             parent ? GTK_WINDOW(parent) : NULL,
             GTK_DIALOG_MODAL,
@@ -1108,115 +1091,90 @@ static void on_undo_cancel_clicked(GtkWidget *widget, gpointer data) {
         return;
     }
 
-    if (stack_is_empty(app_data->stack)) {
+    scheduler_lock(app_data->scheduler);
+    long long available = direction ? journal_redo_count(app_data->journal)
+                                     : journal_undo_count(app_data->journal);
+    scheduler_unlock(app_data->scheduler);
+    if (available == 0) {
         GtkWidget *info_dialog = gtk_message_dialog_new(
             parent ? GTK_WINDOW(parent) : NULL,
             GTK_DIALOG_MODAL,
             GTK_MESSAGE_INFO,
             GTK_BUTTONS_OK,
-            "Geri alinacak iptal edilmis randevu bulunmuyor."
+            direction ? "Yinelenecek islem bulunmuyor." : "Geri alinacak islem bulunmuyor."
         );
         gtk_dialog_run(GTK_DIALOG(info_dialog));
         gtk_widget_destroy(info_dialog);
         return;
     }
 
-    // Pop last cancelled appointment
-    Appointment *appointment = stack_pop(app_data->stack);
-    if (appointment == NULL) {
-        GtkWidget *error_dialog = gtk_message_dialog_new(
-            parent ? GTK_WINDOW(parent) : NULL,
-            GTK_DIALOG_MODAL,
-            GTK_MESSAGE_ERROR,
-            GTK_BUTTONS_OK,
-            "Hata: Geri alma listesinden randevu alinamadi."
-        );
-        gtk_dialog_run(GTK_DIALOG(error_dialog));
-        gtk_widget_destroy(error_dialog);
-        return;
-    }
-
-    // Check for time conflict before re-inserting
-    if (avl_has_conflict(app_data->avl_tree,
-                         appointment->doctor_id,
-                         appointment->start_time,
-                         appointment->end_time)) {
-        // Conflict: push back to stack
-        stack_push(app_data->stack, appointment);
-
+    JournalContext context = {
+        app_data->avl_tree, app_data->heap,
+        app_data->patients, app_data->doctors, app_data->appointments,
+        app_data->registry
+    };
+
+    // Structures only under the scheduler lock; dialogs run without it
+    JournalEntry last;
+    scheduler_lock(app_data->scheduler);
+    int done = direction ? journal_redo(app_data->journal, &context, 1, &last)
+                         : journal_undo(app_data->journal, &context, 1, &last);
+    long long undo_left = journal_undo_count(app_data->journal);
+    long long redo_left = journal_redo_count(app_data->journal);
+    scheduler_unlock(app_data->scheduler);
+    if (done == 0) {
         GtkWidget *warn_dialog = gtk_message_dialog_new(
             parent ? GTK_WINDOW(parent) : NULL,
             GTK_DIALOG_MODAL,
             GTK_MESSAGE_WARNING,
             GTK_BUTTONS_OK,
-            "Uyari: Zaman dilimi artik dolu. Geri alma basarisiz oldu ve randevu geri alma listesine geri eklendi."
+            "Uyari: Islem uygulanamadi (zaman dilimi dolu veya kayit bulunamadi)."
         );
         gtk_dialog_run(GTK_DIALOG(warn_dialog));
         gtk_widget_destroy(warn_dialog);
         return;
     }
 
-    // No conflict - reinsert into AVL and heap
-    if (avl_insert(app_data->avl_tree, appointment, appointment->doctor_id)) {
-        if (heap_insert(app_data->heap, appointment)) {
-            if (*(app_data->appointment_count) < MAX_RECORDS) {
-                app_data->appointments[*(app_data->appointment_count)] = appointment;
-                (*(app_data->appointment_count))++;
+    char description[128];
+    journal_describe(&last, description, sizeof(description));
 
-                GtkWidget *info_dialog = gtk_message_dialog_new(
-                    parent ? GTK_WINDOW(parent) : NULL,
-                    GTK_DIALOG_MODAL,
-                    GTK_MESSAGE_INFO,
-                    GTK_BUTTONS_OK,
-                    "Randevu geri alma basarili."
-                );
-                gtk_dialog_run(GTK_DIALOG(info_dialog));
-                gtk_widget_destroy(info_dialog);
-            } else {
-                // No space in array
-                avl_delete(app_data->avl_tree, appointment->appointment_id);
-                GtkWidget *error_dialog = gtk_message_dialog_new(
-                    parent ? GTK_WINDOW(parent) : NULL,
-                    GTK_DIALOG_MODAL,
-                    GTK_MESSAGE_ERROR,
-                    GTK_BUTTONS_OK,
-                    "Hata: Maksimum randevu kapasitesine ulasildi. Geri alma basarisiz."
-                );
-                gtk_dialog_run(GTK_DIALOG(error_dialog));
-                gtk_widget_destroy(error_dialog);
-            }
-        } else {
-            // Heap insert failed
-            avl_delete(app_data->avl_tree, appointment->appointment_id);
-            GtkWidget *error_dialog = gtk_message_dialog_new(
-                parent ? GTK_WINDOW(parent) : NULL,
-                GTK_DIALOG_MODAL,
-                GTK_MESSAGE_ERROR,
-                GTK_BUTTONS_OK,
-                "Hata: Randevu heap'e eklenemedi. Geri alma basarisiz."
-            );
-            gtk_dialog_run(GTK_DIALOG(error_dialog));
-            gtk_widget_destroy(error_dialog);
-        }
-    } else {
-        // AVL insert failed
-        GtkWidget *error_dialog = gtk_message_dialog_new(
-            parent ? GTK_WINDOW(parent) : NULL,
-            GTK_DIALOG_MODAL,
-            GTK_MESSAGE_ERROR,
-            GTK_BUTTONS_OK,
-            "Hata: Randevu AVL agacina eklenemedi. Geri alma basarisiz."
-        );
-        gtk_dialog_run(GTK_DIALOG(error_dialog));
-        gtk_widget_destroy(error_dialog);
-    }
+    char message[256];
+    snprintf(message, sizeof(message), "%s: %s\n\nKalan: %lld geri alinabilir, %lld yinelenebilir islem.",
+             direction ? "Yinelendi" : "Geri alindi", description,
+             undo_left, redo_left);
+
+    GtkWidget *info_dialog = gtk_message_dialog_new(
+        parent ? GTK_WINDOW(parent) : NULL,
+        GTK_DIALOG_MODAL,
+        GTK_MESSAGE_INFO,
+        GTK_BUTTONS_OK,
+        "%s", message
+    );
+    gtk_dialog_run(GTK_DIALOG(info_dialog));
+    gtk_widget_destroy(info_dialog);
+}
+
+/**
+ * Callback for "Undo" button
+ */
+static void on_undo_clicked(GtkWidget *widget, gpointer data) {
+    (void)widget;
+    run_journal_step(GTK_WIDGET(data), 0);
+}
+
+/**
+ * Callback for "Redo" button
+ */
+static void on_redo_clicked(GtkWidget *widget, gpointer data) {
+    (void)widget;
+    run_journal_step(GTK_WIDGET(data), 1);
 }
 
 /**
  * Shows a read-only window listing all appointments using GtkTreeView
  */
 static void show_appointments_window(GtkWidget *parent) {
-    if (app_data == NULL || app_data->appointments == NULL || app_data->appointment_count == NULL) {
+    if (app_data == NULL || app_data->appointments == NULL) {
         GtkWidget *error_dialog = gtk_message_dialog_new(
             GTK_WINDOW(parent),
             GTK_DIALOG_MODAL,
@@ -1229,7 +1187,9 @@ static void show_appointments_window(GtkWidget *parent) {
         return;
     }
 
-    int count = *(app_data->appointment_count);
+    scheduler_lock(app_data->scheduler);
+    int count = app_data->appointments->count;
+    scheduler_unlock(app_data->scheduler);
 
     if (count == 0) {
         GtkWidget *info_dialog = gtk_message_dialog_new(
@@ -1269,13 +1229,15 @@ static void show_appointments_window(GtkWidget *parent) {
                                              G_TYPE_STRING  // End Time
     );
 
-    // Populate list store from existing appointments
+    // Populate list store from existing appointments (copied under the scheduler lock)
     GtkTreeIter iter;
     char start_buf[6];
     char end_buf[6];
 
+    scheduler_lock(app_data->scheduler);
+    count = app_data->appointments->count;
     for (int i = 0; i < count; i++) {
-        Appointment *appt = app_data->appointments[i];
+        Appointment *appt = app_data->appointments->items[i];
         if (appt == NULL) {
             continue;
         }
@@ -1293,6 +1255,7 @@ static void show_appointments_window(GtkWidget *parent) {
                            4, end_buf,
                            -1);
     }
+    scheduler_unlock(app_data->scheduler);
 
     // Create tree view and set model
     GtkWidget *treeview = gtk_tree_view_new_with_model(GTK_TREE_MODEL(store));
@@ -1348,11 +1311,43 @@ static void on_list_appointments_clicked(GtkWidget *widget, gpointer data) {
     show_appointments_window(parent);
 }
 
+/**
+ * Appends one patient to a list store (PatientVisitor)
+ */
+static int append_patient_row(const Patient *patient, void *context) {
+    GtkListStore *store = (GtkListStore*)context;
+    GtkTreeIter iter;
+
+    gtk_list_store_append(store, &iter);
+    gtk_list_store_set(store, &iter,
+                       0, patient->id,
+                       1, patient->name,
+                       2, patient->age,
+                       -1);
+    return 1;
+}
+
+/**
+ * Appends one doctor to a list store (DoctorVisitor)
+ */
+static int append_doctor_row(const Doctor *doctor, void *context) {
+    GtkListStore *store = (GtkListStore*)context;
+    GtkTreeIter iter;
+
+    gtk_list_store_append(store, &iter);
+    gtk_list_store_set(store, &iter,
+                       0, doctor->id,
+                       1, doctor->name,
+                       2, doctor->department,
+                       -1);
+    return 1;
+}
+
 /**
  * Shows a read-only window listing all patients using GtkTreeView
  */
 static void show_patients_window(GtkWidget *parent) {
-    if (app_data == NULL || app_data->patients == NULL || app_data->patient_count == NULL) {
+    if (app_data == NULL || app_data->patients == NULL) {
         GtkWidget *error_dialog = gtk_message_dialog_new(
             parent ? GTK_WINDOW(parent) : NULL,
             GTK_DIALOG_MODAL,
@@ -1365,7 +1360,9 @@ static void show_patients_window(GtkWidget *parent) {
         return;
     }
 
-    int count = *(app_data->patient_count);
+    scheduler_lock(app_data->scheduler);
+    int count = registry_patient_count(app_data->registry, app_data->patients);
+    scheduler_unlock(app_data->scheduler);
 
     if (count == 0) {
         GtkWidget *info_dialog = gtk_message_dialog_new(
@@ -1403,22 +1400,10 @@ static void show_patients_window(GtkWidget *parent) {
                                              G_TYPE_INT     // Age
     );
 
-    // Populate list store from existing patients
-    GtkTreeIter iter;
-
-    for (int i = 0; i < count; i++) {
-        Patient *patient = app_data->patients[i];
-        if (patient == NULL) {
-            continue;
-        }
-
-        gtk_list_store_append(store, &iter);
-        gtk_list_store_set(store, &iter,
-                           0, patient->id,
-                           1, patient->name,
-                           2, patient->age,
-                           -1);
-    }
+    // Populate list store from existing patients (streamed from the snapshot when lazy)
+    scheduler_lock(app_data->scheduler);
+    registry_visit_patients(app_data->registry, app_data->patients, append_patient_row, store);
+    scheduler_unlock(app_data->scheduler);
 
     // Create tree view and set model
     GtkWidget *treeview = gtk_tree_view_new_with_model(GTK_TREE_MODEL(store));
@@ -1457,7 +1442,7 @@ static void show_patients_window(GtkWidget *parent) {
  * Shows a read-only window listing all doctors using GtkTreeView
  */
 static void show_doctors_window(GtkWidget *parent) {
-    if (app_data == NULL || app_data->doctors == NULL || app_data->doctor_count == NULL) {
+    if (app_data == NULL || app_data->doctors == NULL) {
         GtkWidget *error_dialog = gtk_message_dialog_new(
             parent ? GTK_WINDOW(parent) : NULL,
             GTK_DIALOG_MODAL,
@@ -1470,7 +1455,9 @@ static void show_doctors_window(GtkWidget *parent) {
         return;
     }
 
-    int count = *(app_data->doctor_count);
+    scheduler_lock(app_data->scheduler);
+    int count = registry_doctor_count(app_data->registry, app_data->doctors);
+    scheduler_unlock(app_data->scheduler);
 
     if (count == 0) {
         GtkWidget *info_dialog = gtk_message_dialog_new(
@@ -1508,22 +1495,10 @@ static void show_doctors_window(GtkWidget *parent) {
                                              G_TYPE_STRING  // Department
     );
 
-    // Populate list store from existing doctors
-    GtkTreeIter iter;
-
-    for (int i = 0; i < count; i++) {
-        Doctor *doctor = app_data->doctors[i];
-        if (doctor == NULL) {
-            continue;
-        }
-
-        gtk_list_store_append(store, &iter);
-        gtk_list_store_set(store, &iter,
-                           0, doctor->id,
-                           1, doctor->name,
-                           2, doctor->department,
-                           -1);
-    }
+    // Populate list store from existing doctors (streamed from the snapshot when lazy)
+    scheduler_lock(app_data->scheduler);
+    registry_visit_doctors(app_data->registry, app_data->doctors, append_doctor_row, store);
+    scheduler_unlock(app_data->scheduler);
 
     // Create tree view and set model
     GtkWidget *treeview = gtk_tree_view_new_with_model(GTK_TREE_MODEL(store));
@@ -1576,6 +1551,110 @@ static void on_list_doctors_clicked(GtkWidget *widget, gpointer data) {
     show_doctors_window(parent);
 }
 
+/**
+ * Callback for "Withdraw from Waiting List" button
+ * Removes one appointment (by appointment ID) or all of a patient's
+ * appointments (by patient ID) from the waiting list
+ */
+static void on_withdraw_waitlist_clicked(GtkWidget *widget, gpointer data) {
+    (void)widget;
+    GtkWidget *parent = GTK_WIDGET(data);
+
+    if (app_data == NULL || app_data->waitlist == NULL) {
+        GtkWidget *error_dialog = gtk_message_dialog_new(
+            parent ? GTK_WINDOW(parent) : NULL,
+            GTK_DIALOG_MODAL,
+            GTK_MESSAGE_ERROR,
+            GTK_BUTTONS_OK,
+            "Hata: Uygulama verileri baslatilmadi."
+        );
+        gtk_dialog_run(GTK_DIALOG(error_dialog));
+        gtk_widget_destroy(error_dialog);
+        return;
+    }
+
+    scheduler_lock(app_data->scheduler);
+    int empty = waitlist_is_empty(app_data->waitlist);
+    scheduler_unlock(app_data->scheduler);
+    if (empty) {
+        GtkWidget *info_dialog = gtk_message_dialog_new(
+            parent ? GTK_WINDOW(parent) : NULL,
+            GTK_DIALOG_MODAL,
+            GTK_MESSAGE_INFO,
+            GTK_BUTTONS_OK,
+            "Bekleme listesi bos."
+        );
+        gtk_dialog_run(GTK_DIALOG(info_dialog));
+        gtk_widget_destroy(info_dialog);
+        return;
+    }
+
+    GtkWidget *dialog = gtk_dialog_new_with_buttons(
+        "Bekleme Listesinden Cikar",
+        parent ? GTK_WINDOW(parent) : NULL,
+        GTK_DIALOG_MODAL,
+        "_Cancel", GTK_RESPONSE_CANCEL,
+        "_OK", GTK_RESPONSE_OK,
+        NULL
+    );
+
+    GtkWidget *content_area = gtk_dialog_get_content_area(GTK_DIALOG(dialog));
+    GtkWidget *box = gtk_box_new(GTK_ORIENTATION_VERTICAL, 10);
+    gtk_container_set_border_width(GTK_CONTAINER(box), 10);
+    gtk_container_add(GTK_CONTAINER(content_area), box);
+
+    GtkWidget *combo = gtk_combo_box_text_new();
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo), "Randevu ID ile");
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo), "Hasta ID ile (tum randevulari)");
+    gtk_combo_box_set_active(GTK_COMBO_BOX(combo), 0);
+    gtk_box_pack_start(GTK_BOX(box), combo, FALSE, FALSE, 5);
+
+    GtkWidget *entry = gtk_entry_new();
+    gtk_entry_set_placeholder_text(GTK_ENTRY(entry), "ID");
+    gtk_box_pack_start(GTK_BOX(box), entry, FALSE, FALSE, 5);
+
+    gtk_widget_show_all(dialog);
+
+    if (gtk_dialog_run(GTK_DIALOG(dialog)) == GTK_RESPONSE_OK) {
+        int by_patient = gtk_combo_box_get_active(GTK_COMBO_BOX(combo)) == 1;
+        int id = atoi(gtk_entry_get_text(GTK_ENTRY(entry)));
+        int removed = 0;
+
+        scheduler_lock(app_data->scheduler);
+        if (id > 0 && by_patient) {
+            const WaitlistEntry *waiting;
+            while ((waiting = waitlist_patient_entries(app_data->waitlist, id)) != NULL) {
+                int appointment_id = waiting->appointment->appointment_id;
+                free_appointment(waitlist_withdraw(app_data->waitlist, appointment_id));
+                statelog_waitlist_remove(appointment_id);
+                removed++;
+            }
+        } else if (id > 0) {
+            Appointment *appointment = waitlist_withdraw(app_data->waitlist, id);
+            if (appointment != NULL) {
+                free_appointment(appointment);
+                statelog_waitlist_remove(id);
+                removed = 1;
+            }
+        }
+        scheduler_unlock(app_data->scheduler);
+
+        GtkWidget *result_dialog = gtk_message_dialog_new(
+            GTK_WINDOW(dialog),
+            GTK_DIALOG_MODAL,
+            removed > 0 ? GTK_MESSAGE_INFO : GTK_MESSAGE_ERROR,
+            GTK_BUTTONS_OK,
+            removed > 0 ? "%d randevu bekleme listesinden cikarildi."
+                        : "Hata: Bekleme listesinde kayit bulunamadi.",
+            removed
+        );
+        gtk_dialog_run(GTK_DIALOG(result_dialog));
+        gtk_widget_destroy(result_dialog);
+    }
+
+    gtk_widget_destroy(dialog);
+}
+
 /**
  * Callback for "Exit" button
  */
@@ -1653,10 +1732,10 @@ static GtkWidget* create_main_window(void) {
     g_signal_connect(button, "clicked", G_CALLBACK(on_cancel_appointment_clicked), window);
     gtk_box_pack_start(GTK_BOX(vbox), button, FALSE, FALSE, 5);
     
-    // 5. Undo Cancel button
-    button = gtk_button_new_with_label("5. Iptali Geri Al");
+    // 5. Undo button
+    button = gtk_button_new_with_label("5. Geri Al");
     gtk_widget_set_size_request(button, 300, 40);
-    g_signal_connect(button, "clicked", G_CALLBACK(on_undo_cancel_clicked), window);
+    g_signal_connect(button, "clicked", G_CALLBACK(on_undo_clicked), window);
     gtk_box_pack_start(GTK_BOX(vbox), button, FALSE, FALSE, 5);
     
     // 6. List Appointments button
@@ -1677,16 +1756,32 @@ static GtkWidget* create_main_window(void) {
     g_signal_connect(button, "clicked", G_CALLBACK(on_list_doctors_clicked), window);
     gtk_box_pack_start(GTK_BOX(vbox), button, FALSE, FALSE, 5);
     
+    // 9. Withdraw from Waiting List button
+    button = gtk_button_new_with_label("9. Bekleme Listesinden Cikar");
+    gtk_widget_set_size_request(button, 300, 40);
+    g_signal_connect(button, "clicked", G_CALLBACK(on_withdraw_waitlist_clicked), window);
+    gtk_box_pack_start(GTK_BOX(vbox), button, FALSE, FALSE, 5);
+    
+    // 10. Redo button
+    button = gtk_button_new_with_label("10. Yinele");
+    gtk_widget_set_size_request(button, 300, 40);
+    g_signal_connect(button, "clicked", G_CALLBACK(on_redo_clicked), window);
+    gtk_box_pack_start(GTK_BOX(vbox), button, FALSE, FALSE, 5);
+    
     // Add separator before exit button
     separator = gtk_separator_new(GTK_ORIENTATION_HORIZONTAL);
     gtk_box_pack_start(GTK_BOX(vbox), separator, FALSE, FALSE, 10);
     
-    // 9. Exit button
-    button = gtk_button_new_with_label("9. Cikis");
+    // 11. Exit button
+    button = gtk_button_new_with_label("11. Cikis");
     gtk_widget_set_size_request(button, 300, 40);
     g_signal_connect(button, "clicked", G_CALLBACK(on_exit_clicked), NULL);
     gtk_box_pack_start(GTK_BOX(vbox), button, FALSE, FALSE, 5);
     
+    // Save status line (updated by on_checkpoint_tick)
+    save_status_label = gtk_label_new("");
+    gtk_box_pack_end(GTK_BOX(vbox), save_status_label, FALSE, FALSE, 5);
+    
     // Show all widgets
     gtk_widget_show_all(window);
     
@@ -1712,7 +1807,11 @@ void start_gui(int argc, char *argv[], AppData* app_data_param) {
     // Create and show main window
     create_main_window();
     
-    // Start GTK main event loop
+    // Check the checkpoint interval and refresh the save status a few times per second
+    g_timeout_add(CHECKPOINT_PROGRESS_US / 1000, on_checkpoint_tick, NULL);
+    
+    // Start GTK main event loop (callbacks take scheduler_lock only around
+    // structure access, never while a dialog waits for the user)
     gtk_main();
 }
 
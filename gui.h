@@ -7,9 +7,10 @@
 #include "appointment.h"
 #include "avl.h"
 #include "heap.h"
-#include "queue.h"
-#include "stack.h"
+#include "waitlist.h"
+#include "journal.h"
 #include "file_io.h"
+#include "scheduler.h"
 
 /**
  * GUI Module Header
@@ -26,16 +27,15 @@
  * Holds references to all core data structures for GUI access
  */
 typedef struct {
-    Patient** patients;
-    int* patient_count;
-    Doctor** doctors;
-    int* doctor_count;
-    Appointment** appointments;
-    int* appointment_count;
+    PatientVector* patients;
+    DoctorVector* doctors;
+    AppointmentVector* appointments;
     AVLTree* avl_tree;
     MinHeap* heap;
-    Queue* queue;
-    Stack* stack;
+    Waitlist* waitlist;
+    Journal* journal;
+    Registry* registry;  // Lazily loaded patients/doctors, NULL if all are in the vectors
+    Scheduler* scheduler;  // Applies bookings and cancellations; callbacks lock it around structure access
 } AppData;
 
 /**
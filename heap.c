@@ -9,12 +9,15 @@
  * - insert: O(log n)
  * - extract_min: O(log n)
  * - peek_min: O(1)
+ * - remove by ID: O(n) search + O(log n) repair
+ * - build: O(n)
  * - isEmpty: O(1)
  * - size: O(1)
  * 
- * Space Complexity: O(n) where n is capacity
+ * Space Complexity: O(n); the array doubles when full (amortized O(1) growth)
  */
 
+#include <limits.h>
 #include "heap.h"
 
 /**
@@ -22,7 +25,7 @@
  * Time Complexity: O(1)
  * 
  * @param heap: Pointer to heap to initialize
- * @param capacity: Maximum capacity of heap
+ * @param capacity: Initial capacity of heap (grows as needed)
  * @return: 1 on success, 0 on failure
  */
 int heap_init(MinHeap* heap, int capacity) {
@@ -42,6 +45,39 @@ int heap_init(MinHeap* heap, int capacity) {
     return 1; // Success
 }
 
+/**
+ * Internal helper: Grows the array to hold at least needed elements
+ * Capacity doubles so repeated inserts stay amortized O(1)
+ * Time Complexity: O(n) when the array moves
+ * 
+ * @param heap: Pointer to heap
+ * @param needed: Required number of slots
+ * @return: 1 on success, 0 if memory ran out (the heap is unchanged)
+ */
+static int heap_reserve(MinHeap* heap, int needed) {
+    if (needed <= heap->capacity) {
+        return 1;
+    }
+
+    long long capacity = (heap->capacity > 0) ? heap->capacity : 1;
+    while (capacity < needed) {
+        capacity *= 2;
+    }
+    if (capacity > INT_MAX) {
+        capacity = needed;
+    }
+
+    Appointment** appointments = (Appointment**)realloc(heap->appointments,
+                                                        (size_t)capacity * sizeof(Appointment*));
+    if (appointments == NULL) {
+        return 0; // Memory allocation failed
+    }
+
+    heap->appointments = appointments;
+    heap->capacity = (int)capacity;
+    return 1;
+}
+
 /**
  * Internal helper: Restores min-heap property from root downward
  * Used after extract_min to maintain heap property
@@ -124,9 +160,9 @@ int heap_insert(MinHeap* heap, Appointment* appointment) {
         return 0;
     }
 
-    // Check if heap is full
-    if (heap->size >= heap->capacity) {
-        return 0; // Heap is full
+    // Grow the array if it is full
+    if (heap->size == INT_MAX || !heap_reserve(heap, heap->size + 1)) {
+        return 0; // Memory allocation failed
     }
 
     // Add appointment at the end
@@ -166,6 +202,67 @@ Appointment* heap_extract_min(MinHeap* heap) {
     return min_appointment;
 }
 
+/**
+ * Removes the appointment with the given ID from anywhere in the heap
+ * The last element fills the hole and is sifted up or down
+ * Time Complexity: O(n) - linear search for the ID, O(log n) repair
+ * 
+ * @param heap: Pointer to heap
+ * @param appointment_id: ID of appointment to remove
+ * @return: Pointer to removed appointment, NULL if not found
+ */
+Appointment* heap_remove(MinHeap* heap, int appointment_id) {
+    if (heap == NULL) {
+        return NULL;
+    }
+
+    for (int i = 0; i < heap->size; i++) {
+        if (heap->appointments[i] != NULL &&
+            heap->appointments[i]->appointment_id == appointment_id) {
+            Appointment* removed = heap->appointments[i];
+            heap->size--;
+            if (i < heap->size) {
+                heap->appointments[i] = heap->appointments[heap->size];
+                heapify_up(heap, i);
+                heapify_down(heap, i);
+            }
+            return removed;
+        }
+    }
+
+    return NULL; // Not found
+}
+
+/**
+ * Replaces the heap contents with the given appointments
+ * Bottom-up heap construction (Floyd)
+ * Time Complexity: O(n)
+ * 
+ * @param heap: Pointer to heap
+ * @param appointments: Appointments to load (NULL entries are skipped)
+ * @param count: Number of entries in appointments
+ * @return: 1 on success, 0 if memory ran out
+ */
+int heap_build(MinHeap* heap, Appointment** appointments, int count) {
+    if (heap == NULL || appointments == NULL || count < 0 || !heap_reserve(heap, count)) {
+        return 0;
+    }
+
+    heap->size = 0;
+    for (int i = 0; i < count; i++) {
+        if (appointments[i] != NULL) {
+            heap->appointments[heap->size++] = appointments[i];
+        }
+    }
+
+    // Sift down every internal node, last parent first
+    for (int i = heap->size / 2 - 1; i >= 0; i--) {
+        heapify_down(heap, i);
+    }
+
+    return 1; // Success
+}
+
 /**
  * Returns the earliest appointment without removing it
  * Time Complexity: O(1) - direct access to root
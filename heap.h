@@ -13,7 +13,7 @@
  */
 typedef struct {
     Appointment** appointments;  // Array of appointment pointers
-    int capacity;                // Maximum capacity of heap
+    int capacity;                // Allocated slots (doubles when full)
     int size;                    // Current number of elements
 } MinHeap;
 
@@ -25,7 +25,7 @@ typedef struct {
 /**
  * Initializes an empty min-heap
  * @param heap: Pointer to heap to initialize
- * @param capacity: Maximum capacity of heap
+ * @param capacity: Initial capacity of heap (grows as needed)
  * @return: 1 on success, 0 on failure
  */
 int heap_init(MinHeap* heap, int capacity);
@@ -46,6 +46,23 @@ int heap_insert(MinHeap* heap, Appointment* appointment);
  */
 Appointment* heap_extract_min(MinHeap* heap);
 
+/**
+ * Removes the appointment with the given ID from anywhere in the heap
+ * @param heap: Pointer to heap
+ * @param appointment_id: ID of appointment to remove
+ * @return: Pointer to removed appointment, NULL if not found
+ */
+Appointment* heap_remove(MinHeap* heap, int appointment_id);
+
+/**
+ * Replaces the heap contents with the given appointments in O(n)
+ * @param heap: Pointer to heap
+ * @param appointments: Appointments to load (NULL entries are skipped)
+ * @param count: Number of entries in appointments
+ * @return: 1 on success, 0 if memory ran out
+ */
+int heap_build(MinHeap* heap, Appointment** appointments, int count);
+
 /**
  * Returns the earliest appointment without removing it
  * @param heap: Pointer to heap
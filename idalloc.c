@@ -0,0 +1,271 @@
+/**
+ * Thread-Safe ID Allocator Implementation
+ * 
+ * Fast path: atomic_fetch_add on the table counter, then one atomic load
+ * of the persisted ceiling. Only when the new ID is above the ceiling does
+ * the caller take the mutex and write the file; threads that raced past
+ * the same ceiling find it already raised and return.
+ * 
+ * Time Complexity:
+ * - reserve/next/raise: O(1), plus a 28-byte write + fsync per step
+ * - block_next: O(1), a shared atomic once per IDALLOC_BLOCK IDs
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <limits.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+#include "idalloc.h"
+#include "thread.h"
+
+#ifdef _WIN32
+#include <io.h>
+#define idalloc_fsync(file) _commit(_fileno(file))
+#else
+#include <unistd.h>
+#define idalloc_fsync(file) fsync(fileno(file))
+#endif
+
+#define IDALLOC_VERSION 1
+#define IDALLOC_FILE_SIZE (8 + 4 * IDALLOC_TABLE_COUNT)
+
+static const unsigned char idalloc_magic[4] = { 'R', 'I', 'D', 'S' };
+
+// Process-wide allocator state
+static atomic_int idalloc_counters[IDALLOC_TABLE_COUNT];  // Highest ID in use
+static atomic_int idalloc_ceilings[IDALLOC_TABLE_COUNT];  // Persisted ceilings
+static atomic_int idalloc_persisting;                     // 1 while a file is open
+static ThreadMutex idalloc_lock;                          // Serializes file writes
+static char idalloc_path[512];
+
+/**
+ * Internal helper: Reads the ceilings
+ * @return: 1 if the file exists and is valid, 0 otherwise
+ */
+static int idalloc_read(const char* path, int* ceilings) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return 0;
+    }
+    unsigned char data[IDALLOC_FILE_SIZE];
+    int ok = fread(data, 1, sizeof(data), file) == sizeof(data) &&
+             memcmp(data, idalloc_magic, 4) == 0 &&
+             ((uint32_t)data[4] | ((uint32_t)data[5] << 8) |
+              ((uint32_t)data[6] << 16) | ((uint32_t)data[7] << 24)) == IDALLOC_VERSION;
+    fclose(file);
+    for (int table = 0; ok && table < IDALLOC_TABLE_COUNT; table++) {
+        const unsigned char* field = data + 8 + 4 * table;
+        uint32_t value = (uint32_t)field[0] | ((uint32_t)field[1] << 8) |
+                         ((uint32_t)field[2] << 16) | ((uint32_t)field[3] << 24);
+        ceilings[table] = (int)value;
+        ok = ceilings[table] >= 0;
+    }
+    return ok;
+}
+
+/**
+ * Internal helper: Atomically replaces the file
+ * @return: 1 on success, 0 on failure
+ */
+static int idalloc_write(const char* path, const int* ceilings) {
+    char tmp_path[520];
+    if (strlen(path) + 5 > sizeof(tmp_path)) {
+        return 0;
+    }
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+
+    unsigned char data[IDALLOC_FILE_SIZE];
+    memcpy(data, idalloc_magic, 4);
+    for (int i = 0; i < 4; i++) {
+        data[4 + i] = (unsigned char)((uint32_t)IDALLOC_VERSION >> (8 * i));
+    }
+    for (int table = 0; table < IDALLOC_TABLE_COUNT; table++) {
+        for (int i = 0; i < 4; i++) {
+            data[8 + 4 * table + i] = (unsigned char)((uint32_t)ceilings[table] >> (8 * i));
+        }
+    }
+
+    FILE* file = fopen(tmp_path, "wb");
+    if (file == NULL) {
+        return 0;
+    }
+    int ok = fwrite(data, 1, sizeof(data), file) == sizeof(data) &&
+             fflush(file) == 0 && idalloc_fsync(file) == 0;
+    if (fclose(file) != 0) {
+        ok = 0;
+    }
+#ifdef _WIN32
+    if (ok) {
+        remove(path); // rename does not replace on Windows
+    }
+#endif
+    if (!ok || rename(tmp_path, path) != 0) {
+        remove(tmp_path);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Internal helper: Makes sure the persisted ceiling covers an ID
+ * A failed write stops persisting and removes the file, so the next
+ * startup falls back to scanning instead of trusting a stale ceiling
+ */
+static void idalloc_cover(IdTable table, int id) {
+    if (!atomic_load(&idalloc_persisting) || id <= atomic_load(&idalloc_ceilings[table])) {
+        return;
+    }
+
+    thread_mutex_lock(&idalloc_lock);
+    if (atomic_load(&idalloc_persisting) && id > atomic_load(&idalloc_ceilings[table])) {
+        int ceilings[IDALLOC_TABLE_COUNT];
+        for (int i = 0; i < IDALLOC_TABLE_COUNT; i++) {
+            ceilings[i] = atomic_load(&idalloc_ceilings[i]);
+        }
+        ceilings[table] = (id > INT_MAX - IDALLOC_PERSIST_STEP) ? INT_MAX : id + IDALLOC_PERSIST_STEP;
+        if (idalloc_write(idalloc_path, ceilings)) {
+            atomic_store(&idalloc_ceilings[table], ceilings[table]);
+        } else {
+            atomic_store(&idalloc_persisting, 0);
+            remove(idalloc_path);
+        }
+    }
+    thread_mutex_unlock(&idalloc_lock);
+}
+
+/**
+ * Starts persisting ceilings to a file
+ * Time Complexity: O(1)
+ * 
+ * @param path: High-water mark file
+ * @return: 1 if the file held valid ceilings, 0 otherwise
+ */
+int idalloc_open(const char* path) {
+    if (path == NULL || strlen(path) >= sizeof(idalloc_path) || atomic_load(&idalloc_persisting)) {
+        return 0;
+    }
+
+    int ceilings[IDALLOC_TABLE_COUNT];
+    int loaded = idalloc_read(path, ceilings);
+    for (int table = 0; table < IDALLOC_TABLE_COUNT; table++) {
+        int ceiling = loaded ? ceilings[table] : 0;
+        atomic_store(&idalloc_ceilings[table], ceiling);
+        if (ceiling > atomic_load(&idalloc_counters[table])) {
+            atomic_store(&idalloc_counters[table], ceiling); // Next ID will be ceiling + 1
+        }
+    }
+
+    strcpy(idalloc_path, path);
+    thread_mutex_init(&idalloc_lock);
+    atomic_store(&idalloc_persisting, 1);
+
+    // IDs handed out before the file was opened must be covered too
+    for (int table = 0; table < IDALLOC_TABLE_COUNT; table++) {
+        idalloc_cover((IdTable)table, atomic_load(&idalloc_counters[table]));
+    }
+    return loaded;
+}
+
+/**
+ * Returns count consecutive new IDs
+ * Time Complexity: O(1)
+ * 
+ * @return: First ID of the range
+ */
+int idalloc_reserve(IdTable table, int count) {
+    if (table < 0 || table >= IDALLOC_TABLE_COUNT || count < 1) {
+        return 0;
+    }
+    int last = atomic_fetch_add(&idalloc_counters[table], count) + count;
+    idalloc_cover(table, last);
+    return last - count + 1;
+}
+
+/**
+ * Returns one new ID
+ * Time Complexity: O(1)
+ * 
+ * @return: New ID
+ */
+int idalloc_next(IdTable table) {
+    return idalloc_reserve(table, 1);
+}
+
+/**
+ * Returns the next ID of a block
+ * Time Complexity: O(1)
+ * 
+ * @return: New ID
+ */
+int idalloc_block_next(IdBlock* block, IdTable table) {
+    if (block == NULL) {
+        return idalloc_next(table);
+    }
+    if (block->next <= 0 || block->next > block->end) {
+        block->next = idalloc_reserve(table, IDALLOC_BLOCK);
+        block->end = block->next + IDALLOC_BLOCK - 1;
+    }
+    return block->next++;
+}
+
+/**
+ * Raises a counter to at least an ID in use
+ * Time Complexity: O(1) expected (compare-and-swap loop)
+ * 
+ * @param table: ID sequence
+ * @param id: ID already in use
+ */
+void idalloc_raise(IdTable table, int id) {
+    if (table < 0 || table >= IDALLOC_TABLE_COUNT) {
+        return;
+    }
+    int current = atomic_load(&idalloc_counters[table]);
+    while (id > current &&
+           !atomic_compare_exchange_weak(&idalloc_counters[table], &current, id)) {
+        // current was reloaded by the failed exchange
+    }
+    idalloc_cover(table, id);
+}
+
+/**
+ * Returns the highest ID handed out or raised to
+ * Time Complexity: O(1)
+ * 
+ * @return: Highest ID
+ */
+int idalloc_current(IdTable table) {
+    if (table < 0 || table >= IDALLOC_TABLE_COUNT) {
+        return 0;
+    }
+    return atomic_load(&idalloc_counters[table]);
+}
+
+/**
+ * Writes the exact counters as ceilings and stops persisting
+ * Time Complexity: O(1)
+ * 
+ * @return: 1 on success, 0 on failure
+ */
+int idalloc_close(void) {
+    if (!atomic_load(&idalloc_persisting)) {
+        return 0;
+    }
+
+    thread_mutex_lock(&idalloc_lock);
+    int ceilings[IDALLOC_TABLE_COUNT];
+    for (int table = 0; table < IDALLOC_TABLE_COUNT; table++) {
+        ceilings[table] = atomic_load(&idalloc_counters[table]);
+    }
+    int ok = idalloc_write(idalloc_path, ceilings);
+    if (!ok) {
+        remove(idalloc_path);
+    }
+    atomic_store(&idalloc_persisting, 0);
+    thread_mutex_unlock(&idalloc_lock);
+    thread_mutex_destroy(&idalloc_lock);
+    return ok;
+}
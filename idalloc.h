@@ -0,0 +1,122 @@
+#ifndef IDALLOC_H
+#define IDALLOC_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * Thread-Safe ID Allocator
+ *
+ * One atomic counter per table holds the highest ID in use; handing out
+ * IDs is a single atomic add, so any thread may allocate. Threads that
+ * allocate often take whole blocks (IdBlock, IDALLOC_BLOCK IDs per
+ * reservation) and hand them out without touching the shared counter.
+ *
+ * High-water mark: with a file opened, every table has a persisted
+ * ceiling. An ID above it is only returned after the ceiling has been
+ * raised by IDALLOC_PERSIST_STEP and written (temp file + fsync + rename),
+ * so any ID that reached a record or the write-ahead log is covered.
+ * Startup sets the counters to the ceilings instead of scanning every
+ * record; after a crash the unused part of the last step is skipped.
+ * idalloc_close writes the exact counters, so a clean exit leaves no gap.
+ *
+ * File (little-endian): "RIDS", u32 version, i32 ceiling per table.
+ *
+ * IDs chosen by the user (menu) or read from files must be reported with
+ * idalloc_raise. An ID inside a block another thread still holds is not
+ * detected; block users check for records that already use the ID.
+ */
+
+/**
+ * Default high-water mark file
+ */
+#define IDALLOC_DEFAULT_PATH "data/ids.dat"
+
+/**
+ * IDs reserved per block
+ */
+#define IDALLOC_BLOCK 1024
+
+/**
+ * Ceiling increase per persisted write (16 blocks)
+ */
+#define IDALLOC_PERSIST_STEP (16 * IDALLOC_BLOCK)
+
+/**
+ * Tables with their own ID sequence
+ */
+typedef enum {
+    IDALLOC_PATIENT = 0,
+    IDALLOC_DOCTOR = 1,
+    IDALLOC_APPOINTMENT = 2,
+    IDALLOC_TABLE_COUNT = 3
+} IdTable;
+
+/**
+ * Block of reserved IDs owned by one thread ({0, 0} = empty)
+ */
+typedef struct {
+    int next;  // Next ID to hand out
+    int end;   // Last ID of the block
+} IdBlock;
+
+/**
+ * ID Allocator Operations
+ * Time Complexity: O(1); one file write per IDALLOC_PERSIST_STEP IDs
+ */
+
+/**
+ * Starts persisting ceilings to a file and raises the counters to the
+ * ceilings stored in it
+ * Call once at startup, before other threads allocate
+ * @param path: High-water mark file
+ * @return: 1 if the file held valid ceilings (no scan needed), 0 otherwise
+ */
+int idalloc_open(const char* path);
+
+/**
+ * Returns count consecutive new IDs
+ * @param table: ID sequence
+ * @param count: Number of IDs (>= 1)
+ * @return: First ID of the range
+ */
+int idalloc_reserve(IdTable table, int count);
+
+/**
+ * Returns one new ID
+ * @param table: ID sequence
+ * @return: New ID (starts from 1)
+ */
+int idalloc_next(IdTable table);
+
+/**
+ * Returns the next ID of a block, reserving a new block when it is used up
+ * @param block: Caller-owned block (not shared between threads)
+ * @param table: ID sequence
+ * @return: New ID
+ */
+int idalloc_block_next(IdBlock* block, IdTable table);
+
+/**
+ * Raises a counter so that an ID in use is never handed out again
+ * @param table: ID sequence
+ * @param id: ID already in use
+ */
+void idalloc_raise(IdTable table, int id);
+
+/**
+ * Returns the highest ID handed out or raised to
+ * @param table: ID sequence
+ * @return: Highest ID (0 if none)
+ */
+int idalloc_current(IdTable table);
+
+/**
+ * Writes the exact counters as ceilings and stops persisting
+ * Call at exit, after other threads have stopped allocating
+ * @return: 1 on success, 0 if the file could not be written (it is then
+ *          removed, so the next startup scans)
+ */
+int idalloc_close(void);
+
+#endif // IDALLOC_H
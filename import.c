@@ -0,0 +1,352 @@
+/**
+ * Bulk Appointment Import Implementation
+ * 
+ * State built once per import:
+ * - hash sets (IntMap) of patient, doctor and appointment IDs
+ * - the booked start minutes of the tree (at most one appointment per
+ *   minute, see avl_insert), each with its end time and a link to the
+ *   doctor's next booked minute; an IntMap holds each doctor's first one
+ * 
+ * The CSV visitor copies rows into the batch buffer. A full batch is
+ * validated row by row against that state (accepted rows update it, so
+ * later rows see them), then the accepted rows are committed and the log
+ * is synced once.
+ * 
+ * Time Complexity:
+ * - setup: O(p + d + a) expected
+ * - per row: O(1) expected checks plus O(b) for the doctor's b booked minutes
+ * - commit: O(log n) tree and heap insert per accepted row
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "import.h"
+#include "intmap.h"
+#include "file_io.h"
+#include "registry.h"
+#include "wal.h"
+#include "thread.h"
+
+// Minutes in a day (valid start/end times are 0..IMPORT_MINUTES - 1)
+#define IMPORT_MINUTES 1440
+
+// Verdict of an accepted row (rejected rows hold their ImportReason)
+#define IMPORT_ACCEPTED (-1)
+
+static const char* const import_reason_names[IMPORT_REASON_COUNT] = {
+    "malformed", "invalid_time", "duplicate_id", "unknown_patient",
+    "unknown_doctor", "slot_taken", "doctor_busy", "no_memory"
+};
+
+/**
+ * Import state
+ */
+typedef struct {
+    const JournalContext* ctx;
+    IntMap patient_ids;
+    IntMap doctor_ids;
+    IntMap appointment_ids;
+    IntMap doctor_first;                  // Doctor ID -> first booked minute + 1
+    unsigned char booked[IMPORT_MINUTES]; // 1 if the start minute is taken
+    int booked_end[IMPORT_MINUTES];       // End time of the appointment starting there
+    int booked_next[IMPORT_MINUTES];      // Doctor's next booked minute (-1 = none)
+    Appointment* batch;                   // Rows waiting for validation
+    int* verdicts;                        // IMPORT_ACCEPTED or a reason per batch row
+    int batch_count;
+    int batch_size;
+    long long start_us;
+    ImportProgressFn progress;
+    void* progress_context;
+    ImportReport* report;
+} ImportState;
+
+/**
+ * Internal helpers: Fill the patient / doctor sets (registry visitors)
+ */
+static int import_add_patient(const Patient* patient, void* context) {
+    return intmap_put((IntMap*)context, patient->id, (void*)patient);
+}
+
+static int import_add_doctor(const Doctor* doctor, void* context) {
+    return intmap_put((IntMap*)context, doctor->id, (void*)doctor);
+}
+
+/**
+ * Internal helper: Books a start minute for a doctor in the schedule index
+ * @return: 1 on success, 0 if memory ran out
+ */
+static int import_book(ImportState* state, int doctor_id, int start_time, int end_time) {
+    intptr_t first = (intptr_t)intmap_get(&state->doctor_first, doctor_id);
+    if (!intmap_put(&state->doctor_first, doctor_id, (void*)(intptr_t)(start_time + 1))) {
+        return 0;
+    }
+    state->booked[start_time] = 1;
+    state->booked_end[start_time] = end_time;
+    state->booked_next[start_time] = (int)first - 1;
+    return 1;
+}
+
+/**
+ * Internal helper: 1 if the doctor has an appointment overlapping [start, end)
+ */
+static int import_doctor_busy(const ImportState* state, int doctor_id, int start_time, int end_time) {
+    int minute = (int)(intptr_t)intmap_get(&state->doctor_first, doctor_id) - 1;
+    while (minute >= 0) {
+        if (start_time < state->booked_end[minute] && minute < end_time) {
+            return 1;
+        }
+        minute = state->booked_next[minute];
+    }
+    return 0;
+}
+
+/**
+ * Internal helper: Counts a rejected row
+ */
+static void import_reject(ImportReport* report, ImportReason reason, int appointment_id) {
+    if (report->reasons[reason] == 0) {
+        report->first_id[reason] = appointment_id;
+    }
+    report->reasons[reason]++;
+    report->rejected++;
+}
+
+/**
+ * Internal helper: Decides one row against the current state
+ * @return: IMPORT_ACCEPTED or the rejection reason
+ */
+static int import_validate(ImportState* state, const Appointment* row) {
+    if (row->start_time < 0 || row->end_time > IMPORT_MINUTES - 1 ||
+        row->start_time >= row->end_time) {
+        return IMPORT_INVALID_TIME;
+    }
+    if (intmap_contains(&state->appointment_ids, row->appointment_id)) {
+        return IMPORT_DUPLICATE_ID;
+    }
+    if (!intmap_contains(&state->patient_ids, row->patient_id)) {
+        return IMPORT_UNKNOWN_PATIENT;
+    }
+    if (!intmap_contains(&state->doctor_ids, row->doctor_id)) {
+        return IMPORT_UNKNOWN_DOCTOR;
+    }
+    if (state->booked[row->start_time]) {
+        return IMPORT_SLOT_TAKEN;
+    }
+    if (import_doctor_busy(state, row->doctor_id, row->start_time, row->end_time)) {
+        return IMPORT_DOCTOR_BUSY;
+    }
+
+    // Later rows of the file see this one
+    if (!intmap_put(&state->appointment_ids, row->appointment_id, state) ||
+        !import_book(state, row->doctor_id, row->start_time, row->end_time)) {
+        intmap_remove(&state->appointment_ids, row->appointment_id);
+        return IMPORT_NO_MEMORY;
+    }
+    return IMPORT_ACCEPTED;
+}
+
+/**
+ * Internal helper: Inserts one accepted row into the live structures
+ * @return: 1 on success, 0 if memory ran out (nothing is left behind)
+ */
+static int import_commit_row(const JournalContext* ctx, const Appointment* row) {
+    Appointment* appointment = create_appointment(row->appointment_id, row->patient_id,
+                                                  row->doctor_id, row->start_time, row->end_time);
+    if (appointment == NULL) {
+        return 0;
+    }
+    if (!avl_insert(ctx->avl_tree, appointment, appointment->doctor_id)) {
+        free_appointment(appointment);
+        return 0;
+    }
+    if (!heap_insert(ctx->heap, appointment)) {
+        avl_delete(ctx->avl_tree, appointment->appointment_id);
+        free_appointment(appointment);
+        return 0;
+    }
+    if (!appointment_vector_push(ctx->appointments, appointment)) {
+        heap_remove(ctx->heap, appointment->appointment_id);
+        avl_delete(ctx->avl_tree, appointment->appointment_id);
+        free_appointment(appointment);
+        return 0;
+    }
+    reserve_appointment_id(appointment->appointment_id);
+    wal_log_appointment_create(appointment);
+    return 1;
+}
+
+/**
+ * Internal helper: Validates and commits the buffered rows
+ */
+static void import_flush(ImportState* state) {
+    ImportReport* report = state->report;
+    if (state->batch_count == 0) {
+        return;
+    }
+
+    // Validate the whole batch first, then commit the accepted rows together
+    for (int i = 0; i < state->batch_count; i++) {
+        state->verdicts[i] = import_validate(state, &state->batch[i]);
+    }
+    for (int i = 0; i < state->batch_count; i++) {
+        const Appointment* row = &state->batch[i];
+        int verdict = state->verdicts[i];
+        if (verdict == IMPORT_ACCEPTED && !import_commit_row(state->ctx, row)) {
+            verdict = IMPORT_NO_MEMORY;
+        }
+        if (verdict == IMPORT_ACCEPTED) {
+            report->accepted++;
+        } else {
+            import_reject(report, (ImportReason)verdict, row->appointment_id);
+        }
+    }
+    report->rows += state->batch_count;
+    state->batch_count = 0;
+
+    // One durable write for the whole batch
+    if (wal_is_open()) {
+        wal_sync();
+    }
+    report->batches++;
+    report->elapsed_us = thread_now_us() - state->start_us;
+    if (state->progress != NULL) {
+        state->progress(report, state->progress_context);
+    }
+}
+
+/**
+ * Internal helper: CSV visitor, buffers one row
+ */
+static int import_visit_row(const Appointment* appointment, void* context) {
+    ImportState* state = (ImportState*)context;
+    state->batch[state->batch_count++] = *appointment;
+    if (state->batch_count == state->batch_size) {
+        import_flush(state);
+    }
+    return 1;
+}
+
+/**
+ * Internal helper: Builds the ID sets and the schedule index
+ * @return: 1 on success, 0 if memory ran out or the registry could not be read
+ */
+static int import_prepare(ImportState* state) {
+    const JournalContext* ctx = state->ctx;
+
+    int patient_count = registry_patient_count(ctx->registry, ctx->patients);
+    int doctor_count = registry_doctor_count(ctx->registry, ctx->doctors);
+    if (!intmap_reserve(&state->patient_ids, patient_count) ||
+        !intmap_reserve(&state->doctor_ids, doctor_count) ||
+        !intmap_reserve(&state->appointment_ids, ctx->appointments->count + state->batch_size)) {
+        return 0;
+    }
+    if (!registry_visit_patients(ctx->registry, ctx->patients, import_add_patient,
+                                 &state->patient_ids) ||
+        intmap_size(&state->patient_ids) > patient_count ||
+        !registry_visit_doctors(ctx->registry, ctx->doctors, import_add_doctor,
+                                &state->doctor_ids) ||
+        intmap_size(&state->doctor_ids) > doctor_count) {
+        return 0;
+    }
+
+    for (int i = 0; i < ctx->appointments->count; i++) {
+        const Appointment* appointment = ctx->appointments->items[i];
+        if (appointment != NULL &&
+            !intmap_put(&state->appointment_ids, appointment->appointment_id, state)) {
+            return 0;
+        }
+    }
+
+    // The tree holds at most one appointment per start minute
+    int tree_size = avl_size(ctx->avl_tree);
+    Appointment** booked = (Appointment**)malloc(((size_t)tree_size + 1) * sizeof(Appointment*));
+    if (booked == NULL) {
+        return 0;
+    }
+    int count = avl_to_sorted_array(ctx->avl_tree, booked, tree_size);
+    int ok = 1;
+    for (int i = 0; ok && i < count; i++) {
+        int start = booked[i]->start_time;
+        if (start >= 0 && start < IMPORT_MINUTES) {
+            ok = import_book(state, booked[i]->doctor_id, start, booked[i]->end_time);
+        }
+    }
+    free(booked);
+    return ok;
+}
+
+/**
+ * Imports appointments from a CSV file into the schedule
+ * Time Complexity: O(p + d + a) setup, O(1) expected per row, one log sync per batch
+ * 
+ * @return: 1 if the file was read to the end, 0 on failure
+ */
+int import_appointments_csv(const char* path, const JournalContext* context, int batch_size,
+                            ImportProgressFn progress, void* progress_context,
+                            ImportReport* report) {
+    if (path == NULL || context == NULL || report == NULL || context->avl_tree == NULL ||
+        context->heap == NULL || context->patients == NULL || context->doctors == NULL ||
+        context->appointments == NULL) {
+        return 0;
+    }
+    memset(report, 0, sizeof(*report));
+    if (batch_size <= 0) {
+        batch_size = IMPORT_DEFAULT_BATCH;
+    }
+
+    // Large arrays (booked minutes) live on the heap, not the stack
+    ImportState* state = (ImportState*)calloc(1, sizeof(ImportState));
+    if (state == NULL) {
+        return 0;
+    }
+    state->ctx = context;
+    state->batch_size = batch_size;
+    state->progress = progress;
+    state->progress_context = progress_context;
+    state->report = report;
+    state->start_us = thread_now_us();
+    intmap_init(&state->patient_ids);
+    intmap_init(&state->doctor_ids);
+    intmap_init(&state->appointment_ids);
+    intmap_init(&state->doctor_first);
+    state->batch = (Appointment*)malloc((size_t)batch_size * sizeof(Appointment));
+    state->verdicts = (int*)malloc((size_t)batch_size * sizeof(int));
+
+    int ok = state->batch != NULL && state->verdicts != NULL && import_prepare(state);
+    if (ok) {
+        CsvVisitReport visit;
+        memset(&visit, 0, sizeof(visit));
+        ok = visit_appointments_csv(path, import_visit_row, state, &visit);
+        import_flush(state); // Last partial batch
+
+        // Malformed rows were skipped by the reader, they never reached a batch
+        report->rows += visit.skipped;
+        report->reasons[IMPORT_MALFORMED] = visit.skipped;
+        report->rejected += visit.skipped;
+        report->first_malformed_line = visit.first_skipped;
+        report->elapsed_us = thread_now_us() - state->start_us;
+    }
+
+    intmap_destroy(&state->patient_ids);
+    intmap_destroy(&state->doctor_ids);
+    intmap_destroy(&state->appointment_ids);
+    intmap_destroy(&state->doctor_first);
+    free(state->batch);
+    free(state->verdicts);
+    free(state);
+    return ok;
+}
+
+/**
+ * Returns the name of a rejection reason
+ * Time Complexity: O(1)
+ * 
+ * @param reason: Reason
+ * @return: Short identifier
+ */
+const char* import_reason_name(ImportReason reason) {
+    if (reason < 0 || reason >= IMPORT_REASON_COUNT) {
+        return "unknown";
+    }
+    return import_reason_names[reason];
+}
@@ -0,0 +1,99 @@
+#ifndef IMPORT_H
+#define IMPORT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "journal.h"
+
+/**
+ * Bulk Appointment Import
+ *
+ * Streams an appointments CSV (visit_appointments_csv, fixed buffer) into
+ * the live schedule without the menu. Rows are collected into batches;
+ * each batch is validated against in-memory indexes built once at the
+ * start, then the accepted rows are committed together:
+ *   - appointment ID not in use (hash set of loaded IDs, file IDs added)
+ *   - patient and doctor exist (hash sets, registry-aware)
+ *   - schedule rules of avl_insert: the tree key is the start time, so a
+ *     start minute holds at most one appointment, and the doctor must be
+ *     free for the whole interval (per-doctor chains over the occupied
+ *     minutes instead of a full tree scan per row)
+ * Rejected rows are counted per reason; the first row with a given ID or
+ * slot wins, like the integrity check.
+ *
+ * A commit inserts into the tree, heap and vector, appends one log record
+ * per row and makes the batch durable with a single wal_sync. Imported
+ * rows are not journaled (not undoable): millions of entries would only
+ * push the interactive history out of the journal.
+ */
+
+/**
+ * Default number of rows validated and committed together
+ */
+#define IMPORT_DEFAULT_BATCH 65536
+
+/**
+ * Rejection reasons (index into ImportReport.reasons)
+ */
+typedef enum {
+    IMPORT_MALFORMED = 0,        // Row could not be parsed (skipped by the CSV reader)
+    IMPORT_INVALID_TIME = 1,     // start >= end or outside the day
+    IMPORT_DUPLICATE_ID = 2,     // Appointment ID already in use
+    IMPORT_UNKNOWN_PATIENT = 3,  // patient_id not registered
+    IMPORT_UNKNOWN_DOCTOR = 4,   // doctor_id not registered
+    IMPORT_SLOT_TAKEN = 5,       // Start minute already booked
+    IMPORT_DOCTOR_BUSY = 6,      // Doctor has an overlapping appointment
+    IMPORT_NO_MEMORY = 7,        // Allocation failed while committing
+    IMPORT_REASON_COUNT = 8
+} ImportReason;
+
+/**
+ * Import statistics
+ */
+typedef struct {
+    long long rows;                            // Rows read (valid and malformed)
+    long long accepted;                        // Rows committed to the schedule
+    long long rejected;                        // Rows rejected (sum of reasons)
+    long long reasons[IMPORT_REASON_COUNT];    // Rejected rows per reason
+    int first_id[IMPORT_REASON_COUNT];         // Appointment ID of the first rejected row per reason
+    long long first_malformed_line;            // 1-based file line of the first malformed row (0 if none)
+    long long batches;                         // Committed batches (one log sync each)
+    long long elapsed_us;                      // Wall time so far
+} ImportReport;
+
+/**
+ * Called after each committed batch (e.g. to print progress or start a
+ * checkpoint); the structures are consistent at that point
+ * Malformed rows are only counted when the file has been read to the end
+ */
+typedef void (*ImportProgressFn)(const ImportReport* report, void* context);
+
+/**
+ * Import Operations
+ * Time Complexity: O(n + r) to build the indexes, O(1) expected per row
+ * (plus the doctor's booked minutes), one log sync per batch
+ */
+
+/**
+ * Imports appointments from a CSV file into the schedule
+ * @param path: Appointments CSV (same format as appointments.csv)
+ * @param context: Live structures (patients/doctors through the registry if set)
+ * @param batch_size: Rows per batch (<= 0 -> IMPORT_DEFAULT_BATCH)
+ * @param progress: Called after each batch (may be NULL)
+ * @param progress_context: Passed to progress
+ * @param report: Receives the statistics
+ * @return: 1 if the file was read to the end, 0 if it could not be read or
+ *          memory ran out (rows committed so far stay committed)
+ */
+int import_appointments_csv(const char* path, const JournalContext* context, int batch_size,
+                            ImportProgressFn progress, void* progress_context,
+                            ImportReport* report);
+
+/**
+ * Returns the name of a rejection reason
+ * @param reason: Reason
+ * @return: Short identifier (e.g. "slot_taken")
+ */
+const char* import_reason_name(ImportReason reason);
+
+#endif // IMPORT_H
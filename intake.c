@@ -0,0 +1,379 @@
+/**
+ * Booking Intake Queue Implementation
+ * 
+ * Bounded lock-free MPSC queue (C11 atomics)
+ * Producers claim a position with a CAS on tail, fill the slot and publish it
+ * by advancing the slot's sequence number (release). The single consumer
+ * reads slots in order, so it only needs plain loads/stores on head.
+ * 
+ * Time Complexity:
+ * - submit: O(1) - one CAS in the uncontended case, no locks
+ * - drain: O(k) for a batch of k requests
+ * - handle status: O(1)
+ */
+
+#include <stdint.h>
+#include "intake.h"
+#include "file_io.h"
+#include "statelog.h"
+#include "wal.h"
+#include "thread.h"
+
+/**
+ * Initializes an empty intake queue
+ * Time Complexity: O(capacity) - slot sequence numbers are initialized
+ * 
+ * @param queue: Pointer to queue to initialize
+ * @param capacity: Requested capacity (rounded up to a power of two, min 2)
+ * @return: 1 on success, 0 on failure
+ */
+int intake_init(IntakeQueue* queue, int capacity) {
+    if (queue == NULL || capacity <= 0) {
+        return 0;
+    }
+
+    // Round capacity up to a power of two so positions wrap with a mask
+    size_t size = 2;
+    while (size < (size_t)capacity) {
+        size <<= 1;
+    }
+
+    queue->slots = (IntakeSlot*)malloc(size * sizeof(IntakeSlot));
+    if (queue->slots == NULL) {
+        return 0; // Memory allocation failed
+    }
+
+    // Slot i is initially free for the producer at position i
+    for (size_t i = 0; i < size; i++) {
+        atomic_init(&queue->slots[i].sequence, i);
+    }
+
+    queue->mask = size - 1;
+    atomic_init(&queue->tail, 0);
+    queue->head = 0;
+
+    return 1; // Success
+}
+
+/**
+ * Submits a request (multi-producer safe, lock-free)
+ * Time Complexity: O(1) - retries only when another producer wins the CAS
+ * 
+ * @param queue: Pointer to intake queue
+ * @param request: Request to copy into the queue
+ * @return: 1 on success, 0 if the queue is full
+ */
+int intake_submit(IntakeQueue* queue, const IntakeRequest* request) {
+    if (queue == NULL || queue->slots == NULL || request == NULL) {
+        return 0;
+    }
+
+    if (request->handle != NULL) {
+        request->handle->appointment_id = 0;
+        atomic_store_explicit(&request->handle->status, INTAKE_PENDING, memory_order_relaxed);
+    }
+
+    size_t pos = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    for (;;) {
+        IntakeSlot* slot = &queue->slots[pos & queue->mask];
+        size_t seq = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+        if (diff == 0) {
+            // Slot is free for this position - try to claim it
+            if (atomic_compare_exchange_weak_explicit(&queue->tail, &pos, pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                slot->request = *request;
+                // Publish: consumer sees the payload once it sees pos + 1
+                atomic_store_explicit(&slot->sequence, pos + 1, memory_order_release);
+                return 1;
+            }
+            // CAS failure reloaded pos - retry with the new tail
+        } else if (diff < 0) {
+            // Slot still holds the request from one lap ago: queue is full
+            return 0;
+        } else {
+            // Another producer claimed this position - catch up
+            pos = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * Internal helper: Publishes the result of a request to its handle
+ * Time Complexity: O(1)
+ */
+static void intake_complete(IntakeHandle* handle, IntakeStatus status, int appointment_id) {
+    if (handle == NULL) {
+        return;
+    }
+    handle->appointment_id = appointment_id;
+    // Release pairs with the acquire load in intake_handle_status
+    atomic_store_explicit(&handle->status, status, memory_order_release);
+}
+
+/**
+ * Internal helper: Completes a chunk of applied requests
+ * Waits for the write-ahead log group commit first, so a producer never
+ * sees a completed booking that a crash could still lose
+ */
+static void intake_complete_batch(IntakeHandle** handles, const IntakeStatus* statuses,
+                                  const int* ids, int count) {
+    if (count == 0) {
+        return;
+    }
+    if (wal_is_open()) {
+        wal_sync(); // One fsync for the whole chunk
+    }
+    for (int i = 0; i < count; i++) {
+        intake_complete(handles[i], statuses[i], ids[i]);
+    }
+}
+
+/**
+ * Drains up to max_batch published requests (scheduler thread only)
+ * Slots are released before applying, so producers can refill them
+ * while the batch is processed
+ * Time Complexity: O(k) for k drained requests
+ * 
+ * @param queue: Pointer to intake queue
+ * @param apply: Callback applying a single request
+ * @param context: Context passed to the callback
+ * @param max_batch: Maximum number of requests to apply
+ * @return: Number of requests applied
+ */
+int intake_drain(IntakeQueue* queue, IntakeApplyFn apply, void* context, int max_batch) {
+    if (queue == NULL || queue->slots == NULL || apply == NULL || max_batch <= 0) {
+        return 0;
+    }
+
+    // Results of the current chunk, completed together after one log commit
+    IntakeHandle* handles[INTAKE_DEFAULT_BATCH];
+    IntakeStatus statuses[INTAKE_DEFAULT_BATCH];
+    int ids[INTAKE_DEFAULT_BATCH];
+    int pending = 0;
+
+    int applied = 0;
+    while (applied < max_batch) {
+        size_t pos = queue->head;
+        IntakeSlot* slot = &queue->slots[pos & queue->mask];
+        size_t seq = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+
+        if (seq != pos + 1) {
+            break; // Empty, or the next producer has not published yet
+        }
+
+        IntakeRequest request = slot->request;
+        // Free the slot for the producer one lap ahead
+        atomic_store_explicit(&slot->sequence, pos + queue->mask + 1, memory_order_release);
+        queue->head = pos + 1;
+
+        int appointment_id = request.appointment_id;
+        IntakeStatus status = apply(&request, context, &appointment_id);
+        if (status == INTAKE_PENDING) {
+            status = INTAKE_REJECTED; // Callback must decide - treat as failure
+        }
+        handles[pending] = request.handle;
+        statuses[pending] = status;
+        ids[pending] = appointment_id;
+        pending++;
+        applied++;
+
+        if (pending == INTAKE_DEFAULT_BATCH) {
+            intake_complete_batch(handles, statuses, ids, pending);
+            pending = 0;
+        }
+    }
+    intake_complete_batch(handles, statuses, ids, pending);
+
+    return applied;
+}
+
+/**
+ * Checks whether the next request has been published (scheduler thread only)
+ * Time Complexity: O(1)
+ * 
+ * @param queue: Pointer to intake queue
+ * @return: 1 if a request is ready, 0 otherwise
+ */
+int intake_has_pending(const IntakeQueue* queue) {
+    if (queue == NULL || queue->slots == NULL) {
+        return 0;
+    }
+    const IntakeSlot* slot = &queue->slots[queue->head & queue->mask];
+    return atomic_load_explicit(&((IntakeSlot*)slot)->sequence, memory_order_acquire) ==
+           queue->head + 1;
+}
+
+/**
+ * Returns the current status of a completion handle
+ * Time Complexity: O(1)
+ * 
+ * @param handle: Completion handle
+ * @return: Current status
+ */
+IntakeStatus intake_handle_status(const IntakeHandle* handle) {
+    if (handle == NULL) {
+        return INTAKE_REJECTED;
+    }
+    return (IntakeStatus)atomic_load_explicit(&((IntakeHandle*)handle)->status,
+                                              memory_order_acquire);
+}
+
+/**
+ * Blocks (yielding the CPU) until the handle is completed
+ * 
+ * @param handle: Completion handle
+ * @return: Final status
+ */
+IntakeStatus intake_handle_wait(const IntakeHandle* handle) {
+    IntakeStatus status;
+    while ((status = intake_handle_status(handle)) == INTAKE_PENDING) {
+        thread_yield();
+    }
+    return status;
+}
+
+/**
+ * Internal helper: Existence checks, same as the interactive path
+ */
+static int intake_patient_exists(const IntakeBookingContext* ctx, int patient_id) {
+    return registry_find_patient(ctx->registry, ctx->patients, patient_id) != NULL;
+}
+
+static int intake_doctor_exists(const IntakeBookingContext* ctx, int doctor_id) {
+    return registry_find_doctor(ctx->registry, ctx->doctors, doctor_id) != NULL;
+}
+
+/**
+ * Internal helper: Creates an appointment (conflict -> waiting list)
+ */
+static IntakeStatus intake_apply_create(const IntakeRequest* request,
+                                        IntakeBookingContext* ctx, int* appointment_id) {
+    if (request->start_time < 0 || request->end_time > 1439 ||
+        request->start_time >= request->end_time) {
+        return INTAKE_REJECTED;
+    }
+    if (ctx->patients != NULL && !intake_patient_exists(ctx, request->patient_id)) {
+        return INTAKE_REJECTED;
+    }
+    if (ctx->doctors != NULL && !intake_doctor_exists(ctx, request->doctor_id)) {
+        return INTAKE_REJECTED;
+    }
+
+    int id = request->appointment_id;
+    if (id > 0) {
+        if (appointment_vector_find(ctx->appointments, id) >= 0 ||
+            waitlist_find(ctx->waitlist, id) != NULL) {
+            return INTAKE_REJECTED; // Duplicate appointment ID (booked or waiting)
+        }
+    } else {
+        // Block-reserved IDs: the shared counter is touched once per block;
+        // skip IDs the user entered inside the block meanwhile
+        do {
+            id = idalloc_block_next(&ctx->appointment_ids, IDALLOC_APPOINTMENT);
+        } while (appointment_vector_find(ctx->appointments, id) >= 0 ||
+                 waitlist_find(ctx->waitlist, id) != NULL);
+    }
+
+    Appointment* appointment = create_appointment(id, request->patient_id, request->doctor_id,
+                                                  request->start_time, request->end_time);
+    if (appointment == NULL) {
+        return INTAKE_REJECTED;
+    }
+    *appointment_id = id;
+
+    if (avl_has_conflict(ctx->avl_tree, request->doctor_id,
+                         request->start_time, request->end_time)) {
+        if (waitlist_enqueue(ctx->waitlist, appointment, request->triage_level)) {
+            statelog_waitlist_add(waitlist_find(ctx->waitlist, id));
+            return INTAKE_WAITLISTED;
+        }
+        free_appointment(appointment);
+        return INTAKE_REJECTED;
+    }
+
+    if (!avl_insert(ctx->avl_tree, appointment, request->doctor_id)) {
+        free_appointment(appointment);
+        return INTAKE_REJECTED;
+    }
+    if (!heap_insert(ctx->heap, appointment)) {
+        avl_delete(ctx->avl_tree, id);
+        free_appointment(appointment);
+        return INTAKE_REJECTED;
+    }
+
+    if (!appointment_vector_push(ctx->appointments, appointment)) {
+        heap_remove(ctx->heap, id);
+        avl_delete(ctx->avl_tree, id);
+        free_appointment(appointment);
+        return INTAKE_REJECTED;
+    }
+    journal_record_create(ctx->journal, appointment);
+    return INTAKE_APPLIED;
+}
+
+/**
+ * Internal helper: Cancels an appointment (recorded in the journal)
+ */
+static IntakeStatus intake_apply_cancel(const IntakeRequest* request,
+                                        IntakeBookingContext* ctx) {
+    // Indexed lookup, then delete by the tree key instead of scanning by ID
+    int index = appointment_vector_find(ctx->appointments, request->appointment_id);
+    if (index < 0) {
+        return INTAKE_REJECTED;
+    }
+    Appointment* appointment = appointment_vector_remove(ctx->appointments, index);
+    avl_delete_appointment(ctx->avl_tree, appointment);
+    heap_remove(ctx->heap, request->appointment_id);
+
+    journal_record_cancel(ctx->journal, appointment);
+    free_appointment(appointment);
+    return INTAKE_APPLIED;
+}
+
+/**
+ * Applies a booking request to the scheduler structures
+ * Must only be called from the scheduler (consumer) thread
+ * 
+ * @param request: Request to apply
+ * @param context: Pointer to IntakeBookingContext
+ * @param appointment_id: Receives the assigned/affected appointment ID
+ * @return: Completion status
+ */
+IntakeStatus intake_apply_booking(const IntakeRequest* request, void* context,
+                                  int* appointment_id) {
+    IntakeBookingContext* ctx = (IntakeBookingContext*)context;
+    if (request == NULL || ctx == NULL || appointment_id == NULL ||
+        ctx->avl_tree == NULL || ctx->heap == NULL || ctx->waitlist == NULL ||
+        ctx->journal == NULL || ctx->appointments == NULL) {
+        return INTAKE_REJECTED;
+    }
+
+    switch (request->type) {
+        case INTAKE_CREATE_APPOINTMENT:
+            return intake_apply_create(request, ctx, appointment_id);
+        case INTAKE_CANCEL_APPOINTMENT:
+            return intake_apply_cancel(request, ctx);
+        default:
+            return INTAKE_REJECTED;
+    }
+}
+
+/**
+ * Frees all memory allocated for the intake queue
+ * Time Complexity: O(1)
+ * 
+ * @param queue: Pointer to queue to destroy
+ */
+void intake_destroy(IntakeQueue* queue) {
+    if (queue == NULL) {
+        return;
+    }
+    free(queue->slots);
+    queue->slots = NULL;
+    queue->mask = 0;
+    queue->head = 0;
+    atomic_store(&queue->tail, 0);
+}
@@ -0,0 +1,198 @@
+#ifndef INTAKE_H
+#define INTAKE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include "appointment.h"
+#include "avl.h"
+#include "heap.h"
+#include "idalloc.h"
+#include "waitlist.h"
+#include "journal.h"
+#include "vector.h"
+
+/**
+ * Booking Intake Queue
+ *
+ * Bounded lock-free multi-producer single-consumer (MPSC) queue built on
+ * C11 atomics. Several front-desk terminals/threads submit booking requests;
+ * one scheduler thread (scheduler.h) drains them in batches and applies
+ * them to the AVL tree, heap, waiting list and arrays. Producers never
+ * touch those structures, so submitting takes no lock.
+ *
+ * Each slot carries a sequence number (Vyukov bounded queue):
+ * - sequence == position      -> slot is free for the producer at position
+ * - sequence == position + 1  -> slot holds a published request
+ */
+
+/**
+ * Cache line size used to keep producer and consumer indices apart
+ */
+#define INTAKE_CACHE_LINE 64
+
+/**
+ * Default number of requests applied per drain call
+ */
+#define INTAKE_DEFAULT_BATCH 64
+
+/**
+ * Request types accepted by the scheduler
+ */
+typedef enum {
+    INTAKE_CREATE_APPOINTMENT = 0,  // Book a new appointment
+    INTAKE_CANCEL_APPOINTMENT = 1   // Cancel an existing appointment
+} IntakeRequestType;
+
+/**
+ * Completion status reported back to the producer
+ */
+typedef enum {
+    INTAKE_PENDING = 0,     // Not yet applied by scheduler
+    INTAKE_APPLIED = 1,     // Booked or cancelled successfully
+    INTAKE_WAITLISTED = 2,  // Time slot conflict, added to waiting list
+    INTAKE_REJECTED = 3     // Invalid request or capacity/memory error
+} IntakeStatus;
+
+/**
+ * Completion handle owned by the producer
+ * Must stay valid until its status leaves INTAKE_PENDING
+ */
+typedef struct {
+    atomic_int status;   // IntakeStatus, published by the scheduler
+    int appointment_id;  // Assigned/affected appointment ID (valid once completed)
+} IntakeHandle;
+
+/**
+ * Booking request payload
+ * appointment_id may be 0 for creates; the scheduler then assigns the next ID
+ */
+typedef struct {
+    IntakeRequestType type;  // Operation to perform
+    int appointment_id;      // Appointment ID (create: 0 = auto, cancel: target)
+    int patient_id;          // Patient ID (create only)
+    int doctor_id;           // Doctor ID (create only)
+    int start_time;          // Start time in minutes from midnight (create only)
+    int end_time;            // End time in minutes from midnight (create only)
+    int triage_level;        // Waiting list triage level if waitlisted (0 = default)
+    IntakeHandle* handle;    // Completion handle, may be NULL (fire and forget)
+} IntakeRequest;
+
+/**
+ * Ring slot: sequence number + request payload
+ */
+typedef struct {
+    atomic_size_t sequence;  // Slot state (see module comment)
+    IntakeRequest request;   // Request payload
+} IntakeSlot;
+
+/**
+ * Intake Queue Structure
+ * Producer index (tail) and consumer index (head) live on separate cache lines
+ */
+typedef struct {
+    IntakeSlot* slots;  // Ring of slots (capacity is a power of two)
+    size_t mask;        // capacity - 1
+    _Alignas(INTAKE_CACHE_LINE) atomic_size_t tail;  // Next position to claim (producers)
+    _Alignas(INTAKE_CACHE_LINE) size_t head;         // Next position to consume (scheduler only)
+} IntakeQueue;
+
+/**
+ * Scheduler callback: applies one request and returns its completion status
+ * @param request: Request to apply
+ * @param context: Caller-provided context
+ * @param appointment_id: Receives the assigned/affected appointment ID
+ * @return: Completion status (never INTAKE_PENDING)
+ */
+typedef IntakeStatus (*IntakeApplyFn)(const IntakeRequest* request, void* context,
+                                      int* appointment_id);
+
+/**
+ * Scheduler context for intake_apply_booking
+ * Mirrors the structures the CLI/GUI booking path operates on
+ */
+typedef struct {
+    AVLTree* avl_tree;                // Appointments indexed for conflict checks
+    MinHeap* heap;                    // Earliest appointment heap
+    Waitlist* waitlist;               // Waiting list for conflicting requests
+    Journal* journal;                 // Operation journal (undo/redo)
+    PatientVector* patients;          // Patients (existence check, may be NULL)
+    DoctorVector* doctors;            // Doctors (existence check, may be NULL)
+    AppointmentVector* appointments;  // Appointments
+    Registry* registry;               // Lazily loaded patients/doctors (may be NULL)
+    IdBlock appointment_ids;          // IDs for requests without one (zero-initialize)
+} IntakeBookingContext;
+
+/**
+ * Intake Queue Operations
+ * Time Complexity: O(1) submit (lock-free), O(k) drain for a batch of k
+ */
+
+/**
+ * Initializes an empty intake queue
+ * @param queue: Pointer to queue to initialize
+ * @param capacity: Requested capacity (rounded up to a power of two, min 2)
+ * @return: 1 on success, 0 on failure
+ */
+int intake_init(IntakeQueue* queue, int capacity);
+
+/**
+ * Submits a request (safe to call from any number of threads concurrently)
+ * The request's handle, if any, is reset to INTAKE_PENDING before publishing
+ * @param queue: Pointer to intake queue
+ * @param request: Request to copy into the queue
+ * @return: 1 on success, 0 if the queue is full
+ */
+int intake_submit(IntakeQueue* queue, const IntakeRequest* request);
+
+/**
+ * Drains up to max_batch published requests (scheduler thread only)
+ * Each request is applied with the callback; handles are completed in
+ * chunks of INTAKE_DEFAULT_BATCH once the write-ahead log has committed them
+ * @param queue: Pointer to intake queue
+ * @param apply: Callback applying a single request
+ * @param context: Context passed to the callback
+ * @param max_batch: Maximum number of requests to apply
+ * @return: Number of requests applied
+ */
+int intake_drain(IntakeQueue* queue, IntakeApplyFn apply, void* context, int max_batch);
+
+/**
+ * Checks whether the next request has been published (scheduler thread only)
+ * @param queue: Pointer to intake queue
+ * @return: 1 if intake_drain would apply at least one request, 0 otherwise
+ */
+int intake_has_pending(const IntakeQueue* queue);
+
+/**
+ * Returns the current status of a completion handle
+ * @param handle: Completion handle
+ * @return: Current status
+ */
+IntakeStatus intake_handle_status(const IntakeHandle* handle);
+
+/**
+ * Blocks (yielding the CPU) until the handle is completed
+ * @param handle: Completion handle
+ * @return: Final status
+ */
+IntakeStatus intake_handle_wait(const IntakeHandle* handle);
+
+/**
+ * Applies a booking request to the scheduler structures
+ * Same rules as the interactive path: conflicts go to the waiting list,
+ * applied creations and cancellations are recorded in the journal
+ * Matches IntakeApplyFn; context must point to an IntakeBookingContext
+ */
+IntakeStatus intake_apply_booking(const IntakeRequest* request, void* context,
+                                  int* appointment_id);
+
+/**
+ * Frees all memory allocated for the intake queue
+ * Pending requests are discarded without completing their handles
+ * @param queue: Pointer to queue to destroy
+ */
+void intake_destroy(IntakeQueue* queue);
+
+#endif // INTAKE_H
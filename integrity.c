@@ -0,0 +1,273 @@
+/**
+ * Load-Time Integrity Check Implementation
+ * 
+ * Pass 1 puts every patient and doctor ID into a hash set; a put that does
+ * not grow the set found a duplicate. Pass 2 does the same for appointment
+ * IDs and looks up patient_id and doctor_id in the first two sets. Each
+ * row gets a reason byte (0 = good). With a quarantine file, the bad rows
+ * are appended and fsynced first and only then removed from the vectors,
+ * so a failed write loses nothing.
+ * 
+ * Time Complexity:
+ * - check: O(p + d + a) expected, one hash probe per ID and reference
+ * - quarantine: O(bad rows) written, O(n) compaction
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <string.h>
+#include "integrity.h"
+#include "intmap.h"
+#include "file_io.h"
+
+#ifdef _WIN32
+#include <io.h>
+#define integrity_fsync(file) _commit(_fileno(file))
+#else
+#include <unistd.h>
+#define integrity_fsync(file) fsync(fileno(file))
+#endif
+
+// Row reasons (index into integrity_reasons)
+#define INTEGRITY_OK 0
+#define INTEGRITY_DUPLICATE 1
+#define INTEGRITY_UNKNOWN_PATIENT 2
+#define INTEGRITY_UNKNOWN_DOCTOR 3
+
+static const char* const integrity_reasons[] = {
+    "ok", "duplicate_id", "unknown_patient", "unknown_doctor"
+};
+
+/**
+ * Internal helper: Counts one bad row of a kind
+ */
+static void integrity_note(IntegrityIssue* issue, int id) {
+    if (issue->count == 0) {
+        issue->first_id = id;
+    }
+    issue->count++;
+}
+
+/**
+ * Internal helper: Adds an ID to a set
+ * @return: 1 if it was new, 0 if it was already present, -1 if memory ran out
+ */
+static int integrity_add(IntMap* set, int id, void* value) {
+    // put replaces an existing key, so the size only grows for a new ID (one call, no lookup first)
+    int before = intmap_size(set);
+    if (!intmap_put(set, id, value)) {
+        return -1;
+    }
+    return intmap_size(set) > before;
+}
+
+/**
+ * Internal helper: Appends the bad rows to the quarantine file and fsyncs it
+ */
+static int integrity_write_quarantine(const char* path,
+                                      const PatientVector* patients, const unsigned char* patient_bad,
+                                      const DoctorVector* doctors, const unsigned char* doctor_bad,
+                                      const AppointmentVector* appointments,
+                                      const unsigned char* appointment_bad) {
+    FILE* file = fopen(path, "a");
+    if (file == NULL) {
+        return 0;
+    }
+    fseek(file, 0, SEEK_END);
+    if (ftell(file) == 0) {
+        fprintf(file, "table,reason,row\n");
+    }
+
+    for (int i = 0; i < patients->count; i++) {
+        if (patient_bad[i] != INTEGRITY_OK) {
+            const Patient* patient = patients->items[i];
+            fprintf(file, "patient,%s,%d,%s,%d\n", integrity_reasons[patient_bad[i]],
+                    patient->id, patient->name, patient->age);
+        }
+    }
+    for (int i = 0; i < doctors->count; i++) {
+        if (doctor_bad[i] != INTEGRITY_OK) {
+            const Doctor* doctor = doctors->items[i];
+            fprintf(file, "doctor,%s,%d,%s,%s\n", integrity_reasons[doctor_bad[i]],
+                    doctor->id, doctor->name, doctor->department);
+        }
+    }
+    for (int i = 0; i < appointments->count; i++) {
+        if (appointment_bad[i] != INTEGRITY_OK) {
+            const Appointment* appointment = appointments->items[i];
+            char start[10];
+            char end[10];
+            format_time_string(appointment->start_time, start);
+            format_time_string(appointment->end_time, end);
+            fprintf(file, "appointment,%s,%d,%d,%d,%s,%s\n", integrity_reasons[appointment_bad[i]],
+                    appointment->appointment_id, appointment->patient_id,
+                    appointment->doctor_id, start, end);
+        }
+    }
+
+    int ok = !ferror(file) && fflush(file) == 0 && integrity_fsync(file) == 0;
+    if (fclose(file) != 0) {
+        ok = 0;
+    }
+    return ok;
+}
+
+/**
+ * Checks loaded records for duplicate IDs and dangling references
+ */
+int integrity_check(PatientVector* patients, DoctorVector* doctors,
+                    AppointmentVector* appointments, const char* quarantine_path,
+                    IntegrityReport* report) {
+    if (appointments == NULL || report == NULL || (patients == NULL) != (doctors == NULL)) {
+        return 0;
+    }
+    memset(report, 0, sizeof(*report));
+
+    // Lazy loading: patients and doctors stay in the snapshot, only appointment IDs are checked
+    PatientVector no_patients = { NULL, 0, 0 };
+    DoctorVector no_doctors = { NULL, 0, 0 };
+    int check_references = (patients != NULL);
+    if (!check_references) {
+        patients = &no_patients;
+        doctors = &no_doctors;
+    }
+
+    // One reason byte per row (+1 so empty vectors still get a valid pointer)
+    unsigned char* patient_bad = (unsigned char*)calloc((size_t)patients->count + 1, 1);
+    unsigned char* doctor_bad = (unsigned char*)calloc((size_t)doctors->count + 1, 1);
+    unsigned char* appointment_bad = (unsigned char*)calloc((size_t)appointments->count + 1, 1);
+    IntMap patient_ids;
+    IntMap doctor_ids;
+    IntMap appointment_ids;
+    intmap_init(&patient_ids);
+    intmap_init(&doctor_ids);
+    intmap_init(&appointment_ids);
+
+    // Sized up front: the sets never rehash while they fill
+    int ok = (patient_bad != NULL && doctor_bad != NULL && appointment_bad != NULL &&
+              intmap_reserve(&patient_ids, patients->count) &&
+              intmap_reserve(&doctor_ids, doctors->count) &&
+              intmap_reserve(&appointment_ids, appointments->count));
+
+    // Pass 1: patient and doctor IDs (the first row with an ID wins)
+    for (int i = 0; ok && i < patients->count; i++) {
+        Patient* patient = patients->items[i];
+        if (patient == NULL) {
+            continue;
+        }
+        int added = integrity_add(&patient_ids, patient->id, patient);
+        if (added < 0) {
+            ok = 0;
+        } else if (added == 0) {
+            patient_bad[i] = INTEGRITY_DUPLICATE;
+            integrity_note(&report->duplicate_patients, patient->id);
+            report->bad_patients++;
+        }
+    }
+    for (int i = 0; ok && i < doctors->count; i++) {
+        Doctor* doctor = doctors->items[i];
+        if (doctor == NULL) {
+            continue;
+        }
+        int added = integrity_add(&doctor_ids, doctor->id, doctor);
+        if (added < 0) {
+            ok = 0;
+        } else if (added == 0) {
+            doctor_bad[i] = INTEGRITY_DUPLICATE;
+            integrity_note(&report->duplicate_doctors, doctor->id);
+            report->bad_doctors++;
+        }
+    }
+
+    // Pass 2: appointment IDs and references (every problem is counted, the first is the reason)
+    for (int i = 0; ok && i < appointments->count; i++) {
+        Appointment* appointment = appointments->items[i];
+        if (appointment == NULL) {
+            continue;
+        }
+        int added = integrity_add(&appointment_ids, appointment->appointment_id, appointment);
+        if (added < 0) {
+            ok = 0;
+            break;
+        }
+        unsigned char reason = INTEGRITY_OK;
+        if (added == 0) {
+            reason = INTEGRITY_DUPLICATE;
+            integrity_note(&report->duplicate_appointments, appointment->appointment_id);
+        }
+        if (check_references && !intmap_contains(&patient_ids, appointment->patient_id)) {
+            if (reason == INTEGRITY_OK) {
+                reason = INTEGRITY_UNKNOWN_PATIENT;
+            }
+            integrity_note(&report->unknown_patients, appointment->appointment_id);
+        }
+        if (check_references && !intmap_contains(&doctor_ids, appointment->doctor_id)) {
+            if (reason == INTEGRITY_OK) {
+                reason = INTEGRITY_UNKNOWN_DOCTOR;
+            }
+            integrity_note(&report->unknown_doctors, appointment->appointment_id);
+        }
+        if (reason != INTEGRITY_OK) {
+            appointment_bad[i] = reason;
+            report->bad_appointments++;
+        }
+    }
+
+    intmap_destroy(&patient_ids);
+    intmap_destroy(&doctor_ids);
+    intmap_destroy(&appointment_ids);
+
+    int bad_rows = report->bad_patients + report->bad_doctors + report->bad_appointments;
+    if (ok && quarantine_path != NULL && bad_rows > 0) {
+        // Rows leave the vectors only once they are safely on disk
+        ok = integrity_write_quarantine(quarantine_path, patients, patient_bad, doctors, doctor_bad,
+                                        appointments, appointment_bad);
+        if (ok) {
+            int kept = 0;
+            for (int i = 0; i < patients->count; i++) {
+                if (patient_bad[i] != INTEGRITY_OK) {
+                    free_patient(patients->items[i]);
+                } else {
+                    patients->items[kept++] = patients->items[i];
+                }
+            }
+            patients->count = kept;
+
+            kept = 0;
+            for (int i = 0; i < doctors->count; i++) {
+                if (doctor_bad[i] != INTEGRITY_OK) {
+                    free_doctor(doctors->items[i]);
+                } else {
+                    doctors->items[kept++] = doctors->items[i];
+                }
+            }
+            doctors->count = kept;
+
+            kept = 0;
+            for (int i = 0; i < appointments->count; i++) {
+                if (appointment_bad[i] != INTEGRITY_OK) {
+                    free_appointment(appointments->items[i]);
+                } else {
+                    appointments->items[kept++] = appointments->items[i];
+                }
+            }
+            appointments->count = kept;
+            report->quarantined = bad_rows;
+        }
+    }
+
+    free(patient_bad);
+    free(doctor_bad);
+    free(appointment_bad);
+    return ok;
+}
+
+/**
+ * Returns 1 if the report lists any problem
+ */
+int integrity_has_problems(const IntegrityReport* report) {
+    return report != NULL &&
+           (report->bad_patients + report->bad_doctors + report->bad_appointments) > 0;
+}
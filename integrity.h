@@ -0,0 +1,85 @@
+#ifndef INTEGRITY_H
+#define INTEGRITY_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "patient.h"
+#include "doctor.h"
+#include "appointment.h"
+#include "vector.h"
+
+/**
+ * Load-Time Integrity Check
+ *
+ * Checks loaded records against each other in O(n) with hash sets
+ * (IntMap) of the patient, doctor and appointment IDs:
+ *   - duplicate IDs: the first row with an ID wins, later rows are bad
+ *   - appointments whose patient_id or doctor_id is not loaded
+ *
+ * Problems are summarized per kind (count and first ID). Bad rows stay
+ * loaded unless a quarantine file is given; they are then appended to it
+ * and removed from the vectors (freed, order of the rest kept).
+ *
+ * Quarantine file (CSV, header written when the file is new):
+ *   table,reason,<row as in the table's CSV file>
+ *   e.g. appointment,unknown_doctor,12,3,99,09:00,09:30
+ * An appointment with several problems is written once, with its first
+ * reason (duplicate_id, unknown_patient, unknown_doctor).
+ */
+
+/**
+ * Default quarantine file path
+ */
+#define INTEGRITY_QUARANTINE_PATH "data/quarantine.csv"
+
+/**
+ * One kind of problem
+ */
+typedef struct {
+    int count;     // Rows with this problem
+    int first_id;  // Record ID of the first such row (valid when count > 0)
+} IntegrityIssue;
+
+/**
+ * Result of a check
+ */
+typedef struct {
+    IntegrityIssue duplicate_patients;      // Patients whose ID was already loaded
+    IntegrityIssue duplicate_doctors;       // Doctors whose ID was already loaded
+    IntegrityIssue duplicate_appointments;  // Appointments whose ID was already loaded
+    IntegrityIssue unknown_patients;        // Appointments of a patient that is not loaded
+    IntegrityIssue unknown_doctors;         // Appointments of a doctor that is not loaded
+    int bad_patients;                       // Bad rows per table
+    int bad_doctors;
+    int bad_appointments;
+    int quarantined;                        // Rows moved to the quarantine file
+} IntegrityReport;
+
+/**
+ * Integrity Operations
+ * Time Complexity: O(n) expected
+ */
+
+/**
+ * Checks loaded records for duplicate IDs and dangling references
+ * NULL entries in the vectors are ignored
+ * @param patients, doctors, appointments: Loaded records (patients and
+ *        doctors both NULL: only appointment IDs are checked, for records
+ *        served lazily from the snapshot)
+ * @param quarantine_path: File to move bad rows to (NULL to only report)
+ * @param report: Receives the result
+ * @return: 1 on success, 0 if memory ran out or the quarantine file could
+ *          not be written (the vectors are then left unchanged)
+ */
+int integrity_check(PatientVector* patients, DoctorVector* doctors,
+                    AppointmentVector* appointments, const char* quarantine_path,
+                    IntegrityReport* report);
+
+/**
+ * Returns 1 if the report lists any problem
+ * @param report: Result of integrity_check
+ * @return: 1 if a bad row was found, 0 otherwise
+ */
+int integrity_has_problems(const IntegrityReport* report);
+
+#endif // INTEGRITY_H
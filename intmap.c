@@ -0,0 +1,282 @@
+/**
+ * Integer Hash Map Implementation
+ * 
+ * Open addressing, linear probing, backward-shift deletion
+ * - Keys are mixed with a multiplicative hash so sequential IDs spread out
+ * - Load factor is kept at or below 1/2, probe sequences stay short
+ * - No tombstones: removing a key moves the rest of its cluster back
+ * 
+ * Time Complexity:
+ * - get/contains: O(1) expected
+ * - put: O(1) amortized expected (O(n) only when doubling)
+ * - remove: O(1) expected
+ */
+
+#include <limits.h>
+#include <string.h>
+#include "intmap.h"
+
+/**
+ * Internal helper: Home slot of a key
+ */
+static int intmap_home(const IntMap* map, int key) {
+    unsigned int h = (unsigned int)key * 2654435761u; // Knuth multiplicative hash
+    h ^= h >> 16;
+    return (int)(h & (unsigned int)(map->capacity - 1));
+}
+
+/**
+ * Internal helper: Slot index holding key, -1 if absent
+ */
+static int intmap_find(const IntMap* map, int key) {
+    if (map == NULL || map->size == 0) {
+        return -1;
+    }
+    int mask = map->capacity - 1;
+    for (int i = intmap_home(map, key); map->slots[i].used; i = (i + 1) & mask) {
+        if (map->slots[i].key == key) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Initializes an empty map
+ * Table is allocated lazily on first insert
+ * Time Complexity: O(1)
+ * 
+ * @param map: Pointer to map to initialize
+ */
+void intmap_init(IntMap* map) {
+    if (map == NULL) {
+        return;
+    }
+    map->slots = NULL;
+    map->capacity = 0;
+    map->size = 0;
+}
+
+/**
+ * Internal helper: Moves all keys into a table of new_capacity slots
+ * Time Complexity: O(n)
+ * 
+ * @return: 1 on success, 0 on failure
+ */
+static int intmap_rehash(IntMap* map, int new_capacity) {
+    IntMapSlot* new_slots = (IntMapSlot*)calloc(new_capacity, sizeof(IntMapSlot));
+    if (new_slots == NULL) {
+        return 0; // Memory allocation failed
+    }
+
+    IntMapSlot* old_slots = map->slots;
+    int old_capacity = map->capacity;
+    map->slots = new_slots;
+    map->capacity = new_capacity;
+
+    int mask = new_capacity - 1;
+    for (int i = 0; i < old_capacity; i++) {
+        if (!old_slots[i].used) {
+            continue;
+        }
+        int j = intmap_home(map, old_slots[i].key);
+        while (new_slots[j].used) {
+            j = (j + 1) & mask;
+        }
+        new_slots[j] = old_slots[i];
+    }
+
+    free(old_slots);
+    return 1;
+}
+
+/**
+ * Internal helper: Doubles the table and reinserts all keys
+ * Time Complexity: O(n)
+ * 
+ * @return: 1 on success, 0 on failure
+ */
+static int intmap_grow(IntMap* map) {
+    if (map->capacity > INT_MAX / 2) {
+        return 0; // Doubling would overflow int
+    }
+    int new_capacity = (map->capacity == 0) ? INTMAP_INITIAL_CAPACITY : map->capacity * 2;
+    return intmap_rehash(map, new_capacity);
+}
+
+/**
+ * Makes room for count keys without further growth
+ * Time Complexity: O(n)
+ * 
+ * @param map: Pointer to map
+ * @param count: Number of keys expected
+ * @return: 1 on success, 0 on failure (the map is unchanged)
+ */
+int intmap_reserve(IntMap* map, int count) {
+    if (map == NULL || count < 0) {
+        return 0;
+    }
+    int new_capacity = (map->capacity == 0) ? INTMAP_INITIAL_CAPACITY : map->capacity;
+    while (new_capacity < 2 * count) {
+        if (new_capacity > (1 << 29)) {
+            return 0; // Overflow
+        }
+        new_capacity *= 2;
+    }
+    return (new_capacity == map->capacity) ? 1 : intmap_rehash(map, new_capacity);
+}
+
+/**
+ * Returns the value stored for a key
+ * Time Complexity: O(1) expected
+ * 
+ * @param map: Pointer to map
+ * @param key: Key to look up
+ * @return: Stored pointer, NULL if key is absent
+ */
+void* intmap_get(const IntMap* map, int key) {
+    int i = intmap_find(map, key);
+    return (i < 0) ? NULL : map->slots[i].value;
+}
+
+/**
+ * Checks whether a key is present
+ * Time Complexity: O(1) expected
+ * 
+ * @param map: Pointer to map
+ * @param key: Key to look up
+ * @return: 1 if present, 0 otherwise
+ */
+int intmap_contains(const IntMap* map, int key) {
+    return intmap_find(map, key) >= 0;
+}
+
+/**
+ * Stores a value for a key (replaces an existing value)
+ * Time Complexity: O(1) amortized expected
+ * 
+ * @param map: Pointer to map
+ * @param key: Key
+ * @param value: Pointer to store
+ * @return: 1 on success, 0 on failure
+ */
+int intmap_put(IntMap* map, int key, void* value) {
+    if (map == NULL) {
+        return 0;
+    }
+
+    int existing = intmap_find(map, key);
+    if (existing >= 0) {
+        map->slots[existing].value = value;
+        return 1;
+    }
+
+    // Keep load factor <= 1/2
+    if ((map->size + 1) * 2 > map->capacity && !intmap_grow(map)) {
+        return 0; // Memory allocation failed
+    }
+
+    int mask = map->capacity - 1;
+    int i = intmap_home(map, key);
+    while (map->slots[i].used) {
+        i = (i + 1) & mask;
+    }
+    map->slots[i].key = key;
+    map->slots[i].used = 1;
+    map->slots[i].value = value;
+    map->size++;
+    return 1; // Success
+}
+
+/**
+ * Removes a key
+ * The rest of the probe cluster is shifted back so no tombstone is needed
+ * Time Complexity: O(1) expected
+ * 
+ * @param map: Pointer to map
+ * @param key: Key to remove
+ * @return: Removed value, NULL if key was absent
+ */
+void* intmap_remove(IntMap* map, int key) {
+    int hole = intmap_find(map, key);
+    if (hole < 0) {
+        return NULL;
+    }
+
+    void* value = map->slots[hole].value;
+    int mask = map->capacity - 1;
+
+    for (int j = (hole + 1) & mask; map->slots[j].used; j = (j + 1) & mask) {
+        int home = intmap_home(map, map->slots[j].key);
+        // Move slot j into the hole unless its home lies cyclically in (hole, j]
+        int stays = (hole <= j) ? (hole < home && home <= j)
+                                : (hole < home || home <= j);
+        if (!stays) {
+            map->slots[hole] = map->slots[j];
+            hole = j;
+        }
+    }
+
+    map->slots[hole].used = 0;
+    map->slots[hole].value = NULL;
+    map->size--;
+    return value;
+}
+
+/**
+ * Returns the number of stored keys
+ * Time Complexity: O(1)
+ * 
+ * @param map: Pointer to map
+ * @return: Number of keys
+ */
+int intmap_size(const IntMap* map) {
+    if (map == NULL) {
+        return 0;
+    }
+    return map->size;
+}
+
+/**
+ * Replaces a map's contents with a copy of another map (same layout, no rehash)
+ * Time Complexity: O(capacity)
+ * 
+ * @param map: Destination map (initialized)
+ * @param source: Map to copy
+ * @return: 1 on success, 0 if memory ran out (map is left empty)
+ */
+int intmap_copy(IntMap* map, const IntMap* source) {
+    if (map == NULL || source == NULL) {
+        return 0;
+    }
+    intmap_destroy(map);
+    if (source->capacity == 0) {
+        return 1;
+    }
+    map->slots = (IntMapSlot*)malloc((size_t)source->capacity * sizeof(IntMapSlot));
+    if (map->slots == NULL) {
+        return 0;
+    }
+    memcpy(map->slots, source->slots, (size_t)source->capacity * sizeof(IntMapSlot));
+    map->capacity = source->capacity;
+    map->size = source->size;
+    return 1;
+}
+
+/**
+ * Frees the slot table
+ * Time Complexity: O(1)
+ * 
+ * Note: Stored values are not freed - they are managed elsewhere
+ * 
+ * @param map: Pointer to map to destroy
+ */
+void intmap_destroy(IntMap* map) {
+    if (map == NULL) {
+        return;
+    }
+    free(map->slots);
+    map->slots = NULL;
+    map->capacity = 0;
+    map->size = 0;
+}
@@ -0,0 +1,113 @@
+#ifndef INTMAP_H
+#define INTMAP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * Integer Hash Map
+ * Maps int keys (record IDs) to pointers
+ *
+ * Open addressing with linear probing over a power-of-two table.
+ * Deletion shifts the following cluster back instead of leaving
+ * tombstones, so lookups never degrade after many removals.
+ * The table doubles when it becomes more than half full.
+ */
+
+/**
+ * Initial table size (allocated on first insert)
+ */
+#define INTMAP_INITIAL_CAPACITY 16
+
+/**
+ * Hash Map Slot
+ */
+typedef struct {
+    int key;      // Record ID
+    int used;     // 1 if slot holds a key
+    void* value;  // Stored pointer
+} IntMapSlot;
+
+/**
+ * Hash Map Structure
+ */
+typedef struct {
+    IntMapSlot* slots;  // Slot table (capacity is a power of two)
+    int capacity;       // Number of slots
+    int size;           // Number of stored keys
+} IntMap;
+
+/**
+ * Hash Map Operations
+ * Time Complexity: O(1) expected for get/put/remove
+ */
+
+/**
+ * Initializes an empty map (no allocation until first insert)
+ * @param map: Pointer to map to initialize
+ */
+void intmap_init(IntMap* map);
+
+/**
+ * Makes room for count keys, so inserting them does not grow the table
+ * @param map: Pointer to map
+ * @param count: Number of keys expected
+ * @return: 1 on success, 0 on failure (the map is unchanged)
+ */
+int intmap_reserve(IntMap* map, int count);
+
+/**
+ * Returns the value stored for a key
+ * @param map: Pointer to map
+ * @param key: Key to look up
+ * @return: Stored pointer, NULL if key is absent
+ */
+void* intmap_get(const IntMap* map, int key);
+
+/**
+ * Checks whether a key is present
+ * @param map: Pointer to map
+ * @param key: Key to look up
+ * @return: 1 if present, 0 otherwise
+ */
+int intmap_contains(const IntMap* map, int key);
+
+/**
+ * Stores a value for a key (replaces an existing value)
+ * @param map: Pointer to map
+ * @param key: Key
+ * @param value: Pointer to store
+ * @return: 1 on success, 0 on failure
+ */
+int intmap_put(IntMap* map, int key, void* value);
+
+/**
+ * Removes a key
+ * @param map: Pointer to map
+ * @param key: Key to remove
+ * @return: Removed value, NULL if key was absent
+ */
+void* intmap_remove(IntMap* map, int key);
+
+/**
+ * Returns the number of stored keys
+ * @param map: Pointer to map
+ * @return: Number of keys
+ */
+int intmap_size(const IntMap* map);
+
+/**
+ * Replaces a map's contents with a copy of another map
+ * @param map: Destination map (initialized; its old table is freed)
+ * @param source: Map to copy
+ * @return: 1 on success, 0 if memory ran out (map is left empty)
+ */
+int intmap_copy(IntMap* map, const IntMap* source);
+
+/**
+ * Frees the slot table (stored values are not freed)
+ * @param map: Pointer to map to destroy
+ */
+void intmap_destroy(IntMap* map);
+
+#endif // INTMAP_H
@@ -0,0 +1,857 @@
+/**
+ * Operation Journal Implementation
+ * 
+ * Undo/redo history held in a fixed-size ring with a disk backing file
+ * - The ring holds a contiguous window [base, base + length) of the history
+ * - Recording into a full ring spills its oldest half to the backing file
+ * - Undo/redo past the window edge spills the far end of the window and
+ *   reads the next block back, so each entry costs O(1) amortized I/O
+ * - Entries are stored by value, so spilled entries need no fix-ups
+ * - Every recorded, undone or redone change is appended to the
+ *   write-ahead log (wal.h) as its net effect
+ * 
+ * The backing file is a header followed by a ring of JOURNAL_HISTORY_LIMIT
+ * raw JournalEntry records (entry i at JOURNAL_HEADER_SIZE +
+ * (i % limit) * sizeof(JournalEntry)), so it never grows past the limit;
+ * entries older than total - limit are overwritten and can no longer be
+ * undone. The header stores the entry size and the limit, so a file
+ * written by a build with a different layout is discarded instead of
+ * misread. Offsets are 64-bit (fseeko / _fseeki64).
+ * 
+ * Time Complexity:
+ * - record: O(1) amortized
+ * - undo/redo of k entries: O(k) amortized + O(n) heap rebuild
+ * - open/close: O(capacity)
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#define _FILE_OFFSET_BITS 64
+#endif
+
+#include <stdint.h>
+#include <string.h>
+#include <sys/types.h>
+#include "journal.h"
+#include "file_io.h"
+#include "wal.h"
+
+#define JOURNAL_VERSION 2
+
+#ifdef _WIN32
+#define journal_seek(file, offset) _fseeki64((file), (offset), SEEK_SET)
+#else
+#define journal_seek(file, offset) fseeko((file), (off_t)(offset), SEEK_SET)
+#endif
+
+static const char journal_magic[4] = { 'R', 'J', 'N', 'L' };
+
+/**
+ * Backing file header
+ */
+typedef struct {
+    char magic[4];        // "RJNL"
+    uint32_t version;     // JOURNAL_VERSION
+    uint32_t entry_size;  // sizeof(JournalEntry) of the writer
+    uint32_t clean;       // 1 only after journal_close
+    int64_t total;        // History length
+    int64_t cursor;       // Applied entries
+    int64_t floor;        // Oldest entry still in the file
+    int64_t limit;        // Entries the file ring holds
+} JournalHeader;
+
+#define JOURNAL_HEADER_SIZE ((long long)sizeof(JournalHeader))
+
+/**
+ * Internal helper: Writes the header with the given clean flag
+ */
+static void journal_write_header(Journal* journal, int clean) {
+    if (journal->file == NULL) {
+        return;
+    }
+    JournalHeader header;
+    memcpy(header.magic, journal_magic, 4);
+    header.version = JOURNAL_VERSION;
+    header.entry_size = (uint32_t)sizeof(JournalEntry);
+    header.clean = (uint32_t)clean;
+    header.total = journal->total;
+    header.cursor = journal->cursor;
+    header.floor = journal->floor;
+    header.limit = journal->limit;
+    if (journal_seek(journal->file, 0) != 0 ||
+        fwrite(&header, sizeof(header), 1, journal->file) != 1) {
+        return;
+    }
+    fflush(journal->file);
+}
+
+/**
+ * Internal helper: Copies a run of history entries between ring and file
+ * The window slice [k, k + n) may wrap around the ring end and the file
+ * ring end, so it is copied in up to three runs
+ * 
+ * @param write: 1 = ring -> file, 0 = file -> ring
+ * @return: 1 on success, 0 on I/O failure
+ */
+static int journal_transfer(Journal* journal, int k, int n, int write) {
+    if (journal->file == NULL) {
+        return 0;
+    }
+
+    long long index = journal->base + k;
+    while (n > 0) {
+        int slot = (journal->head + k) % journal->capacity;
+        long long file_slot = index % journal->limit;
+        int run = journal->capacity - slot;
+        if (run > n) {
+            run = n;
+        }
+        if (run > journal->limit - file_slot) {
+            run = (int)(journal->limit - file_slot);
+        }
+
+        long long offset = JOURNAL_HEADER_SIZE + file_slot * (long long)sizeof(JournalEntry);
+        if (journal_seek(journal->file, offset) != 0) {
+            return 0;
+        }
+        size_t moved = write ? fwrite(&journal->ring[slot], sizeof(JournalEntry), run, journal->file)
+                             : fread(&journal->ring[slot], sizeof(JournalEntry), run, journal->file);
+        if (moved != (size_t)run) {
+            return 0;
+        }
+
+        k += run;
+        index += run;
+        n -= run;
+    }
+    return 1;
+}
+
+/**
+ * Internal helper: Moves the n oldest windowed entries out to the file
+ * Without a backing file they are dropped and the history floor rises
+ */
+static void journal_spill_oldest(Journal* journal, int n) {
+    journal_transfer(journal, 0, n, 1);
+    journal->head = (journal->head + n) % journal->capacity;
+    journal->base += n;
+    journal->length -= n;
+}
+
+/**
+ * Internal helper: Moves the n newest windowed entries out to the file
+ * Without a backing file the redo tail is dropped
+ */
+static void journal_spill_newest(Journal* journal, int n) {
+    if (!journal_transfer(journal, journal->length - n, n, 1)) {
+        journal->total = journal->base + journal->length - n;
+    }
+    journal->length -= n;
+}
+
+/**
+ * Internal helper: Makes history entry index part of the window
+ * Loads half a ring of entries in the direction of travel
+ * 
+ * @return: 1 if the entry is windowed, 0 if it is not available
+ */
+static int journal_window_fetch(Journal* journal, long long index) {
+    if (index < journal->floor || index >= journal->total) {
+        return 0;
+    }
+    if (index >= journal->base && index < journal->base + journal->length) {
+        return 1;
+    }
+    if (journal->file == NULL) {
+        return 0; // Entry was dropped
+    }
+
+    int block = journal->capacity / 2;
+    if (block < 1) {
+        block = 1;
+    }
+
+    if (index < journal->base) {
+        // Walking back: make room at the new end, then read the older block
+        long long start = index + 1 - block;
+        if (start < journal->floor) {
+            start = journal->floor;
+        }
+        if (journal->base - start > journal->capacity) {
+            // Far jump: restart the window at the target block
+            journal_spill_newest(journal, journal->length);
+            journal->base = index + 1;
+            journal->head = 0;
+        }
+        int n = (int)(journal->base - start);
+        if (journal->length + n > journal->capacity) {
+            journal_spill_newest(journal, journal->length + n - journal->capacity);
+        }
+        journal->head = (journal->head - n + journal->capacity) % journal->capacity;
+        journal->base -= n;
+        journal->length += n;
+        if (!journal_transfer(journal, 0, n, 0)) {
+            journal->head = (journal->head + n) % journal->capacity;
+            journal->base += n;
+            journal->length -= n;
+            return 0;
+        }
+    } else {
+        // Walking forward: make room at the old end, then read the newer block
+        long long end = index + block;
+        if (end > journal->total) {
+            end = journal->total;
+        }
+        if (end - (journal->base + journal->length) > journal->capacity) {
+            journal_spill_oldest(journal, journal->length);
+            journal->base = index;
+            journal->head = 0;
+        }
+        int n = (int)(end - (journal->base + journal->length));
+        if (journal->length + n > journal->capacity) {
+            journal_spill_oldest(journal, journal->length + n - journal->capacity);
+        }
+        int k = journal->length;
+        journal->length += n;
+        if (!journal_transfer(journal, k, n, 0)) {
+            journal->length -= n;
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * Internal helper: Windowed entry for a history index (must be fetched)
+ */
+static JournalEntry* journal_at(Journal* journal, long long index) {
+    int k = (int)(index - journal->base);
+    return &journal->ring[(journal->head + k) % journal->capacity];
+}
+
+/**
+ * Opens a journal, restoring the history of the last clean exit
+ * Time Complexity: O(capacity)
+ * 
+ * @param journal: Pointer to journal to initialize
+ * @param path: Backing file path
+ * @param capacity: Ring capacity (<= 0 -> JOURNAL_DEFAULT_CAPACITY)
+ * @return: 1 if the backing file is usable, 0 otherwise
+ */
+int journal_open(Journal* journal, const char* path, int capacity) {
+    if (journal == NULL) {
+        return 0;
+    }
+
+    journal->capacity = (capacity > 0) ? capacity : JOURNAL_DEFAULT_CAPACITY;
+    journal->limit = (journal->capacity > JOURNAL_HISTORY_LIMIT) ? journal->capacity
+                                                                   : JOURNAL_HISTORY_LIMIT;
+    journal->head = 0;
+    journal->length = 0;
+    journal->base = 0;
+    journal->total = 0;
+    journal->cursor = 0;
+    journal->floor = 0;
+    journal->file = NULL;
+    journal->path[0] = '\0';
+
+    journal->ring = (JournalEntry*)malloc((size_t)journal->capacity * sizeof(JournalEntry));
+    if (journal->ring == NULL) {
+        journal->capacity = 0;
+        return 0; // Memory allocation failed - journal disabled
+    }
+
+    if (path == NULL || strlen(path) >= sizeof(journal->path)) {
+        return 0;
+    }
+    strcpy(journal->path, path);
+
+    // Resume a cleanly closed history, otherwise start a new one
+    JournalHeader header;
+    journal->file = fopen(path, "r+b");
+    if (journal->file != NULL &&
+        fread(&header, sizeof(header), 1, journal->file) == 1 &&
+        memcmp(header.magic, journal_magic, 4) == 0 &&
+        header.version == JOURNAL_VERSION &&
+        header.entry_size == sizeof(JournalEntry) &&
+        header.clean == 1 &&
+        header.limit == journal->limit &&
+        header.floor >= 0 && header.floor <= header.cursor &&
+        header.cursor <= header.total && header.total - header.floor <= header.limit) {
+        journal->total = header.total;
+        journal->cursor = header.cursor;
+        journal->floor = header.floor;
+        // Start with the window centred on the cursor (undo and redo both ready)
+        journal->base = journal->cursor - journal->capacity / 2;
+        if (journal->base < journal->floor) {
+            journal->base = journal->floor;
+        }
+        long long available = journal->total - journal->base;
+        journal->length = (int)(available < journal->capacity ? available : journal->capacity);
+        if (!journal_transfer(journal, 0, journal->length, 0)) {
+            journal->total = 0;
+            journal->cursor = 0;
+            journal->floor = 0;
+            journal->base = 0;
+            journal->length = 0;
+        }
+    } else {
+        if (journal->file != NULL) {
+            fclose(journal->file);
+        }
+        journal->file = fopen(path, "w+b");
+    }
+
+    if (journal->file == NULL) {
+        return 0;
+    }
+
+    // Dirty until journal_close: a crash discards this history
+    journal_write_header(journal, 0);
+    return 1;
+}
+
+/**
+ * Internal helper: Appends an entry after the cursor, dropping any redo tail
+ * Time Complexity: O(1) amortized
+ */
+static void journal_record(Journal* journal, const JournalEntry* entry) {
+    if (journal == NULL || journal->ring == NULL) {
+        return;
+    }
+
+    // New operation invalidates the redo tail
+    journal->total = journal->cursor;
+    if (journal->cursor < journal->base ||
+        journal->cursor > journal->base + journal->length) {
+        // Window does not touch the cursor: restart it there
+        journal_spill_oldest(journal, journal->length);
+        journal->base = journal->cursor;
+        journal->head = 0;
+    } else {
+        journal->length = (int)(journal->cursor - journal->base);
+    }
+
+    if (journal->length == journal->capacity) {
+        int half = journal->capacity / 2;
+        journal_spill_oldest(journal, half > 0 ? half : 1);
+    }
+
+    int slot = (journal->head + journal->length) % journal->capacity;
+    journal->ring[slot] = *entry;
+    journal->length++;
+    journal->total++;
+    journal->cursor++;
+
+    // The file ring now overwrites the oldest entry
+    if (journal->total - journal->floor > journal->limit) {
+        journal->floor = journal->total - journal->limit;
+    }
+}
+
+/**
+ * Records a booked appointment
+ * Time Complexity: O(1) amortized
+ * 
+ * @param journal: Pointer to journal
+ * @param appointment: Appointment that was created
+ */
+void journal_record_create(Journal* journal, const Appointment* appointment) {
+    if (appointment == NULL) {
+        return;
+    }
+    reserve_appointment_id(appointment->appointment_id); // IDs may be entered by the user
+    wal_log_appointment_create(appointment);
+    JournalEntry entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.type = JOURNAL_CREATE_APPOINTMENT;
+    entry.data.appointment = *appointment;
+    journal_record(journal, &entry);
+}
+
+/**
+ * Records a cancelled appointment
+ * Time Complexity: O(1) amortized
+ * 
+ * @param journal: Pointer to journal
+ * @param appointment: Appointment that was cancelled
+ */
+void journal_record_cancel(Journal* journal, const Appointment* appointment) {
+    if (appointment == NULL) {
+        return;
+    }
+    wal_log_appointment_cancel(appointment->appointment_id);
+    JournalEntry entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.type = JOURNAL_CANCEL_APPOINTMENT;
+    entry.data.appointment = *appointment;
+    journal_record(journal, &entry);
+}
+
+/**
+ * Records a rescheduled appointment
+ * Time Complexity: O(1) amortized
+ * 
+ * @param journal: Pointer to journal
+ * @param appointment: Appointment with its new times
+ * @param old_start_time: Start time before the change
+ * @param old_end_time: End time before the change
+ */
+void journal_record_reschedule(Journal* journal, const Appointment* appointment,
+                               int old_start_time, int old_end_time) {
+    if (appointment == NULL) {
+        return;
+    }
+    wal_log_appointment_reschedule(appointment);
+    JournalEntry entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.type = JOURNAL_RESCHEDULE_APPOINTMENT;
+    entry.old_start_time = old_start_time;
+    entry.old_end_time = old_end_time;
+    entry.data.appointment = *appointment;
+    journal_record(journal, &entry);
+}
+
+/**
+ * Records an added patient
+ * Time Complexity: O(1) amortized
+ * 
+ * @param journal: Pointer to journal
+ * @param patient: Patient that was added
+ */
+void journal_record_add_patient(Journal* journal, const Patient* patient) {
+    if (patient == NULL) {
+        return;
+    }
+    reserve_patient_id(patient->id);
+    wal_log_patient_add(patient);
+    JournalEntry entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.type = JOURNAL_ADD_PATIENT;
+    entry.data.patient = *patient;
+    journal_record(journal, &entry);
+}
+
+/**
+ * Records an added doctor
+ * Time Complexity: O(1) amortized
+ * 
+ * @param journal: Pointer to journal
+ * @param doctor: Doctor that was added
+ */
+void journal_record_add_doctor(Journal* journal, const Doctor* doctor) {
+    if (doctor == NULL) {
+        return;
+    }
+    reserve_doctor_id(doctor->id);
+    wal_log_doctor_add(doctor);
+    JournalEntry entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.type = JOURNAL_ADD_DOCTOR;
+    entry.data.doctor = *doctor;
+    journal_record(journal, &entry);
+}
+
+/**
+ * Internal helper: Inserts a copy of an appointment (AVL + array)
+ * The heap is rebuilt once per undo/redo call
+ */
+static int journal_insert_appointment(const JournalContext* ctx, const Appointment* data) {
+    if (appointment_vector_find(ctx->appointments, data->appointment_id) >= 0) {
+        return 0;
+    }
+
+    Appointment* appointment = create_appointment(data->appointment_id, data->patient_id,
+                                                  data->doctor_id, data->start_time,
+                                                  data->end_time);
+    if (appointment == NULL) {
+        return 0;
+    }
+    if (!appointment_vector_push(ctx->appointments, appointment)) {
+        free_appointment(appointment);
+        return 0;
+    }
+    if (!avl_insert(ctx->avl_tree, appointment, appointment->doctor_id)) {
+        appointment_vector_remove(ctx->appointments, ctx->appointments->count - 1); // Time slot taken
+        free_appointment(appointment);
+        return 0;
+    }
+    wal_log_appointment_create(appointment);
+    return 1;
+}
+
+/**
+ * Internal helper: Removes and frees an appointment (AVL + array)
+ */
+static int journal_remove_appointment(const JournalContext* ctx, int appointment_id) {
+    int index = appointment_vector_find(ctx->appointments, appointment_id);
+    if (index < 0) {
+        return 0;
+    }
+
+    Appointment* appointment = appointment_vector_remove(ctx->appointments, index);
+    avl_delete_appointment(ctx->avl_tree, appointment);
+
+    wal_log_appointment_cancel(appointment_id);
+    free_appointment(appointment);
+    return 1;
+}
+
+/**
+ * Internal helper: Moves an appointment to new times (AVL is keyed by time)
+ * Restores the old times if the new slot conflicts
+ */
+static int journal_move_appointment(const JournalContext* ctx, int appointment_id,
+                                    int start_time, int end_time) {
+    int index = appointment_vector_find(ctx->appointments, appointment_id);
+    if (index < 0) {
+        return 0;
+    }
+
+    Appointment* appointment = ctx->appointments->items[index];
+    if (avl_delete_appointment(ctx->avl_tree, appointment) == NULL) {
+        return 0;
+    }
+
+    int old_start_time = appointment->start_time;
+    int old_end_time = appointment->end_time;
+    appointment->start_time = start_time;
+    appointment->end_time = end_time;
+    if (avl_insert(ctx->avl_tree, appointment, appointment->doctor_id)) {
+        wal_log_appointment_reschedule(appointment);
+        return 1;
+    }
+
+    appointment->start_time = old_start_time;
+    appointment->end_time = old_end_time;
+    avl_insert(ctx->avl_tree, appointment, appointment->doctor_id);
+    return 0;
+}
+
+/**
+ * Internal helper: Adds a copy of a patient
+ */
+static int journal_insert_patient(const JournalContext* ctx, const Patient* data) {
+    Patient* existing;
+    if (registry_lookup_patient(ctx->registry, ctx->patients, data->id, &existing) != 0) {
+        return 0; // ID already in use, or the snapshot cannot be read to tell
+    }
+    Patient* patient = create_patient(data->id, data->name, data->age);
+    if (patient == NULL) {
+        return 0;
+    }
+    if (!patient_vector_push(ctx->patients, patient)) {
+        free_patient(patient);
+        return 0;
+    }
+    wal_log_patient_add(patient);
+    return 1;
+}
+
+/**
+ * Internal helper: Removes and frees a patient (last slot checked first)
+ * A patient that only exists in the registry's snapshot is hidden instead
+ */
+static int journal_remove_patient(const JournalContext* ctx, int id) {
+    int count = ctx->patients->count;
+    for (int i = count - 1; i >= 0; i--) {
+        if (ctx->patients->items[i] != NULL && ctx->patients->items[i]->id == id) {
+            // An older copy may be in the snapshot: hide it first, fail if that cannot be told
+            if (registry_hide_patient(ctx->registry, id) < 0) {
+                return 0;
+            }
+            free_patient(ctx->patients->items[i]);
+            ctx->patients->items[i] = ctx->patients->items[count - 1];
+            ctx->patients->items[count - 1] = NULL;
+            ctx->patients->count--;
+            wal_log_patient_remove(id);
+            return 1;
+        }
+    }
+    if (registry_hide_patient(ctx->registry, id) > 0) {
+        wal_log_patient_remove(id);
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Internal helper: Adds a copy of a doctor
+ */
+static int journal_insert_doctor(const JournalContext* ctx, const Doctor* data) {
+    Doctor* existing;
+    if (registry_lookup_doctor(ctx->registry, ctx->doctors, data->id, &existing) != 0) {
+        return 0; // ID already in use, or the snapshot cannot be read to tell
+    }
+    Doctor* doctor = create_doctor(data->id, data->name, data->department);
+    if (doctor == NULL) {
+        return 0;
+    }
+    if (!doctor_vector_push(ctx->doctors, doctor)) {
+        free_doctor(doctor);
+        return 0;
+    }
+    wal_log_doctor_add(doctor);
+    return 1;
+}
+
+/**
+ * Internal helper: Removes and frees a doctor (last slot checked first)
+ * A doctor that only exists in the registry's snapshot is hidden instead
+ */
+static int journal_remove_doctor(const JournalContext* ctx, int id) {
+    int count = ctx->doctors->count;
+    for (int i = count - 1; i >= 0; i--) {
+        if (ctx->doctors->items[i] != NULL && ctx->doctors->items[i]->id == id) {
+            // An older copy may be in the snapshot: hide it first, fail if that cannot be told
+            if (registry_hide_doctor(ctx->registry, id) < 0) {
+                return 0;
+            }
+            free_doctor(ctx->doctors->items[i]);
+            ctx->doctors->items[i] = ctx->doctors->items[count - 1];
+            ctx->doctors->items[count - 1] = NULL;
+            ctx->doctors->count--;
+            wal_log_doctor_remove(id);
+            return 1;
+        }
+    }
+    if (registry_hide_doctor(ctx->registry, id) > 0) {
+        wal_log_doctor_remove(id);
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Internal helper: Applies an entry forward (redo) or backward (undo)
+ * @return: 1 on success, 0 if the structures do not allow it
+ */
+static int journal_apply(const JournalContext* ctx, const JournalEntry* entry, int forward) {
+    const Appointment* appointment = &entry->data.appointment;
+
+    switch (entry->type) {
+        case JOURNAL_CREATE_APPOINTMENT:
+            return forward ? journal_insert_appointment(ctx, appointment)
+                           : journal_remove_appointment(ctx, appointment->appointment_id);
+        case JOURNAL_CANCEL_APPOINTMENT:
+            return forward ? journal_remove_appointment(ctx, appointment->appointment_id)
+                           : journal_insert_appointment(ctx, appointment);
+        case JOURNAL_RESCHEDULE_APPOINTMENT:
+            return forward ? journal_move_appointment(ctx, appointment->appointment_id,
+                                                      appointment->start_time, appointment->end_time)
+                           : journal_move_appointment(ctx, appointment->appointment_id,
+                                                      entry->old_start_time, entry->old_end_time);
+        case JOURNAL_ADD_PATIENT:
+            return forward ? journal_insert_patient(ctx, &entry->data.patient)
+                           : journal_remove_patient(ctx, entry->data.patient.id);
+        case JOURNAL_ADD_DOCTOR:
+            return forward ? journal_insert_doctor(ctx, &entry->data.doctor)
+                           : journal_remove_doctor(ctx, entry->data.doctor.id);
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Internal helper: Validates the context pointers
+ */
+static int journal_context_valid(const JournalContext* ctx) {
+    return ctx != NULL && ctx->avl_tree != NULL && ctx->heap != NULL &&
+           ctx->patients != NULL && ctx->doctors != NULL && ctx->appointments != NULL;
+}
+
+/**
+ * Applies one entry to the structures without recording it
+ * The heap is not touched; callers rebuild it after a batch
+ * Time Complexity: O(log n) expected (ID index + AVL), O(n) for the first
+ * lookup after a bulk load
+ * 
+ * @param context: Structures to modify
+ * @param entry: Entry to apply
+ * @param forward: 1 = perform the operation, 0 = revert it
+ * @return: 1 on success, 0 if the structures do not allow it
+ */
+int journal_apply_entry(const JournalContext* context, const JournalEntry* entry, int forward) {
+    if (!journal_context_valid(context) || entry == NULL) {
+        return 0;
+    }
+    return journal_apply(context, entry, forward);
+}
+
+/**
+ * Undoes up to count operations, most recent first
+ * The heap is rebuilt once at the end instead of per entry
+ * Time Complexity: O(k) amortized journal work + O(n) heap rebuild
+ * 
+ * @param journal: Pointer to journal
+ * @param context: Structures to modify
+ * @param count: Maximum number of operations to undo
+ * @param last: Receives the last undone entry (may be NULL)
+ * @return: Number of operations undone
+ */
+int journal_undo(Journal* journal, const JournalContext* context, int count, JournalEntry* last) {
+    if (journal == NULL || journal->ring == NULL || !journal_context_valid(context)) {
+        return 0;
+    }
+
+    int done = 0;
+    while (done < count && journal->cursor > journal->floor) {
+        if (!journal_window_fetch(journal, journal->cursor - 1)) {
+            break; // Entry no longer available
+        }
+        JournalEntry* entry = journal_at(journal, journal->cursor - 1);
+        if (!journal_apply(context, entry, 0)) {
+            break;
+        }
+        if (last != NULL) {
+            *last = *entry;
+        }
+        journal->cursor--;
+        done++;
+    }
+
+    if (done > 0) {
+        heap_build(context->heap, context->appointments->items, context->appointments->count);
+    }
+    return done;
+}
+
+/**
+ * Re-applies up to count undone operations, oldest first
+ * Time Complexity: O(k) amortized journal work + O(n) heap rebuild
+ * 
+ * @param journal: Pointer to journal
+ * @param context: Structures to modify
+ * @param count: Maximum number of operations to redo
+ * @param last: Receives the last redone entry (may be NULL)
+ * @return: Number of operations redone
+ */
+int journal_redo(Journal* journal, const JournalContext* context, int count, JournalEntry* last) {
+    if (journal == NULL || journal->ring == NULL || !journal_context_valid(context)) {
+        return 0;
+    }
+
+    int done = 0;
+    while (done < count && journal->cursor < journal->total) {
+        if (!journal_window_fetch(journal, journal->cursor)) {
+            break;
+        }
+        JournalEntry* entry = journal_at(journal, journal->cursor);
+        if (!journal_apply(context, entry, 1)) {
+            break;
+        }
+        if (last != NULL) {
+            *last = *entry;
+        }
+        journal->cursor++;
+        done++;
+    }
+
+    if (done > 0) {
+        heap_build(context->heap, context->appointments->items, context->appointments->count);
+    }
+    return done;
+}
+
+/**
+ * Returns the number of undoable operations
+ * Entries overwritten in the file ring (or, without a backing file, pushed
+ * out of the memory ring) are not counted
+ * Time Complexity: O(1)
+ * 
+ * @param journal: Pointer to journal
+ * @return: Applied entry count
+ */
+long long journal_undo_count(const Journal* journal) {
+    if (journal == NULL || journal->ring == NULL) {
+        return 0;
+    }
+    long long floor = (journal->file != NULL || journal->base < journal->floor) ? journal->floor
+                                                                                : journal->base;
+    return (journal->cursor > floor) ? journal->cursor - floor : 0;
+}
+
+/**
+ * Returns the number of redoable operations
+ * Time Complexity: O(1)
+ * 
+ * @param journal: Pointer to journal
+ * @return: Undone entry count
+ */
+long long journal_redo_count(const Journal* journal) {
+    if (journal == NULL) {
+        return 0;
+    }
+    return journal->total - journal->cursor;
+}
+
+/**
+ * Formats a short description of an entry
+ * 
+ * @param entry: Journal entry
+ * @param buffer: Output buffer
+ * @param size: Buffer size
+ */
+void journal_describe(const JournalEntry* entry, char* buffer, int size) {
+    if (buffer == NULL || size <= 0) {
+        return;
+    }
+    if (entry == NULL) {
+        buffer[0] = '\0';
+        return;
+    }
+
+    switch (entry->type) {
+        case JOURNAL_CREATE_APPOINTMENT:
+            snprintf(buffer, size, "Randevu olusturma (Randevu ID: %d)",
+                     entry->data.appointment.appointment_id);
+            break;
+        case JOURNAL_CANCEL_APPOINTMENT:
+            snprintf(buffer, size, "Randevu iptali (Randevu ID: %d)",
+                     entry->data.appointment.appointment_id);
+            break;
+        case JOURNAL_RESCHEDULE_APPOINTMENT:
+            snprintf(buffer, size, "Randevu saat degisikligi (Randevu ID: %d)",
+                     entry->data.appointment.appointment_id);
+            break;
+        case JOURNAL_ADD_PATIENT:
+            snprintf(buffer, size, "Hasta ekleme (Hasta ID: %d)", entry->data.patient.id);
+            break;
+        case JOURNAL_ADD_DOCTOR:
+            snprintf(buffer, size, "Doktor ekleme (Doktor ID: %d)", entry->data.doctor.id);
+            break;
+        default:
+            snprintf(buffer, size, "Bilinmeyen islem");
+            break;
+    }
+}
+
+/**
+ * Writes the window and a clean header, then frees the journal
+ * Time Complexity: O(capacity)
+ * 
+ * @param journal: Pointer to journal to close
+ */
+void journal_close(Journal* journal) {
+    if (journal == NULL) {
+        return;
+    }
+
+    if (journal->file != NULL) {
+        if (journal_transfer(journal, 0, journal->length, 1)) {
+            journal_write_header(journal, 1);
+        }
+        fclose(journal->file);
+        journal->file = NULL;
+    }
+
+    free(journal->ring);
+    journal->ring = NULL;
+    journal->capacity = 0;
+    journal->length = 0;
+    journal->base = 0;
+    journal->total = 0;
+    journal->cursor = 0;
+    journal->floor = 0;
+}
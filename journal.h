@@ -0,0 +1,231 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "patient.h"
+#include "doctor.h"
+#include "appointment.h"
+#include "avl.h"
+#include "heap.h"
+#include "vector.h"
+#include "registry.h"
+
+/**
+ * Operation Journal (multi-operation undo/redo)
+ *
+ * Linear history of the mutations applied to patients, doctors and
+ * appointments. Each entry stores enough data to apply the operation in
+ * either direction:
+ * - create appointment  <-> remove it
+ * - cancel appointment  <-> insert it back
+ * - reschedule          <-> restore the old times
+ * - add patient/doctor  <-> remove the record
+ *
+ * A cursor splits the history into applied (undoable) and undone
+ * (redoable) entries; recording a new operation discards the redo tail.
+ *
+ * Memory is bounded: only a window of JOURNAL_DEFAULT_CAPACITY entries is
+ * held in a fixed-size ring. Entries that fall out of the window are
+ * spilled to a backing file and read back in blocks when undo/redo walks
+ * past the window. The file is itself a ring of JOURNAL_HISTORY_LIMIT
+ * entries, so only that many of the most recent operations can be undone.
+ *
+ * The backing file also keeps the history across restarts. It is marked
+ * clean only by journal_close at exit; after a crash the in-memory window
+ * was never written, so the history is discarded (the data itself is
+ * recovered from the write-ahead log).
+ *
+ * Every change the journal records, undoes or redoes is also appended to
+ * the write-ahead log (wal.h) as its net effect.
+ */
+
+/**
+ * Default ring capacity (entries held in memory)
+ */
+#define JOURNAL_DEFAULT_CAPACITY 1024
+
+/**
+ * Entries kept in the backing file (about 11 MB); older ones are overwritten
+ */
+#define JOURNAL_HISTORY_LIMIT 65536
+
+/**
+ * Default backing file path
+ */
+#define JOURNAL_DEFAULT_PATH "data/journal.bin"
+
+/**
+ * Journaled operation types
+ */
+typedef enum {
+    JOURNAL_CREATE_APPOINTMENT = 1,      // Appointment booked
+    JOURNAL_CANCEL_APPOINTMENT = 2,      // Appointment cancelled
+    JOURNAL_RESCHEDULE_APPOINTMENT = 3,  // Appointment times changed
+    JOURNAL_ADD_PATIENT = 4,             // Patient added
+    JOURNAL_ADD_DOCTOR = 5               // Doctor added
+} JournalOpType;
+
+/**
+ * Journal Entry
+ * Records are stored by value, the journal never points into live data
+ */
+typedef struct {
+    JournalOpType type;           // Operation type
+    int old_start_time;           // Reschedule: start time before the change
+    int old_end_time;             // Reschedule: end time before the change
+    union {
+        Appointment appointment;  // Create/cancel: the appointment; reschedule: new times
+        Patient patient;          // Add patient
+        Doctor doctor;            // Add doctor
+    } data;
+} JournalEntry;
+
+/**
+ * Structures the journal operates on
+ * Mirrors the record vectors and indexes the CLI/GUI work with
+ * With a registry, patients and doctors are looked up through it and the
+ * vectors only hold records added since the snapshot (registry.h)
+ */
+typedef struct {
+    AVLTree* avl_tree;                // Appointment index
+    MinHeap* heap;                    // Earliest appointment heap (rebuilt after undo/redo)
+    PatientVector* patients;          // Patients
+    DoctorVector* doctors;            // Doctors
+    AppointmentVector* appointments;  // Appointments
+    Registry* registry;               // Lazily loaded patients/doctors, NULL if all are in the vectors
+} JournalContext;
+
+/**
+ * Journal Structure
+ */
+typedef struct {
+    JournalEntry* ring;      // Fixed-size ring holding the in-memory window
+    int capacity;            // Ring capacity
+    int head;                // Ring slot of the oldest windowed entry
+    int length;              // Entries in the window
+    long long base;          // History index of the oldest windowed entry
+    long long total;         // History length (applied + redoable)
+    long long cursor;        // Number of applied entries
+    long long floor;         // History index of the oldest undoable entry
+    long long limit;         // Entries the backing file holds (>= capacity)
+    FILE* file;              // Backing file (spilled entries), NULL if unavailable
+    char path[512];          // Backing file path
+} Journal;
+
+/**
+ * Journal Operations
+ * Time Complexity: O(1) amortized record/undo/redo per entry (block I/O
+ * when crossing the window), plus one O(n) heap rebuild per undo/redo call
+ */
+
+/**
+ * Opens a journal, restoring the history of the last clean exit
+ * Without a usable backing file the journal still works in memory, but
+ * entries pushed out of the ring are then lost
+ * @param journal: Pointer to journal to initialize
+ * @param path: Backing file path
+ * @param capacity: Ring capacity (<= 0 -> JOURNAL_DEFAULT_CAPACITY)
+ * @return: 1 if the backing file is usable, 0 otherwise
+ */
+int journal_open(Journal* journal, const char* path, int capacity);
+
+/**
+ * Records a booked appointment
+ * @param journal: Pointer to journal
+ * @param appointment: Appointment that was created
+ */
+void journal_record_create(Journal* journal, const Appointment* appointment);
+
+/**
+ * Records a cancelled appointment
+ * @param journal: Pointer to journal
+ * @param appointment: Appointment that was cancelled (copied)
+ */
+void journal_record_cancel(Journal* journal, const Appointment* appointment);
+
+/**
+ * Records a rescheduled appointment
+ * @param journal: Pointer to journal
+ * @param appointment: Appointment with its new times
+ * @param old_start_time: Start time before the change
+ * @param old_end_time: End time before the change
+ */
+void journal_record_reschedule(Journal* journal, const Appointment* appointment,
+                               int old_start_time, int old_end_time);
+
+/**
+ * Records an added patient
+ * @param journal: Pointer to journal
+ * @param patient: Patient that was added (copied)
+ */
+void journal_record_add_patient(Journal* journal, const Patient* patient);
+
+/**
+ * Records an added doctor
+ * @param journal: Pointer to journal
+ * @param doctor: Doctor that was added (copied)
+ */
+void journal_record_add_doctor(Journal* journal, const Doctor* doctor);
+
+/**
+ * Applies one entry to the structures without recording it
+ * Used by write-ahead log replay; the heap is left for the caller to rebuild
+ * @param context: Structures to modify
+ * @param entry: Entry to apply
+ * @param forward: 1 = perform the operation, 0 = revert it
+ * @return: 1 on success, 0 if the structures do not allow it
+ */
+int journal_apply_entry(const JournalContext* context, const JournalEntry* entry, int forward);
+
+/**
+ * Undoes up to count operations, most recent first
+ * Stops early if an operation cannot be reverted
+ * @param journal: Pointer to journal
+ * @param context: Structures to modify
+ * @param count: Maximum number of operations to undo
+ * @param last: Receives the last undone entry (may be NULL)
+ * @return: Number of operations undone
+ */
+int journal_undo(Journal* journal, const JournalContext* context, int count, JournalEntry* last);
+
+/**
+ * Re-applies up to count undone operations, oldest first
+ * Stops early if an operation cannot be applied
+ * @param journal: Pointer to journal
+ * @param context: Structures to modify
+ * @param count: Maximum number of operations to redo
+ * @param last: Receives the last redone entry (may be NULL)
+ * @return: Number of operations redone
+ */
+int journal_redo(Journal* journal, const JournalContext* context, int count, JournalEntry* last);
+
+/**
+ * Returns the number of undoable operations
+ * @param journal: Pointer to journal
+ * @return: Applied entry count
+ */
+long long journal_undo_count(const Journal* journal);
+
+/**
+ * Returns the number of redoable operations
+ * @param journal: Pointer to journal
+ * @return: Undone entry count
+ */
+long long journal_redo_count(const Journal* journal);
+
+/**
+ * Formats a short description of an entry
+ * @param entry: Journal entry
+ * @param buffer: Output buffer
+ * @param size: Buffer size
+ */
+void journal_describe(const JournalEntry* entry, char* buffer, int size);
+
+/**
+ * Writes the window and a clean header, then frees the journal
+ * @param journal: Pointer to journal to close
+ */
+void journal_close(Journal* journal);
+
+#endif // JOURNAL_H
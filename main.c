@@ -5,8 +5,17 @@
  * 
  * Bu program çeşitli veri yapıları kullanarak hastane randevularını yönetir:
  * - AVL Ağacı: Verimli randevu saklama ve çakışma tespiti
- * - Kuyruk: Dolu doktorlar için bekleme listesi
- * - Yığın: İptal edilen randevular için geri alma sistemi
+ * - Bekleme Listesi: Dolu doktorlar için FIFO veya triyaj öncelikli liste
+ * - İşlem Günlüğü: Çok adımlı geri alma/yineleme (halka tampon + disk)
+ * - Ön-yazım Günlüğü: Her değişiklik tek kayıt olarak eklenir, grup commit ile
+ *   toplu olarak fsync edilir (çökmeye dayanıklı)
+ * - Kontrol Noktası: Arka planda CSV ve ikili anlık görüntü yazılır, günlük kısaltılır
+ * - İkili Anlık Görüntü: Açılışta CSV yerine sabit boyutlu kayıtlar okunur
+ * - Bütünlük Denetimi: Yüklenen kayıtlarda tekrarlanan ID ve olmayan hasta/doktor (O(n))
+ * - Tembel Yükleme: Hasta/doktor kayıtları açılışta değil, ID ile ilk istendiğinde
+ *   anlık görüntünün sıralı dizininden okunur ve küçük bir LRU önbellekte tutulur
+ * - Toplu İçe Aktarma: Büyük randevu CSV'leri menüsüz, akışla ve toplu doğrulanıp
+ *   toplu commit edilerek takvime eklenir
  * - Min-Heap: En erken randevuları verimli bulma
  * - Sıralama: Randevu listeleme için MergeSort ve HeapSort
  * - Binary Search: Hasta, doktor ve randevu araması
@@ -23,13 +32,146 @@
 #include "appointment.h"
 #include "avl.h"
 #include "heap.h"
-#include "queue.h"
-#include "stack.h"
+#include "waitlist.h"
+#include "journal.h"
 #include "file_io.h"
+#include "statelog.h"
+#include "wal.h"
+#include "checkpoint.h"
+#include "thread.h"
+#include "snapshot.h"
+#include "archive.h"
+#include "integrity.h"
+#include "registry.h"
+#include "import.h"
+#include "idalloc.h"
+#include "scheduler.h"
 #include "sort_search.h"
 #include "menu.h"
 #include "gui.h"
 
+/**
+ * Tembel yüklemede çıkışta toplanan tam kayıt listesi
+ * (bellek yetmezse failed işaretlenir; ziyaretçinin durması hata sayılmaz)
+ */
+typedef struct {
+    PatientVector* patients;
+    DoctorVector* doctors;
+    int failed;
+} LazyCollection;
+
+/**
+ * Yardımcı Fonksiyon: Tembel yüklemede hastanın kopyasını vektöre ekler (PatientVisitor)
+ * Çıkışta tam kayıt listesi gerektiğinde kullanılır
+ */
+static int collect_patient(const Patient* patient, void* context) {
+    LazyCollection* collection = (LazyCollection*)context;
+    Patient* copy = create_patient(patient->id, patient->name, patient->age);
+    if (copy == NULL || !patient_vector_push(collection->patients, copy)) {
+        free_patient(copy);
+        collection->failed = 1;
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Yardımcı Fonksiyon: Tembel yüklemede doktorun kopyasını vektöre ekler (DoctorVisitor)
+ */
+static int collect_doctor(const Doctor* doctor, void* context) {
+    LazyCollection* collection = (LazyCollection*)context;
+    Doctor* copy = create_doctor(doctor->id, doctor->name, doctor->department);
+    if (copy == NULL || !doctor_vector_push(collection->doctors, copy)) {
+        free_doctor(copy);
+        collection->failed = 1;
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Yardımcı Fonksiyon: Toplu içe aktarmada her toplu commit sonrası ilerlemeyi yazar
+ * Aralık dolduysa arka planda kontrol noktası başlatır (günlük sınırsız büyümesin)
+ */
+static void print_import_progress(const ImportReport* report, void* context) {
+    (void)context;
+    double seconds = (double)report->elapsed_us / 1000000.0;
+    printf("\r  %lld satir islendi (%lld kabul, %lld red), %.0f satir/sn", report->rows,
+           report->accepted, report->rejected, seconds > 0 ? (double)report->rows / seconds : 0.0);
+    fflush(stdout);
+    checkpoint_maybe();
+}
+
+/**
+ * Yardımcı Fonksiyon: Arşiv sorgusunda eşleşen satırları CSV biçiminde yazar (ArchiveVisitor)
+ */
+static int print_archive_rows(const ArchiveBatch* batch, void* context) {
+    (void)context;
+    char start[6];
+    char end[6];
+    for (int i = 0; i < batch->count; i++) {
+        format_time_string(batch->start_time[i], start);
+        format_time_string(batch->end_time[i], end);
+        printf("%d,%d,%d,%s,%s\n", batch->appointment_id[i], batch->patient_id[i],
+               batch->doctor_id[i], start, end);
+    }
+    return 1;
+}
+
+/**
+ * Yardımcı Fonksiyon: --archive-query modu
+ * Sonraki argümanlar filtredir: doctor=N, from=HH:MM, to=HH:MM (hepsi isteğe bağlı)
+ * 
+ * @param argc: Argüman sayısı
+ * @param argv: Argümanlar
+ * @param first: İlk filtre argümanının indeksi
+ * @return: Çıkış kodu (0 başarılı)
+ */
+static int run_archive_query(int argc, char* argv[], int first) {
+    ArchiveQuery query;
+    archive_query_init(&query, ARCHIVE_COLUMN_ALL);
+
+    for (int i = first; i < argc && strncmp(argv[i], "--", 2) != 0; i++) {
+        const char* arg = argv[i];
+        if (strncmp(arg, "doctor=", 7) == 0) {
+            char* end = NULL;
+            long doctor_id = strtol(arg + 7, &end, 10);
+            if (end == arg + 7 || *end != '\0' || doctor_id <= 0 || doctor_id > 2147483647L) {
+                printf("Hata: Gecersiz doktor ID'si: %s\n", arg + 7);
+                return 1;
+            }
+            query.doctor_id = (int)doctor_id;
+        } else if (strncmp(arg, "from=", 5) == 0 || strncmp(arg, "to=", 3) == 0) {
+            int is_from = arg[0] == 'f';
+            const char* value = arg + (is_from ? 5 : 3);
+            int minutes = parse_time_string(value);
+            if (minutes < 0) {
+                printf("Hata: Gecersiz saat (SS:DD bekleniyor): %s\n", value);
+                return 1;
+            }
+            if (is_from) {
+                query.min_start_time = minutes;
+            } else {
+                query.max_start_time = minutes;
+            }
+        } else {
+            printf("Hata: Bilinmeyen sorgu filtresi: %s (doctor=N, from=SS:DD, to=SS:DD)\n", arg);
+            return 1;
+        }
+    }
+
+    printf("appointment_id,patient_id,doctor_id,start_time,end_time\n");
+    ArchiveScanReport report;
+    if (!archive_scan(ARCHIVE_DEFAULT_PATH, &query, print_archive_rows, NULL, &report)) {
+        printf("Hata: %s okunamadi veya bozuk (once --archive-csv calistirin).\n",
+               ARCHIVE_DEFAULT_PATH);
+        return 1;
+    }
+    printf("%lld randevu eslesti (%lld/%lld blok atlandi, %lld satir tarandi).\n",
+           report.rows_matched, report.blocks_skipped, report.blocks, report.rows_scanned);
+    return 0;
+}
+
 /**
  * Ana fonksiyon - Programın giriş noktası
  * Veri yapılarını başlatır ve CLI veya GUI sistemini başlatır
@@ -40,85 +182,333 @@ int main(int argc, char *argv[]) {
     printf("========================================\n");
     printf("Sistem baslatiliyor...\n\n");
 
+    // Yarim kalan kontrol noktasini tamamla veya at (veriler yuklenmeden once)
+    unsigned long long snapshot_lsn = checkpoint_recover(CHECKPOINT_DEFAULT_PATH, WAL_DEFAULT_PATH);
+
+    // Donusturme modlari: CSV <-> ikili anlik goruntu, CSV -> arsiv, arsiv sorgusu, sonra cik
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--import-csv") == 0) {
+            if (!snapshot_import_csv(SNAPSHOT_DEFAULT_PATH, snapshot_lsn, PATIENTS_CSV_PATH,
+                                     DOCTORS_CSV_PATH, APPOINTMENTS_CSV_PATH)) {
+                printf("Hata: CSV dosyalari %s dosyasina donusturulemedi.\n", SNAPSHOT_DEFAULT_PATH);
+                return 1;
+            }
+            // CSV'ler elle degistirilmis olabilir: sonraki acilista ID'ler yeniden taransin
+            remove(IDALLOC_DEFAULT_PATH);
+            printf("CSV dosyalari %s dosyasina donusturuldu.\n", SNAPSHOT_DEFAULT_PATH);
+            return 0;
+        }
+        if (strcmp(argv[i], "--export-csv") == 0) {
+            // Kontrol noktasindan eski bir anlik goruntu daha yeni CSV'lerin ustune yazilmamali
+            unsigned long long file_lsn = 0;
+            if (!snapshot_read_lsn(SNAPSHOT_DEFAULT_PATH, &file_lsn) || file_lsn != snapshot_lsn ||
+                !snapshot_export_csv(SNAPSHOT_DEFAULT_PATH, PATIENTS_CSV_PATH,
+                                     DOCTORS_CSV_PATH, APPOINTMENTS_CSV_PATH)) {
+                printf("Hata: %s gecersiz veya guncel degil, CSV dosyalari yazilmadi.\n",
+                       SNAPSHOT_DEFAULT_PATH);
+                return 1;
+            }
+            printf("%s CSV dosyalarina donusturuldu.\n", SNAPSHOT_DEFAULT_PATH);
+            return 0;
+        }
+        if (strcmp(argv[i], "--archive-csv") == 0) {
+            // Gecmis randevular icin sutunlu arsiv (CSV akisla okunur, bellege sigmasi gerekmez)
+            long long archived = 0;
+            if (!archive_write_csv(ARCHIVE_DEFAULT_PATH, APPOINTMENTS_CSV_PATH, &archived)) {
+                printf("Hata: %s dosyasi %s arsivine donusturulemedi.\n",
+                       APPOINTMENTS_CSV_PATH, ARCHIVE_DEFAULT_PATH);
+                return 1;
+            }
+            printf("%lld randevu %s arsivine yazildi.\n", archived, ARCHIVE_DEFAULT_PATH);
+            return 0;
+        }
+        if (strcmp(argv[i], "--archive-query") == 0) {
+            // Arsivde doktor/saat filtreli tarama (indeks sayesinde kesismeyen bloklar atlanir)
+            return run_archive_query(argc, argv, i + 1);
+        }
+    }
+
     // Veri yapilarini baslat
     AVLTree avl_tree;
     avl_init(&avl_tree);
 
     MinHeap heap;
-    if (!heap_init(&heap, MAX_RECORDS)) {
+    if (!heap_init(&heap, VECTOR_INITIAL_CAPACITY)) {
         printf("Hata: Heap baslatilamadi.\n");
         return 1;
     }
 
-    Queue queue;
-    queue_init(&queue);
+    Waitlist waitlist;
+    waitlist_init(&waitlist, WAITLIST_MODE_FIFO);
 
-    Stack stack;
-    stack_init(&stack);
+    // Veri vektorlerini baslat (sabit ust sinir yok, gerektikce buyur)
+    PatientVector patients;
+    DoctorVector doctors;
+    AppointmentVector appointments;
+    patient_vector_init(&patients);
+    doctor_vector_init(&doctors);
+    appointment_vector_init(&appointments);
 
-    // Veri dizilerini baslat
-    Patient* patients[MAX_RECORDS] = {0};
-    Doctor* doctors[MAX_RECORDS] = {0};
-    Appointment* appointments[MAX_RECORDS] = {0};
+    // Kalici ID ust siniri: varsa acilista kayitlari taramaya gerek kalmaz
+    int ids_loaded = idalloc_open(IDALLOC_DEFAULT_PATH);
 
-    int patient_count = 0;
-    int doctor_count = 0;
-    int appointment_count = 0;
-
-    // CSV dosyalarindan veri yukle
+    // Once ikili anlik goruntuden, yoksa veya guncel degilse CSV dosyalarindan yukle
     printf("Veriler yukleniyor...\n");
-    
-    patient_count = load_patients_from_csv("data/patients.csv", patients, MAX_RECORDS);
-    printf("  %d hasta yuklendi.\n", patient_count);
+    int loaded_from_csv = 0;
+
+    AppointmentVector tree_order; // Anlik goruntudeki AVL agaci sirasi (varsa)
+    appointment_vector_init(&tree_order);
+
+    // --lazy: hasta/doktorlar anlik goruntude kalir, ID ile istendikce okunur (yalnizca randevular
+    // yuklenir); vektorler bu durumda yalnizca anlik goruntuden sonra eklenen kayitlari tutar
+    int lazy_requested = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--lazy") == 0) {
+            lazy_requested = 1;
+        }
+    }
+    Registry registry;
+    Registry* lazy = NULL;
+    if (lazy_requested) {
+        if (registry_open(&registry, SNAPSHOT_DEFAULT_PATH, REGISTRY_DEFAULT_CACHE) &&
+            snapshot_load(SNAPSHOT_DEFAULT_PATH, snapshot_lsn, NULL, NULL, &appointments, &tree_order)) {
+            lazy = &registry;
+        } else {
+            registry_close(&registry);
+            printf("  Uyari: %s yok veya guncel degil, tembel yukleme yerine tum kayitlar yuklenecek.\n",
+                   SNAPSHOT_DEFAULT_PATH);
+        }
+    }
 
-    doctor_count = load_doctors_from_csv("data/doctors.csv", doctors, MAX_RECORDS);
-    printf("  %d doktor yuklendi.\n", doctor_count);
+    if (lazy != NULL) {
+        printf("  %s tembel acildi: %d hasta ve %d doktor diskte, %d randevu yuklendi.\n",
+               SNAPSHOT_DEFAULT_PATH, registry_patient_count(lazy, &patients),
+               registry_doctor_count(lazy, &doctors), appointments.count);
+    } else if (snapshot_load(SNAPSHOT_DEFAULT_PATH, snapshot_lsn, &patients, &doctors, &appointments,
+                             &tree_order)) {
+        printf("  %s yuklendi: %d hasta, %d doktor, %d randevu.\n", SNAPSHOT_DEFAULT_PATH,
+               patients.count, doctors.count, appointments.count);
+    } else {
+        loaded_from_csv = 1;
+        load_patients_from_csv(PATIENTS_CSV_PATH, &patients);
+        printf("  %d hasta yuklendi.\n", patients.count);
 
-    appointment_count = load_appointments_from_csv("data/appointments.csv", appointments, MAX_RECORDS);
-    printf("  %d randevu yuklendi.\n", appointment_count);
+        load_doctors_from_csv(DOCTORS_CSV_PATH, &doctors);
+        printf("  %d doktor yuklendi.\n", doctors.count);
 
-    // ID sayaçlarını güncelle (CSV'den yüklenen maksimum ID'lere göre)
-    update_patient_id_counter(patients, patient_count);
-    update_doctor_id_counter(doctors, doctor_count);
-    update_appointment_id_counter(appointments, appointment_count);
+        load_appointments_from_csv(APPOINTMENTS_CSV_PATH, &appointments);
+        CsvLoadReport load_report;
+        get_appointment_load_report(&load_report);
+        printf("  %d randevu yuklendi.\n", appointments.count);
+        if (load_report.skipped > 0) {
+            printf("  Uyari: %d gecersiz randevu satiri atlandi (ilki %lld. satir).\n",
+                   load_report.skipped, load_report.first_skipped);
+        }
+    }
+
+    // Yuklenen kayitlari birbirine karsi denetle: tekrarlanan ID'ler ve olmayan hasta/doktora
+    // bagli randevular (hash kumeleriyle O(n)); --quarantine ile hatali satirlar ayri dosyaya
+    // tasinir ve bellekten cikarilir
+    int quarantine = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--quarantine") == 0) {
+            quarantine = 1;
+        }
+    }
+    IntegrityReport integrity;
+    // Tembel yuklemede hasta/doktorlar bellekte degil: yalnizca randevu ID'leri denetlenir
+    int integrity_ok = integrity_check(lazy != NULL ? NULL : &patients, lazy != NULL ? NULL : &doctors,
+                                       &appointments, quarantine ? INTEGRITY_QUARANTINE_PATH : NULL,
+                                       &integrity);
+    if (integrity_has_problems(&integrity)) {
+        printf("  Uyari: Butunluk denetiminde %d hatali kayit bulundu:\n",
+               integrity.bad_patients + integrity.bad_doctors + integrity.bad_appointments);
+        if (integrity.duplicate_patients.count > 0) {
+            printf("    %d tekrarlanan hasta ID'si (ilki %d)\n",
+                   integrity.duplicate_patients.count, integrity.duplicate_patients.first_id);
+        }
+        if (integrity.duplicate_doctors.count > 0) {
+            printf("    %d tekrarlanan doktor ID'si (ilki %d)\n",
+                   integrity.duplicate_doctors.count, integrity.duplicate_doctors.first_id);
+        }
+        if (integrity.duplicate_appointments.count > 0) {
+            printf("    %d tekrarlanan randevu ID'si (ilki %d)\n",
+                   integrity.duplicate_appointments.count, integrity.duplicate_appointments.first_id);
+        }
+        if (integrity.unknown_patients.count > 0) {
+            printf("    %d randevunun hastasi kayitli degil (ilki randevu %d)\n",
+                   integrity.unknown_patients.count, integrity.unknown_patients.first_id);
+        }
+        if (integrity.unknown_doctors.count > 0) {
+            printf("    %d randevunun doktoru kayitli degil (ilki randevu %d)\n",
+                   integrity.unknown_doctors.count, integrity.unknown_doctors.first_id);
+        }
+        if (integrity.quarantined > 0) {
+            printf("  %d hatali satir %s dosyasina tasindi.\n",
+                   integrity.quarantined, INTEGRITY_QUARANTINE_PATH);
+            tree_order.count = 0; // Tasinan randevular serbest birakildi, agac yeniden kurulur
+        } else if (!quarantine) {
+            printf("  Hatali satirlar yuklendi; ayirmak icin --quarantine ile baslatin.\n");
+        }
+    }
+    if (!integrity_ok) {
+        printf("  Uyari: Butunluk denetimi tamamlanamadi, hatali satirlar tasinmadi.\n");
+    }
 
-    // Yuklenen randevulari AVL agacina ve heap'e ekle
-    for (int i = 0; i < appointment_count; i++) {
-        if (appointments[i] != NULL) {
-            // Çakışma kontrolü yapmadan ekle (zaten dosyadan yüklendi)
-            // Gerçek uygulamada çakışma kontrolü yapılmalı
-            avl_insert(&avl_tree, appointments[i], appointments[i]->doctor_id);
-            heap_insert(&heap, appointments[i]);
+    // Kayitli agac sirasi varsa AVL agacini dogrudan kur (O(n), cakisma taramasi yok),
+    // yoksa yuklenen randevulari tek tek ekle
+    if (tree_order.count > 0 && avl_build_sorted(&avl_tree, tree_order.items, tree_order.count)) {
+        printf("  Randevu agaci kayitli siradan kuruldu (%d randevu).\n", avl_size(&avl_tree));
+    } else {
+        for (int i = 0; i < appointments.count; i++) {
+            if (appointments.items[i] != NULL) {
+                // Çakışma kontrolü yapmadan ekle (zaten dosyadan yüklendi)
+                // Gerçek uygulamada çakışma kontrolü yapılmalı
+                avl_insert(&avl_tree, appointments.items[i], appointments.items[i]->doctor_id);
+            }
         }
     }
+    appointment_vector_destroy(&tree_order);
+
+    // Heap tek seferde kurulur (Floyd, O(n))
+    heap_build(&heap, appointments.items, appointments.count);
+
+    // Son anlik goruntuden (CSV) sonraki degisiklikleri on-yazim gunlugunden uygula
+    JournalContext context = { &avl_tree, &heap, &patients, &doctors, &appointments, lazy };
+    int wal_records = wal_open(WAL_DEFAULT_PATH, &context, snapshot_lsn);
+    if (wal_records < 0) {
+        printf("  Uyari: %s acilamadi, veriler yalnizca cikista kaydedilecek.\n",
+               WAL_DEFAULT_PATH);
+    } else {
+        printf("  %d gunluk kaydi uygulandi (%d hasta, %d doktor, %d randevu).\n",
+               wal_records, registry_patient_count(lazy, &patients),
+               registry_doctor_count(lazy, &doctors), appointments.count);
+    }
+
+    // ID sayaçlarını güncelle (CSV ve günlükten yüklenen maksimum ID'lere göre); kalici ust sinir
+    // okunduysa ve veriler anlik goruntuden geldiyse tarama gerekmez (sinir tum verilen ID'leri kapsar)
+    if (!ids_loaded || loaded_from_csv) {
+        update_patient_id_counter(patients.items, patients.count);
+        update_doctor_id_counter(doctors.items, doctors.count);
+        update_appointment_id_counter(appointments.items, appointments.count);
+    } else {
+        printf("  ID sayaclari %s dosyasindan okundu (hasta %d, doktor %d, randevu %d).\n",
+               IDALLOC_DEFAULT_PATH, idalloc_current(IDALLOC_PATIENT),
+               idalloc_current(IDALLOC_DOCTOR), idalloc_current(IDALLOC_APPOINTMENT));
+    }
+    if (lazy != NULL) {
+        // Anlik goruntude kalan kayitlarin ID'leri de yeniden verilmemeli
+        reserve_patient_id(lazy->max_patient_id);
+        reserve_doctor_id(lazy->max_doctor_id);
+    }
+
+    // Bekleme listesini ikili gunlukten geri yukle
+    int replayed = statelog_open(STATELOG_DEFAULT_PATH, &waitlist);
+    if (replayed < 0) {
+        printf("  Uyari: %s acilamadi, bekleme listesi kaydedilmeyecek.\n",
+               STATELOG_DEFAULT_PATH);
+    } else {
+        printf("  %d bekleyen randevu yuklendi.\n", waitlist_size(&waitlist));
+    }
+
+    // Islem gunlugunu ac (son duzgun cikistaki geri alma/yineleme gecmisi)
+    Journal journal;
+    if (!journal_open(&journal, JOURNAL_DEFAULT_PATH, JOURNAL_DEFAULT_CAPACITY)) {
+        printf("  Uyari: %s acilamadi, geri alma gecmisi yalnizca bellekte tutulacak.\n",
+               JOURNAL_DEFAULT_PATH);
+    } else {
+        printf("  %lld geri alinabilir, %lld yinelenebilir islem yuklendi.\n",
+               journal_undo_count(&journal), journal_redo_count(&journal));
+    }
 
     printf("\nSistem hazir!\n");
 
-    // Argumanlara gore calisma modu sec (CLI veya GUI)
+    // Argumanlara gore calisma modu sec (CLI veya GUI, FIFO veya triyaj)
     int use_gui = 0;
+    const char* import_path = NULL;
+    long long checkpoint_interval = CHECKPOINT_DEFAULT_INTERVAL;
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "--gui") == 0) {
             use_gui = 1;
-            break;
+        } else if (strcmp(argv[i], "--import") == 0 && i + 1 < argc) {
+            // Toplu ice aktarma: menu yok, dosya islenince kaydedilip cikilir
+            import_path = argv[++i];
+        } else if (strcmp(argv[i], "--triage") == 0) {
+            waitlist_set_mode(&waitlist, WAITLIST_MODE_TRIAGE);
+            printf("Bekleme listesi triyaj modunda (--triage).\n");
+        } else if (strncmp(argv[i], "--commit-window=", 16) == 0) {
+            // Grup commit penceresi (mikrosaniye, 0 = beklemeden yaz)
+            long long window_us = atoll(argv[i] + 16);
+            wal_set_commit_window(window_us);
+            printf("Gunluk commit penceresi: %lld us.\n", window_us < 0 ? 0 : window_us);
+        } else if (strncmp(argv[i], "--checkpoint-interval=", 22) == 0) {
+            // Kontrol noktalari arasindaki en az gunluk kaydi (0 = kapali); buyuk veri
+            // kumelerinde veri boyutunun 1/CHECKPOINT_LOG_RATIO'su kadar beklenir
+            checkpoint_interval = atoll(argv[i] + 22);
+            printf("Kontrol noktasi araligi: en az %lld kayit.\n", checkpoint_interval);
         }
     }
 
-    if (use_gui) {
+    // Arka plan kontrol noktasi: CSV anlik goruntusu + gunluk kisaltma
+    if (wal_is_open() && !checkpoint_start(CHECKPOINT_DEFAULT_PATH, &context, checkpoint_interval)) {
+        printf("Uyari: Kontrol noktasi baslatilamadi, gunluk kisaltilmayacak.\n");
+    } else if (wal_is_open() && integrity.quarantined > 0) {
+        // Tasinan satirlar veri dosyalarindan da silinsin (sonraki acilista yeniden tasinmasin)
+        checkpoint_request();
+    }
+
+    // Randevu zamanlayicisi: menu/GUI randevulari kuyruga gonderir, zamanlayici is parcacigi
+    // agaci, heap'i, bekleme listesini ve vektorleri gunceller (ice aktarma modunda kullanilmaz)
+    Scheduler scheduler;
+    IntakeBookingContext booking = { &avl_tree, &heap, &waitlist, &journal, &patients, &doctors,
+                                     &appointments, lazy, { 0, 0 } };
+
+    if (import_path != NULL) {
+        // Toplu ice aktarma modu: satirlar akisla okunur, toplu dogrulanir ve toplu commit edilir
+        printf("%s ice aktariliyor (--import)...\n", import_path);
+        ImportReport import_report;
+        int imported = import_appointments_csv(import_path, &context, IMPORT_DEFAULT_BATCH,
+                                               print_import_progress, NULL, &import_report);
+        double seconds = (double)import_report.elapsed_us / 1000000.0;
+        printf("\n");
+        if (!imported) {
+            printf("Hata: %s okunamadi veya bellek yetersiz; yalnizca islenen satirlar eklendi.\n",
+                   import_path);
+        }
+        printf("Ice aktarma: %lld satir, %.2f sn, %.0f satir/sn, %lld toplu commit.\n",
+               import_report.rows, seconds,
+               seconds > 0 ? (double)import_report.rows / seconds : 0.0, import_report.batches);
+        printf("  Kabul: %lld, red: %lld.\n", import_report.accepted, import_report.rejected);
+        for (int reason = 0; reason < IMPORT_REASON_COUNT; reason++) {
+            if (import_report.reasons[reason] == 0) {
+                continue;
+            }
+            if (reason == IMPORT_MALFORMED) {
+                printf("    %-16s %lld (ilki %lld. satir)\n", import_reason_name((ImportReason)reason),
+                       import_report.reasons[reason], import_report.first_malformed_line);
+            } else {
+                printf("    %-16s %lld (ilki randevu %d)\n", import_reason_name((ImportReason)reason),
+                       import_report.reasons[reason], import_report.first_id[reason]);
+            }
+        }
+    } else if (!scheduler_start(&scheduler, &booking, SCHEDULER_DEFAULT_CAPACITY)) {
+        printf("Hata: Randevu zamanlayicisi baslatilamadi.\n");
+    } else if (use_gui) {
         // GUI modu: AppData yapisini hazirla ve GTK arayuzunu baslat
         AppData app_data;
-        app_data.patients = patients;
-        app_data.patient_count = &patient_count;
-        app_data.doctors = doctors;
-        app_data.doctor_count = &doctor_count;
-        app_data.appointments = appointments;
-        app_data.appointment_count = &appointment_count;
+        app_data.patients = &patients;
+        app_data.doctors = &doctors;
+        app_data.appointments = &appointments;
         app_data.avl_tree = &avl_tree;
         app_data.heap = &heap;
-        app_data.queue = &queue;
-        app_data.stack = &stack;
+        app_data.waitlist = &waitlist;
+        app_data.journal = &journal;
+        app_data.registry = lazy;
+        app_data.scheduler = &scheduler;
 
         printf("GUI modu baslatiliyor (--gui).\n");
         start_gui(argc, argv, &app_data);
+        scheduler_stop(&scheduler);
     } else {
         // CLI modu: mevcut metin tabanli menuyu calistir
         printf("CLI modu baslatiliyor.\n");
@@ -126,58 +516,239 @@ int main(int argc, char *argv[]) {
         // Menü döngüsü
         int choice;
         int continue_program = 1;
+        int reported_checkpoints = 0;
 
         while (continue_program) {
             display_menu();
-            choice = get_int_input("", 0, 8);
-            continue_program = process_menu_choice(choice, &avl_tree, &heap, &queue, &stack,
-                                                  patients, &patient_count,
-                                                  doctors, &doctor_count,
-                                                  appointments, &appointment_count);
+            choice = get_int_input("", 0, 12);
+            continue_program = process_menu_choice(choice, &avl_tree, &heap, &waitlist, &journal,
+                                                  &patients, &doctors, &appointments, lazy,
+                                                  &scheduler);
+
+            // Menuye donmeden once islemin gunluge (fsync ile) yazilmasini bekle
+            if (wal_is_open() && !wal_sync()) {
+                printf("Uyari: Degisiklik %s gunlugune yazilamadi!\n", WAL_DEFAULT_PATH);
+            }
+
+            // Biten kontrol noktalarini bildir
+            CheckpointStats done;
+            checkpoint_stats(&done);
+            if (done.checkpoints > reported_checkpoints) {
+                printf("Kontrol noktasi kaydedildi: %lld kayit, %lld ms.\n",
+                       done.last_records, done.last_write_us / 1000);
+                reported_checkpoints = done.checkpoints;
+            }
+
+            // Aralik dolduysa arka planda kontrol noktasi baslat (yakalama yapilari okur)
+            scheduler_lock(&scheduler);
+            int checkpoint_started = checkpoint_maybe();
+            scheduler_unlock(&scheduler);
+            if (checkpoint_started) {
+                printf("Kontrol noktasi arka planda yaziliyor...\n");
+            }
         }
+
+        // Kuyrukta kalan randevular uygulanir, zamanlayici durur
+        scheduler_stop(&scheduler);
     }
 
     // Cikista verileri kaydet
     printf("\nVeriler kaydediliyor...\n");
-    
-    int saved_patients = save_patients_to_csv("data/patients.csv", patients, patient_count);
-    printf("  %d hasta kaydedildi.\n", saved_patients);
 
-    int saved_doctors = save_doctors_to_csv("data/doctors.csv", doctors, doctor_count);
-    printf("  %d doktor kaydedildi.\n", saved_doctors);
+    // Suren kontrol noktasini bitir (gunlugu kisaltabilmesi icin once durdurulur)
+    if (!checkpoint_wait(CHECKPOINT_PROGRESS_US)) {
+        CheckpointProgress progress;
+        do {
+            checkpoint_progress(&progress);
+            if (progress.active && progress.records_total > 0) {
+                printf("\r  Kontrol noktasi yaziliyor: %%%lld (%lld/%lld kayit, %lld ms)",
+                       progress.records_done * 100 / progress.records_total,
+                       progress.records_done, progress.records_total, progress.elapsed_us / 1000);
+                fflush(stdout);
+            }
+        } while (!checkpoint_wait(CHECKPOINT_PROGRESS_US));
+        printf("\n");
+    }
+    checkpoint_stop();
+    CheckpointStats checkpoint_info;
+    checkpoint_stats(&checkpoint_info);
+    if (checkpoint_info.checkpoints > 0) {
+        printf("  %d kontrol noktasi yazildi (son: kayit %llu, yakalama %lld us, yazma %lld us).\n",
+               checkpoint_info.checkpoints, checkpoint_info.last_lsn,
+               checkpoint_info.last_capture_us, checkpoint_info.last_write_us);
+    }
+    if (checkpoint_info.failures > 0) {
+        printf("  Uyari: %d kontrol noktasi yazilamadi.\n", checkpoint_info.failures);
+    }
+
+    if (wal_is_open()) {
+        // Her degisiklik zaten gunlukte; CSV dosyalarini bastan yazmaya gerek yok
+        printf("  Degisiklikler %s gunlugunde (son kayit: %llu).\n",
+               WAL_DEFAULT_PATH, wal_last_lsn());
+        wal_close();
+
+        // Grup commit ozeti: toplu yazim boyutlari ve commit gecikmeleri
+        WalCommitStats stats;
+        wal_commit_stats(&stats);
+        if (stats.batches > 0) {
+            printf("  Grup commit: %lld kayit, %lld yazim+fsync (ortalama %.1f, en fazla %d kayit/yazim).\n",
+                   stats.records, stats.batches, (double)stats.records / stats.batches,
+                   stats.max_batch);
+            printf("  Commit gecikmesi: p50 %lld us, p90 %lld us, p99 %lld us, en fazla %lld us "
+                   "(fsync ortalama %lld us).\n",
+                   stats.latency_p50_us, stats.latency_p90_us, stats.latency_p99_us,
+                   stats.latency_max_us, stats.fsync_mean_us);
+        }
+    } else {
+        // Gunluk yok: yalnizca bu oturumda degisen (veya satiri tasinan) tablolar yeniden yazilir
+        // (her dosya "<dosya>.tmp" olarak yazilip fsync edilir, sonra yerine tasinir)
+        int changed = 0;
+        long long save_start = thread_now_us();
+        int patients_changed = wal_change_count(WAL_TABLE_PATIENTS) > 0 ||
+                               (integrity.quarantined > 0 && integrity.bad_patients > 0);
+        int doctors_changed = wal_change_count(WAL_TABLE_DOCTORS) > 0 ||
+                              (integrity.quarantined > 0 && integrity.bad_doctors > 0);
+        int appointments_changed = wal_change_count(WAL_TABLE_APPOINTMENTS) > 0 ||
+                                   (integrity.quarantined > 0 && integrity.bad_appointments > 0);
+
+        // Tembel yuklemede dosyalar tum kayitlarla yazilmali: anlik goruntudeki kayitlar
+        // akisla kopyalanir (toplanamazsa eksik dosya yazmak yerine hic yazilmaz)
+        PatientVector all_patients;
+        DoctorVector all_doctors;
+        patient_vector_init(&all_patients);
+        doctor_vector_init(&all_doctors);
+        PatientVector* saved_patient_vector = &patients;
+        DoctorVector* saved_doctor_vector = &doctors;
+        if (lazy != NULL && (patients_changed || doctors_changed || appointments_changed)) {
+            LazyCollection collection = { &all_patients, &all_doctors, 0 };
+            if (registry_visit_patients(lazy, &patients, collect_patient, &collection) &&
+                registry_visit_doctors(lazy, &doctors, collect_doctor, &collection) &&
+                !collection.failed) {
+                saved_patient_vector = &all_patients;
+                saved_doctor_vector = &all_doctors;
+            } else {
+                printf("  Hata: %s okunamadi, degisiklikler kaydedilemedi.\n", SNAPSHOT_DEFAULT_PATH);
+                patients_changed = doctors_changed = appointments_changed = 0;
+            }
+        }
+
+        if (patients_changed) {
+            int saved_patients = save_patients_to_csv(PATIENTS_CSV_PATH, saved_patient_vector->items,
+                                                      saved_patient_vector->count);
+            printf("  %d hasta kaydedildi.\n", saved_patients);
+            changed = 1;
+        }
+
+        if (doctors_changed) {
+            int saved_doctors = save_doctors_to_csv(DOCTORS_CSV_PATH, saved_doctor_vector->items,
+                                                    saved_doctor_vector->count);
+            printf("  %d doktor kaydedildi.\n", saved_doctors);
+            changed = 1;
+        }
+
+        if (appointments_changed) {
+            int saved_appointments = save_appointments_to_csv(APPOINTMENTS_CSV_PATH, appointments.items,
+                                                              appointments.count);
+            printf("  %d randevu kaydedildi.\n", saved_appointments);
+            changed = 1;
+        }
+
+        if (!changed) {
+            printf("  Degisiklik yok, veri dosyalari yeniden yazilmadi.\n");
+        } else {
+            // Anlik goruntu CSV'lerle ayni noktayi gostermeli, yoksa acilista eskisi okunur
+            // (agac sirasi da yazilir, bir sonraki acilista agac yeniden kurulmaz)
+            Appointment** tree_items = (Appointment**)malloc((avl_size(&avl_tree) + 1) * sizeof(Appointment*));
+            int tree_count = (tree_items != NULL)
+                             ? avl_to_sorted_array(&avl_tree, tree_items, avl_size(&avl_tree)) : 0;
+            if (!snapshot_save(SNAPSHOT_DEFAULT_PATH, snapshot_lsn,
+                               saved_patient_vector->items, saved_patient_vector->count,
+                               saved_doctor_vector->items, saved_doctor_vector->count,
+                               appointments.items, appointments.count, tree_items, tree_count)) {
+                remove(SNAPSHOT_DEFAULT_PATH);
+            }
+            free(tree_items);
+            printf("  Kayit suresi: %lld ms.\n", (thread_now_us() - save_start) / 1000);
+        }
+
+        for (int i = 0; i < all_patients.count; i++) {
+            free_patient(all_patients.items[i]);
+        }
+        patient_vector_destroy(&all_patients);
+        for (int i = 0; i < all_doctors.count; i++) {
+            free_doctor(all_doctors.items[i]);
+        }
+        doctor_vector_destroy(&all_doctors);
+    }
 
-    int saved_appointments = save_appointments_to_csv("data/appointments.csv", appointments, appointment_count);
-    printf("  %d randevu kaydedildi.\n", saved_appointments);
+    // Tembel yukleme ozeti: onbellek isabet orani
+    if (lazy != NULL) {
+        RegistryStats lookups;
+        registry_stats(lazy, &lookups);
+        if (lookups.lookups > 0) {
+            printf("  Tembel yukleme: %lld arama, %lld onbellekten (%%%.1f), %lld diskten, %lld bulunamadi.\n",
+                   lookups.lookups, lookups.hits, 100.0 * (double)lookups.hits / (double)lookups.lookups,
+                   lookups.faults, lookups.absent);
+        }
+        if (lookups.errors > 0) {
+            printf("  Uyari: Anlik goruntu %lld aramada okunamadi.\n", lookups.errors);
+        }
+        registry_close(lazy);
+    }
+
+    // Gunluk zaten guncel; sonraki acilis hizli olsun diye sikistir
+    if (statelog_compact(&waitlist)) {
+        printf("  %d bekleyen randevu kaydedildi.\n", waitlist_size(&waitlist));
+    }
+    statelog_close();
+
+    // CSV ile birlikte islem gecmisini de tutarli olarak isaretle
+    printf("  %lld islemlik geri alma gecmisi kaydedildi.\n",
+           journal_undo_count(&journal) + journal_redo_count(&journal));
+    journal_close(&journal);
+
+    // Kesin ID ust sinirlarini yaz (duzgun cikista atlanan ID kalmaz)
+    if (!idalloc_close()) {
+        printf("  Uyari: %s yazilamadi, sonraki acilista ID'ler taranacak.\n", IDALLOC_DEFAULT_PATH);
+    }
 
     // Bellegi temizle
     printf("\nBellek temizleniyor...\n");
 
     // Hastalari serbest birak
-    for (int i = 0; i < patient_count; i++) {
-        if (patients[i] != NULL) {
-            free_patient(patients[i]);
+    for (int i = 0; i < patients.count; i++) {
+        if (patients.items[i] != NULL) {
+            free_patient(patients.items[i]);
         }
     }
+    patient_vector_destroy(&patients);
 
     // Doktorlari serbest birak
-    for (int i = 0; i < doctor_count; i++) {
-        if (doctors[i] != NULL) {
-            free_doctor(doctors[i]);
+    for (int i = 0; i < doctors.count; i++) {
+        if (doctors.items[i] != NULL) {
+            free_doctor(doctors.items[i]);
         }
     }
+    doctor_vector_destroy(&doctors);
 
     // Randevulari serbest birak
-    for (int i = 0; i < appointment_count; i++) {
-        if (appointments[i] != NULL) {
-            free_appointment(appointments[i]);
+    for (int i = 0; i < appointments.count; i++) {
+        if (appointments.items[i] != NULL) {
+            free_appointment(appointments.items[i]);
         }
     }
+    appointment_vector_destroy(&appointments);
+
+    // Bekleme listesindeki randevulari serbest birak
+    Appointment* waiting;
+    while ((waiting = waitlist_dequeue(&waitlist)) != NULL) {
+        free_appointment(waiting);
+    }
 
     // Veri yapilarini temizle
     avl_destroy(&avl_tree);
     heap_destroy(&heap);
-    queue_destroy(&queue);
-    stack_destroy(&stack);
+    waitlist_destroy(&waitlist);
 
     printf("\nProgram sonlandirildi. Iyi gunler!\n");
     return 0;
@@ -0,0 +1,142 @@
+/**
+ * Read-Only Memory-Mapped Files Implementation
+ * 
+ * Win32: CreateFileA + CreateFileMappingA + MapViewOfFile
+ * POSIX: open + fstat + mmap(PROT_READ, MAP_PRIVATE), then
+ *        posix_madvise(POSIX_MADV_SEQUENTIAL) for read-ahead
+ * 
+ * Time Complexity: O(1) per call (page faults are paid by the reader)
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdint.h>
+#include "mapfile.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Internal helper: Resets a mapping to the empty state
+ */
+static void mapfile_reset(MappedFile* map) {
+    map->data = NULL;
+    map->size = 0;
+#ifdef _WIN32
+    map->file = INVALID_HANDLE_VALUE;
+    map->mapping = NULL;
+#endif
+}
+
+/**
+ * Maps a whole file read-only
+ * Time Complexity: O(1)
+ * 
+ * @param map: Mapping to fill
+ * @param path: File path
+ * @return: 1 on success, 0 if the file cannot be opened or mapped
+ */
+int mapfile_open(MappedFile* map, const char* path) {
+    if (map == NULL || path == NULL) {
+        return 0;
+    }
+    mapfile_reset(map);
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return 0;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || (unsigned long long)size.QuadPart > SIZE_MAX) {
+        CloseHandle(file);
+        return 0;
+    }
+    if (size.QuadPart == 0) {
+        CloseHandle(file); // Nothing to map
+        return 1;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL) {
+        CloseHandle(file);
+        return 0;
+    }
+    const char* data = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == NULL) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return 0;
+    }
+
+    map->file = file;
+    map->mapping = mapping;
+    map->data = data;
+    map->size = (size_t)size.QuadPart;
+    return 1;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) ||
+        (unsigned long long)info.st_size > SIZE_MAX) {
+        close(fd);
+        return 0;
+    }
+    if (info.st_size == 0) {
+        close(fd); // Nothing to map
+        return 1;
+    }
+
+    void* data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps its own reference to the file
+    if (data == MAP_FAILED) {
+        return 0;
+    }
+    posix_madvise(data, (size_t)info.st_size, POSIX_MADV_SEQUENTIAL);
+
+    map->data = (const char*)data;
+    map->size = (size_t)info.st_size;
+    return 1;
+#endif
+}
+
+/**
+ * Unmaps a file mapped with mapfile_open
+ * Time Complexity: O(1)
+ * 
+ * @param map: Mapping to release (left empty)
+ */
+void mapfile_close(MappedFile* map) {
+    if (map == NULL) {
+        return;
+    }
+
+#ifdef _WIN32
+    if (map->data != NULL) {
+        UnmapViewOfFile(map->data);
+    }
+    if (map->mapping != NULL) {
+        CloseHandle(map->mapping);
+    }
+    if (map->file != INVALID_HANDLE_VALUE) {
+        CloseHandle(map->file);
+    }
+#else
+    if (map->data != NULL) {
+        munmap((void*)map->data, map->size);
+    }
+#endif
+    mapfile_reset(map);
+}
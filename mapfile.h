@@ -0,0 +1,52 @@
+#ifndef MAPFILE_H
+#define MAPFILE_H
+
+#include <stddef.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+/**
+ * Read-Only Memory-Mapped Files
+ * Minimal wrapper over Win32 file mappings and POSIX mmap
+ *
+ * Lets the loaders parse a whole file in place: no read buffers, no line
+ * copies. The mapping is private and read-only; the file contents must not
+ * be modified through it. The kernel is told access is sequential so it
+ * reads ahead aggressively.
+ */
+
+/**
+ * Mapped File
+ */
+typedef struct {
+    const char* data;        // First byte of the file (NULL for an empty file)
+    size_t size;             // File size in bytes
+#ifdef _WIN32
+    HANDLE file;             // Win32 file handle
+    HANDLE mapping;          // Win32 file mapping object
+#endif
+} MappedFile;
+
+/**
+ * Mapped File Operations
+ * Time Complexity: O(1) to map, pages are loaded on first access
+ */
+
+/**
+ * Maps a whole file read-only
+ * An empty file succeeds with data == NULL and size == 0
+ * @param map: Mapping to fill
+ * @param path: File path
+ * @return: 1 on success, 0 if the file cannot be opened or mapped
+ */
+int mapfile_open(MappedFile* map, const char* path);
+
+/**
+ * Unmaps a file mapped with mapfile_open
+ * @param map: Mapping to release (left empty)
+ */
+void mapfile_close(MappedFile* map);
+
+#endif // MAPFILE_H
@@ -5,9 +5,12 @@
  * Tüm kullanıcı etkileşimlerini yönetir
  */
 
+#include <string.h>
 #include "menu.h"
 #include "sort_search.h"
 #include "file_io.h"
+#include "statelog.h"
+#include "journal.h"
 
 /**
  * Ana menüyü ekrana yazdırır
@@ -20,10 +23,14 @@ void display_menu(void) {
     printf("2. Doktor Ekle\n");
     printf("3. Randevu Olustur\n");
     printf("4. Randevu Iptal Et\n");
-    printf("5. Iptali Geri Al (Undo)\n");
+    printf("5. Geri Al (Undo)\n");
     printf("6. Bekleme Listesini Göster\n");
     printf("7. En Erken Randevuyu Göster\n");
     printf("8. Tum Randevulari Listele (Sirali)\n");
+    printf("9. Bekleme Listesinden Cik\n");
+    printf("10. Yinele (Redo)\n");
+    printf("11. Randevu Saatini Degistir\n");
+    printf("12. Randevulari Doktora Gore Listele\n");
     printf("0. Cikis\n");
     printf("========================================\n");
     printf("Seciminiz: ");
@@ -92,30 +99,34 @@ void get_string_input(const char* prompt, char* buffer, int buffer_size) {
 /**
  * Yeni hasta ekleme menü işlevi
  * 
- * @param patients: Hasta işaretçileri dizisi
- * @param patient_count: Mevcut hasta sayısı (güncellenecek)
+ * @param patients: Hasta vektörü (yeni hasta eklenir)
+ * @param registry: Tembel yüklenen kayıtlar (NULL ise hepsi vektörde)
+ * @param journal: İşlem günlüğü (geri alma için)
+ * @param scheduler: Zamanlayıcı (yapılara yalnızca kilit altında erişilir, girdi kilitsiz okunur)
  */
-void menu_add_patient(Patient** patients, int* patient_count) {
-    if (patients == NULL || patient_count == NULL) {
+void menu_add_patient(PatientVector* patients, Registry* registry, Journal* journal,
+                      Scheduler* scheduler) {
+    if (patients == NULL) {
         printf("Hata: Geçersiz parametreler.\n");
         return;
     }
 
-    if (*patient_count >= MAX_RECORDS) {
-        printf("Hata: Maksimum hasta sayısına ulaşıldı (%d).\n", MAX_RECORDS);
-        return;
-    }
-
     printf("\n--- Yeni Hasta Ekleme ---\n");
 
     int id = get_int_input("Hasta ID: ", 1, 999999);
     
-    // ID kontrolu (benzersiz olmali)
-    for (int i = 0; i < *patient_count; i++) {
-        if (patients[i] != NULL && patients[i]->id == id) {
-            printf("Hata: Bu ID zaten kullaniliyor.\n");
-            return;
-        }
+    // ID kontrolu (benzersiz olmali; tembel yuklemede snapshot'a da bakilir)
+    Patient* existing;
+    scheduler_lock(scheduler);
+    int id_in_use = registry_lookup_patient(registry, patients, id, &existing);
+    scheduler_unlock(scheduler);
+    if (id_in_use < 0) {
+        printf("Hata: Kayitlar okunamadi, ID kontrol edilemedi.\n");
+        return;
+    }
+    if (id_in_use) {
+        printf("Hata: Bu ID zaten kullaniliyor.\n");
+        return;
     }
 
     char name[100];
@@ -129,8 +140,19 @@ void menu_add_patient(Patient** patients, int* patient_count) {
         return;
     }
 
-    patients[*patient_count] = patient;
-    (*patient_count)++;
+    // Girdi beklenirken kilit birakildi: ID tekrar kontrol edilir
+    scheduler_lock(scheduler);
+    int added = registry_lookup_patient(registry, patients, id, &existing) == 0 &&
+                patient_vector_push(patients, patient);
+    if (added) {
+        journal_record_add_patient(journal, patient);
+    }
+    scheduler_unlock(scheduler);
+    if (!added) {
+        printf("Hata: Hasta eklenemedi (ID kullaniliyor veya bellek yetersiz).\n");
+        free_patient(patient);
+        return;
+    }
 
     printf("Hasta basariyla eklendi!\n");
     display_patient(patient);
@@ -139,30 +161,34 @@ void menu_add_patient(Patient** patients, int* patient_count) {
 /**
  * Yeni doktor ekleme menü işlevi
  * 
- * @param doctors: Doktor işaretçileri dizisi
- * @param doctor_count: Mevcut doktor sayısı (güncellenecek)
+ * @param doctors: Doktor vektörü (yeni doktor eklenir)
+ * @param registry: Tembel yüklenen kayıtlar (NULL ise hepsi vektörde)
+ * @param journal: İşlem günlüğü (geri alma için)
+ * @param scheduler: Zamanlayıcı (yapılara yalnızca kilit altında erişilir, girdi kilitsiz okunur)
  */
-void menu_add_doctor(Doctor** doctors, int* doctor_count) {
-    if (doctors == NULL || doctor_count == NULL) {
+void menu_add_doctor(DoctorVector* doctors, Registry* registry, Journal* journal,
+                     Scheduler* scheduler) {
+    if (doctors == NULL) {
         printf("Hata: Geçersiz parametreler.\n");
         return;
     }
 
-    if (*doctor_count >= MAX_RECORDS) {
-        printf("Hata: Maksimum doktor sayısına ulaşıldı (%d).\n", MAX_RECORDS);
-        return;
-    }
-
     printf("\n--- Yeni Doktor Ekleme ---\n");
 
     int id = get_int_input("Doktor ID: ", 1, 999999);
     
-    // ID kontrolu (benzersiz olmali)
-    for (int i = 0; i < *doctor_count; i++) {
-        if (doctors[i] != NULL && doctors[i]->id == id) {
-            printf("Hata: Bu ID zaten kullaniliyor.\n");
-            return;
-        }
+    // ID kontrolu (benzersiz olmali; tembel yuklemede snapshot'a da bakilir)
+    Doctor* existing;
+    scheduler_lock(scheduler);
+    int id_in_use = registry_lookup_doctor(registry, doctors, id, &existing);
+    scheduler_unlock(scheduler);
+    if (id_in_use < 0) {
+        printf("Hata: Kayitlar okunamadi, ID kontrol edilemedi.\n");
+        return;
+    }
+    if (id_in_use) {
+        printf("Hata: Bu ID zaten kullaniliyor.\n");
+        return;
     }
 
     char name[100];
@@ -177,8 +203,19 @@ void menu_add_doctor(Doctor** doctors, int* doctor_count) {
         return;
     }
 
-    doctors[*doctor_count] = doctor;
-    (*doctor_count)++;
+    // Girdi beklenirken kilit birakildi: ID tekrar kontrol edilir
+    scheduler_lock(scheduler);
+    int added = registry_lookup_doctor(registry, doctors, id, &existing) == 0 &&
+                doctor_vector_push(doctors, doctor);
+    if (added) {
+        journal_record_add_doctor(journal, doctor);
+    }
+    scheduler_unlock(scheduler);
+    if (!added) {
+        printf("Hata: Doktor eklenemedi (ID kullaniliyor veya bellek yetersiz).\n");
+        free_doctor(doctor);
+        return;
+    }
 
     printf("Doktor basariyla eklendi!\n");
     display_doctor(doctor);
@@ -186,36 +223,25 @@ void menu_add_doctor(Doctor** doctors, int* doctor_count) {
 
 /**
  * Randevu oluşturma menü işlevi
- * Çakışma kontrolü yapar ve gerekirse bekleme listesine ekler
+ * Girdiler scheduler_lock altında kontrol edilir, randevu zamanlayıcı
+ * iş parçacığına gönderilir; çakışma varsa zamanlayıcı bekleme listesine ekler
  * 
- * @param avl_tree: AVL ağacı (çakışma kontrolü için)
- * @param heap: Min-heap (randevu ekleme için)
- * @param queue: Bekleme listesi kuyruğu
- * @param appointments: Randevu işaretçileri dizisi
- * @param appointment_count: Mevcut randevu sayısı (güncellenecek)
- * @param patients: Hasta işaretçileri dizisi
- * @param patient_count: Hasta sayısı
- * @param doctors: Doktor işaretçileri dizisi
- * @param doctor_count: Doktor sayısı
+ * @param scheduler: Çalışan zamanlayıcı (randevu yapılarının sahibi)
  */
-void menu_create_appointment(AVLTree* avl_tree, MinHeap* heap, Queue* queue,
-                            Appointment** appointments, int* appointment_count,
-                            Patient** patients, int patient_count,
-                            Doctor** doctors, int doctor_count) {
-    if (avl_tree == NULL || heap == NULL || queue == NULL || 
-        appointments == NULL || appointment_count == NULL) {
+void menu_create_appointment(Scheduler* scheduler) {
+    if (scheduler == NULL) {
         printf("Hata: Geçersiz parametreler.\n");
         return;
     }
-
-    if (*appointment_count >= MAX_RECORDS) {
-        printf("Hata: Maksimum randevu sayısına ulaşıldı (%d).\n", MAX_RECORDS);
-        return;
-    }
+    IntakeBookingContext* ctx = &scheduler->booking; // Yalnizca kilit altinda okunur
 
     printf("\n--- Yeni Randevu Olusturma ---\n");
 
     // Hasta ve doktor kontrolu
+    scheduler_lock(scheduler);
+    int patient_count = registry_patient_count(ctx->registry, ctx->patients);
+    int doctor_count = registry_doctor_count(ctx->registry, ctx->doctors);
+    scheduler_unlock(scheduler);
     if (patient_count == 0) {
         printf("Hata: Sistemde hasta bulunmuyor. Once hasta ekleyin.\n");
         return;
@@ -229,31 +255,23 @@ void menu_create_appointment(AVLTree* avl_tree, MinHeap* heap, Queue* queue,
     int appointment_id = get_int_input("Randevu ID: ", 1, 999999);
     
     // ID kontrolu
-    for (int i = 0; i < *appointment_count; i++) {
-        if (appointments[i] != NULL && appointments[i]->appointment_id == appointment_id) {
-            printf("Hata: Bu randevu ID'si zaten kullaniliyor.\n");
-            return;
-        }
+    scheduler_lock(scheduler);
+    int id_in_use = appointment_vector_find(ctx->appointments, appointment_id) >= 0 ||
+                    waitlist_find(ctx->waitlist, appointment_id) != NULL;
+    scheduler_unlock(scheduler);
+    if (id_in_use) {
+        printf("Hata: Bu randevu ID'si zaten kullaniliyor.\n");
+        return;
     }
 
     int patient_id = get_int_input("Hasta ID: ", 1, 999999);
     int doctor_id = get_int_input("Doktor ID: ", 1, 999999);
 
     // Hasta ve doktor var mi kontrol et
-    int patient_found = 0, doctor_found = 0;
-    for (int i = 0; i < patient_count; i++) {
-        if (patients[i] != NULL && patients[i]->id == patient_id) {
-            patient_found = 1;
-            break;
-        }
-    }
-    for (int i = 0; i < doctor_count; i++) {
-        if (doctors[i] != NULL && doctors[i]->id == doctor_id) {
-            doctor_found = 1;
-            break;
-        }
-    }
-
+    scheduler_lock(scheduler);
+    int patient_found = registry_find_patient(ctx->registry, ctx->patients, patient_id) != NULL;
+    int doctor_found = registry_find_doctor(ctx->registry, ctx->doctors, doctor_id) != NULL;
+    scheduler_unlock(scheduler);
     if (!patient_found) {
         printf("Hata: Hasta bulunamadi (ID: %d).\n", patient_id);
         return;
@@ -281,68 +299,64 @@ void menu_create_appointment(AVLTree* avl_tree, MinHeap* heap, Queue* queue,
         return;
     }
 
-    // Randevu olustur
-    Appointment* appointment = create_appointment(appointment_id, patient_id, 
-                                                doctor_id, start_time, end_time);
-    if (appointment == NULL) {
-        printf("Hata: Randevu olusturulamadi.\n");
-        return;
-    }
-
-    // Cakisma kontrolu (AVL agacinda)
-    if (avl_has_conflict(avl_tree, doctor_id, start_time, end_time)) {
+    // Cakisma kontrolu (AVL agacinda): triyaj seviyesi yalnizca bekleyecek randevu icin sorulur
+    scheduler_lock(scheduler);
+    int conflict = avl_has_conflict(ctx->avl_tree, doctor_id, start_time, end_time);
+    int triage_mode = ctx->waitlist->mode == WAITLIST_MODE_TRIAGE;
+    scheduler_unlock(scheduler);
+
+    IntakeRequest request;
+    memset(&request, 0, sizeof(request));
+    request.type = INTAKE_CREATE_APPOINTMENT;
+    request.appointment_id = appointment_id;
+    request.patient_id = patient_id;
+    request.doctor_id = doctor_id;
+    request.start_time = start_time;
+    request.end_time = end_time;
+    request.triage_level = WAITLIST_DEFAULT_TRIAGE;
+    if (conflict) {
         printf("Uyari: Bu zaman dilimi icin doktorun baska bir randevusu var.\n");
-        printf("Randevu bekleme listesine eklendi.\n");
-        
-        // Bekleme listesine ekle
-        if (queue_enqueue(queue, appointment)) {
-            printf("Randevu bekleme listesine basariyla eklendi.\n");
-        } else {
-            printf("Hata: Bekleme listesine eklenemedi.\n");
-            free_appointment(appointment);
+        if (triage_mode) {
+            request.triage_level = get_int_input("Triyaj seviyesi (1=Kritik, 2=Acil, 3=Oncelikli, 4=Normal, 5=Rutin): ",
+                                                 1, WAITLIST_TRIAGE_LEVELS);
         }
-        return;
     }
 
-    // Cakisma yok, randevuyu ekle
-    if (avl_insert(avl_tree, appointment, doctor_id)) {
-        // AVL'ye eklendi, simdi heap'e de ekle
-        if (heap_insert(heap, appointment)) {
-            appointments[*appointment_count] = appointment;
-            (*appointment_count)++;
+    // Zamanlayici uygular; kayit gunluge islendikten sonra sonuc doner
+    switch (scheduler_book(scheduler, &request, NULL)) {
+        case INTAKE_APPLIED: {
+            Appointment booked = { appointment_id, patient_id, doctor_id, start_time, end_time };
             printf("Randevu basariyla olusturuldu!\n");
-            display_appointment(appointment);
-        } else {
-            printf("Hata: Heap'e eklenemedi.\n");
-            // AVL'den sil (basitlestirilmis - gercek uygulamada daha dikkatli olunmali)
-            avl_delete(avl_tree, appointment_id);
-            free_appointment(appointment);
+            display_appointment(&booked);
+            break;
         }
-    } else {
-        printf("Hata: Randevu eklenemedi.\n");
-        free_appointment(appointment);
+        case INTAKE_WAITLISTED:
+            printf("Randevu bekleme listesine basariyla eklendi.\n");
+            break;
+        default:
+            printf("Hata: Randevu eklenemedi.\n");
+            break;
     }
 }
 
 /**
  * Randevu iptal etme menü işlevi
- * İptal edilen randevu geri almak için stack'e eklenir
+ * İptal isteği zamanlayıcıya gönderilir; zamanlayıcı randevuyu yapılardan
+ * çıkarır ve geri alınabilmesi için işlem günlüğüne yazar
  * 
- * @param avl_tree: AVL ağacı
- * @param heap: Min-heap
- * @param stack: Geri alma stack'i
- * @param appointments: Randevu işaretçileri dizisi
- * @param appointment_count: Mevcut randevu sayısı (güncellenecek)
+ * @param scheduler: Çalışan zamanlayıcı (randevu yapılarının sahibi)
  */
-void menu_cancel_appointment(AVLTree* avl_tree, MinHeap* heap, Stack* stack,
-                            Appointment** appointments, int* appointment_count) {
-    if (avl_tree == NULL || heap == NULL || stack == NULL || 
-        appointments == NULL || appointment_count == NULL) {
+void menu_cancel_appointment(Scheduler* scheduler) {
+    if (scheduler == NULL) {
         printf("Hata: Geçersiz parametreler.\n");
         return;
     }
+    AppointmentVector* appointments = scheduler->booking.appointments; // Yalnizca kilit altinda okunur
 
-    if (*appointment_count == 0) {
+    scheduler_lock(scheduler);
+    int appointment_count = appointments->count;
+    scheduler_unlock(scheduler);
+    if (appointment_count == 0) {
         printf("Iptal edilecek randevu bulunmuyor.\n");
         return;
     }
@@ -350,129 +364,362 @@ void menu_cancel_appointment(AVLTree* avl_tree, MinHeap* heap, Stack* stack,
     printf("\n--- Randevu Iptal Etme ---\n");
     int appointment_id = get_int_input("Iptal edilecek Randevu ID: ", 1, 999999);
 
-    // Randevuyu bul ve sil
-    Appointment* appointment = avl_delete(avl_tree, appointment_id);
-    if (appointment == NULL) {
+    // Gosterim icin kopya alinir (iptalden sonra randevu serbest birakilir)
+    Appointment cancelled;
+    scheduler_lock(scheduler);
+    int index = appointment_vector_find(appointments, appointment_id);
+    if (index >= 0) {
+        cancelled = *appointments->items[index];
+    }
+    scheduler_unlock(scheduler);
+
+    IntakeRequest request;
+    memset(&request, 0, sizeof(request));
+    request.type = INTAKE_CANCEL_APPOINTMENT;
+    request.appointment_id = appointment_id;
+
+    // Zamanlayici iptali uygular (heap, agac, vektor ve gunluk)
+    if (index < 0 || scheduler_book(scheduler, &request, NULL) != INTAKE_APPLIED) {
         printf("Hata: Randevu bulunamadi (ID: %d).\n", appointment_id);
         return;
     }
 
-    // Heap'ten de sil (basitlestirilmis - gercek uygulamada daha karmasik)
-    // Not: Heap'ten ID ile silme zor oldugu icin, tum heap'i yeniden olusturmak gerekebilir
-    // Bu ornekte sadece AVL'den sildik
+    printf("Randevu basariyla iptal edildi (Geri Al ile geri getirilebilir).\n");
+    display_appointment(&cancelled);
+}
 
-    // Diziden de sil
-    for (int i = 0; i < *appointment_count; i++) {
-        if (appointments[i] != NULL && appointments[i]->appointment_id == appointment_id) {
-            // Son elemani buraya tasi
-            appointments[i] = appointments[*appointment_count - 1];
-            appointments[*appointment_count - 1] = NULL;
-            (*appointment_count)--;
-            break;
-        }
+/**
+ * Randevu saatini değiştirme menü işlevi
+ * AVL ağacı başlangıç saatine göre sıralı olduğu için randevu çıkarılıp
+ * yeni saatle tekrar eklenir
+ * 
+ * @param avl_tree: AVL ağacı
+ * @param heap: Min-heap
+ * @param journal: İşlem günlüğü (geri alma için)
+ * @param appointments: Randevu vektörü (ID dizini ile aranır)
+ * @param scheduler: Zamanlayıcı (yapılara yalnızca kilit altında erişilir, girdi kilitsiz okunur)
+ */
+void menu_reschedule_appointment(AVLTree* avl_tree, MinHeap* heap, Journal* journal,
+                                 AppointmentVector* appointments, Scheduler* scheduler) {
+    if (avl_tree == NULL || heap == NULL || journal == NULL || appointments == NULL) {
+        printf("Hata: Geçersiz parametreler.\n");
+        return;
     }
 
-    // Stack'e ekle (geri alma icin)
-    if (stack_push(stack, appointment)) {
-        printf("Randevu basariyla iptal edildi ve geri alma listesine eklendi.\n");
-        display_appointment(appointment);
-    } else {
-        printf("Randevu iptal edildi ancak geri alma listesine eklenemedi.\n");
+    scheduler_lock(scheduler);
+    int appointment_count = appointments->count;
+    scheduler_unlock(scheduler);
+    if (appointment_count == 0) {
+        printf("Degistirilecek randevu bulunmuyor.\n");
+        return;
+    }
+
+    printf("\n--- Randevu Saatini Degistirme ---\n");
+    int appointment_id = get_int_input("Randevu ID: ", 1, 999999);
+
+    // Gosterim icin kopya alinir; randevu girdi beklenirken iptal edilebilir
+    Appointment current;
+    scheduler_lock(scheduler);
+    int index = appointment_vector_find(appointments, appointment_id);
+    if (index >= 0) {
+        current = *appointments->items[index];
     }
+    scheduler_unlock(scheduler);
+    if (index < 0) {
+        printf("Hata: Randevu bulunamadi (ID: %d).\n", appointment_id);
+        return;
+    }
+    display_appointment(&current);
+
+    // Zaman bilgisi al
+    char start_time_str[10], end_time_str[10];
+    get_string_input("Yeni baslangic saati (HH:MM): ", start_time_str, sizeof(start_time_str));
+    get_string_input("Yeni bitis saati (HH:MM): ", end_time_str, sizeof(end_time_str));
+
+    int start_time = parse_time_string(start_time_str);
+    int end_time = parse_time_string(end_time_str);
+
+    if (start_time < 0 || end_time < 0) {
+        printf("Hata: Gecersiz zaman formati. HH:MM formatinda girin (orn: 09:30).\n");
+        return;
+    }
+
+    if (start_time >= end_time) {
+        printf("Hata: Baslangic saati bitis saatinden once olmalidir.\n");
+        return;
+    }
+
+    scheduler_lock(scheduler);
+    index = appointment_vector_find(appointments, appointment_id);
+    if (index < 0) {
+        scheduler_unlock(scheduler);
+        printf("Hata: Randevu bulunamadi (ID: %d).\n", appointment_id);
+        return;
+    }
+    Appointment* appointment = appointments->items[index];
+
+    // Eski saatle agactan cikar, cakisma kontrolunu kendisi haric yap
+    int old_start_time = appointment->start_time;
+    int old_end_time = appointment->end_time;
+    avl_delete_appointment(avl_tree, appointment);
+
+    if (avl_has_conflict(avl_tree, appointment->doctor_id, start_time, end_time)) {
+        avl_insert(avl_tree, appointment, appointment->doctor_id);
+        scheduler_unlock(scheduler);
+        printf("Uyari: Bu zaman dilimi icin doktorun baska bir randevusu var.\n");
+        return;
+    }
+
+    appointment->start_time = start_time;
+    appointment->end_time = end_time;
+    if (!avl_insert(avl_tree, appointment, appointment->doctor_id)) {
+        appointment->start_time = old_start_time;
+        appointment->end_time = old_end_time;
+        avl_insert(avl_tree, appointment, appointment->doctor_id);
+        scheduler_unlock(scheduler);
+        printf("Hata: Randevu saati degistirilemedi.\n");
+        return;
+    }
+
+    // Heap'te anahtar degisti: cikarip tekrar ekle
+    heap_remove(heap, appointment_id);
+    heap_insert(heap, appointment);
+
+    journal_record_reschedule(journal, appointment, old_start_time, old_end_time);
+    current = *appointment;
+    scheduler_unlock(scheduler);
+
+    printf("Randevu saati basariyla degistirildi!\n");
+    display_appointment(&current);
 }
 
 /**
- * Son iptali geri alma menü işlevi
- * Stack'ten son iptal edilen randevuyu alır ve geri ekler
+ * Geri alma menü işlevi
+ * Günlükteki son işlemleri (oluşturma, iptal, saat değişikliği, hasta/doktor
+ * ekleme) tersine çevirir; birden fazla işlem varsa kaç tane olduğu sorulur
  * 
- * @param avl_tree: AVL ağacı
- * @param heap: Min-heap
- * @param stack: Geri alma stack'i
- * @param appointments: Randevu işaretçileri dizisi
- * @param appointment_count: Mevcut randevu sayısı (güncellenecek)
+ * @param journal: İşlem günlüğü
+ * @param context: Günlüğün değiştireceği veri yapıları
+ * @param scheduler: Zamanlayıcı (yapılara yalnızca kilit altında erişilir, girdi kilitsiz okunur)
  */
-void menu_undo_cancel(AVLTree* avl_tree, MinHeap* heap, Stack* stack,
-                     Appointment** appointments, int* appointment_count) {
-    if (avl_tree == NULL || heap == NULL || stack == NULL || 
-        appointments == NULL || appointment_count == NULL) {
+void menu_undo(Journal* journal, const JournalContext* context, Scheduler* scheduler) {
+    if (journal == NULL || context == NULL) {
         printf("Hata: Geçersiz parametreler.\n");
         return;
     }
 
-    if (stack_is_empty(stack)) {
-        printf("Geri alinacak iptal bulunmuyor.\n");
+    scheduler_lock(scheduler);
+    long long available = journal_undo_count(journal);
+    scheduler_unlock(scheduler);
+    if (available == 0) {
+        printf("Geri alinacak islem bulunmuyor.\n");
+        return;
+    }
+
+    printf("\n--- Geri Alma ---\n");
+
+    int count = 1;
+    if (available > 1) {
+        int max = (available > 999999) ? 999999 : (int)available;
+        printf("Geri alinabilir islem sayisi: %lld\n", available);
+        count = get_int_input("Kac islem geri alinsin: ", 1, max);
+    }
+
+    JournalEntry last;
+    scheduler_lock(scheduler);
+    int done = journal_undo(journal, context, count, &last);
+    scheduler_unlock(scheduler);
+    if (done == 0) {
+        printf("Uyari: Son islem geri alinamadi (zaman dilimi dolu veya kayit bulunamadi).\n");
         return;
     }
 
-    printf("\n--- Iptali Geri Alma ---\n");
+    char description[128];
+    journal_describe(&last, description, sizeof(description));
+    printf("%d islem geri alindi. Son geri alinan: %s\n", done, description);
+    if (done < count) {
+        printf("Uyari: Kalan islemler geri alinamadi (zaman dilimi dolu veya kayit bulunamadi).\n");
+    }
+}
+
+/**
+ * Yineleme menü işlevi
+ * Geri alınan işlemleri sırasıyla tekrar uygular
+ * 
+ * @param journal: İşlem günlüğü
+ * @param context: Günlüğün değiştireceği veri yapıları
+ * @param scheduler: Zamanlayıcı (yapılara yalnızca kilit altında erişilir, girdi kilitsiz okunur)
+ */
+void menu_redo(Journal* journal, const JournalContext* context, Scheduler* scheduler) {
+    if (journal == NULL || context == NULL) {
+        printf("Hata: Geçersiz parametreler.\n");
+        return;
+    }
 
-    // Stack'ten randevuyu al
-    Appointment* appointment = stack_pop(stack);
-    if (appointment == NULL) {
-        printf("Hata: Randevu alinamadi.\n");
+    scheduler_lock(scheduler);
+    long long available = journal_redo_count(journal);
+    scheduler_unlock(scheduler);
+    if (available == 0) {
+        printf("Yinelenecek islem bulunmuyor.\n");
         return;
     }
 
-    // Cakisma kontrolu
-    if (avl_has_conflict(avl_tree, appointment->doctor_id, 
-                        appointment->start_time, appointment->end_time)) {
-        printf("Uyari: Bu zaman dilimi artik dolu. Randevu geri alinamadi.\n");
-        printf("Randevu tekrar stack'e eklendi.\n");
-        
-        // Stack'e geri ekle (daha sonra tekrar denemek icin)
-        stack_push(stack, appointment);
+    printf("\n--- Yineleme ---\n");
+
+    int count = 1;
+    if (available > 1) {
+        int max = (available > 999999) ? 999999 : (int)available;
+        printf("Yinelenebilir islem sayisi: %lld\n", available);
+        count = get_int_input("Kac islem yinelensin: ", 1, max);
+    }
+
+    JournalEntry last;
+    scheduler_lock(scheduler);
+    int done = journal_redo(journal, context, count, &last);
+    scheduler_unlock(scheduler);
+    if (done == 0) {
+        printf("Uyari: Islem yinelenemedi (zaman dilimi dolu veya kayit bulunamadi).\n");
         return;
     }
 
-    // Randevuyu geri ekle
-    if (avl_insert(avl_tree, appointment, appointment->doctor_id)) {
-        if (heap_insert(heap, appointment)) {
-            if (*appointment_count < MAX_RECORDS) {
-                appointments[*appointment_count] = appointment;
-                (*appointment_count)++;
-                printf("Randevu basariyla geri alindi!\n");
-                display_appointment(appointment);
-            } else {
-                printf("Hata: Maksimum randevu sayisina ulasildi.\n");
-                avl_delete(avl_tree, appointment->appointment_id);
-                free_appointment(appointment);
-            }
-        } else {
-            printf("Hata: Heap'e eklenemedi.\n");
-            avl_delete(avl_tree, appointment->appointment_id);
-            free_appointment(appointment);
-        }
-    } else {
-        printf("Hata: Randevu geri eklenemedi.\n");
-        free_appointment(appointment);
+    char description[128];
+    journal_describe(&last, description, sizeof(description));
+    printf("%d islem yinelendi. Son yinelenen: %s\n", done, description);
+    if (done < count) {
+        printf("Uyari: Kalan islemler yinelenemedi (zaman dilimi dolu veya kayit bulunamadi).\n");
     }
 }
 
 /**
- * Bekleme listesini gösterir
+ * Bekleme listesini hizmet sırasına göre gösterir
+ * FIFO modunda geliş sırası, triyaj modunda (seviye, bekleme süresi) sırası
  * 
- * @param queue: Bekleme listesi kuyruğu
+ * @param waitlist: Bekleme listesi
  */
-void menu_show_waiting_queue(Queue* queue) {
-    if (queue == NULL) {
+void menu_show_waiting_queue(Waitlist* waitlist) {
+    if (waitlist == NULL) {
         printf("Hata: Geçersiz parametreler.\n");
         return;
     }
 
     printf("\n--- Bekleme Listesi ---\n");
 
-    if (queue_is_empty(queue)) {
+    if (waitlist_is_empty(waitlist)) {
         printf("Bekleme listesi bos.\n");
         return;
     }
 
-    printf("Bekleyen randevu sayisi: %d\n\n", queue_size(queue));
-    
-    // Kuyrugu gecici olarak kopyala ve goster (orijinal kuyrugu bozmadan)
-    // Not: Bu basitlestirilmis bir gosterim
-    // Gercek uygulamada queue'yu traverse edebilmek icin iterator gerekir
-    printf("Not: Bekleme listesi goruntuleme icin queue traversal gerekir.\n");
-    printf("Su anda %d randevu bekliyor.\n", queue_size(queue));
+    int count = waitlist_size(waitlist);
+    printf("Bekleyen randevu sayisi: %d (%s)\n\n", count,
+           waitlist->mode == WAITLIST_MODE_TRIAGE ? "triyaj sirasi" : "gelis sirasi");
+
+    const WaitlistEntry** entries = (const WaitlistEntry**)malloc(count * sizeof(WaitlistEntry*));
+    if (entries == NULL) {
+        printf("Hata: Bellek ayrilamadi.\n");
+        return;
+    }
+
+    count = waitlist_ordered(waitlist, entries, count);
+    long long now = waitlist_now_minutes();
+    for (int i = 0; i < count; i++) {
+        printf("%d. [Triyaj %d - %s, %lld dk bekliyor]\n", i + 1,
+               entries[i]->triage_level, waitlist_triage_name(entries[i]->triage_level),
+               now - entries[i]->enqueued_at);
+        display_appointment(entries[i]->appointment);
+    }
+
+    free(entries);
+}
+
+/**
+ * Bekleme listesinden çıkma menü işlevi
+ * Randevu ID ile tek kayıt, hasta ID ile hastanın kayıtlarından biri veya
+ * tamamı çıkarılır. Çıkarılan randevular serbest bırakılır.
+ * 
+ * @param waitlist: Bekleme listesi
+ * @param scheduler: Zamanlayıcı (listeye yalnızca kilit altında erişilir, girdi kilitsiz okunur)
+ */
+void menu_withdraw_from_waitlist(Waitlist* waitlist, Scheduler* scheduler) {
+    if (waitlist == NULL) {
+        printf("Hata: Geçersiz parametreler.\n");
+        return;
+    }
+
+    scheduler_lock(scheduler);
+    int empty = waitlist_is_empty(waitlist);
+    scheduler_unlock(scheduler);
+    if (empty) {
+        printf("Bekleme listesi bos.\n");
+        return;
+    }
+
+    printf("\n--- Bekleme Listesinden Cikma ---\n");
+    int by = get_int_input("1. Randevu ID ile\n2. Hasta ID ile\nSeciminiz: ", 1, 2);
+
+    if (by == 1) {
+        int appointment_id = get_int_input("Randevu ID: ", 1, 999999);
+        scheduler_lock(scheduler);
+        Appointment* appointment = waitlist_withdraw(waitlist, appointment_id);
+        if (appointment != NULL) {
+            statelog_waitlist_remove(appointment_id);
+        }
+        scheduler_unlock(scheduler);
+        if (appointment == NULL) {
+            printf("Hata: Bu randevu bekleme listesinde degil (ID: %d).\n", appointment_id);
+            return;
+        }
+        printf("Randevu bekleme listesinden cikarildi.\n");
+        display_appointment(appointment);
+        free_appointment(appointment);
+        return;
+    }
+
+    int patient_id = get_int_input("Hasta ID: ", 1, 999999);
+    scheduler_lock(scheduler);
+    const WaitlistEntry* entry = waitlist_patient_entries(waitlist, patient_id);
+    if (entry != NULL) {
+        printf("\nHastanin bekleyen randevulari:\n");
+    }
+    for (; entry != NULL; entry = entry->patient_next) {
+        printf("[Triyaj %d - %s]\n", entry->triage_level,
+               waitlist_triage_name(entry->triage_level));
+        display_appointment(entry->appointment);
+    }
+    int listed = waitlist_patient_entries(waitlist, patient_id) != NULL;
+    scheduler_unlock(scheduler);
+    if (!listed) {
+        printf("Bu hasta bekleme listesinde degil (ID: %d).\n", patient_id);
+        return;
+    }
+
+    int appointment_id = get_int_input("Cikarilacak Randevu ID (0 = hepsi): ", 0, 999999);
+    if (appointment_id != 0) {
+        scheduler_lock(scheduler);
+        entry = waitlist_find(waitlist, appointment_id);
+        int found = entry != NULL && entry->appointment->patient_id == patient_id;
+        if (found) {
+            free_appointment(waitlist_withdraw(waitlist, appointment_id));
+            statelog_waitlist_remove(appointment_id);
+        }
+        scheduler_unlock(scheduler);
+        if (!found) {
+            printf("Hata: Bu randevu hastanin bekleyen randevulari arasinda degil.\n");
+            return;
+        }
+        printf("Randevu bekleme listesinden cikarildi.\n");
+        return;
+    }
+
+    int removed = 0;
+    scheduler_lock(scheduler);
+    while ((entry = waitlist_patient_entries(waitlist, patient_id)) != NULL) {
+        appointment_id = entry->appointment->appointment_id;
+        free_appointment(waitlist_withdraw(waitlist, appointment_id));
+        statelog_waitlist_remove(appointment_id);
+        removed++;
+    }
+    scheduler_unlock(scheduler);
+    printf("%d randevu bekleme listesinden cikarildi.\n", removed);
 }
 
 /**
@@ -529,7 +776,7 @@ void menu_list_appointments(Appointment** appointments, int appointment_count,
         return;
     }
 
-    // Randevulari sirala (MergeSort kullanarak)
+    // Randevulari sirala (buyuk listede sayma siralamasi O(n), kucukte MergeSort)
     Appointment** sorted_appointments = (Appointment**)malloc(appointment_count * sizeof(Appointment*));
     if (sorted_appointments == NULL) {
         printf("Hata: Bellek ayrilamadi.\n");
@@ -542,7 +789,7 @@ void menu_list_appointments(Appointment** appointments, int appointment_count,
     }
 
     // Sırala
-    merge_sort_appointments(sorted_appointments, 0, appointment_count - 1);
+    sort_appointments_by_time(sorted_appointments, appointment_count);
 
     // Listele
     printf("Toplam %d randevu:\n\n", appointment_count);
@@ -556,63 +803,146 @@ void menu_list_appointments(Appointment** appointments, int appointment_count,
     free(sorted_appointments);
 }
 
+/**
+ * Randevuları doktora göre gruplayarak listeler (taban sıralaması ile)
+ * Her doktorun randevuları başlangıç saatine göre sıralıdır
+ * 
+ * @param appointments: Randevu işaretçileri dizisi
+ * @param appointment_count: Randevu sayısı
+ * @param doctors: Doktor vektörü (önce burada aranır)
+ * @param registry: Tembel yüklenen kayıtlar (NULL ise yalnızca vektör)
+ */
+void menu_list_appointments_by_doctor(Appointment** appointments, int appointment_count,
+                                      DoctorVector* doctors, Registry* registry) {
+    if (appointments == NULL && appointment_count > 0) {
+        printf("Hata: Geçersiz parametreler.\n");
+        return;
+    }
+
+    printf("\n--- Doktora Gore Randevular ---\n");
+
+    if (appointment_count == 0) {
+        printf("Randevu bulunmuyor.\n");
+        return;
+    }
+
+    Appointment** sorted_appointments = (Appointment**)malloc(appointment_count * sizeof(Appointment*));
+    if (sorted_appointments == NULL) {
+        printf("Hata: Bellek ayrilamadi.\n");
+        return;
+    }
+    for (int i = 0; i < appointment_count; i++) {
+        sorted_appointments[i] = appointments[i];
+    }
+
+    // (doctor_id, start_time) sırası: büyük listede taban sıralaması O(n)
+    sort_appointments_by_doctor(sorted_appointments, appointment_count);
+
+    int current_doctor = 0;
+    int doctor_count = 0;
+    for (int i = 0; i < appointment_count; i++) {
+        const Appointment* appointment = sorted_appointments[i];
+        if (appointment == NULL) {
+            continue;
+        }
+        if (doctor_count == 0 || appointment->doctor_id != current_doctor) {
+            current_doctor = appointment->doctor_id;
+            doctor_count++;
+            const Doctor* doctor = registry_find_doctor(registry, doctors, current_doctor);
+            printf("\nDoktor %d", current_doctor);
+            if (doctor != NULL) {
+                printf(" - %s (%s)", doctor->name, doctor->department);
+            }
+            printf(":\n");
+        }
+        printf("  ");
+        display_appointment(appointment);
+    }
+    printf("\nToplam %d randevu, %d doktor.\n", appointment_count, doctor_count);
+
+    free(sorted_appointments);
+}
+
 /**
  * Kullanıcı menü seçimini işler
  * 
  * @param choice: Kullanıcının seçimi
  * @param avl_tree: AVL ağacı
  * @param heap: Min-heap
- * @param queue: Bekleme listesi kuyruğu
- * @param stack: Geri alma stack'i
- * @param patients: Hasta işaretçileri dizisi
- * @param patient_count: Hasta sayısı (güncellenebilir)
- * @param doctors: Doktor işaretçileri dizisi
- * @param doctor_count: Doktor sayısı (güncellenebilir)
- * @param appointments: Randevu işaretçileri dizisi
- * @param appointment_count: Randevu sayısı (güncellenebilir)
+ * @param waitlist: Bekleme listesi
+ * @param journal: İşlem günlüğü (geri alma/yineleme)
+ * @param patients: Hasta vektörü (güncellenebilir)
+ * @param doctors: Doktor vektörü (güncellenebilir)
+ * @param appointments: Randevu vektörü (güncellenebilir)
+ * @param registry: Tembel yüklenen hasta/doktor kayıtları (NULL ise hepsi vektörde)
+ * @param scheduler: Randevuları uygulayan zamanlayıcı
  * @return: Devam etmek için 1, çıkış için 0
  */
 int process_menu_choice(int choice, AVLTree* avl_tree, MinHeap* heap, 
-                        Queue* queue, Stack* stack,
-                        Patient** patients, int* patient_count,
-                        Doctor** doctors, int* doctor_count,
-                        Appointment** appointments, int* appointment_count) {
+                        Waitlist* waitlist, Journal* journal,
+                        PatientVector* patients, DoctorVector* doctors,
+                        AppointmentVector* appointments, Registry* registry,
+                        Scheduler* scheduler) {
+    JournalContext context = { avl_tree, heap, patients, doctors, appointments, registry };
+
+    // Kullanici girdisi kilitsiz okunur: isleyiciler kilidi yalnizca yapilara
+    // erisirken alir, randevu olusturma/iptal zamanlayici uzerinden gider
     switch (choice) {
         case 1:
-            menu_add_patient(patients, patient_count);
+            menu_add_patient(patients, registry, journal, scheduler);
             break;
         case 2:
-            menu_add_doctor(doctors, doctor_count);
+            menu_add_doctor(doctors, registry, journal, scheduler);
             break;
         case 3:
-            menu_create_appointment(avl_tree, heap, queue, appointments, appointment_count,
-                                   patients, *patient_count, doctors, *doctor_count);
+            menu_create_appointment(scheduler);
             break;
         case 4:
-            menu_cancel_appointment(avl_tree, heap, stack, appointments, appointment_count);
+            menu_cancel_appointment(scheduler);
             break;
         case 5:
-            menu_undo_cancel(avl_tree, heap, stack, appointments, appointment_count);
+            menu_undo(journal, &context, scheduler);
             break;
         case 6:
-            menu_show_waiting_queue(queue);
+            // Yalnizca gosterim: girdi beklemez, tamami kisa bir kilit altinda
+            scheduler_lock(scheduler);
+            menu_show_waiting_queue(waitlist);
+            scheduler_unlock(scheduler);
             break;
         case 7:
+            scheduler_lock(scheduler);
             menu_show_earliest_appointment(heap);
+            scheduler_unlock(scheduler);
             break;
         case 8:
-            menu_list_appointments(appointments, *appointment_count,
-                                 patients, *patient_count,
-                                 doctors, *doctor_count);
+            scheduler_lock(scheduler);
+            menu_list_appointments(appointments->items, appointments->count,
+                                 patients->items, patients->count,
+                                 doctors->items, doctors->count);
+            scheduler_unlock(scheduler);
+            break;
+        case 9:
+            menu_withdraw_from_waitlist(waitlist, scheduler);
+            break;
+        case 10:
+            menu_redo(journal, &context, scheduler);
+            break;
+        case 11:
+            menu_reschedule_appointment(avl_tree, heap, journal, appointments, scheduler);
+            break;
+        case 12:
+            scheduler_lock(scheduler);
+            menu_list_appointments_by_doctor(appointments->items, appointments->count,
+                                             doctors, registry);
+            scheduler_unlock(scheduler);
             break;
         case 0:
             printf("\nCikiliyor...\n");
             return 0; // Cikis
         default:
-            printf("Hata: Gecersiz secim. Lutfen 0-8 arasi bir deger girin.\n");
+            printf("Hata: Gecersiz secim. Lutfen 0-12 arasi bir deger girin.\n");
             break;
     }
 
     return 1; // Devam et
 }
-
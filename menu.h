@@ -8,8 +8,9 @@
 #include "appointment.h"
 #include "avl.h"
 #include "heap.h"
-#include "queue.h"
-#include "stack.h"
+#include "waitlist.h"
+#include "journal.h"
+#include "scheduler.h"
 
 /**
  * Menu System
@@ -26,21 +27,22 @@ void display_menu(void);
  * @param choice: User's menu choice
  * @param avl_tree: Pointer to AVL tree for appointments
  * @param heap: Pointer to min-heap for earliest appointments
- * @param queue: Pointer to queue for waiting list
- * @param stack: Pointer to stack for undo operations
- * @param patients: Array of patient pointers
- * @param patient_count: Number of patients
- * @param doctors: Array of doctor pointers
- * @param doctor_count: Number of doctors
- * @param appointments: Array of appointment pointers
- * @param appointment_count: Number of appointments
+ * @param waitlist: Pointer to waiting list
+ * @param journal: Pointer to operation journal (undo/redo)
+ * @param patients: Pointer to patient vector
+ * @param doctors: Pointer to doctor vector
+ * @param appointments: Pointer to appointment vector
+ * @param registry: Lazily loaded patients/doctors (NULL if all are in the vectors)
+ * @param scheduler: Scheduler applying bookings and cancellations; the handlers
+ *                   read input unlocked and hold scheduler_lock only around
+ *                   structure access
  * @return: 1 to continue, 0 to exit
  */
 int process_menu_choice(int choice, AVLTree* avl_tree, MinHeap* heap, 
-                        Queue* queue, Stack* stack,
-                        Patient** patients, int* patient_count,
-                        Doctor** doctors, int* doctor_count,
-                        Appointment** appointments, int* appointment_count);
+                        Waitlist* waitlist, Journal* journal,
+                        PatientVector* patients, DoctorVector* doctors,
+                        AppointmentVector* appointments, Registry* registry,
+                        Scheduler* scheduler);
 
 /**
  * Menu Option Handlers
@@ -48,65 +50,84 @@ int process_menu_choice(int choice, AVLTree* avl_tree, MinHeap* heap,
 
 /**
  * Handles adding a new patient
- * @param patients: Array of patient pointers
- * @param patient_count: Pointer to current patient count
+ * @param patients: Pointer to patient vector (grows as needed)
+ * @param registry: Lazily loaded records checked for duplicate IDs (may be NULL)
+ * @param journal: Pointer to operation journal
+ * @param scheduler: Scheduler whose lock guards the structures
  */
-void menu_add_patient(Patient** patients, int* patient_count);
+void menu_add_patient(PatientVector* patients, Registry* registry, Journal* journal,
+                  Scheduler* scheduler);
 
 /**
  * Handles adding a new doctor
- * @param doctors: Array of doctor pointers
- * @param doctor_count: Pointer to current doctor count
+ * @param doctors: Pointer to doctor vector (grows as needed)
+ * @param registry: Lazily loaded records checked for duplicate IDs (may be NULL)
+ * @param journal: Pointer to operation journal
+ * @param scheduler: Scheduler whose lock guards the structures
  */
-void menu_add_doctor(Doctor** doctors, int* doctor_count);
+void menu_add_doctor(DoctorVector* doctors, Registry* registry, Journal* journal,
+                 Scheduler* scheduler);
 
 /**
  * Handles creating a new appointment
- * Checks for conflicts and manages waiting list
- * @param avl_tree: Pointer to AVL tree
- * @param heap: Pointer to min-heap
- * @param queue: Pointer to waiting queue
- * @param appointments: Array of appointment pointers
- * @param appointment_count: Pointer to current appointment count
- * @param patients: Array of patient pointers
- * @param patient_count: Number of patients
- * @param doctors: Array of doctor pointers
- * @param doctor_count: Number of doctors
+ * Input is checked under scheduler_lock, then the booking is submitted to
+ * the scheduler thread, which applies it (conflicts go to the waiting list)
+ * In triage mode, asks for the triage level of waitlisted requests
+ * @param scheduler: Running scheduler (owns the booking structures)
  */
-void menu_create_appointment(AVLTree* avl_tree, MinHeap* heap, Queue* queue,
-                            Appointment** appointments, int* appointment_count,
-                            Patient** patients, int patient_count,
-                            Doctor** doctors, int doctor_count);
+void menu_create_appointment(Scheduler* scheduler);
 
 /**
  * Handles cancelling an appointment
- * Pushes cancelled appointment to undo stack
- * @param avl_tree: Pointer to AVL tree
- * @param heap: Pointer to min-heap
- * @param stack: Pointer to undo stack
- * @param appointments: Array of appointment pointers
- * @param appointment_count: Pointer to current appointment count
+ * The cancellation is submitted to the scheduler thread, which removes the
+ * appointment and records it in the journal so it can be undone
+ * @param scheduler: Running scheduler (owns the booking structures)
  */
-void menu_cancel_appointment(AVLTree* avl_tree, MinHeap* heap, Stack* stack,
-                            Appointment** appointments, int* appointment_count);
+void menu_cancel_appointment(Scheduler* scheduler);
 
 /**
- * Handles undoing the last cancellation
- * Restores appointment from undo stack
+ * Handles moving an appointment to new start/end times
+ * Checks for conflicts and records the change in the journal
  * @param avl_tree: Pointer to AVL tree
  * @param heap: Pointer to min-heap
- * @param stack: Pointer to undo stack
- * @param appointments: Array of appointment pointers
- * @param appointment_count: Pointer to current appointment count
+ * @param journal: Pointer to operation journal
+ * @param appointments: Pointer to appointment vector (searched by ID index)
+ * @param scheduler: Scheduler whose lock guards the structures
+ */
+void menu_reschedule_appointment(AVLTree* avl_tree, MinHeap* heap, Journal* journal,
+                                 AppointmentVector* appointments, Scheduler* scheduler);
+
+/**
+ * Handles undoing the most recent journaled operations
+ * Asks how many to undo when more than one is available
+ * @param journal: Pointer to operation journal
+ * @param context: Structures the journal modifies
+ * @param scheduler: Scheduler whose lock guards the structures
+ */
+void menu_undo(Journal* journal, const JournalContext* context, Scheduler* scheduler);
+
+/**
+ * Handles redoing undone operations
+ * Asks how many to redo when more than one is available
+ * @param journal: Pointer to operation journal
+ * @param context: Structures the journal modifies
+ * @param scheduler: Scheduler whose lock guards the structures
  */
-void menu_undo_cancel(AVLTree* avl_tree, MinHeap* heap, Stack* stack,
-                     Appointment** appointments, int* appointment_count);
+void menu_redo(Journal* journal, const JournalContext* context, Scheduler* scheduler);
 
 /**
- * Displays waiting queue (appointments waiting for available slots)
- * @param queue: Pointer to waiting queue
+ * Displays waiting list in service order (appointments waiting for available slots)
+ * @param waitlist: Pointer to waiting list
  */
-void menu_show_waiting_queue(Queue* queue);
+void menu_show_waiting_queue(Waitlist* waitlist);
+
+/**
+ * Withdraws appointments from the waiting list by appointment or patient ID
+ * Withdrawn appointments are freed
+ * @param waitlist: Pointer to waiting list
+ * @param scheduler: Scheduler whose lock guards the waiting list
+ */
+void menu_withdraw_from_waitlist(Waitlist* waitlist, Scheduler* scheduler);
 
 /**
  * Displays the earliest appointment using min-heap
@@ -128,6 +149,17 @@ void menu_list_appointments(Appointment** appointments, int appointment_count,
                            Patient** patients, int patient_count,
                            Doctor** doctors, int doctor_count);
 
+/**
+ * Lists all appointments grouped by doctor, each doctor's by start time
+ * Uses radix sort on (doctor_id, start_time)
+ * @param appointments: Array of appointment pointers
+ * @param appointment_count: Number of appointments
+ * @param doctors: Doctor vector (searched first)
+ * @param registry: Lazily loaded records (NULL: vector only)
+ */
+void menu_list_appointments_by_doctor(Appointment** appointments, int appointment_count,
+                                      DoctorVector* doctors, Registry* registry);
+
 /**
  * Utility Functions
  */
@@ -0,0 +1,518 @@
+/**
+ * Lazy Patient/Doctor Registry Implementation
+ * 
+ * Cache: entries live in preallocated arrays and are chained into an LRU
+ * list through prev/next indices; an IntMap (reserved for the full
+ * capacity, so it never grows) maps an ID to its entry. A hit moves the
+ * entry to the front, a fault reuses the tail entry.
+ * 
+ * Faults and scans go through snapshot_find_* / snapshot_visit_*, which map
+ * the file per call; nothing keeps the snapshot open between calls.
+ * 
+ * Time Complexity:
+ * - find: O(k) overlay scan + O(1) cache hit or O(log n) fault
+ * - hide: O(log n)
+ * - visit: O(n + k)
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "registry.h"
+#include "snapshot.h"
+
+/**
+ * Internal helper: Allocates an empty cache
+ * @return: 1 on success, 0 if memory ran out
+ */
+static int registry_cache_init(RegistryCache* cache, int record_size, int capacity) {
+    intmap_init(&cache->slots);
+    cache->records = (unsigned char*)malloc((size_t)capacity * (size_t)record_size);
+    cache->ids = (int*)malloc((size_t)capacity * sizeof(int));
+    cache->prev = (int*)malloc((size_t)capacity * sizeof(int));
+    cache->next = (int*)malloc((size_t)capacity * sizeof(int));
+    cache->record_size = record_size;
+    cache->capacity = capacity;
+    cache->count = 0;
+    cache->head = -1;
+    cache->tail = -1;
+    return cache->records != NULL && cache->ids != NULL && cache->prev != NULL &&
+           cache->next != NULL && intmap_reserve(&cache->slots, capacity);
+}
+
+/**
+ * Internal helper: Frees a cache
+ */
+static void registry_cache_destroy(RegistryCache* cache) {
+    intmap_destroy(&cache->slots);
+    free(cache->records);
+    free(cache->ids);
+    free(cache->prev);
+    free(cache->next);
+    cache->records = NULL;
+    cache->ids = NULL;
+    cache->prev = NULL;
+    cache->next = NULL;
+    cache->count = 0;
+}
+
+/**
+ * Internal helpers: LRU list maintenance
+ */
+static void registry_cache_unlink(RegistryCache* cache, int entry) {
+    if (cache->prev[entry] >= 0) {
+        cache->next[cache->prev[entry]] = cache->next[entry];
+    } else {
+        cache->head = cache->next[entry];
+    }
+    if (cache->next[entry] >= 0) {
+        cache->prev[cache->next[entry]] = cache->prev[entry];
+    } else {
+        cache->tail = cache->prev[entry];
+    }
+}
+
+static void registry_cache_push_front(RegistryCache* cache, int entry) {
+    cache->prev[entry] = -1;
+    cache->next[entry] = cache->head;
+    if (cache->head >= 0) {
+        cache->prev[cache->head] = entry;
+    } else {
+        cache->tail = entry;
+    }
+    cache->head = entry;
+}
+
+static void registry_cache_push_back(RegistryCache* cache, int entry) {
+    cache->next[entry] = -1;
+    cache->prev[entry] = cache->tail;
+    if (cache->tail >= 0) {
+        cache->next[cache->tail] = entry;
+    } else {
+        cache->head = entry;
+    }
+    cache->tail = entry;
+}
+
+/**
+ * Internal helper: Entry holding an ID, -1 if not cached
+ */
+static int registry_cache_entry(const RegistryCache* cache, int id) {
+    intptr_t slot = (intptr_t)intmap_get(&cache->slots, id);
+    return (int)slot - 1;
+}
+
+/**
+ * Internal helper: Returns a cached record and marks it most recently used
+ */
+static void* registry_cache_get(RegistryCache* cache, int id) {
+    int entry = registry_cache_entry(cache, id);
+    if (entry < 0) {
+        return NULL;
+    }
+    if (entry != cache->head) {
+        registry_cache_unlink(cache, entry);
+        registry_cache_push_front(cache, entry);
+    }
+    return cache->records + (size_t)entry * (size_t)cache->record_size;
+}
+
+/**
+ * Internal helper: Stores a record, evicting the least recently used one when full
+ * @return: The cached copy
+ */
+static void* registry_cache_put(RegistryCache* cache, int id, const void* record) {
+    int entry;
+    if (cache->count < cache->capacity) {
+        entry = cache->count++;
+    } else {
+        entry = cache->tail;
+        registry_cache_unlink(cache, entry);
+        if (registry_cache_entry(cache, cache->ids[entry]) == entry) {
+            intmap_remove(&cache->slots, cache->ids[entry]);
+        }
+    }
+    cache->ids[entry] = id;
+    memcpy(cache->records + (size_t)entry * (size_t)cache->record_size, record,
+           (size_t)cache->record_size);
+    intmap_put(&cache->slots, id, (void*)(intptr_t)(entry + 1)); // Reserved, cannot fail
+    registry_cache_push_front(cache, entry);
+    return cache->records + (size_t)entry * (size_t)cache->record_size;
+}
+
+/**
+ * Internal helper: Drops a record; its entry is reused first
+ */
+static void registry_cache_remove(RegistryCache* cache, int id) {
+    int entry = registry_cache_entry(cache, id);
+    if (entry < 0) {
+        return;
+    }
+    intmap_remove(&cache->slots, id);
+    registry_cache_unlink(cache, entry);
+    registry_cache_push_back(cache, entry);
+}
+
+/**
+ * Opens a registry over a snapshot
+ * Time Complexity: O(capacity)
+ * 
+ * @return: 1 on success, 0 on failure
+ */
+int registry_open(Registry* registry, const char* path, int cache_capacity) {
+    if (registry == NULL) {
+        return 0;
+    }
+    memset(registry, 0, sizeof(*registry)); // registry_close is safe after any failure
+    if (path == NULL || strlen(path) >= sizeof(registry->path)) {
+        return 0;
+    }
+    if (cache_capacity < 2) {
+        cache_capacity = 2;
+    }
+
+    SnapshotInfo info;
+    if (!snapshot_read_info(path, &info)) {
+        return 0;
+    }
+
+    strcpy(registry->path, path);
+    registry->max_patient_id = info.max_patient_id;
+    registry->max_doctor_id = info.max_doctor_id;
+    registry->patient_count = info.patient_count;
+    registry->doctor_count = info.doctor_count;
+    intmap_init(&registry->hidden_patients);
+    intmap_init(&registry->hidden_doctors);
+    int ok = registry_cache_init(&registry->patients, (int)sizeof(Patient), cache_capacity);
+    ok = registry_cache_init(&registry->doctors, (int)sizeof(Doctor), cache_capacity) && ok;
+    if (!ok) {
+        registry_close(registry);
+    }
+    return ok;
+}
+
+/**
+ * Frees the caches and sets
+ * Time Complexity: O(1)
+ * 
+ * @param registry: Registry to close
+ */
+void registry_close(Registry* registry) {
+    if (registry == NULL) {
+        return;
+    }
+    registry_cache_destroy(&registry->patients);
+    registry_cache_destroy(&registry->doctors);
+    intmap_destroy(&registry->hidden_patients);
+    intmap_destroy(&registry->hidden_doctors);
+}
+
+/**
+ * Looks up a patient by ID (overlay, hidden set, cache, then snapshot)
+ * Time Complexity: O(k) + O(1) hit or O(log n) fault
+ * 
+ * @return: 1 if found, 0 if absent, -1 if the snapshot cannot be read
+ */
+int registry_lookup_patient(Registry* registry, PatientVector* overlay, int id, Patient** patient) {
+    *patient = NULL;
+    if (overlay != NULL) {
+        for (int i = 0; i < overlay->count; i++) {
+            if (overlay->items[i] != NULL && overlay->items[i]->id == id) {
+                *patient = overlay->items[i];
+                return 1;
+            }
+        }
+    }
+    if (registry == NULL) {
+        return 0;
+    }
+
+    registry->stats.lookups++;
+    if (intmap_contains(&registry->hidden_patients, id)) {
+        registry->stats.absent++;
+        return 0;
+    }
+    Patient* cached = (Patient*)registry_cache_get(&registry->patients, id);
+    if (cached != NULL) {
+        registry->stats.hits++;
+        *patient = cached;
+        return 1;
+    }
+    Patient record;
+    int found = snapshot_find_patient(registry->path, id, &record);
+    if (found <= 0) {
+        if (found < 0) {
+            registry->stats.errors++;
+        } else {
+            registry->stats.absent++;
+        }
+        return found;
+    }
+    registry->stats.faults++;
+    *patient = (Patient*)registry_cache_put(&registry->patients, id, &record);
+    return 1;
+}
+
+/**
+ * Finds a patient by ID
+ * Time Complexity: O(k) + O(1) hit or O(log n) fault
+ * 
+ * @return: Patient, NULL if not found or the snapshot cannot be read
+ */
+Patient* registry_find_patient(Registry* registry, PatientVector* overlay, int id) {
+    Patient* patient;
+    registry_lookup_patient(registry, overlay, id, &patient);
+    return patient;
+}
+
+/**
+ * Looks up a doctor by ID (overlay, hidden set, cache, then snapshot)
+ * Time Complexity: O(k) + O(1) hit or O(log n) fault
+ * 
+ * @return: 1 if found, 0 if absent, -1 if the snapshot cannot be read
+ */
+int registry_lookup_doctor(Registry* registry, DoctorVector* overlay, int id, Doctor** doctor) {
+    *doctor = NULL;
+    if (overlay != NULL) {
+        for (int i = 0; i < overlay->count; i++) {
+            if (overlay->items[i] != NULL && overlay->items[i]->id == id) {
+                *doctor = overlay->items[i];
+                return 1;
+            }
+        }
+    }
+    if (registry == NULL) {
+        return 0;
+    }
+
+    registry->stats.lookups++;
+    if (intmap_contains(&registry->hidden_doctors, id)) {
+        registry->stats.absent++;
+        return 0;
+    }
+    Doctor* cached = (Doctor*)registry_cache_get(&registry->doctors, id);
+    if (cached != NULL) {
+        registry->stats.hits++;
+        *doctor = cached;
+        return 1;
+    }
+    Doctor record;
+    int found = snapshot_find_doctor(registry->path, id, &record);
+    if (found <= 0) {
+        if (found < 0) {
+            registry->stats.errors++;
+        } else {
+            registry->stats.absent++;
+        }
+        return found;
+    }
+    registry->stats.faults++;
+    *doctor = (Doctor*)registry_cache_put(&registry->doctors, id, &record);
+    return 1;
+}
+
+/**
+ * Finds a doctor by ID
+ * Time Complexity: O(k) + O(1) hit or O(log n) fault
+ * 
+ * @return: Doctor, NULL if not found or the snapshot cannot be read
+ */
+Doctor* registry_find_doctor(Registry* registry, DoctorVector* overlay, int id) {
+    Doctor* doctor;
+    registry_lookup_doctor(registry, overlay, id, &doctor);
+    return doctor;
+}
+
+/**
+ * Marks a patient as removed
+ * Time Complexity: O(log n)
+ * 
+ * @return: 1 if the snapshot held the patient, 0 if not, -1 if it cannot be read
+ */
+int registry_hide_patient(Registry* registry, int id) {
+    Patient patient;
+    if (registry == NULL) {
+        return 0;
+    }
+    int found = snapshot_find_patient(registry->path, id, &patient);
+    if (found <= 0) {
+        return found;
+    }
+    registry_cache_remove(&registry->patients, id);
+    return intmap_put(&registry->hidden_patients, id, registry) ? 1 : -1;
+}
+
+/**
+ * Marks a doctor as removed
+ * Time Complexity: O(log n)
+ * 
+ * @return: 1 if the snapshot held the doctor, 0 if not, -1 if it cannot be read
+ */
+int registry_hide_doctor(Registry* registry, int id) {
+    Doctor doctor;
+    if (registry == NULL) {
+        return 0;
+    }
+    int found = snapshot_find_doctor(registry->path, id, &doctor);
+    if (found <= 0) {
+        return found;
+    }
+    registry_cache_remove(&registry->doctors, id);
+    return intmap_put(&registry->hidden_doctors, id, registry) ? 1 : -1;
+}
+
+/**
+ * Upper bound on the number of live patients
+ * Time Complexity: O(1)
+ * 
+ * @return: Patient count
+ */
+int registry_patient_count(Registry* registry, const PatientVector* overlay) {
+    int count = (overlay != NULL) ? overlay->count : 0;
+    // Hidden IDs are all snapshot records, so they are subtracted exactly
+    return (registry != NULL) ? count + registry->patient_count - intmap_size(&registry->hidden_patients) : count;
+}
+
+/**
+ * Upper bound on the number of live doctors
+ * Time Complexity: O(1)
+ * 
+ * @return: Doctor count
+ */
+int registry_doctor_count(Registry* registry, const DoctorVector* overlay) {
+    int count = (overlay != NULL) ? overlay->count : 0;
+    // Hidden IDs are all snapshot records, so they are subtracted exactly
+    return (registry != NULL) ? count + registry->doctor_count - intmap_size(&registry->hidden_doctors) : count;
+}
+
+/**
+ * Snapshot scan state: records shadowed by the overlay or removed are skipped
+ */
+typedef struct {
+    const IntMap* hidden;
+    IntMap overlay_ids;
+    PatientVisitor patient_visitor;
+    DoctorVisitor doctor_visitor;
+    void* context;
+    int stopped;
+} RegistryScan;
+
+/**
+ * Internal helpers: Snapshot visitors that filter and forward
+ */
+static int registry_scan_patient(const Patient* patient, void* context) {
+    RegistryScan* scan = (RegistryScan*)context;
+    if (intmap_contains(scan->hidden, patient->id) || intmap_contains(&scan->overlay_ids, patient->id)) {
+        return 1;
+    }
+    if (!scan->patient_visitor(patient, scan->context)) {
+        scan->stopped = 1;
+        return 0;
+    }
+    return 1;
+}
+
+static int registry_scan_doctor(const Doctor* doctor, void* context) {
+    RegistryScan* scan = (RegistryScan*)context;
+    if (intmap_contains(scan->hidden, doctor->id) || intmap_contains(&scan->overlay_ids, doctor->id)) {
+        return 1;
+    }
+    if (!scan->doctor_visitor(doctor, scan->context)) {
+        scan->stopped = 1;
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Visits every live patient once
+ * Time Complexity: O(n + k)
+ * 
+ * @return: 1 if the scan finished or the visitor stopped, 0 on failure
+ */
+int registry_visit_patients(Registry* registry, const PatientVector* overlay,
+                            PatientVisitor visitor, void* context) {
+    if (overlay == NULL || visitor == NULL) {
+        return 0;
+    }
+
+    RegistryScan scan;
+    memset(&scan, 0, sizeof(scan));
+    if (registry != NULL) {
+        scan.hidden = &registry->hidden_patients;
+        scan.patient_visitor = visitor;
+        scan.context = context;
+        intmap_init(&scan.overlay_ids);
+        int ok = intmap_reserve(&scan.overlay_ids, overlay->count);
+        for (int i = 0; ok && i < overlay->count; i++) {
+            if (overlay->items[i] != NULL) {
+                ok = intmap_put(&scan.overlay_ids, overlay->items[i]->id, overlay->items[i]);
+            }
+        }
+        ok = ok && snapshot_visit_patients(registry->path, registry_scan_patient, &scan);
+        intmap_destroy(&scan.overlay_ids);
+        if (!ok) {
+            return 0;
+        }
+    }
+
+    for (int i = 0; !scan.stopped && i < overlay->count; i++) {
+        if (overlay->items[i] != NULL && !visitor(overlay->items[i], context)) {
+            break;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Visits every live doctor once
+ * Time Complexity: O(n + k)
+ * 
+ * @return: 1 if the scan finished or the visitor stopped, 0 on failure
+ */
+int registry_visit_doctors(Registry* registry, const DoctorVector* overlay,
+                           DoctorVisitor visitor, void* context) {
+    if (overlay == NULL || visitor == NULL) {
+        return 0;
+    }
+
+    RegistryScan scan;
+    memset(&scan, 0, sizeof(scan));
+    if (registry != NULL) {
+        scan.hidden = &registry->hidden_doctors;
+        scan.doctor_visitor = visitor;
+        scan.context = context;
+        intmap_init(&scan.overlay_ids);
+        int ok = intmap_reserve(&scan.overlay_ids, overlay->count);
+        for (int i = 0; ok && i < overlay->count; i++) {
+            if (overlay->items[i] != NULL) {
+                ok = intmap_put(&scan.overlay_ids, overlay->items[i]->id, overlay->items[i]);
+            }
+        }
+        ok = ok && snapshot_visit_doctors(registry->path, registry_scan_doctor, &scan);
+        intmap_destroy(&scan.overlay_ids);
+        if (!ok) {
+            return 0;
+        }
+    }
+
+    for (int i = 0; !scan.stopped && i < overlay->count; i++) {
+        if (overlay->items[i] != NULL && !visitor(overlay->items[i], context)) {
+            break;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Returns lookup statistics
+ * Time Complexity: O(1)
+ * 
+ * @param registry: Registry
+ * @param stats: Receives the statistics
+ */
+void registry_stats(const Registry* registry, RegistryStats* stats) {
+    if (registry == NULL || stats == NULL) {
+        return;
+    }
+    *stats = registry->stats;
+}
@@ -0,0 +1,173 @@
+#ifndef REGISTRY_H
+#define REGISTRY_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "patient.h"
+#include "doctor.h"
+#include "vector.h"
+#include "intmap.h"
+#include "file_io.h"
+
+/**
+ * Lazy Patient/Doctor Registry
+ *
+ * Serves patients and doctors from the binary snapshot instead of loading
+ * them at startup. A record is read by ID through the snapshot's sorted
+ * index the first time it is needed and kept in a small LRU cache.
+ *
+ * The live tables are the union of three parts:
+ *   overlay   the PatientVector / DoctorVector: records added since the
+ *             snapshot was written (menu, WAL replay, redo)
+ *   hidden    IDs removed since then (undo of an add)
+ *   snapshot  whichever valid snapshot is on disk; a checkpoint may replace
+ *             it mid-session with one that already holds overlay records
+ * Lookups try the overlay, then the hidden set, the cache and the snapshot.
+ * Full scans (checkpoints, listings) stream the snapshot, skip hidden and
+ * overlay IDs, then add the overlay.
+ *
+ * The snapshot is mapped only for the duration of each read, so the
+ * checkpointer can replace it at any time.
+ *
+ * A NULL registry means every record is in the vectors; the functions
+ * below then only look at the vectors, so callers need no second path.
+ */
+
+/**
+ * Default number of cached records per table
+ */
+#define REGISTRY_DEFAULT_CACHE 1024
+
+/**
+ * LRU cache of fixed-size records
+ */
+typedef struct {
+    IntMap slots;            // ID -> entry index + 1
+    unsigned char* records;  // capacity * record_size bytes
+    int* ids;                // ID held by each entry
+    int* prev;               // LRU list, most recent first (-1 = none)
+    int* next;
+    int record_size;
+    int capacity;
+    int count;               // Entries in use
+    int head;                // Most recently used entry
+    int tail;                // Least recently used entry (evicted next)
+} RegistryCache;
+
+/**
+ * Lookup statistics (lookups that reached the registry, i.e. missed the overlay)
+ */
+typedef struct {
+    long long lookups;  // Registry lookups
+    long long hits;     // Served from the cache
+    long long faults;   // Read from the snapshot
+    long long absent;   // Not found (hidden or not in the snapshot)
+    long long errors;   // Snapshot could not be read
+} RegistryStats;
+
+/**
+ * Registry Structure
+ */
+typedef struct {
+    char path[260];           // Snapshot path
+    RegistryCache patients;   // Cached patients
+    RegistryCache doctors;    // Cached doctors
+    IntMap hidden_patients;   // Patient IDs removed since the snapshot
+    IntMap hidden_doctors;    // Doctor IDs removed since the snapshot
+    int max_patient_id;       // Highest IDs in the snapshot at open
+    int max_doctor_id;
+    int patient_count;        // Records in the snapshot at open (a checkpoint's
+    int doctor_count;         // replacement holds no records beyond these + overlay)
+    RegistryStats stats;
+} Registry;
+
+/**
+ * Registry Operations
+ * Time Complexity: O(1) cached lookup, O(log n) fault, O(n) scan
+ */
+
+/**
+ * Opens a registry over a snapshot (only its header is read; its record
+ * counts are kept so that counting needs no file access)
+ * @param registry: Registry to initialize
+ * @param path: Snapshot path
+ * @param cache_capacity: Cached records per table (min 2)
+ * @return: 1 on success, 0 if the snapshot is missing or invalid or memory ran out
+ *          (registry_close may still be called)
+ */
+int registry_open(Registry* registry, const char* path, int cache_capacity);
+
+/**
+ * Frees the caches and sets
+ * @param registry: Registry to close
+ */
+void registry_close(Registry* registry);
+
+/**
+ * Looks up a patient or doctor by ID
+ * Records from the snapshot are cached copies, valid until the registry
+ * reads another record of the same table from the snapshot
+ * @param registry: Registry (NULL: vectors only)
+ * @param overlay: Vector to search first
+ * @param id: Record ID
+ * @param patient / doctor: Receives the record, NULL unless found
+ * @return: 1 if found, 0 if absent, -1 if the snapshot cannot be read
+ *          (callers that add or remove records must fail then)
+ */
+int registry_lookup_patient(Registry* registry, PatientVector* overlay, int id, Patient** patient);
+int registry_lookup_doctor(Registry* registry, DoctorVector* overlay, int id, Doctor** doctor);
+
+/**
+ * Finds a patient or doctor by ID (registry_lookup_* for display and
+ * existence checks that may treat a read error as "not found")
+ * @param registry: Registry (NULL: vectors only)
+ * @param overlay: Vector to search first
+ * @param id: Record ID
+ * @return: Record, NULL if not found or the snapshot cannot be read
+ */
+Patient* registry_find_patient(Registry* registry, PatientVector* overlay, int id);
+Doctor* registry_find_doctor(Registry* registry, DoctorVector* overlay, int id);
+
+/**
+ * Marks a record as removed (undo of an add); overlay records are removed
+ * by the caller
+ * @param registry: Registry (NULL: nothing to do)
+ * @param id: Record ID
+ * @return: 1 if the snapshot held the record, 0 if not, -1 if the snapshot
+ *          cannot be read or memory ran out (nothing is hidden)
+ */
+int registry_hide_patient(Registry* registry, int id);
+int registry_hide_doctor(Registry* registry, int id);
+
+/**
+ * Upper bound on the number of live records (snapshot records at open,
+ * less the removed ones, plus the overlay vector's length)
+ * @param registry: Registry (NULL: overlay count)
+ * @param overlay: Overlay vector
+ * @return: Record count
+ */
+int registry_patient_count(Registry* registry, const PatientVector* overlay);
+int registry_doctor_count(Registry* registry, const DoctorVector* overlay);
+
+/**
+ * Visits every live record once: snapshot records first, then the overlay
+ * @param registry: Registry (NULL: overlay only)
+ * @param overlay: Overlay vector
+ * @param visitor: Called once per record (return 0 to stop)
+ * @param context: Passed to the visitor
+ * @return: 1 if the scan finished or the visitor stopped, 0 if the
+ *          snapshot cannot be read or memory ran out
+ */
+int registry_visit_patients(Registry* registry, const PatientVector* overlay,
+                            PatientVisitor visitor, void* context);
+int registry_visit_doctors(Registry* registry, const DoctorVector* overlay,
+                           DoctorVisitor visitor, void* context);
+
+/**
+ * Returns lookup statistics
+ * @param registry: Registry
+ * @param stats: Receives the statistics
+ */
+void registry_stats(const Registry* registry, RegistryStats* stats);
+
+#endif // REGISTRY_H
@@ -0,0 +1,187 @@
+/**
+ * Booking Scheduler Implementation
+ * 
+ * One thread drains the intake queue: lock owner, apply up to
+ * INTAKE_DEFAULT_BATCH requests (one log commit per batch, inside
+ * intake_drain), let the checkpointer capture, unlock. When the queue is
+ * empty it sleeps on a condition variable until a producer signals it.
+ * 
+ * Time Complexity:
+ * - submit: O(1), lock-free unless the scheduler is idle
+ * - drain: O(k) per batch of k requests
+ */
+
+#include "scheduler.h"
+#include "checkpoint.h"
+
+/**
+ * Internal helper: Wakes the scheduler if it is (about to go) idle
+ * The fence orders the publish in intake_submit before the idle check;
+ * the scheduler fences between setting idle and re-checking the queue
+ */
+static void scheduler_wake(Scheduler* scheduler) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load(&scheduler->idle) || atomic_load(&scheduler->stopping)) {
+        thread_mutex_lock(&scheduler->idle_lock);
+        thread_cond_signal(&scheduler->wake);
+        thread_mutex_unlock(&scheduler->idle_lock);
+    }
+}
+
+/**
+ * Internal helper: Scheduler thread entry point
+ */
+static void scheduler_main(void* arg) {
+    Scheduler* scheduler = (Scheduler*)arg;
+
+    for (;;) {
+        thread_mutex_lock(&scheduler->owner);
+        int applied = intake_drain(&scheduler->queue, intake_apply_booking,
+                                   &scheduler->booking, INTAKE_DEFAULT_BATCH);
+        if (applied > 0) {
+            checkpoint_maybe(); // Capture between batches, on the mutating thread
+        }
+        thread_mutex_unlock(&scheduler->owner);
+
+        if (applied > 0) {
+            atomic_fetch_add(&scheduler->applied, applied);
+            continue;
+        }
+
+        // Queue empty: stop, or sleep until a producer publishes
+        thread_mutex_lock(&scheduler->idle_lock);
+        atomic_store(&scheduler->idle, 1);
+        atomic_thread_fence(memory_order_seq_cst);
+        int stopping = atomic_load(&scheduler->stopping);
+        int pending = intake_has_pending(&scheduler->queue);
+        if (!pending && !stopping) {
+            thread_cond_timedwait(&scheduler->wake, &scheduler->idle_lock, SCHEDULER_IDLE_WAIT_US);
+        }
+        atomic_store(&scheduler->idle, 0);
+        thread_mutex_unlock(&scheduler->idle_lock);
+
+        if (!pending && stopping) {
+            break; // Producers have stopped and the queue is empty
+        }
+    }
+}
+
+/**
+ * Starts the scheduler thread
+ * Time Complexity: O(capacity)
+ * 
+ * @return: 1 on success, 0 on failure
+ */
+int scheduler_start(Scheduler* scheduler, const IntakeBookingContext* booking, int capacity) {
+    if (scheduler == NULL || booking == NULL) {
+        return 0;
+    }
+    if (!intake_init(&scheduler->queue, capacity > 0 ? capacity : SCHEDULER_DEFAULT_CAPACITY)) {
+        return 0;
+    }
+    scheduler->booking = *booking;
+    thread_mutex_init(&scheduler->owner);
+    thread_mutex_init(&scheduler->idle_lock);
+    thread_cond_init(&scheduler->wake);
+    atomic_init(&scheduler->idle, 0);
+    atomic_init(&scheduler->stopping, 0);
+    atomic_init(&scheduler->applied, 0);
+
+    if (!thread_start(&scheduler->thread, scheduler_main, scheduler)) {
+        thread_cond_destroy(&scheduler->wake);
+        thread_mutex_destroy(&scheduler->idle_lock);
+        thread_mutex_destroy(&scheduler->owner);
+        intake_destroy(&scheduler->queue);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Submits a request without waiting
+ * Time Complexity: O(1)
+ * 
+ * @return: 1 on success, 0 if the queue is full or the scheduler is stopping
+ */
+int scheduler_submit(Scheduler* scheduler, const IntakeRequest* request) {
+    if (scheduler == NULL || atomic_load(&scheduler->stopping) ||
+        !intake_submit(&scheduler->queue, request)) {
+        return 0;
+    }
+    scheduler_wake(scheduler);
+    return 1;
+}
+
+/**
+ * Submits a request and waits until it is applied
+ * Time Complexity: O(1) plus the wait
+ * 
+ * @return: Completion status
+ */
+IntakeStatus scheduler_book(Scheduler* scheduler, const IntakeRequest* request,
+                            int* appointment_id) {
+    if (scheduler == NULL || request == NULL) {
+        return INTAKE_REJECTED;
+    }
+    IntakeHandle handle;
+    IntakeRequest copy = *request;
+    copy.handle = &handle;
+
+    while (!scheduler_submit(scheduler, &copy)) {
+        if (atomic_load(&scheduler->stopping)) {
+            return INTAKE_REJECTED;
+        }
+        thread_yield(); // Queue full: let the scheduler drain
+    }
+
+    IntakeStatus status = intake_handle_wait(&handle);
+    if (appointment_id != NULL) {
+        *appointment_id = handle.appointment_id;
+    }
+    return status;
+}
+
+/**
+ * Gives the calling thread direct access to the booking structures
+ * Time Complexity: O(1), waits for a running batch
+ */
+void scheduler_lock(Scheduler* scheduler) {
+    if (scheduler != NULL) {
+        thread_mutex_lock(&scheduler->owner);
+    }
+}
+
+/**
+ * Ends direct access started with scheduler_lock
+ * Time Complexity: O(1)
+ */
+void scheduler_unlock(Scheduler* scheduler) {
+    if (scheduler != NULL) {
+        thread_mutex_unlock(&scheduler->owner);
+    }
+}
+
+/**
+ * Returns the number of requests applied so far
+ * Time Complexity: O(1)
+ */
+long long scheduler_applied(Scheduler* scheduler) {
+    return scheduler != NULL ? atomic_load(&scheduler->applied) : 0;
+}
+
+/**
+ * Applies the requests still queued, stops the thread and frees the queue
+ * Time Complexity: O(k) for k queued requests
+ */
+void scheduler_stop(Scheduler* scheduler) {
+    if (scheduler == NULL || atomic_exchange(&scheduler->stopping, 1)) {
+        return;
+    }
+    scheduler_wake(scheduler);
+    thread_join(&scheduler->thread);
+
+    thread_cond_destroy(&scheduler->wake);
+    thread_mutex_destroy(&scheduler->idle_lock);
+    thread_mutex_destroy(&scheduler->owner);
+    intake_destroy(&scheduler->queue);
+}
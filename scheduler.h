@@ -0,0 +1,116 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include "intake.h"
+#include "thread.h"
+
+/**
+ * Booking Scheduler
+ *
+ * Runs the consumer side of the intake queue (intake.h) on its own thread.
+ * Any number of producer threads submit requests; the scheduler drains
+ * them in batches of INTAKE_DEFAULT_BATCH and applies them with
+ * intake_apply_booking, then gives the checkpointer a chance to capture.
+ * The AVL tree, heap, waiting list, journal and vectors of the booking
+ * context belong to the scheduler.
+ *
+ * A thread that reads or changes those structures directly (the menu, the
+ * GUI) holds scheduler_lock meanwhile; the scheduler holds the same lock
+ * while it applies a batch, so direct access never overlaps a batch. Such
+ * a thread takes the lock only around the access itself: never while it
+ * waits for user input or for its own booking.
+ *
+ * Idle wait: the scheduler marks itself idle and re-checks the queue before
+ * sleeping on a condition variable; a producer that sees the mark after
+ * publishing signals it (both sides fence, so one of them always notices).
+ */
+
+/**
+ * Default intake queue capacity (requests)
+ */
+#define SCHEDULER_DEFAULT_CAPACITY 1024
+
+/**
+ * Longest idle sleep before the queue is polled again
+ */
+#define SCHEDULER_IDLE_WAIT_US 100000
+
+/**
+ * Scheduler Structure
+ */
+typedef struct {
+    IntakeQueue queue;              // Requests from the producers
+    IntakeBookingContext booking;   // Structures the requests are applied to
+    Thread thread;                  // Scheduler thread
+    ThreadMutex owner;              // Held while a batch is applied (scheduler_lock)
+    ThreadMutex idle_lock;          // Guards the idle wait
+    ThreadCond wake;                // Signalled when a request arrives while idle
+    atomic_int idle;                // 1 while the scheduler is about to sleep
+    atomic_int stopping;            // 1 once scheduler_stop was called
+    atomic_llong applied;           // Requests applied so far
+} Scheduler;
+
+/**
+ * Scheduler Operations
+ * Time Complexity: O(1) submit, O(k) per drained batch of k
+ */
+
+/**
+ * Starts the scheduler thread
+ * @param scheduler: Scheduler to start
+ * @param booking: Structures to apply requests to (copied; appointment_ids
+ *                 should be {0, 0})
+ * @param capacity: Intake queue capacity (<= 0 -> SCHEDULER_DEFAULT_CAPACITY)
+ * @return: 1 on success, 0 on failure
+ */
+int scheduler_start(Scheduler* scheduler, const IntakeBookingContext* booking, int capacity);
+
+/**
+ * Submits a request without waiting (any thread)
+ * @param scheduler: Running scheduler
+ * @param request: Request to copy into the queue
+ * @return: 1 on success, 0 if the queue is full or the scheduler is stopping
+ */
+int scheduler_submit(Scheduler* scheduler, const IntakeRequest* request);
+
+/**
+ * Submits a request and waits until it is applied (any thread not holding
+ * scheduler_lock); retries while the queue is full
+ * @param scheduler: Running scheduler
+ * @param request: Request (its handle is replaced by a local one)
+ * @param appointment_id: Receives the assigned/affected appointment ID (may be NULL)
+ * @return: Completion status (INTAKE_REJECTED if the scheduler is stopping)
+ */
+IntakeStatus scheduler_book(Scheduler* scheduler, const IntakeRequest* request,
+                            int* appointment_id);
+
+/**
+ * Gives the calling thread direct access to the booking structures
+ * @param scheduler: Running scheduler
+ */
+void scheduler_lock(Scheduler* scheduler);
+
+/**
+ * Ends direct access started with scheduler_lock
+ * @param scheduler: Running scheduler
+ */
+void scheduler_unlock(Scheduler* scheduler);
+
+/**
+ * Returns the number of requests applied so far
+ * @param scheduler: Scheduler
+ * @return: Applied requests
+ */
+long long scheduler_applied(Scheduler* scheduler);
+
+/**
+ * Applies the requests still queued, stops the thread and frees the queue
+ * Producers must have stopped submitting
+ * @param scheduler: Running scheduler
+ */
+void scheduler_stop(Scheduler* scheduler);
+
+#endif // SCHEDULER_H
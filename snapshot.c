@@ -0,0 +1,1052 @@
+/**
+ * Binary Snapshot Implementation
+ * 
+ * Save: records are encoded into a 64 KB buffer field by field (so struct
+ * padding never reaches the file), checksummed as they are written, and
+ * the header is filled in last. The file is written as "<path>.tmp",
+ * fsynced and renamed over the old snapshot.
+ * 
+ * Load: the file is mapped, the header and every section checksum are
+ * verified, then each record is copied out of the mapping with one memcpy
+ * (or decoded field by field on hosts with another layout).
+ * 
+ * Tree order: the caller's in-order tree contents are mapped to record
+ * indices through an appointment_id hash map; the loader turns the indices
+ * back into pointers and checks that start times strictly increase.
+ * 
+ * ID indexes: (id, record number) pairs of the patient and doctor sections,
+ * sorted with qsort at save time. A lookup maps the file, checks the header
+ * and binary searches the index, so it touches O(log n) index pages and one
+ * record page no matter how large the tables are.
+ * 
+ * Time Complexity:
+ * - save: O(n), O(p log p + d log d) for the indexes
+ * - load: O(n), one pass for the checksums and one to create records
+ * - find: O(log n)
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include "snapshot.h"
+#include "crc32.h"
+#include "mapfile.h"
+#include "file_io.h"
+#include "intmap.h"
+
+#ifdef _WIN32
+#include <io.h>
+#define snapshot_fsync(file) _commit(_fileno(file))
+#else
+#include <unistd.h>
+#define snapshot_fsync(file) fsync(fileno(file))
+#endif
+
+#define SNAPSHOT_WRITE_BUFFER (64 * 1024)
+
+static const unsigned char snapshot_magic[4] = { 'R', 'S', 'N', 'P' };
+
+// Record size of each section, indexed by kind - 1
+static const uint32_t snapshot_record_sizes[SNAPSHOT_SECTION_COUNT] = {
+    SNAPSHOT_PATIENT_SIZE, SNAPSHOT_DOCTOR_SIZE, SNAPSHOT_APPOINTMENT_SIZE, SNAPSHOT_ORDER_SIZE,
+    SNAPSHOT_INDEX_SIZE, SNAPSHOT_INDEX_SIZE
+};
+
+// Section positions of the two indexed tables and their indexes
+#define SNAPSHOT_INDEXED_TABLES 2
+static const int snapshot_index_sections[SNAPSHOT_INDEXED_TABLES] = {
+    SNAPSHOT_PATIENT_INDEX - 1, SNAPSHOT_DOCTOR_INDEX - 1
+};
+
+/**
+ * Parsed section table entry
+ */
+typedef struct {
+    uint32_t kind;
+    uint32_t record_size;
+    uint64_t offset;
+    uint32_t count;
+    uint32_t crc;
+} SnapshotEntry;
+
+/**
+ * ID index entry
+ */
+typedef struct {
+    int32_t id;
+    uint32_t record;  // Record number within the table section
+} SnapshotIndexEntry;
+
+/**
+ * Internal helpers: Little-endian encoding
+ */
+static void snapshot_put_u32(unsigned char* p, uint32_t v) {
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+}
+
+static void snapshot_put_u64(unsigned char* p, uint64_t v) {
+    snapshot_put_u32(p, (uint32_t)v);
+    snapshot_put_u32(p + 4, (uint32_t)(v >> 32));
+}
+
+static uint32_t snapshot_get_u32(const unsigned char* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t snapshot_get_u64(const unsigned char* p) {
+    return (uint64_t)snapshot_get_u32(p) | ((uint64_t)snapshot_get_u32(p + 4) << 32);
+}
+
+/**
+ * Internal helper: Rounds a section offset up to 8 bytes
+ */
+static uint64_t snapshot_align(uint64_t offset) {
+    return (offset + 7) & ~(uint64_t)7;
+}
+
+/**
+ * Internal helper: 1 if the structs have exactly the on-disk record layout
+ */
+static int snapshot_native_layout(void) {
+    const uint32_t probe = 1;
+    return *(const unsigned char*)&probe == 1 &&
+           sizeof(Patient) == SNAPSHOT_PATIENT_SIZE &&
+           offsetof(Patient, name) == 4 && offsetof(Patient, age) == 104 &&
+           sizeof(Doctor) == SNAPSHOT_DOCTOR_SIZE &&
+           offsetof(Doctor, name) == 4 && offsetof(Doctor, department) == 104 &&
+           sizeof(Appointment) == SNAPSHOT_APPOINTMENT_SIZE &&
+           offsetof(Appointment, patient_id) == 4 && offsetof(Appointment, doctor_id) == 8 &&
+           offsetof(Appointment, start_time) == 12 && offsetof(Appointment, end_time) == 16;
+}
+
+/**
+ * Internal helper: Copies a string into a zeroed fixed-width field,
+ * keeping at least one NUL
+ */
+static void snapshot_put_string(unsigned char* out, const char* text, size_t width) {
+    size_t length = 0;
+    while (length + 1 < width && text[length] != '\0') {
+        length++;
+    }
+    memcpy(out, text, length);
+}
+
+/**
+ * Internal helpers: Encode one record (out is zeroed by the caller)
+ */
+static void snapshot_encode_patient(unsigned char* out, const void* record) {
+    const Patient* patient = (const Patient*)record;
+    snapshot_put_u32(out, (uint32_t)patient->id);
+    snapshot_put_string(out + 4, patient->name, sizeof(patient->name));
+    snapshot_put_u32(out + 104, (uint32_t)patient->age);
+}
+
+static void snapshot_encode_doctor(unsigned char* out, const void* record) {
+    const Doctor* doctor = (const Doctor*)record;
+    snapshot_put_u32(out, (uint32_t)doctor->id);
+    snapshot_put_string(out + 4, doctor->name, sizeof(doctor->name));
+    snapshot_put_string(out + 104, doctor->department, sizeof(doctor->department));
+}
+
+static void snapshot_encode_appointment(unsigned char* out, const void* record) {
+    const Appointment* appointment = (const Appointment*)record;
+    snapshot_put_u32(out, (uint32_t)appointment->appointment_id);
+    snapshot_put_u32(out + 4, (uint32_t)appointment->patient_id);
+    snapshot_put_u32(out + 8, (uint32_t)appointment->doctor_id);
+    snapshot_put_u32(out + 12, (uint32_t)appointment->start_time);
+    snapshot_put_u32(out + 16, (uint32_t)appointment->end_time);
+}
+
+typedef void (*SnapshotEncoder)(unsigned char* out, const void* record);
+
+/**
+ * Internal helper: Writes the zero padding after a section
+ * @return: 1 on success, 0 on write error
+ */
+static int snapshot_write_padding(FILE* file, const SnapshotEntry* entry) {
+    uint64_t end = entry->offset + (uint64_t)entry->count * entry->record_size;
+    size_t padding = (size_t)(snapshot_align(end) - end);
+    static const unsigned char zeros[8] = { 0 };
+    return fwrite(zeros, 1, padding, file) == padding;
+}
+
+/**
+ * Internal helper: Writes one section and its alignment padding
+ * @param records: Record pointers (NULL entries skipped)
+ * @param entry: Receives count and CRC
+ * @return: 1 on success, 0 on write error
+ */
+static int snapshot_write_section(FILE* file, unsigned char* buffer, void** records, int count,
+                                  SnapshotEncoder encode, SnapshotEntry* entry) {
+    size_t used = 0;
+    uint32_t crc = 0;
+    for (int i = 0; i < count; i++) {
+        if (records[i] == NULL) {
+            continue;
+        }
+        if (used + entry->record_size > SNAPSHOT_WRITE_BUFFER) {
+            crc = crc32_update(crc, buffer, used);
+            if (fwrite(buffer, 1, used, file) != used) {
+                return 0;
+            }
+            used = 0;
+        }
+        memset(buffer + used, 0, entry->record_size);
+        encode(buffer + used, records[i]);
+        used += entry->record_size;
+    }
+    crc = crc32_update(crc, buffer, used);
+    if (fwrite(buffer, 1, used, file) != used) {
+        return 0;
+    }
+    entry->crc = crc;
+    return snapshot_write_padding(file, entry);
+}
+
+/**
+ * Internal helper: Writes the tree order section
+ * @param order: entry->count record indices
+ * @param entry: Receives the CRC
+ * @return: 1 on success, 0 on write error
+ */
+static int snapshot_write_order(FILE* file, unsigned char* buffer, const uint32_t* order,
+                                SnapshotEntry* entry) {
+    size_t used = 0;
+    uint32_t crc = 0;
+    for (uint32_t i = 0; i < entry->count; i++) {
+        if (used + SNAPSHOT_ORDER_SIZE > SNAPSHOT_WRITE_BUFFER) {
+            crc = crc32_update(crc, buffer, used);
+            if (fwrite(buffer, 1, used, file) != used) {
+                return 0;
+            }
+            used = 0;
+        }
+        snapshot_put_u32(buffer + used, order[i]);
+        used += SNAPSHOT_ORDER_SIZE;
+    }
+    crc = crc32_update(crc, buffer, used);
+    if (fwrite(buffer, 1, used, file) != used) {
+        return 0;
+    }
+    entry->crc = crc;
+    return snapshot_write_padding(file, entry);
+}
+
+/**
+ * Internal helper: Writes an ID index section
+ * @param index: entry->count entries sorted by ID
+ * @param entry: Receives the CRC
+ * @return: 1 on success, 0 on write error
+ */
+static int snapshot_write_index(FILE* file, unsigned char* buffer, const SnapshotIndexEntry* index,
+                                SnapshotEntry* entry) {
+    size_t used = 0;
+    uint32_t crc = 0;
+    for (uint32_t i = 0; i < entry->count; i++) {
+        if (used + SNAPSHOT_INDEX_SIZE > SNAPSHOT_WRITE_BUFFER) {
+            crc = crc32_update(crc, buffer, used);
+            if (fwrite(buffer, 1, used, file) != used) {
+                return 0;
+            }
+            used = 0;
+        }
+        snapshot_put_u32(buffer + used, (uint32_t)index[i].id);
+        snapshot_put_u32(buffer + used + 4, index[i].record);
+        used += SNAPSHOT_INDEX_SIZE;
+    }
+    crc = crc32_update(crc, buffer, used);
+    if (fwrite(buffer, 1, used, file) != used) {
+        return 0;
+    }
+    entry->crc = crc;
+    return snapshot_write_padding(file, entry);
+}
+
+/**
+ * Internal helper: qsort comparator for index entries (ID, then record number)
+ */
+static int snapshot_compare_index(const void* a, const void* b) {
+    const SnapshotIndexEntry* x = (const SnapshotIndexEntry*)a;
+    const SnapshotIndexEntry* y = (const SnapshotIndexEntry*)b;
+    if (x->id != y->id) {
+        return (x->id < y->id) ? -1 : 1;
+    }
+    return (x->record > y->record) - (x->record < y->record);
+}
+
+/**
+ * Internal helper: Builds the sorted ID index of the patient (table 0) or
+ * doctor (table 1) pointer array; record numbers skip NULL entries like the
+ * section writer does
+ * @return: Array of one entry per non-NULL record (caller frees), NULL if memory ran out
+ */
+static SnapshotIndexEntry* snapshot_build_index(int table, void** records, int count) {
+    SnapshotIndexEntry* index = (SnapshotIndexEntry*)malloc(((size_t)count + 1) * sizeof(SnapshotIndexEntry));
+    if (index == NULL) {
+        return NULL;
+    }
+    uint32_t present = 0;
+    for (int i = 0; i < count; i++) {
+        if (records[i] != NULL) {
+            index[present].id = (table == 0) ? ((const Patient*)records[i])->id
+                                             : ((const Doctor*)records[i])->id;
+            index[present].record = present;
+            present++;
+        }
+    }
+    qsort(index, present, sizeof(SnapshotIndexEntry), snapshot_compare_index);
+    return index;
+}
+
+/**
+ * Internal helper: Counts the non-NULL entries of a pointer array
+ */
+static uint32_t snapshot_count(void** records, int count) {
+    uint32_t present = 0;
+    for (int i = 0; i < count; i++) {
+        if (records[i] != NULL) {
+            present++;
+        }
+    }
+    return present;
+}
+
+/**
+ * Internal helper: 1 if two appointments hold the same values
+ */
+static int snapshot_same_appointment(const Appointment* a, const Appointment* b) {
+    return a->appointment_id == b->appointment_id && a->patient_id == b->patient_id &&
+           a->doctor_id == b->doctor_id && a->start_time == b->start_time &&
+           a->end_time == b->end_time;
+}
+
+/**
+ * Internal helper: Maps the tree order onto appointment record indices
+ * Entries are matched by appointment_id and must equal the record field by
+ * field, since the checkpointer passes copies rather than the same pointers
+ * @return: Array of tree_count indices (caller frees), NULL if an entry has
+ *          no matching record, the appointment array has holes or memory ran out
+ */
+static uint32_t* snapshot_build_order(Appointment** appointments, int appointment_count,
+                                      Appointment** tree_order, int tree_count) {
+    if (tree_count > appointment_count ||
+        snapshot_count((void**)appointments, appointment_count) != (uint32_t)appointment_count) {
+        return NULL; // Record indices would not match array positions
+    }
+
+    uint32_t* order = (uint32_t*)malloc((size_t)tree_count * sizeof(uint32_t));
+    IntMap by_id;
+    intmap_init(&by_id);
+    int ok = order != NULL;
+
+    // appointment_id -> array position + 1 (a duplicate ID keeps the last one)
+    for (int i = 0; ok && i < appointment_count; i++) {
+        ok = intmap_put(&by_id, appointments[i]->appointment_id, (void*)(intptr_t)(i + 1));
+    }
+    for (int i = 0; ok && i < tree_count; i++) {
+        intptr_t slot = (tree_order[i] != NULL)
+                        ? (intptr_t)intmap_get(&by_id, tree_order[i]->appointment_id) : 0;
+        ok = slot > 0 && snapshot_same_appointment(appointments[slot - 1], tree_order[i]);
+        if (ok) {
+            order[i] = (uint32_t)(slot - 1);
+        }
+    }
+    intmap_destroy(&by_id);
+
+    if (!ok) {
+        free(order);
+        return NULL;
+    }
+    return order;
+}
+
+/**
+ * Writes a snapshot atomically
+ * Time Complexity: O(n)
+ * 
+ * @param path: Snapshot file path
+ * @param lsn: Log position the records correspond to
+ * @return: 1 on success, 0 on failure
+ */
+int snapshot_save(const char* path, unsigned long long lsn,
+                  Patient** patients, int patient_count,
+                  Doctor** doctors, int doctor_count,
+                  Appointment** appointments, int appointment_count,
+                  Appointment** tree_order, int tree_count) {
+    if (path == NULL || patient_count < 0 || doctor_count < 0 || appointment_count < 0 ||
+        (patient_count > 0 && patients == NULL) || (doctor_count > 0 && doctors == NULL) ||
+        (appointment_count > 0 && appointments == NULL)) {
+        return 0;
+    }
+
+    char tmp_path[520];
+    if (strlen(path) + 5 > sizeof(tmp_path)) {
+        return 0;
+    }
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+
+    void** tables[SNAPSHOT_APPOINTMENTS] = { (void**)patients, (void**)doctors, (void**)appointments };
+    int counts[SNAPSHOT_APPOINTMENTS] = { patient_count, doctor_count, appointment_count };
+    SnapshotEncoder encoders[SNAPSHOT_APPOINTMENTS] = {
+        snapshot_encode_patient, snapshot_encode_doctor, snapshot_encode_appointment
+    };
+
+    // Tree order is optional: without it startup rebuilds the tree
+    uint32_t* order = (tree_order != NULL && tree_count > 0)
+                      ? snapshot_build_order(appointments, appointment_count, tree_order, tree_count)
+                      : NULL;
+
+    // Section layout is known before anything is written
+    SnapshotEntry entries[SNAPSHOT_SECTION_COUNT];
+    uint64_t offset = SNAPSHOT_HEADER_SIZE;
+    for (int i = 0; i < SNAPSHOT_SECTION_COUNT; i++) {
+        entries[i].kind = (uint32_t)(i + 1);
+        entries[i].record_size = snapshot_record_sizes[i];
+        entries[i].offset = snapshot_align(offset);
+        if (i < SNAPSHOT_APPOINTMENTS) {
+            entries[i].count = (counts[i] > 0) ? snapshot_count(tables[i], counts[i]) : 0;
+        } else if (i == SNAPSHOT_APPOINTMENT_ORDER - 1) {
+            entries[i].count = (order != NULL) ? (uint32_t)tree_count : 0;
+        } else {
+            entries[i].count = entries[i - (SNAPSHOT_PATIENT_INDEX - 1)].count; // One entry per record
+        }
+        entries[i].crc = 0;
+        offset = entries[i].offset + (uint64_t)entries[i].count * entries[i].record_size;
+    }
+
+    // Indexes are required: a lazy reader cannot use the file without them
+    SnapshotIndexEntry* indexes[SNAPSHOT_INDEXED_TABLES];
+    for (int t = 0; t < SNAPSHOT_INDEXED_TABLES; t++) {
+        indexes[t] = snapshot_build_index(t, tables[t], counts[t]);
+    }
+
+    unsigned char* buffer = (unsigned char*)malloc(SNAPSHOT_WRITE_BUFFER);
+    FILE* file = (buffer != NULL && indexes[0] != NULL && indexes[1] != NULL)
+                 ? fopen(tmp_path, "wb") : NULL;
+    if (file == NULL) {
+        free(buffer);
+        free(order);
+        free(indexes[0]);
+        free(indexes[1]);
+        return 0;
+    }
+
+    // Header placeholder, sections, then the real header
+    unsigned char header[SNAPSHOT_HEADER_SIZE];
+    memset(header, 0, sizeof(header));
+    int ok = fwrite(header, 1, sizeof(header), file) == sizeof(header);
+    for (int i = 0; ok && i < SNAPSHOT_APPOINTMENTS; i++) {
+        ok = snapshot_write_section(file, buffer, tables[i], counts[i], encoders[i], &entries[i]);
+    }
+    ok = ok && snapshot_write_order(file, buffer, order, &entries[SNAPSHOT_APPOINTMENT_ORDER - 1]);
+    for (int t = 0; t < SNAPSHOT_INDEXED_TABLES; t++) {
+        ok = ok && snapshot_write_index(file, buffer, indexes[t], &entries[snapshot_index_sections[t]]);
+        free(indexes[t]);
+    }
+    free(buffer);
+    free(order);
+
+    memcpy(header, snapshot_magic, 4);
+    snapshot_put_u32(header + 4, SNAPSHOT_VERSION);
+    snapshot_put_u64(header + 8, lsn);
+    snapshot_put_u32(header + 16, SNAPSHOT_SECTION_COUNT);
+    for (int i = 0; i < SNAPSHOT_SECTION_COUNT; i++) {
+        unsigned char* entry = header + 24 + i * 24;
+        snapshot_put_u32(entry, entries[i].kind);
+        snapshot_put_u32(entry + 4, entries[i].record_size);
+        snapshot_put_u64(entry + 8, entries[i].offset);
+        snapshot_put_u32(entry + 16, entries[i].count);
+        snapshot_put_u32(entry + 20, entries[i].crc);
+    }
+    snapshot_put_u32(header + 20, crc32_update(0, header, sizeof(header)));
+
+    ok = ok && fseek(file, 0, SEEK_SET) == 0 &&
+         fwrite(header, 1, sizeof(header), file) == sizeof(header) &&
+         fflush(file) == 0 && snapshot_fsync(file) == 0;
+    if (fclose(file) != 0) {
+        ok = 0;
+    }
+
+    if (ok) {
+        // rename does not replace on Windows
+#ifdef _WIN32
+        remove(path);
+#endif
+        ok = rename(tmp_path, path) == 0;
+    }
+    if (!ok) {
+        remove(tmp_path);
+    }
+    return ok;
+}
+
+/**
+ * Internal helper: Validates the header and section table of a mapping
+ * @param entries: Receives the section table
+ * @param lsn: Receives the snapshot LSN
+ * @return: 1 if the header is valid, 0 otherwise
+ */
+static int snapshot_parse_header(const MappedFile* map, SnapshotEntry* entries,
+                                 unsigned long long* lsn) {
+    if (map->size < SNAPSHOT_HEADER_SIZE) {
+        return 0;
+    }
+    const unsigned char* data = (const unsigned char*)map->data;
+    if (memcmp(data, snapshot_magic, 4) != 0 ||
+        snapshot_get_u32(data + 4) != SNAPSHOT_VERSION ||
+        snapshot_get_u32(data + 16) != SNAPSHOT_SECTION_COUNT) {
+        return 0;
+    }
+
+    unsigned char header[SNAPSHOT_HEADER_SIZE];
+    memcpy(header, data, sizeof(header));
+    memset(header + 20, 0, 4);
+    if (crc32_update(0, header, sizeof(header)) != snapshot_get_u32(data + 20)) {
+        return 0;
+    }
+
+    for (int i = 0; i < SNAPSHOT_SECTION_COUNT; i++) {
+        const unsigned char* entry = data + 24 + i * 24;
+        entries[i].kind = snapshot_get_u32(entry);
+        entries[i].record_size = snapshot_get_u32(entry + 4);
+        entries[i].offset = snapshot_get_u64(entry + 8);
+        entries[i].count = snapshot_get_u32(entry + 16);
+        entries[i].crc = snapshot_get_u32(entry + 20);
+
+        if (entries[i].kind != (uint32_t)(i + 1) ||
+            entries[i].record_size != snapshot_record_sizes[i] ||
+            entries[i].count > INT_MAX ||
+            entries[i].offset < SNAPSHOT_HEADER_SIZE || entries[i].offset > map->size ||
+            (uint64_t)entries[i].count * entries[i].record_size > map->size - entries[i].offset) {
+            return 0;
+        }
+    }
+    for (int t = 0; t < SNAPSHOT_INDEXED_TABLES; t++) {
+        if (entries[snapshot_index_sections[t]].count != entries[t].count) {
+            return 0; // Every record needs its index entry
+        }
+    }
+
+    *lsn = snapshot_get_u64(data + 8);
+    return 1;
+}
+
+/**
+ * Reads the LSN stored in a snapshot header
+ * Time Complexity: O(1)
+ * 
+ * @param path: Snapshot file path
+ * @param lsn: Receives the LSN
+ * @return: 1 on success, 0 if the file is missing or its header is invalid
+ */
+int snapshot_read_lsn(const char* path, unsigned long long* lsn) {
+    if (path == NULL || lsn == NULL) {
+        return 0;
+    }
+
+    MappedFile map;
+    if (!mapfile_open(&map, path)) {
+        return 0;
+    }
+    SnapshotEntry entries[SNAPSHOT_SECTION_COUNT];
+    int ok = snapshot_parse_header(&map, entries, lsn);
+    mapfile_close(&map);
+    return ok;
+}
+
+/**
+ * Internal helpers: Fill one record from its on-disk bytes
+ */
+static void snapshot_read_patient(const unsigned char* in, int native, Patient* patient) {
+    if (native) {
+        memcpy(patient, in, SNAPSHOT_PATIENT_SIZE);
+    } else {
+        patient->id = (int)snapshot_get_u32(in);
+        memcpy(patient->name, in + 4, sizeof(patient->name));
+        patient->age = (int)snapshot_get_u32(in + 104);
+    }
+    patient->name[sizeof(patient->name) - 1] = '\0';
+}
+
+static void snapshot_read_doctor(const unsigned char* in, int native, Doctor* doctor) {
+    if (native) {
+        memcpy(doctor, in, SNAPSHOT_DOCTOR_SIZE);
+    } else {
+        doctor->id = (int)snapshot_get_u32(in);
+        memcpy(doctor->name, in + 4, sizeof(doctor->name));
+        memcpy(doctor->department, in + 104, sizeof(doctor->department));
+    }
+    doctor->name[sizeof(doctor->name) - 1] = '\0';
+    doctor->department[sizeof(doctor->department) - 1] = '\0';
+}
+
+/**
+ * Internal helpers: Create one record from its on-disk bytes
+ */
+static Patient* snapshot_decode_patient(const unsigned char* in, int native) {
+    Patient* patient = (Patient*)malloc(sizeof(Patient));
+    if (patient != NULL) {
+        snapshot_read_patient(in, native, patient);
+    }
+    return patient;
+}
+
+static Doctor* snapshot_decode_doctor(const unsigned char* in, int native) {
+    Doctor* doctor = (Doctor*)malloc(sizeof(Doctor));
+    if (doctor != NULL) {
+        snapshot_read_doctor(in, native, doctor);
+    }
+    return doctor;
+}
+
+static Appointment* snapshot_decode_appointment(const unsigned char* in, int native) {
+    Appointment* appointment = (Appointment*)malloc(sizeof(Appointment));
+    if (appointment == NULL) {
+        return NULL;
+    }
+    if (native) {
+        memcpy(appointment, in, SNAPSHOT_APPOINTMENT_SIZE);
+    } else {
+        appointment->appointment_id = (int)snapshot_get_u32(in);
+        appointment->patient_id = (int)snapshot_get_u32(in + 4);
+        appointment->doctor_id = (int)snapshot_get_u32(in + 8);
+        appointment->start_time = (int)snapshot_get_u32(in + 12);
+        appointment->end_time = (int)snapshot_get_u32(in + 16);
+    }
+    return appointment;
+}
+
+/**
+ * Internal helper: Frees the records appended after the given counts
+ */
+static void snapshot_rollback(PatientVector* patients, int patient_base,
+                              DoctorVector* doctors, int doctor_base,
+                              AppointmentVector* appointments, int appointment_base) {
+    while (patients->count > patient_base) {
+        free(patients->items[--patients->count]);
+    }
+    while (doctors->count > doctor_base) {
+        free(doctors->items[--doctors->count]);
+    }
+    while (appointments->count > appointment_base) {
+        free(appointments->items[--appointments->count]);
+    }
+}
+
+/**
+ * Internal helper: Appends the saved tree order to tree_order
+ * An order that does not describe a valid tree (index out of range, start
+ * times not strictly increasing) or does not fit in memory is ignored, so
+ * startup rebuilds the tree instead
+ * @param appointments: Vector holding the loaded appointments from base on
+ */
+static void snapshot_load_order(const MappedFile* map, const SnapshotEntry* entry,
+                                const AppointmentVector* appointments, int base,
+                                AppointmentVector* tree_order) {
+    int order_base = tree_order->count;
+    uint32_t loaded = (uint32_t)(appointments->count - base);
+    if (entry->count == 0 || entry->count > loaded ||
+        (int)entry->count > INT_MAX - order_base ||
+        !appointment_vector_reserve(tree_order, order_base + (int)entry->count)) {
+        return;
+    }
+
+    const unsigned char* in = (const unsigned char*)map->data + entry->offset;
+    const Appointment* previous = NULL;
+    for (uint32_t i = 0; i < entry->count; i++, in += SNAPSHOT_ORDER_SIZE) {
+        uint32_t index = snapshot_get_u32(in);
+        Appointment* appointment = (index < loaded) ? appointments->items[base + (int)index] : NULL;
+        if (appointment == NULL ||
+            (previous != NULL && previous->start_time >= appointment->start_time)) {
+            tree_order->count = order_base;
+            return;
+        }
+        tree_order->items[tree_order->count++] = appointment; // Space reserved above
+        previous = appointment;
+    }
+}
+
+/**
+ * Loads a snapshot, appending the records to the vectors
+ * Time Complexity: O(n)
+ * 
+ * @param path: Snapshot file path
+ * @param expected_lsn: Required snapshot LSN
+ * @return: 1 on success, 0 on failure (vectors unchanged)
+ */
+int snapshot_load(const char* path, unsigned long long expected_lsn,
+                  PatientVector* patients, DoctorVector* doctors,
+                  AppointmentVector* appointments, AppointmentVector* tree_order) {
+    if (path == NULL || (patients == NULL) != (doctors == NULL) || appointments == NULL) {
+        return 0;
+    }
+
+    // Without vectors for them the patient and doctor sections are left on disk
+    PatientVector no_patients;
+    DoctorVector no_doctors;
+    int lazy = (patients == NULL);
+    if (lazy) {
+        patient_vector_init(&no_patients);
+        doctor_vector_init(&no_doctors);
+        patients = &no_patients;
+        doctors = &no_doctors;
+    }
+
+    MappedFile map;
+    if (!mapfile_open(&map, path)) {
+        return 0;
+    }
+
+    // Header, bounds and every checksum are verified before any record is created
+    SnapshotEntry entries[SNAPSHOT_SECTION_COUNT];
+    unsigned long long lsn = 0;
+    int ok = snapshot_parse_header(&map, entries, &lsn) && lsn == expected_lsn;
+    for (int i = 0; ok && i < SNAPSHOT_SECTION_COUNT; i++) {
+        if (lazy && i != SNAPSHOT_APPOINTMENTS - 1 && i != SNAPSHOT_APPOINTMENT_ORDER - 1) {
+            entries[i].count = (i < SNAPSHOT_APPOINTMENTS) ? 0 : entries[i].count;
+            continue;
+        }
+        ok = crc32_update(0, (const unsigned char*)map.data + entries[i].offset,
+                            (size_t)entries[i].count * entries[i].record_size) == entries[i].crc;
+    }
+
+    int patient_base = patients->count;
+    int doctor_base = doctors->count;
+    int appointment_base = appointments->count;
+    ok = ok &&
+         (int)entries[0].count <= INT_MAX - patient_base &&
+         (int)entries[1].count <= INT_MAX - doctor_base &&
+         (int)entries[2].count <= INT_MAX - appointment_base &&
+         patient_vector_reserve(patients, patient_base + (int)entries[0].count) &&
+         doctor_vector_reserve(doctors, doctor_base + (int)entries[1].count) &&
+         appointment_vector_reserve(appointments, appointment_base + (int)entries[2].count);
+
+    if (ok) {
+        int native = snapshot_native_layout();
+        const unsigned char* in = (const unsigned char*)map.data + entries[0].offset;
+        for (uint32_t i = 0; ok && i < entries[0].count; i++, in += SNAPSHOT_PATIENT_SIZE) {
+            Patient* patient = snapshot_decode_patient(in, native);
+            ok = patient != NULL;
+            if (ok) {
+                patients->items[patients->count++] = patient; // Space reserved above
+            }
+        }
+        in = (const unsigned char*)map.data + entries[1].offset;
+        for (uint32_t i = 0; ok && i < entries[1].count; i++, in += SNAPSHOT_DOCTOR_SIZE) {
+            Doctor* doctor = snapshot_decode_doctor(in, native);
+            ok = doctor != NULL;
+            if (ok) {
+                doctors->items[doctors->count++] = doctor;
+            }
+        }
+        in = (const unsigned char*)map.data + entries[2].offset;
+        for (uint32_t i = 0; ok && i < entries[2].count; i++, in += SNAPSHOT_APPOINTMENT_SIZE) {
+            Appointment* appointment = snapshot_decode_appointment(in, native);
+            ok = appointment != NULL;
+            if (ok) {
+                appointments->items[appointments->count++] = appointment;
+            }
+        }
+        if (!ok) {
+            snapshot_rollback(patients, patient_base, doctors, doctor_base,
+                              appointments, appointment_base);
+        } else if (tree_order != NULL) {
+            snapshot_load_order(&map, &entries[SNAPSHOT_APPOINTMENT_ORDER - 1],
+                                appointments, appointment_base, tree_order);
+        }
+    }
+
+    mapfile_close(&map);
+    return ok;
+}
+
+/**
+ * Internal helper: Highest ID of an index section (its last entry), 0 if empty
+ */
+static int snapshot_index_max(const MappedFile* map, const SnapshotEntry* entry) {
+    if (entry->count == 0) {
+        return 0;
+    }
+    const unsigned char* last = (const unsigned char*)map->data + entry->offset +
+                                (size_t)(entry->count - 1) * SNAPSHOT_INDEX_SIZE;
+    return (int)snapshot_get_u32(last);
+}
+
+/**
+ * Reads the table sizes and highest IDs of a snapshot
+ * Time Complexity: O(1)
+ * 
+ * @param path: Snapshot file path
+ * @param info: Receives the sizes
+ * @return: 1 on success, 0 if the file is missing or its header is invalid
+ */
+int snapshot_read_info(const char* path, SnapshotInfo* info) {
+    if (path == NULL || info == NULL) {
+        return 0;
+    }
+
+    MappedFile map;
+    if (!mapfile_open(&map, path)) {
+        return 0;
+    }
+    SnapshotEntry entries[SNAPSHOT_SECTION_COUNT];
+    int ok = snapshot_parse_header(&map, entries, &info->lsn);
+    if (ok) {
+        info->patient_count = (int)entries[SNAPSHOT_PATIENTS - 1].count;
+        info->doctor_count = (int)entries[SNAPSHOT_DOCTORS - 1].count;
+        info->appointment_count = (int)entries[SNAPSHOT_APPOINTMENTS - 1].count;
+        info->max_patient_id = snapshot_index_max(&map, &entries[SNAPSHOT_PATIENT_INDEX - 1]);
+        info->max_doctor_id = snapshot_index_max(&map, &entries[SNAPSHOT_DOCTOR_INDEX - 1]);
+    }
+    mapfile_close(&map);
+    return ok;
+}
+
+/**
+ * Internal helper: Binary searches the index of a table for an ID
+ * @param table: 0 for patients, 1 for doctors
+ * @param record_out: Receives a pointer to the record bytes if found
+ * @return: 1 if found, 0 if the ID is absent, -1 if the index points
+ *          outside the section or disagrees with the record
+ */
+static int snapshot_index_find(const MappedFile* map, const SnapshotEntry* entries,
+                               int table, int id, const unsigned char** record_out) {
+    const SnapshotEntry* index = &entries[snapshot_index_sections[table]];
+    const unsigned char* base = (const unsigned char*)map->data + index->offset;
+    uint32_t low = 0;
+    uint32_t high = index->count;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if ((int)snapshot_get_u32(base + (size_t)mid * SNAPSHOT_INDEX_SIZE) < id) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low == index->count || (int)snapshot_get_u32(base + (size_t)low * SNAPSHOT_INDEX_SIZE) != id) {
+        return 0;
+    }
+
+    const SnapshotEntry* section = &entries[table];
+    uint32_t record = snapshot_get_u32(base + (size_t)low * SNAPSHOT_INDEX_SIZE + 4);
+    if (record >= section->count) {
+        return -1;
+    }
+    const unsigned char* in = (const unsigned char*)map->data + section->offset +
+                              (size_t)record * section->record_size;
+    if ((int)snapshot_get_u32(in) != id) {
+        return -1; // Index and record must agree
+    }
+    *record_out = in;
+    return 1;
+}
+
+/**
+ * Reads one patient by ID through the sorted index
+ * Time Complexity: O(log n)
+ * 
+ * @return: 1 if found, 0 if absent, -1 if the file is missing or invalid
+ */
+int snapshot_find_patient(const char* path, int id, Patient* patient) {
+    if (path == NULL || patient == NULL) {
+        return -1;
+    }
+
+    MappedFile map;
+    if (!mapfile_open(&map, path)) {
+        return -1;
+    }
+    SnapshotEntry entries[SNAPSHOT_SECTION_COUNT];
+    unsigned long long lsn = 0;
+    const unsigned char* in = NULL;
+    int found = snapshot_parse_header(&map, entries, &lsn)
+                ? snapshot_index_find(&map, entries, 0, id, &in) : -1;
+    if (found > 0) {
+        snapshot_read_patient(in, snapshot_native_layout(), patient);
+    }
+    mapfile_close(&map);
+    return found;
+}
+
+/**
+ * Reads one doctor by ID through the sorted index
+ * Time Complexity: O(log n)
+ * 
+ * @return: 1 if found, 0 if absent, -1 if the file is missing or invalid
+ */
+int snapshot_find_doctor(const char* path, int id, Doctor* doctor) {
+    if (path == NULL || doctor == NULL) {
+        return -1;
+    }
+
+    MappedFile map;
+    if (!mapfile_open(&map, path)) {
+        return -1;
+    }
+    SnapshotEntry entries[SNAPSHOT_SECTION_COUNT];
+    unsigned long long lsn = 0;
+    const unsigned char* in = NULL;
+    int found = snapshot_parse_header(&map, entries, &lsn)
+                ? snapshot_index_find(&map, entries, 1, id, &in) : -1;
+    if (found > 0) {
+        snapshot_read_doctor(in, snapshot_native_layout(), doctor);
+    }
+    mapfile_close(&map);
+    return found;
+}
+
+/**
+ * Internal helper: Maps a snapshot and verifies one table section
+ * @return: Pointer to the first record (entry receives the section), NULL
+ *          if the file is missing or invalid; map is open only on success
+ */
+static const unsigned char* snapshot_open_section(MappedFile* map, const char* path, int table,
+                                                  SnapshotEntry* entry) {
+    if (path == NULL || !mapfile_open(map, path)) {
+        return NULL;
+    }
+    SnapshotEntry entries[SNAPSHOT_SECTION_COUNT];
+    unsigned long long lsn = 0;
+    if (!snapshot_parse_header(map, entries, &lsn) ||
+        crc32_update(0, (const unsigned char*)map->data + entries[table].offset,
+                       (size_t)entries[table].count * entries[table].record_size) != entries[table].crc) {
+        mapfile_close(map);
+        return NULL;
+    }
+    *entry = entries[table];
+    return (const unsigned char*)map->data + entry->offset;
+}
+
+/**
+ * Streams the patients of a snapshot in file order
+ * Time Complexity: O(p)
+ * 
+ * @return: 1 if every record was visited or the visitor stopped, 0 if the file is missing or invalid
+ */
+int snapshot_visit_patients(const char* path, PatientVisitor visitor, void* context) {
+    MappedFile map;
+    SnapshotEntry entry;
+    const unsigned char* in = (visitor != NULL) ? snapshot_open_section(&map, path, 0, &entry) : NULL;
+    if (in == NULL) {
+        return 0;
+    }
+    int native = snapshot_native_layout();
+    Patient patient;
+    for (uint32_t i = 0; i < entry.count; i++, in += SNAPSHOT_PATIENT_SIZE) {
+        snapshot_read_patient(in, native, &patient);
+        if (!visitor(&patient, context)) {
+            break;
+        }
+    }
+    mapfile_close(&map);
+    return 1;
+}
+
+/**
+ * Streams the doctors of a snapshot in file order
+ * Time Complexity: O(d)
+ * 
+ * @return: 1 if every record was visited or the visitor stopped, 0 if the file is missing or invalid
+ */
+int snapshot_visit_doctors(const char* path, DoctorVisitor visitor, void* context) {
+    MappedFile map;
+    SnapshotEntry entry;
+    const unsigned char* in = (visitor != NULL) ? snapshot_open_section(&map, path, 1, &entry) : NULL;
+    if (in == NULL) {
+        return 0;
+    }
+    int native = snapshot_native_layout();
+    Doctor doctor;
+    for (uint32_t i = 0; i < entry.count; i++, in += SNAPSHOT_DOCTOR_SIZE) {
+        snapshot_read_doctor(in, native, &doctor);
+        if (!visitor(&doctor, context)) {
+            break;
+        }
+    }
+    mapfile_close(&map);
+    return 1;
+}
+
+/**
+ * Internal helper: Frees the records of the three vectors and the vectors
+ */
+static void snapshot_free_vectors(PatientVector* patients, DoctorVector* doctors,
+                                  AppointmentVector* appointments) {
+    snapshot_rollback(patients, 0, doctors, 0, appointments, 0);
+    patient_vector_destroy(patients);
+    doctor_vector_destroy(doctors);
+    appointment_vector_destroy(appointments);
+}
+
+/**
+ * Converts the CSV files into a snapshot
+ * Time Complexity: O(n)
+ * 
+ * @return: 1 on success, 0 on failure
+ */
+int snapshot_import_csv(const char* path, unsigned long long lsn,
+                        const char* patients_csv, const char* doctors_csv,
+                        const char* appointments_csv) {
+    if (path == NULL || patients_csv == NULL || doctors_csv == NULL || appointments_csv == NULL) {
+        return 0;
+    }
+
+    PatientVector patients;
+    DoctorVector doctors;
+    AppointmentVector appointments;
+    patient_vector_init(&patients);
+    doctor_vector_init(&doctors);
+    appointment_vector_init(&appointments);
+
+    load_patients_from_csv(patients_csv, &patients);
+    load_doctors_from_csv(doctors_csv, &doctors);
+    load_appointments_from_csv(appointments_csv, &appointments);
+    int ok = snapshot_save(path, lsn, patients.items, patients.count,
+                           doctors.items, doctors.count,
+                           appointments.items, appointments.count, NULL, 0);
+
+    snapshot_free_vectors(&patients, &doctors, &appointments);
+    return ok;
+}
+
+/**
+ * Converts a snapshot into CSV files
+ * Time Complexity: O(n)
+ * 
+ * @return: 1 on success, 0 on failure
+ */
+int snapshot_export_csv(const char* path, const char* patients_csv,
+                        const char* doctors_csv, const char* appointments_csv) {
+    if (path == NULL || patients_csv == NULL || doctors_csv == NULL || appointments_csv == NULL) {
+        return 0;
+    }
+
+    unsigned long long lsn = 0;
+    if (!snapshot_read_lsn(path, &lsn)) {
+        return 0;
+    }
+
+    PatientVector patients;
+    DoctorVector doctors;
+    AppointmentVector appointments;
+    patient_vector_init(&patients);
+    doctor_vector_init(&doctors);
+    appointment_vector_init(&appointments);
+
+    int ok = snapshot_load(path, lsn, &patients, &doctors, &appointments, NULL) &&
+             save_patients_to_csv(patients_csv, patients.items, patients.count) == patients.count &&
+             save_doctors_to_csv(doctors_csv, doctors.items, doctors.count) == doctors.count &&
+             save_appointments_to_csv(appointments_csv, appointments.items,
+                                      appointments.count) == appointments.count;
+
+    snapshot_free_vectors(&patients, &doctors, &appointments);
+    return ok;
+}
@@ -0,0 +1,199 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "patient.h"
+#include "doctor.h"
+#include "appointment.h"
+#include "vector.h"
+#include "file_io.h"
+
+/**
+ * Binary Snapshot
+ *
+ * Fixed-size binary copy of patients, doctors and appointments, written
+ * next to the CSV files by every checkpoint so startup does not have to
+ * parse text. The CSV files stay the import/export format; the converters
+ * below turn one into the other.
+ *
+ * File layout (all integers little-endian):
+ *   header (SNAPSHOT_HEADER_SIZE bytes):
+ *     "RSNP" magic (4 bytes), version (u32), snapshot LSN (u64),
+ *     section count (u32), header CRC-32 (u32, computed with this field 0),
+ *     then one entry per section:
+ *       kind (u32), record size (u32), offset (u64), count (u32), CRC-32 (u32)
+ *   sections (8-byte aligned, in kind order): count fixed-size records
+ *     patient     (108): i32 id, char name[100], i32 age
+ *     doctor      (156): i32 id, char name[100], char department[50], u16 0
+ *     appointment  (20): i32 id, i32 patient_id, i32 doctor_id,
+ *                        i32 start_time, i32 end_time
+ *     order         (4): u32 index into the appointment section
+ *     patient index (8): i32 id, u32 record number in the patient section
+ *     doctor index  (8): i32 id, u32 record number in the doctor section
+ *   Strings are NUL-padded to their full width. Index entries are sorted by
+ *   id and there is exactly one per record.
+ *
+ * The order section is the AVL tree in start_time order at save time. Startup
+ * builds the tree from it directly (avl_build_sorted) instead of inserting
+ * every appointment with a conflict scan. It is empty when no tree was given
+ * (CSV import) or the tree could not be matched to the records; startup then
+ * rebuilds the tree and the next checkpoint stores it.
+ *
+ * The loader maps the file, verifies every checksum and only then creates
+ * records. On little-endian hosts where the structs have exactly the record
+ * layout, each record is created with a single memcpy.
+ *
+ * The ID indexes let a single patient or doctor be read by binary search
+ * without loading the table (snapshot_find_*, used by the lazy registry);
+ * such lookups check the header but not the section checksums.
+ *
+ * The snapshot LSN ties the file to the checkpoint marker: startup only
+ * uses a snapshot taken at the marker's LSN and falls back to the CSV files
+ * otherwise.
+ */
+
+/**
+ * Default snapshot path
+ */
+#define SNAPSHOT_DEFAULT_PATH "data/snapshot.bin"
+
+/**
+ * Format version, header and record sizes
+ */
+#define SNAPSHOT_VERSION 3
+#define SNAPSHOT_SECTION_COUNT 6
+#define SNAPSHOT_HEADER_SIZE (24 + SNAPSHOT_SECTION_COUNT * 24)
+#define SNAPSHOT_PATIENT_SIZE 108
+#define SNAPSHOT_DOCTOR_SIZE 156
+#define SNAPSHOT_APPOINTMENT_SIZE 20
+#define SNAPSHOT_ORDER_SIZE 4
+#define SNAPSHOT_INDEX_SIZE 8
+
+/**
+ * Section kinds
+ */
+typedef enum {
+    SNAPSHOT_PATIENTS = 1,
+    SNAPSHOT_DOCTORS = 2,
+    SNAPSHOT_APPOINTMENTS = 3,
+    SNAPSHOT_APPOINTMENT_ORDER = 4,
+    SNAPSHOT_PATIENT_INDEX = 5,
+    SNAPSHOT_DOCTOR_INDEX = 6
+} SnapshotSection;
+
+/**
+ * Table sizes and highest IDs of a snapshot (read from the header and indexes)
+ */
+typedef struct {
+    unsigned long long lsn;
+    int patient_count;
+    int doctor_count;
+    int appointment_count;
+    int max_patient_id;  // 0 when there are no patients
+    int max_doctor_id;   // 0 when there are no doctors
+} SnapshotInfo;
+
+/**
+ * Snapshot Operations
+ * Time Complexity: O(n) save and load
+ */
+
+/**
+ * Writes a snapshot atomically ("<path>.tmp", fsync, rename)
+ * NULL entries in the arrays are skipped
+ * @param path: Snapshot file path
+ * @param lsn: Log position the records correspond to
+ * @param patients, doctors, appointments: Record pointer arrays
+ * @param patient_count, doctor_count, appointment_count: Array lengths
+ * @param tree_order: AVL tree contents in start_time order (NULL for none);
+ *                    entries are matched to appointments by ID and fields
+ * @param tree_count: Length of tree_order
+ * @return: 1 on success, 0 on failure (an existing snapshot is left intact)
+ */
+int snapshot_save(const char* path, unsigned long long lsn,
+                  Patient** patients, int patient_count,
+                  Doctor** doctors, int doctor_count,
+                  Appointment** appointments, int appointment_count,
+                  Appointment** tree_order, int tree_count);
+
+/**
+ * Loads a snapshot, appending the records to the vectors
+ * Nothing is appended unless the whole file is valid
+ * @param path: Snapshot file path
+ * @param expected_lsn: Required snapshot LSN
+ * @param patients, doctors: Vectors to append to, or both NULL to skip the
+ *                           patient and doctor sections (not loaded, not
+ *                           checksummed; see snapshot_find_*)
+ * @param appointments: Vector to append to
+ * @param tree_order: Receives the loaded appointments in saved tree order
+ *                    (may be NULL; left empty if the file has no usable order)
+ * @return: 1 on success, 0 if the file is missing, corrupt, from another
+ *          LSN or memory ran out
+ */
+int snapshot_load(const char* path, unsigned long long expected_lsn,
+                  PatientVector* patients, DoctorVector* doctors,
+                  AppointmentVector* appointments, AppointmentVector* tree_order);
+
+/**
+ * Reads the LSN stored in a snapshot header
+ * @param path: Snapshot file path
+ * @param lsn: Receives the LSN
+ * @return: 1 on success, 0 if the file is missing or its header is invalid
+ */
+int snapshot_read_lsn(const char* path, unsigned long long* lsn);
+
+/**
+ * Reads the table sizes and highest IDs of a snapshot
+ * Time Complexity: O(1), the header and the last index entries
+ * @param path: Snapshot file path
+ * @param info: Receives the sizes
+ * @return: 1 on success, 0 if the file is missing or its header is invalid
+ */
+int snapshot_read_info(const char* path, SnapshotInfo* info);
+
+/**
+ * Reads one patient or doctor by ID through the sorted index
+ * Time Complexity: O(log n), only the touched index pages and the record are read
+ * @param path: Snapshot file path
+ * @param id: Record ID
+ * @param patient / doctor: Receives the record
+ * @return: 1 if found, 0 if absent, -1 if the file is missing or invalid
+ */
+int snapshot_find_patient(const char* path, int id, Patient* patient);
+int snapshot_find_doctor(const char* path, int id, Doctor* doctor);
+
+/**
+ * Streams the patients or doctors of a snapshot in file order
+ * The section checksum is verified before the first record is visited
+ * @param path: Snapshot file path
+ * @param visitor: Called once per record (return 0 to stop)
+ * @param context: Passed to the visitor
+ * @return: 1 if every record was visited or the visitor stopped, 0 if the
+ *          file is missing or invalid
+ */
+int snapshot_visit_patients(const char* path, PatientVisitor visitor, void* context);
+int snapshot_visit_doctors(const char* path, DoctorVisitor visitor, void* context);
+
+/**
+ * Converts the CSV files into a snapshot
+ * No tree order is written; the first startup rebuilds the tree
+ * @param path: Snapshot file path to write
+ * @param lsn: Log position the CSV files correspond to
+ * @param patients_csv, doctors_csv, appointments_csv: CSV file paths
+ * @return: 1 on success, 0 on failure
+ */
+int snapshot_import_csv(const char* path, unsigned long long lsn,
+                        const char* patients_csv, const char* doctors_csv,
+                        const char* appointments_csv);
+
+/**
+ * Converts a snapshot into CSV files
+ * @param path: Snapshot file path to read
+ * @param patients_csv, doctors_csv, appointments_csv: CSV file paths to write
+ * @return: 1 on success, 0 on failure
+ */
+int snapshot_export_csv(const char* path, const char* patients_csv,
+                        const char* doctors_csv, const char* appointments_csv);
+
+#endif // SNAPSHOT_H
@@ -1,7 +1,8 @@
 /**
  * Sıralama ve Arama Algoritmaları Uygulaması
  * 
- * Bu dosya MergeSort, HeapSort ve Binary Search algoritmalarını içerir.
+ * Bu dosya MergeSort, HeapSort, sayma/taban sıralaması ve Binary Search
+ * algoritmalarını içerir.
  * Tüm algoritmalar manuel olarak uygulanmıştır (hazır kütüphane kullanılmamıştır).
  */
 
@@ -11,166 +12,260 @@
  * Yardımcı Fonksiyon: İki sıralı randevu alt dizisini birleştirir
  * MergeSort algoritmasının birleştirme (merge) adımı
  * 
+ * src[left..mid] ve src[mid+1..right] sıralı parçaları dst[left..right]
+ * aralığına yazılır; bellek ayrılmaz. Parçalar zaten sıralıysa (sol
+ * parçanın sonu sağ parçanın başından büyük değilse) yalnızca kopyalanır.
+ * 
  * Zaman Karmaşıklığı: O(n) - n = right - left + 1
- * Uzay Karmaşıklığı: O(n) - geçici dizi gerektirir
+ * Uzay Karmaşıklığı: O(1) - dst çağıran tarafından sağlanır
  * 
- * @param appointments: Randevu işaretçileri dizisi
+ * @param src: Kaynak dizi
+ * @param dst: Hedef dizi (src ile aynı olamaz)
  * @param left: Sol alt dizinin başlangıç indeksi
  * @param mid: Orta nokta (sol dizinin sonu, sağ dizinin başlangıcı)
  * @param right: Sağ alt dizinin bitiş indeksi
  */
-void merge_appointments(Appointment** appointments, int left, int mid, int right) {
-    int i, j, k;
-    int n1 = mid - left + 1;  // Sol alt dizinin boyutu
-    int n2 = right - mid;     // Sağ alt dizinin boyutu
-
-    // Geçici diziler oluştur
-    Appointment** left_arr = (Appointment**)malloc(n1 * sizeof(Appointment*));
-    Appointment** right_arr = (Appointment**)malloc(n2 * sizeof(Appointment*));
-
-    if (left_arr == NULL || right_arr == NULL) {
-        // Bellek hatası - işlemi durdur
-        if (left_arr != NULL) free(left_arr);
-        if (right_arr != NULL) free(right_arr);
+static void merge_appointments(Appointment** src, Appointment** dst, int left, int mid, int right) {
+    int i = left;     // Sol alt dizinin indeksi
+    int j = mid + 1;  // Sağ alt dizinin indeksi
+    int k = left;     // Birleştirilmiş dizinin indeksi
+
+    if (mid >= right || src[mid]->start_time <= src[mid + 1]->start_time) {
+        while (k <= right) {
+            dst[k] = src[k];
+            k++;
+        }
         return;
     }
 
-    // Verileri geçici dizilere kopyala
-    for (i = 0; i < n1; i++) {
-        left_arr[i] = appointments[left + i];
-    }
-    for (j = 0; j < n2; j++) {
-        right_arr[j] = appointments[mid + 1 + j];
-    }
-
-    // İki alt diziyi birleştir (sıralı şekilde)
-    i = 0;  // Sol alt dizinin indeksi
-    j = 0;  // Sağ alt dizinin indeksi
-    k = left;  // Birleştirilmiş dizinin indeksi
-
-    while (i < n1 && j < n2) {
-        // start_time'a göre karşılaştır
-        if (left_arr[i]->start_time <= right_arr[j]->start_time) {
-            appointments[k] = left_arr[i];
-            i++;
+    // İki alt diziyi birleştir (eşitlikte sol taraf önce: kararlı)
+    while (i <= mid && j <= right) {
+        if (src[i]->start_time <= src[j]->start_time) {
+            dst[k++] = src[i++];
         } else {
-            appointments[k] = right_arr[j];
-            j++;
+            dst[k++] = src[j++];
         }
-        k++;
     }
 
-    // Kalan elemanları kopyala (sol alt diziden)
-    while (i < n1) {
-        appointments[k] = left_arr[i];
-        i++;
-        k++;
+    // Kalan elemanları kopyala
+    while (i <= mid) {
+        dst[k++] = src[i++];
     }
-
-    // Kalan elemanları kopyala (sağ alt diziden)
-    while (j < n2) {
-        appointments[k] = right_arr[j];
-        j++;
-        k++;
+    while (j <= right) {
+        dst[k++] = src[j++];
     }
+}
 
-    // Geçici dizileri serbest bırak
-    free(left_arr);
-    free(right_arr);
+/**
+ * Yardımcı Fonksiyon: Küçük bir randevu aralığını araya eklemeyle sıralar
+ * (kararlı; kısa parçalarda birleştirmeden hızlı)
+ */
+static void insertion_sort_appointments(Appointment** appointments, int left, int right) {
+    for (int i = left + 1; i <= right; i++) {
+        Appointment* current = appointments[i];
+        int j = i - 1;
+        while (j >= left && appointments[j]->start_time > current->start_time) {
+            appointments[j + 1] = appointments[j];
+            j--;
+        }
+        appointments[j + 1] = current;
+    }
 }
 
 /**
- * MergeSort algoritması - Randevular için
- * Böl ve fethet (divide and conquer) yaklaşımı kullanır
+ * MergeSort algoritması - Randevular için (çağıranın geçici dizisiyle)
+ * Aşağıdan yukarı (iteratif) birleştirme: önce SORT_INSERTION_CUTOFF
+ * uzunluğundaki parçalar araya eklemeyle sıralanır, sonra parça genişliği
+ * her turda ikiye katlanarak dizi ile geçici dizi arasında gidip gelinir
  * 
  * Zaman Karmaşıklığı: O(n log n) - her durumda garantili
- * Uzay Karmaşıklığı: O(n) - geçici dizi gerektirir
+ * Uzay Karmaşıklığı: O(n) - tek geçici dizi, özyineleme yok
  * Kararlılık: Evet (stabil sıralama)
  * 
  * @param appointments: Randevu işaretçileri dizisi
  * @param left: Sol indeks
  * @param right: Sağ indeks
+ * @param scratch: En az right - left + 1 elemanlık geçici dizi (NULL ise
+ *                 bir kez ayrılır)
  */
-void merge_sort_appointments(Appointment** appointments, int left, int right) {
-    if (appointments == NULL || left < 0 || right < 0) {
+void merge_sort_appointments_scratch(Appointment** appointments, int left, int right,
+                                     Appointment** scratch) {
+    if (appointments == NULL || left < 0 || right < 0 || left >= right) {
         return;
     }
 
-    if (left < right) {
-        // Orta noktayı bul
-        int mid = left + (right - left) / 2;
+    int n = right - left + 1;
+    Appointment** a = appointments + left;
+    for (int lo = 0; lo < n; lo += SORT_INSERTION_CUTOFF) {
+        int hi = lo + SORT_INSERTION_CUTOFF - 1;
+        insertion_sort_appointments(a, lo, hi < n - 1 ? hi : n - 1);
+    }
+    if (n <= SORT_INSERTION_CUTOFF) {
+        return;
+    }
 
-        // Sol yarıyı sırala
-        merge_sort_appointments(appointments, left, mid);
+    Appointment** owned = NULL;
+    if (scratch == NULL) {
+        owned = (Appointment**)malloc((size_t)n * sizeof(Appointment*));
+        if (owned == NULL) {
+            // Bellek hatası - yavaş ama doğru sıralamaya düş
+            insertion_sort_appointments(a, 0, n - 1);
+            return;
+        }
+        scratch = owned;
+    }
 
-        // Sağ yarıyı sırala
-        merge_sort_appointments(appointments, mid + 1, right);
+    // Her tur src'deki sıralı parçaları ikişer ikişer dst'ye birleştirir
+    Appointment** src = a;
+    Appointment** dst = scratch;
+    for (int width = SORT_INSERTION_CUTOFF; width < n; width *= 2) {
+        for (int lo = 0; lo < n; lo += 2 * width) {
+            int mid = (lo + width < n ? lo + width : n) - 1;
+            int hi = (lo + 2 * width < n ? lo + 2 * width : n) - 1;
+            merge_appointments(src, dst, lo, mid, hi);
+        }
+        Appointment** temp = src;
+        src = dst;
+        dst = temp;
+    }
 
-        // İki sıralı yarıyı birleştir
-        merge_appointments(appointments, left, mid, right);
+    // Son tur geçici diziye yazdıysa sonucu geri kopyala
+    if (src != a) {
+        for (int i = 0; i < n; i++) {
+            a[i] = src[i];
+        }
     }
+    free(owned);
+}
+
+/**
+ * MergeSort algoritması - Randevular için
+ * Geçici dizi sıralama başına bir kez ayrılır
+ * 
+ * Zaman Karmaşıklığı: O(n log n) - her durumda garantili
+ * Uzay Karmaşıklığı: O(n) - geçici dizi gerektirir
+ * Kararlılık: Evet (stabil sıralama)
+ * 
+ * @param appointments: Randevu işaretçileri dizisi
+ * @param left: Sol indeks
+ * @param right: Sağ indeks
+ */
+void merge_sort_appointments(Appointment** appointments, int left, int right) {
+    merge_sort_appointments_scratch(appointments, left, right, NULL);
 }
 
 /**
  * Yardımcı Fonksiyon: İki sıralı hasta alt dizisini birleştirir
+ * src[left..mid] ve src[mid+1..right] -> dst[left..right], bellek ayrılmaz
  * Zaman Karmaşıklığı: O(n)
  * 
- * @param patients: Hasta işaretçileri dizisi
+ * @param src: Kaynak dizi
+ * @param dst: Hedef dizi (src ile aynı olamaz)
  * @param left: Sol alt dizinin başlangıç indeksi
  * @param mid: Orta nokta
  * @param right: Sağ alt dizinin bitiş indeksi
  */
-void merge_patients(Patient** patients, int left, int mid, int right) {
-    int i, j, k;
-    int n1 = mid - left + 1;
-    int n2 = right - mid;
+static void merge_patients(Patient** src, Patient** dst, int left, int mid, int right) {
+    int i = left;
+    int j = mid + 1;
+    int k = left;
+
+    if (mid >= right || src[mid]->id <= src[mid + 1]->id) {
+        while (k <= right) {
+            dst[k] = src[k];
+            k++;
+        }
+        return;
+    }
 
-    Patient** left_arr = (Patient**)malloc(n1 * sizeof(Patient*));
-    Patient** right_arr = (Patient**)malloc(n2 * sizeof(Patient*));
+    while (i <= mid && j <= right) {
+        // ID'ye göre karşılaştır
+        if (src[i]->id <= src[j]->id) {
+            dst[k++] = src[i++];
+        } else {
+            dst[k++] = src[j++];
+        }
+    }
 
-    if (left_arr == NULL || right_arr == NULL) {
-        if (left_arr != NULL) free(left_arr);
-        if (right_arr != NULL) free(right_arr);
-        return;
+    while (i <= mid) {
+        dst[k++] = src[i++];
     }
+    while (j <= right) {
+        dst[k++] = src[j++];
+    }
+}
 
-    for (i = 0; i < n1; i++) {
-        left_arr[i] = patients[left + i];
+/**
+ * Yardımcı Fonksiyon: Küçük bir hasta aralığını araya eklemeyle sıralar
+ */
+static void insertion_sort_patients(Patient** patients, int left, int right) {
+    for (int i = left + 1; i <= right; i++) {
+        Patient* current = patients[i];
+        int j = i - 1;
+        while (j >= left && patients[j]->id > current->id) {
+            patients[j + 1] = patients[j];
+            j--;
+        }
+        patients[j + 1] = current;
     }
-    for (j = 0; j < n2; j++) {
-        right_arr[j] = patients[mid + 1 + j];
+}
+
+/**
+ * MergeSort algoritması - Hastalar için (çağıranın geçici dizisiyle)
+ * ID'ye göre sıralar; aşağıdan yukarı, araya ekleme eşiğiyle
+ * 
+ * Zaman Karmaşıklığı: O(n log n)
+ * 
+ * @param patients: Hasta işaretçileri dizisi
+ * @param left: Sol indeks
+ * @param right: Sağ indeks
+ * @param scratch: En az right - left + 1 elemanlık geçici dizi (NULL ise
+ *                 bir kez ayrılır)
+ */
+void merge_sort_patients_scratch(Patient** patients, int left, int right, Patient** scratch) {
+    if (patients == NULL || left < 0 || right < 0 || left >= right) {
+        return;
     }
 
-    i = 0;
-    j = 0;
-    k = left;
+    int n = right - left + 1;
+    Patient** a = patients + left;
+    for (int lo = 0; lo < n; lo += SORT_INSERTION_CUTOFF) {
+        int hi = lo + SORT_INSERTION_CUTOFF - 1;
+        insertion_sort_patients(a, lo, hi < n - 1 ? hi : n - 1);
+    }
+    if (n <= SORT_INSERTION_CUTOFF) {
+        return;
+    }
 
-    while (i < n1 && j < n2) {
-        // ID'ye göre karşılaştır
-        if (left_arr[i]->id <= right_arr[j]->id) {
-            patients[k] = left_arr[i];
-            i++;
-        } else {
-            patients[k] = right_arr[j];
-            j++;
+    Patient** owned = NULL;
+    if (scratch == NULL) {
+        owned = (Patient**)malloc((size_t)n * sizeof(Patient*));
+        if (owned == NULL) {
+            insertion_sort_patients(a, 0, n - 1);
+            return;
         }
-        k++;
+        scratch = owned;
     }
 
-    while (i < n1) {
-        patients[k] = left_arr[i];
-        i++;
-        k++;
+    Patient** src = a;
+    Patient** dst = scratch;
+    for (int width = SORT_INSERTION_CUTOFF; width < n; width *= 2) {
+        for (int lo = 0; lo < n; lo += 2 * width) {
+            int mid = (lo + width < n ? lo + width : n) - 1;
+            int hi = (lo + 2 * width < n ? lo + 2 * width : n) - 1;
+            merge_patients(src, dst, lo, mid, hi);
+        }
+        Patient** temp = src;
+        src = dst;
+        dst = temp;
     }
 
-    while (j < n2) {
-        patients[k] = right_arr[j];
-        j++;
-        k++;
+    if (src != a) {
+        for (int i = 0; i < n; i++) {
+            a[i] = src[i];
+        }
     }
-
-    free(left_arr);
-    free(right_arr);
+    free(owned);
 }
 
 /**
@@ -184,78 +279,121 @@ void merge_patients(Patient** patients, int left, int mid, int right) {
  * @param right: Sağ indeks
  */
 void merge_sort_patients(Patient** patients, int left, int right) {
-    if (patients == NULL || left < 0 || right < 0) {
-        return;
-    }
-
-    if (left < right) {
-        int mid = left + (right - left) / 2;
-        merge_sort_patients(patients, left, mid);
-        merge_sort_patients(patients, mid + 1, right);
-        merge_patients(patients, left, mid, right);
-    }
+    merge_sort_patients_scratch(patients, left, right, NULL);
 }
 
 /**
  * Yardımcı Fonksiyon: İki sıralı doktor alt dizisini birleştirir
+ * src[left..mid] ve src[mid+1..right] -> dst[left..right], bellek ayrılmaz
  * Zaman Karmaşıklığı: O(n)
  * 
- * @param doctors: Doktor işaretçileri dizisi
+ * @param src: Kaynak dizi
+ * @param dst: Hedef dizi (src ile aynı olamaz)
  * @param left: Sol alt dizinin başlangıç indeksi
  * @param mid: Orta nokta
  * @param right: Sağ alt dizinin bitiş indeksi
  */
-void merge_doctors(Doctor** doctors, int left, int mid, int right) {
-    int i, j, k;
-    int n1 = mid - left + 1;
-    int n2 = right - mid;
+static void merge_doctors(Doctor** src, Doctor** dst, int left, int mid, int right) {
+    int i = left;
+    int j = mid + 1;
+    int k = left;
+
+    if (mid >= right || src[mid]->id <= src[mid + 1]->id) {
+        while (k <= right) {
+            dst[k] = src[k];
+            k++;
+        }
+        return;
+    }
 
-    Doctor** left_arr = (Doctor**)malloc(n1 * sizeof(Doctor*));
-    Doctor** right_arr = (Doctor**)malloc(n2 * sizeof(Doctor*));
+    while (i <= mid && j <= right) {
+        // ID'ye göre karşılaştır
+        if (src[i]->id <= src[j]->id) {
+            dst[k++] = src[i++];
+        } else {
+            dst[k++] = src[j++];
+        }
+    }
 
-    if (left_arr == NULL || right_arr == NULL) {
-        if (left_arr != NULL) free(left_arr);
-        if (right_arr != NULL) free(right_arr);
-        return;
+    while (i <= mid) {
+        dst[k++] = src[i++];
     }
+    while (j <= right) {
+        dst[k++] = src[j++];
+    }
+}
 
-    for (i = 0; i < n1; i++) {
-        left_arr[i] = doctors[left + i];
+/**
+ * Yardımcı Fonksiyon: Küçük bir doktor aralığını araya eklemeyle sıralar
+ */
+static void insertion_sort_doctors(Doctor** doctors, int left, int right) {
+    for (int i = left + 1; i <= right; i++) {
+        Doctor* current = doctors[i];
+        int j = i - 1;
+        while (j >= left && doctors[j]->id > current->id) {
+            doctors[j + 1] = doctors[j];
+            j--;
+        }
+        doctors[j + 1] = current;
     }
-    for (j = 0; j < n2; j++) {
-        right_arr[j] = doctors[mid + 1 + j];
+}
+
+/**
+ * MergeSort algoritması - Doktorlar için (çağıranın geçici dizisiyle)
+ * ID'ye göre sıralar; aşağıdan yukarı, araya ekleme eşiğiyle
+ * 
+ * Zaman Karmaşıklığı: O(n log n)
+ * 
+ * @param doctors: Doktor işaretçileri dizisi
+ * @param left: Sol indeks
+ * @param right: Sağ indeks
+ * @param scratch: En az right - left + 1 elemanlık geçici dizi (NULL ise
+ *                 bir kez ayrılır)
+ */
+void merge_sort_doctors_scratch(Doctor** doctors, int left, int right, Doctor** scratch) {
+    if (doctors == NULL || left < 0 || right < 0 || left >= right) {
+        return;
     }
 
-    i = 0;
-    j = 0;
-    k = left;
+    int n = right - left + 1;
+    Doctor** a = doctors + left;
+    for (int lo = 0; lo < n; lo += SORT_INSERTION_CUTOFF) {
+        int hi = lo + SORT_INSERTION_CUTOFF - 1;
+        insertion_sort_doctors(a, lo, hi < n - 1 ? hi : n - 1);
+    }
+    if (n <= SORT_INSERTION_CUTOFF) {
+        return;
+    }
 
-    while (i < n1 && j < n2) {
-        // ID'ye göre karşılaştır
-        if (left_arr[i]->id <= right_arr[j]->id) {
-            doctors[k] = left_arr[i];
-            i++;
-        } else {
-            doctors[k] = right_arr[j];
-            j++;
+    Doctor** owned = NULL;
+    if (scratch == NULL) {
+        owned = (Doctor**)malloc((size_t)n * sizeof(Doctor*));
+        if (owned == NULL) {
+            insertion_sort_doctors(a, 0, n - 1);
+            return;
         }
-        k++;
+        scratch = owned;
     }
 
-    while (i < n1) {
-        doctors[k] = left_arr[i];
-        i++;
-        k++;
+    Doctor** src = a;
+    Doctor** dst = scratch;
+    for (int width = SORT_INSERTION_CUTOFF; width < n; width *= 2) {
+        for (int lo = 0; lo < n; lo += 2 * width) {
+            int mid = (lo + width < n ? lo + width : n) - 1;
+            int hi = (lo + 2 * width < n ? lo + 2 * width : n) - 1;
+            merge_doctors(src, dst, lo, mid, hi);
+        }
+        Doctor** temp = src;
+        src = dst;
+        dst = temp;
     }
 
-    while (j < n2) {
-        doctors[k] = right_arr[j];
-        j++;
-        k++;
+    if (src != a) {
+        for (int i = 0; i < n; i++) {
+            a[i] = src[i];
+        }
     }
-
-    free(left_arr);
-    free(right_arr);
+    free(owned);
 }
 
 /**
@@ -269,16 +407,7 @@ void merge_doctors(Doctor** doctors, int left, int mid, int right) {
  * @param right: Sağ indeks
  */
 void merge_sort_doctors(Doctor** doctors, int left, int right) {
-    if (doctors == NULL || left < 0 || right < 0) {
-        return;
-    }
-
-    if (left < right) {
-        int mid = left + (right - left) / 2;
-        merge_sort_doctors(doctors, left, mid);
-        merge_sort_doctors(doctors, mid + 1, right);
-        merge_doctors(doctors, left, mid, right);
-    }
+    merge_sort_doctors_scratch(doctors, left, right, NULL);
 }
 
 /**
@@ -359,6 +488,296 @@ void heap_sort_appointments(Appointment** appointments, int n) {
     }
 }
 
+/**
+ * Doğrusal zamanlı sıralamalar (sayma / taban sıralaması)
+ * 
+ * start_time 0-1439 aralığında olduğundan dakikaya göre sayma sıralaması
+ * karşılaştırma yapmadan O(n) sürer. Bileşik anahtarlar (doktor, dakika)
+ * en önemsiz basamaktan başlayarak basamak basamak sıralanır (LSD radix);
+ * her geçiş kararlı olduğu için önceki basamakların sırası korunur.
+ */
+
+#define SORT_MINUTES 1440                       // start_time değer sayısı
+#define SORT_RADIX_BITS 11                      // Basamak genişliği (2048 kova >= 1440 dakika)
+#define SORT_RADIX_SIZE (1 << SORT_RADIX_BITS)
+#define SORT_PASS_MINUTE 0                      // Geçiş 0: start_time
+#define SORT_PASS_DOCTOR_LAST 3                 // Geçiş 1-3: doctor_id'nin 11+11+10 biti
+
+/**
+ * Yardımcı Fonksiyon: Bir geçişin basamağı
+ * doctor_id işaret biti çevrilerek işaretsiz sayıya dönüştürülür (negatif
+ * ID'ler de doğru sıralanır)
+ */
+static int sort_radix_digit(const Appointment* appointment, int pass) {
+    if (pass == SORT_PASS_MINUTE) {
+        return appointment->start_time;
+    }
+    unsigned int key = (unsigned int)appointment->doctor_id ^ 0x80000000u;
+    return (int)((key >> (SORT_RADIX_BITS * (pass - 1))) & (SORT_RADIX_SIZE - 1));
+}
+
+/**
+ * Yardımcı Fonksiyon: Tek basamaklı kararlı sayma geçişi (src -> dst)
+ * 
+ * Zaman Karmaşıklığı: O(n + 2048)
+ * 
+ * @return: 1 ise dst'ye yazıldı, 0 ise tüm anahtarların basamağı aynı
+ *          (geçiş atlandı, sıra değişmez)
+ */
+static int sort_radix_pass(Appointment** src, Appointment** dst, int n, int pass) {
+    int counts[SORT_RADIX_SIZE + 1] = { 0 };
+    for (int i = 0; i < n; i++) {
+        counts[sort_radix_digit(src[i], pass) + 1]++;
+    }
+    if (counts[sort_radix_digit(src[0], pass) + 1] == n) {
+        return 0;
+    }
+
+    // Önek toplamı: counts[d] = d basamağının ilk çıkış konumu
+    for (int d = 0; d < SORT_RADIX_SIZE; d++) {
+        counts[d + 1] += counts[d];
+    }
+    for (int i = 0; i < n; i++) {
+        dst[counts[sort_radix_digit(src[i], pass)]++] = src[i];
+    }
+    return 1;
+}
+
+/**
+ * Yardımcı Fonksiyon: Geçişleri en önemsiz basamaktan başlayarak uygular
+ * (0: dakika, 1..last_pass: doctor_id'nin düşükten yükseğe basamakları)
+ * NULL eleman veya 0-1439 dışında start_time varsa dizi değiştirilmez
+ * 
+ * @return: 1 ise sıralandı, 0 ise dizi değişmedi
+ */
+static int sort_radix_appointments(Appointment** appointments, int n, int last_pass) {
+    if (appointments == NULL || n < 0) {
+        return 0;
+    }
+    for (int i = 0; i < n; i++) {
+        if (appointments[i] == NULL || appointments[i]->start_time < 0 ||
+            appointments[i]->start_time >= SORT_MINUTES) {
+            return 0; // Karşılaştırmalı sıralama kullanılmalı
+        }
+    }
+    if (n < 2) {
+        return 1;
+    }
+
+    Appointment** scratch = (Appointment**)malloc((size_t)n * sizeof(Appointment*));
+    if (scratch == NULL) {
+        return 0;
+    }
+
+    // Geçişler iki dizi arasında gidip gelir; atlanan geçişte yer değişmez
+    Appointment** src = appointments;
+    Appointment** dst = scratch;
+    for (int pass = SORT_PASS_MINUTE; pass <= last_pass; pass++) {
+        if (sort_radix_pass(src, dst, n, pass)) {
+            Appointment** temp = src;
+            src = dst;
+            dst = temp;
+        }
+    }
+    if (src != appointments) {
+        for (int i = 0; i < n; i++) {
+            appointments[i] = src[i];
+        }
+    }
+
+    free(scratch);
+    return 1;
+}
+
+/**
+ * Sayma sıralaması - Randevular için (start_time'a göre)
+ * 
+ * Zaman Karmaşıklığı: O(n + 1440) - karşılaştırma yapılmaz
+ * Uzay Karmaşıklığı: O(n) - tek geçici dizi
+ * Kararlılık: Evet (aynı dakikadaki randevular giriş sırasını korur)
+ * 
+ * @param appointments: Randevu işaretçileri dizisi
+ * @param n: Randevu sayısı
+ * @return: Sıralandıysa 1, dizi değişmediyse 0
+ */
+int counting_sort_appointments(Appointment** appointments, int n) {
+    return sort_radix_appointments(appointments, n, SORT_PASS_MINUTE);
+}
+
+/**
+ * Taban sıralaması (LSD radix) - Randevular için (doctor_id, start_time)
+ * 
+ * Zaman Karmaşıklığı: O(k * n) - k = uygulanan geçiş sayısı (en fazla 4)
+ * Uzay Karmaşıklığı: O(n)
+ * Kararlılık: Evet
+ * 
+ * @param appointments: Randevu işaretçileri dizisi
+ * @param n: Randevu sayısı
+ * @return: Sıralandıysa 1, dizi değişmediyse 0
+ */
+int radix_sort_appointments_by_doctor(Appointment** appointments, int n) {
+    return sort_radix_appointments(appointments, n, SORT_PASS_DOCTOR_LAST);
+}
+
+/**
+ * Randevuları start_time'a göre sıralar (kararlı), algoritmayı boyuta göre seçer
+ * Büyük girdide sayma sıralaması, küçük girdide veya sayma sıralaması
+ * kullanılamadığında MergeSort
+ * 
+ * @param appointments: Randevu işaretçileri dizisi
+ * @param n: Randevu sayısı
+ */
+void sort_appointments_by_time(Appointment** appointments, int n) {
+    if (appointments == NULL || n < 2) {
+        return;
+    }
+    if (n >= SORT_COUNTING_MIN) {
+        if (!counting_sort_appointments(appointments, n)) {
+            merge_sort_appointments(appointments, 0, n - 1);
+        }
+        return;
+    }
+
+    // Küçük girdi: geçici dizi yığında, bellek ayrılmaz
+    Appointment* scratch[SORT_COUNTING_MIN];
+    merge_sort_appointments_scratch(appointments, 0, n - 1, scratch);
+}
+
+/**
+ * Yardımcı Fonksiyon: (doctor_id, start_time) sırasında a, b'den önce
+ * gelebilir mi? NULL elemanlar en sona gider
+ */
+static int appointment_doctor_le(const Appointment* a, const Appointment* b) {
+    if (b == NULL) {
+        return 1;
+    }
+    if (a == NULL) {
+        return 0;
+    }
+    if (a->doctor_id != b->doctor_id) {
+        return a->doctor_id < b->doctor_id;
+    }
+    return a->start_time <= b->start_time;
+}
+
+/**
+ * Yardımcı Fonksiyon: İki sıralı alt diziyi (doctor_id, start_time) sırasında
+ * birleştirir; src[left..mid] ve src[mid+1..right] -> dst[left..right]
+ * Zaman Karmaşıklığı: O(n)
+ */
+static void merge_appointments_by_doctor(Appointment** src, Appointment** dst,
+                                         int left, int mid, int right) {
+    int i = left;
+    int j = mid + 1;
+    int k = left;
+
+    // Eşitlikte sol taraf önce: kararlı
+    while (i <= mid && j <= right) {
+        if (appointment_doctor_le(src[i], src[j])) {
+            dst[k++] = src[i++];
+        } else {
+            dst[k++] = src[j++];
+        }
+    }
+    while (i <= mid) {
+        dst[k++] = src[i++];
+    }
+    while (j <= right) {
+        dst[k++] = src[j++];
+    }
+}
+
+/**
+ * Yardımcı Fonksiyon: Küçük bir aralığı (doctor_id, start_time) sırasında
+ * araya eklemeyle sıralar (kararlı)
+ */
+static void insertion_sort_appointments_by_doctor(Appointment** appointments, int left, int right) {
+    for (int i = left + 1; i <= right; i++) {
+        Appointment* current = appointments[i];
+        int j = i - 1;
+        while (j >= left && !appointment_doctor_le(appointments[j], current)) {
+            appointments[j + 1] = appointments[j];
+            j--;
+        }
+        appointments[j + 1] = current;
+    }
+}
+
+/**
+ * Yardımcı Fonksiyon: (doctor_id, start_time) sırasında aşağıdan yukarı MergeSort
+ * merge_sort_appointments_scratch ile aynı düzen
+ * 
+ * Zaman Karmaşıklığı: O(n log n)
+ * Uzay Karmaşıklığı: O(n)
+ * 
+ * @param scratch: En az n elemanlık geçici dizi (NULL ise bir kez ayrılır)
+ */
+static void merge_sort_appointments_by_doctor(Appointment** appointments, int n,
+                                              Appointment** scratch) {
+    for (int lo = 0; lo < n; lo += SORT_INSERTION_CUTOFF) {
+        int hi = lo + SORT_INSERTION_CUTOFF - 1;
+        insertion_sort_appointments_by_doctor(appointments, lo, hi < n - 1 ? hi : n - 1);
+    }
+    if (n <= SORT_INSERTION_CUTOFF) {
+        return;
+    }
+
+    Appointment** owned = NULL;
+    if (scratch == NULL) {
+        owned = (Appointment**)malloc((size_t)n * sizeof(Appointment*));
+        if (owned == NULL) {
+            // Bellek hatası - yavaş ama doğru sıralamaya düş
+            insertion_sort_appointments_by_doctor(appointments, 0, n - 1);
+            return;
+        }
+        scratch = owned;
+    }
+
+    Appointment** src = appointments;
+    Appointment** dst = scratch;
+    for (int width = SORT_INSERTION_CUTOFF; width < n; width *= 2) {
+        for (int lo = 0; lo < n; lo += 2 * width) {
+            int mid = (lo + width < n ? lo + width : n) - 1;
+            int hi = (lo + 2 * width < n ? lo + 2 * width : n) - 1;
+            merge_appointments_by_doctor(src, dst, lo, mid, hi);
+        }
+        Appointment** temp = src;
+        src = dst;
+        dst = temp;
+    }
+
+    if (src != appointments) {
+        for (int i = 0; i < n; i++) {
+            appointments[i] = src[i];
+        }
+    }
+    free(owned);
+}
+
+/**
+ * Randevuları (doctor_id, start_time) sırasına göre sıralar (kararlı)
+ * Büyük girdide taban sıralaması, küçük girdide veya taban sıralaması
+ * kullanılamadığında MergeSort
+ * 
+ * @param appointments: Randevu işaretçileri dizisi
+ * @param n: Randevu sayısı
+ */
+void sort_appointments_by_doctor(Appointment** appointments, int n) {
+    if (appointments == NULL || n < 2) {
+        return;
+    }
+    if (n >= SORT_COUNTING_MIN) {
+        if (!radix_sort_appointments_by_doctor(appointments, n)) {
+            merge_sort_appointments_by_doctor(appointments, n, NULL);
+        }
+        return;
+    }
+
+    // Küçük girdi: geçici dizi yığında, bellek ayrılmaz
+    Appointment* scratch[SORT_COUNTING_MIN];
+    merge_sort_appointments_by_doctor(appointments, n, scratch);
+}
+
 /**
  * Binary Search algoritması - Randevu ID'sine göre arama
  * 
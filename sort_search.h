@@ -9,23 +9,39 @@
 
 /**
  * Sorting and Searching Algorithms
- * Implements MergeSort, HeapSort, and Binary Search
+ * Implements MergeSort, HeapSort, counting/radix sort, and Binary Search
  */
 
 /**
  * Sorting Algorithms
  */
 
+/**
+ * Run length sorted by insertion sort before the bottom-up merge passes
+ */
+#define SORT_INSERTION_CUTOFF 16
+
 /**
  * MergeSort for appointments (sorted by start_time)
- * Time Complexity: O(n log n) - stable, divide and conquer
- * Space Complexity: O(n) - requires temporary array
+ * Time Complexity: O(n log n) - stable, bottom-up (no recursion)
+ * Space Complexity: O(n) - one temporary array per call
  * @param appointments: Array of appointment pointers
  * @param left: Left index of subarray
  * @param right: Right index of subarray
  */
 void merge_sort_appointments(Appointment** appointments, int left, int right);
 
+/**
+ * MergeSort for appointments with a caller-provided temporary array
+ * No allocation when scratch is given; reuse it across calls
+ * @param appointments: Array of appointment pointers
+ * @param left: Left index of subarray
+ * @param right: Right index of subarray
+ * @param scratch: At least right - left + 1 entries (NULL -> allocated once)
+ */
+void merge_sort_appointments_scratch(Appointment** appointments, int left, int right,
+                                     Appointment** scratch);
+
 /**
  * HeapSort for appointments (sorted by start_time)
  * Time Complexity: O(n log n) - in-place sorting
@@ -35,6 +51,58 @@ void merge_sort_appointments(Appointment** appointments, int left, int right);
  */
 void heap_sort_appointments(Appointment** appointments, int n);
 
+/**
+ * Linear-time sorts for appointments
+ * start_time is bounded to 0-1439, so a counting sort over minutes is O(n)
+ * and stable; longer keys are sorted digit by digit (LSD radix, 11-bit
+ * digits, digits shared by every key are skipped)
+ * Space Complexity: O(n) - one scratch array, O(2048) counts
+ */
+
+/**
+ * Smallest input for which sort_appointments_by_time uses counting sort
+ * (below it the fixed cost of the count array outweighs the gain)
+ */
+#define SORT_COUNTING_MIN 64
+
+/**
+ * Counting sort for appointments (sorted by start_time, stable)
+ * Time Complexity: O(n + 1440)
+ * @param appointments: Array of appointment pointers
+ * @param n: Number of appointments
+ * @return: 1 if sorted, 0 if the array is unchanged (NULL entry,
+ *          start_time outside 0-1439 or out of memory)
+ */
+int counting_sort_appointments(Appointment** appointments, int n);
+
+/**
+ * LSD radix sort for appointments by (doctor_id, start_time), stable
+ * Time Complexity: O(n) per digit - one pass for the minute, up to three
+ * for doctor_id (usually one, since small IDs share the upper digits)
+ * @param appointments: Array of appointment pointers
+ * @param n: Number of appointments
+ * @return: 1 if sorted, 0 if the array is unchanged (as counting sort)
+ */
+int radix_sort_appointments_by_doctor(Appointment** appointments, int n);
+
+/**
+ * Sorts appointments by start_time (stable), choosing the algorithm:
+ * counting sort from SORT_COUNTING_MIN elements, MergeSort below it (on a
+ * stack buffer, no allocation) or when counting sort cannot be used
+ * @param appointments: Array of appointment pointers
+ * @param n: Number of appointments
+ */
+void sort_appointments_by_time(Appointment** appointments, int n);
+
+/**
+ * Sorts appointments by (doctor_id, start_time) (stable): radix sort from
+ * SORT_COUNTING_MIN elements, merge sort below it or when radix sort
+ * cannot be used
+ * @param appointments: Array of appointment pointers
+ * @param n: Number of appointments
+ */
+void sort_appointments_by_doctor(Appointment** appointments, int n);
+
 /**
  * MergeSort for patients (sorted by id)
  * Time Complexity: O(n log n)
@@ -44,6 +112,15 @@ void heap_sort_appointments(Appointment** appointments, int n);
  */
 void merge_sort_patients(Patient** patients, int left, int right);
 
+/**
+ * MergeSort for patients with a caller-provided temporary array
+ * @param patients: Array of patient pointers
+ * @param left: Left index of subarray
+ * @param right: Right index of subarray
+ * @param scratch: At least right - left + 1 entries (NULL -> allocated once)
+ */
+void merge_sort_patients_scratch(Patient** patients, int left, int right, Patient** scratch);
+
 /**
  * MergeSort for doctors (sorted by id)
  * Time Complexity: O(n log n)
@@ -53,6 +130,15 @@ void merge_sort_patients(Patient** patients, int left, int right);
  */
 void merge_sort_doctors(Doctor** doctors, int left, int right);
 
+/**
+ * MergeSort for doctors with a caller-provided temporary array
+ * @param doctors: Array of doctor pointers
+ * @param left: Left index of subarray
+ * @param right: Right index of subarray
+ * @param scratch: At least right - left + 1 entries (NULL -> allocated once)
+ */
+void merge_sort_doctors_scratch(Doctor** doctors, int left, int right, Doctor** scratch);
+
 /**
  * Searching Algorithms
  */
@@ -90,23 +176,5 @@ int binary_search_patient_by_id(Patient** patients, int n, int patient_id);
  */
 int binary_search_doctor_by_id(Doctor** doctors, int n, int doctor_id);
 
-/**
- * Helper function: Merges two sorted subarrays (for MergeSort)
- * Time Complexity: O(n)
- */
-void merge_appointments(Appointment** appointments, int left, int mid, int right);
-
-/**
- * Helper function: Merges two sorted patient subarrays
- * Time Complexity: O(n)
- */
-void merge_patients(Patient** patients, int left, int mid, int right);
-
-/**
- * Helper function: Merges two sorted doctor subarrays
- * Time Complexity: O(n)
- */
-void merge_doctors(Doctor** doctors, int left, int mid, int right);
-
 #endif // SORT_SEARCH_H
 
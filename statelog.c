@@ -0,0 +1,344 @@
+/**
+ * Waiting List State Log Implementation
+ * 
+ * Append-only binary log of fixed-size records
+ * - Each change costs one 32-byte append, no rewrite of existing data
+ * - Replay is a single sequential pass, O(1) work per record
+ *   (waiting list removals go through the appointment ID index)
+ * - Compaction writes the current state to a temp file and renames it
+ *   over the log, so a crash during compaction keeps the old log
+ * 
+ * Time Complexity:
+ * - logging a change: O(1)
+ * - open (replay + compaction): O(n) in log records
+ * - compaction: O(n * L) for the waiting list merge
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "statelog.h"
+#include "file_io.h"
+
+#define STATELOG_HEADER_SIZE 8
+#define STATELOG_BATCH 256  // Records read per fread during replay
+
+static const unsigned char statelog_magic[4] = { 'R', 'S', 'T', 'L' };
+
+// Process-wide log (NULL while closed, logging calls are then ignored)
+static FILE* statelog_file = NULL;
+static char statelog_path[512];
+
+/**
+ * Decoded record
+ */
+typedef struct {
+    StateLogOp op;
+    int triage_level;
+    int appointment_id;
+    int patient_id;
+    int doctor_id;
+    int start_time;
+    int end_time;
+    long long enqueued_at;
+} StateLogRecord;
+
+/**
+ * Internal helpers: Little-endian field encoding
+ */
+static void statelog_put_u32(unsigned char* p, uint32_t v) {
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+}
+
+static uint32_t statelog_get_u32(const unsigned char* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void statelog_encode(const StateLogRecord* record, unsigned char* p) {
+    uint64_t enqueued_at = (uint64_t)record->enqueued_at;
+    p[0] = (unsigned char)record->op;
+    p[1] = (unsigned char)record->triage_level;
+    p[2] = 0;
+    p[3] = 0;
+    statelog_put_u32(p + 4, (uint32_t)record->appointment_id);
+    statelog_put_u32(p + 8, (uint32_t)record->patient_id);
+    statelog_put_u32(p + 12, (uint32_t)record->doctor_id);
+    statelog_put_u32(p + 16, (uint32_t)record->start_time);
+    statelog_put_u32(p + 20, (uint32_t)record->end_time);
+    statelog_put_u32(p + 24, (uint32_t)enqueued_at);
+    statelog_put_u32(p + 28, (uint32_t)(enqueued_at >> 32));
+}
+
+static void statelog_decode(const unsigned char* p, StateLogRecord* record) {
+    record->op = (StateLogOp)p[0];
+    record->triage_level = p[1];
+    record->appointment_id = (int32_t)statelog_get_u32(p + 4);
+    record->patient_id = (int32_t)statelog_get_u32(p + 8);
+    record->doctor_id = (int32_t)statelog_get_u32(p + 12);
+    record->start_time = (int32_t)statelog_get_u32(p + 16);
+    record->end_time = (int32_t)statelog_get_u32(p + 20);
+    record->enqueued_at = (long long)((uint64_t)statelog_get_u32(p + 24) |
+                                      ((uint64_t)statelog_get_u32(p + 28) << 32));
+}
+
+static void statelog_set_appointment(StateLogRecord* record, StateLogOp op,
+                                     const Appointment* appointment) {
+    memset(record, 0, sizeof(*record));
+    record->op = op;
+    record->appointment_id = appointment->appointment_id;
+    record->patient_id = appointment->patient_id;
+    record->doctor_id = appointment->doctor_id;
+    record->start_time = appointment->start_time;
+    record->end_time = appointment->end_time;
+}
+
+/**
+ * Internal helper: Writes the file header
+ * @return: 1 on success, 0 on failure
+ */
+static int statelog_write_header(FILE* file) {
+    unsigned char header[STATELOG_HEADER_SIZE];
+    memcpy(header, statelog_magic, 4);
+    statelog_put_u32(header + 4, STATELOG_VERSION);
+    return fwrite(header, 1, sizeof(header), file) == sizeof(header);
+}
+
+/**
+ * Internal helper: Appends one record to the open log
+ * Flushed right away so the record survives a crash of the program
+ */
+static void statelog_append(const StateLogRecord* record) {
+    if (statelog_file == NULL) {
+        return;
+    }
+    unsigned char buffer[STATELOG_RECORD_SIZE];
+    statelog_encode(record, buffer);
+    fwrite(buffer, 1, sizeof(buffer), statelog_file);
+    fflush(statelog_file);
+}
+
+/**
+ * Internal helper: Applies one record to the in-memory structures
+ * No validation scans: the log only contains changes that succeeded
+ * Time Complexity: O(1) expected
+ */
+static void statelog_apply(const StateLogRecord* record, Waitlist* waitlist) {
+    Appointment* appointment;
+
+    switch (record->op) {
+        case STATELOG_WAIT_ADD:
+            appointment = create_appointment(record->appointment_id, record->patient_id,
+                                             record->doctor_id, record->start_time,
+                                             record->end_time);
+            if (appointment == NULL) {
+                return;
+            }
+            reserve_appointment_id(record->appointment_id);
+            if (!waitlist_enqueue_at(waitlist, appointment, record->triage_level,
+                                     record->enqueued_at)) {
+                free_appointment(appointment);
+            }
+            break;
+        case STATELOG_WAIT_REMOVE:
+            free_appointment(waitlist_withdraw(waitlist, record->appointment_id));
+            break;
+        default:
+            break; // Unknown or retired (undo stack) record - skip
+    }
+}
+
+/**
+ * Internal helper: Replays an existing log file
+ * Time Complexity: O(n) in records
+ * 
+ * @return: Number of records replayed, 0 if the file does not exist, -1 on bad header
+ */
+static int statelog_replay(const char* path, Waitlist* waitlist) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return 0; // No log yet
+    }
+
+    unsigned char header[STATELOG_HEADER_SIZE];
+    if (fread(header, 1, sizeof(header), file) != sizeof(header) ||
+        memcmp(header, statelog_magic, 4) != 0 ||
+        statelog_get_u32(header + 4) != STATELOG_VERSION) {
+        fclose(file);
+        return -1; // Not a state log (or unsupported version)
+    }
+
+    unsigned char buffer[STATELOG_BATCH * STATELOG_RECORD_SIZE];
+    int replayed = 0;
+    size_t got;
+    // A torn trailing record (crash mid-append) is a partial read and is dropped
+    while ((got = fread(buffer, STATELOG_RECORD_SIZE, STATELOG_BATCH, file)) > 0) {
+        for (size_t i = 0; i < got; i++) {
+            StateLogRecord record;
+            statelog_decode(buffer + i * STATELOG_RECORD_SIZE, &record);
+            statelog_apply(&record, waitlist);
+            replayed++;
+        }
+    }
+
+    fclose(file);
+    return replayed;
+}
+
+/**
+ * Replays the log, compacts it and opens it for appending
+ * Time Complexity: O(n)
+ * 
+ * @param path: Log file path
+ * @param waitlist: Waiting list to fill (should be empty)
+ * @return: Number of records replayed, -1 if the log could not be opened
+ */
+int statelog_open(const char* path, Waitlist* waitlist) {
+    if (path == NULL || waitlist == NULL ||
+        strlen(path) + 5 > sizeof(statelog_path)) {
+        return -1;
+    }
+
+    statelog_close();
+
+    int replayed = statelog_replay(path, waitlist);
+    if (replayed < 0) {
+        return -1; // Keep the unknown file untouched
+    }
+
+    strcpy(statelog_path, path);
+    if (!statelog_compact(waitlist)) {
+        return -1;
+    }
+    return replayed;
+}
+
+/**
+ * Records a waiting list insertion
+ * Time Complexity: O(1)
+ * 
+ * @param entry: Entry just added
+ */
+void statelog_waitlist_add(const WaitlistEntry* entry) {
+    if (entry == NULL || entry->appointment == NULL) {
+        return;
+    }
+    StateLogRecord record;
+    statelog_set_appointment(&record, STATELOG_WAIT_ADD, entry->appointment);
+    record.triage_level = entry->triage_level;
+    record.enqueued_at = entry->enqueued_at;
+    statelog_append(&record);
+}
+
+/**
+ * Records that an appointment left the waiting list
+ * Time Complexity: O(1)
+ * 
+ * @param appointment_id: Appointment ID
+ */
+void statelog_waitlist_remove(int appointment_id) {
+    StateLogRecord record;
+    memset(&record, 0, sizeof(record));
+    record.op = STATELOG_WAIT_REMOVE;
+    record.appointment_id = appointment_id;
+    statelog_append(&record);
+}
+
+/**
+ * Internal helper: Writes the current state to a new file
+ * Records are encoded into one buffer and written with a single fwrite
+ * Time Complexity: O(n * L)
+ * 
+ * @return: 1 on success, 0 on failure (partial file removed)
+ */
+static int statelog_write_snapshot(const char* path, const Waitlist* waitlist) {
+    int waiting = waitlist_size(waitlist);
+
+    const WaitlistEntry** entries = (const WaitlistEntry**)malloc((waiting > 0 ? waiting : 1) * sizeof(WaitlistEntry*));
+    unsigned char* buffer = (unsigned char*)malloc((waiting > 0 ? waiting : 1) * STATELOG_RECORD_SIZE);
+    if (entries == NULL || buffer == NULL) {
+        free(entries);
+        free(buffer);
+        return 0; // Memory allocation failed
+    }
+
+    unsigned char* p = buffer;
+    StateLogRecord record;
+    waiting = waitlist_arrival_order(waitlist, entries, waiting);
+    for (int i = 0; i < waiting; i++) {
+        statelog_set_appointment(&record, STATELOG_WAIT_ADD, entries[i]->appointment);
+        record.triage_level = entries[i]->triage_level;
+        record.enqueued_at = entries[i]->enqueued_at;
+        statelog_encode(&record, p);
+        p += STATELOG_RECORD_SIZE;
+    }
+
+    int ok = 0;
+    FILE* file = fopen(path, "wb");
+    if (file != NULL) {
+        size_t bytes = (size_t)(p - buffer);
+        ok = statelog_write_header(file) && fwrite(buffer, 1, bytes, file) == bytes;
+        if (fclose(file) != 0) {
+            ok = 0;
+        }
+        if (!ok) {
+            remove(path);
+        }
+    }
+
+    free(entries);
+    free(buffer);
+    return ok;
+}
+
+/**
+ * Rewrites the log with only the current state
+ * Written to "<path>.tmp" first and renamed over the log
+ * Time Complexity: O(n * L)
+ * 
+ * @param waitlist: Current waiting list
+ * @return: 1 on success, 0 on failure (old log is kept)
+ */
+int statelog_compact(const Waitlist* waitlist) {
+    if (waitlist == NULL || statelog_path[0] == '\0') {
+        return 0;
+    }
+
+    char tmp_path[sizeof(statelog_path) + 4];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", statelog_path);
+
+    int ok = statelog_write_snapshot(tmp_path, waitlist);
+    if (ok) {
+        // Swap the compacted file in (rename does not replace on Windows)
+        statelog_close();
+#ifdef _WIN32
+        remove(statelog_path);
+#endif
+        if (rename(tmp_path, statelog_path) != 0) {
+            remove(tmp_path);
+            ok = 0;
+        }
+    }
+
+    // Keep appending to whichever log is current
+    if (statelog_file == NULL) {
+        statelog_file = fopen(statelog_path, "ab");
+        if (statelog_file == NULL) {
+            ok = 0;
+        }
+    }
+    return ok;
+}
+
+/**
+ * Closes the log
+ * Time Complexity: O(1)
+ */
+void statelog_close(void) {
+    if (statelog_file != NULL) {
+        fclose(statelog_file);
+        statelog_file = NULL;
+    }
+}
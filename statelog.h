@@ -0,0 +1,100 @@
+#ifndef STATELOG_H
+#define STATELOG_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "appointment.h"
+#include "waitlist.h"
+
+/**
+ * Waiting List State Log
+ *
+ * Compact binary append-only log that keeps the waiting list across
+ * restarts (undo/redo history lives in the operation journal, journal.h).
+ * Every change is appended as one fixed-size record as it happens, so
+ * nothing has to be rewritten on exit and a crash loses at most the
+ * record being written.
+ *
+ * File layout (all integers little-endian):
+ *   header: "RSTL" magic (4 bytes) + version (u32)
+ *   records: STATELOG_RECORD_SIZE bytes each
+ *     u8  op              StateLogOp
+ *     u8  triage_level    waiting list only
+ *     u16 reserved
+ *     i32 appointment_id
+ *     i32 patient_id
+ *     i32 doctor_id
+ *     i32 start_time
+ *     i32 end_time
+ *     i64 enqueued_at     waiting list only (minutes since epoch)
+ *
+ * Replay applies records in order with O(1) work each, so loading is O(n)
+ * and keeps the original waiting order. The log is compacted (rewritten as
+ * the current state only) at startup and exit.
+ *
+ * The log is a single process-wide instance, like the ID counters in
+ * file_io; logging calls are no-ops while no log is open.
+ */
+
+/**
+ * Default state log path
+ */
+#define STATELOG_DEFAULT_PATH "data/state.log"
+
+/**
+ * Format version and record size
+ */
+#define STATELOG_VERSION 1
+#define STATELOG_RECORD_SIZE 32
+
+/**
+ * Record operations
+ */
+typedef enum {
+    STATELOG_WAIT_ADD = 1,     // Appointment added to waiting list
+    STATELOG_WAIT_REMOVE = 2,  // Appointment left waiting list (dequeue/withdraw)
+    STATELOG_UNDO_PUSH = 3,    // Retired (former undo stack), skipped on replay
+    STATELOG_UNDO_POP = 4      // Retired (former undo stack), skipped on replay
+} StateLogOp;
+
+/**
+ * State Log Operations
+ * Time Complexity: O(1) per logged change, O(n) load and compaction
+ */
+
+/**
+ * Replays the log into an empty waiting list,
+ * then compacts it and opens it for appending
+ * A missing file starts an empty log; a torn last record is ignored
+ * @param path: Log file path
+ * @param waitlist: Waiting list to fill (should be empty)
+ * @return: Number of records replayed, -1 if the log could not be opened
+ */
+int statelog_open(const char* path, Waitlist* waitlist);
+
+/**
+ * Records a waiting list insertion
+ * @param entry: Entry just added (waitlist_find after enqueue)
+ */
+void statelog_waitlist_add(const WaitlistEntry* entry);
+
+/**
+ * Records that an appointment left the waiting list
+ * @param appointment_id: Appointment ID
+ */
+void statelog_waitlist_remove(int appointment_id);
+
+/**
+ * Rewrites the log with only the current state
+ * Waiting entries are written in arrival order
+ * @param waitlist: Current waiting list
+ * @return: 1 on success, 0 on failure (old log is kept)
+ */
+int statelog_compact(const Waitlist* waitlist);
+
+/**
+ * Closes the log (further logging calls are ignored)
+ */
+void statelog_close(void);
+
+#endif // STATELOG_H
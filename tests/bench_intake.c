@@ -0,0 +1,140 @@
+/**
+ * Intake Scheduler Throughput Benchmark
+ * 
+ * Submits a fixed number of bookings from 1, 2, 4, ... 32 producer threads
+ * to a running scheduler and reports requests per second until the last
+ * handle completes. Each producer books a full day for its own doctor and
+ * then keeps requesting the same doctor, so the scheduler runs the real
+ * booking path (conflict check + waiting list) without growing the tree.
+ * 
+ * Usage: bench_intake [work directory]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "scheduler.h"
+#include "thread.h"
+
+#define BENCH_REQUESTS 256000     // Total per run, split evenly between producers
+#define BENCH_MAX_PRODUCERS 32
+
+/**
+ * One producer thread and its slice of the completion handles
+ */
+typedef struct {
+    Scheduler* scheduler;
+    int producer;
+    int first_id;           // ID of the producer's first request
+    int count;              // Requests to submit
+    IntakeHandle* handles;  // count handles
+    Thread thread;
+} Producer;
+
+static void producer_main(void* arg) {
+    Producer* producer = (Producer*)arg;
+    for (int i = 0; i < producer->count; i++) {
+        IntakeRequest request;
+        memset(&request, 0, sizeof(request));
+        request.type = INTAKE_CREATE_APPOINTMENT;
+        request.appointment_id = producer->first_id + i;
+        request.patient_id = producer->producer + 1;
+        request.doctor_id = producer->producer + 1;
+        request.start_time = i == 0 ? producer->producer : 600;
+        request.end_time = i == 0 ? 1439 : 660;
+        request.handle = &producer->handles[i];
+
+        while (!scheduler_submit(producer->scheduler, &request)) {
+            thread_yield(); // Queue full
+        }
+    }
+}
+
+/**
+ * Runs one configuration on fresh structures
+ * @return: Requests per second, or -1 on failure
+ */
+static double bench_run(const char* journal_path, int producer_count) {
+    AVLTree avl_tree;
+    MinHeap heap;
+    Waitlist waitlist;
+    Journal journal;
+    AppointmentVector appointments;
+    avl_init(&avl_tree);
+    waitlist_init(&waitlist, WAITLIST_MODE_FIFO);
+    appointment_vector_init(&appointments);
+    remove(journal_path);
+    journal_open(&journal, journal_path, 0);
+
+    IntakeHandle* handles = calloc(BENCH_REQUESTS, sizeof(IntakeHandle));
+    Producer producers[BENCH_MAX_PRODUCERS];
+    IntakeBookingContext booking = { &avl_tree, &heap, &waitlist, &journal, NULL, NULL,
+                                     &appointments, NULL, { 0, 0 } };
+    Scheduler scheduler;
+    double rate = -1;
+
+    if (handles != NULL && heap_init(&heap, BENCH_MAX_PRODUCERS)) {
+        if (scheduler_start(&scheduler, &booking, SCHEDULER_DEFAULT_CAPACITY)) {
+            int per_producer = BENCH_REQUESTS / producer_count;
+            long long start = thread_now_us();
+            int started = 0;
+            for (int p = 0; p < producer_count; p++) {
+                producers[p].scheduler = &scheduler;
+                producers[p].producer = p;
+                producers[p].first_id = p * per_producer + 1;
+                producers[p].count = per_producer;
+                producers[p].handles = handles + p * per_producer;
+                if (!thread_start(&producers[p].thread, producer_main, &producers[p])) {
+                    break;
+                }
+                started++;
+            }
+            for (int p = 0; p < started; p++) {
+                thread_join(&producers[p].thread);
+            }
+            int completed = 1;
+            for (int i = 0; i < started * per_producer; i++) {
+                completed = intake_handle_wait(&handles[i]) != INTAKE_REJECTED && completed;
+            }
+            long long elapsed = thread_now_us() - start;
+            scheduler_stop(&scheduler);
+
+            if (started == producer_count && completed) {
+                rate = (double)started * per_producer * 1000000.0 / (elapsed > 0 ? elapsed : 1);
+            }
+        }
+        heap_destroy(&heap);
+    }
+
+    while (!waitlist_is_empty(&waitlist)) {
+        free_appointment(waitlist_dequeue(&waitlist));
+    }
+    for (int i = 0; i < appointments.count; i++) {
+        free_appointment(appointments.items[i]);
+    }
+    journal_close(&journal);
+    remove(journal_path);
+    appointment_vector_destroy(&appointments);
+    waitlist_destroy(&waitlist);
+    avl_destroy(&avl_tree);
+    free(handles);
+    return rate;
+}
+
+int main(int argc, char* argv[]) {
+    const char* dir = argc > 1 ? argv[1] : ".";
+    char journal_path[512];
+    snprintf(journal_path, sizeof(journal_path), "%s/bench_intake_journal.bin", dir);
+
+    printf("intake: %d requests per run\n", BENCH_REQUESTS);
+    printf("%10s %16s\n", "producers", "requests/s");
+    for (int producers = 1; producers <= BENCH_MAX_PRODUCERS; producers *= 2) {
+        double rate = bench_run(journal_path, producers);
+        if (rate < 0) {
+            printf("FAIL bench: run with %d producers\n", producers);
+            return 1;
+        }
+        printf("%10d %16.0f\n", producers, rate);
+    }
+    return 0;
+}
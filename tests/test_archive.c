@@ -0,0 +1,164 @@
+/**
+ * Archive Query Test
+ * 
+ * Writes a random appointments CSV, converts it with archive_write_csv and
+ * checks that archive_scan returns, for random doctor/time filters, exactly
+ * the rows (same order) that a filtered visit_appointments_csv scan returns.
+ * 
+ * Usage: test_archive [work directory]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "archive.h"
+#include "file_io.h"
+
+#define TEST_ROWS 200000          // About three archive blocks
+#define TEST_DOCTORS 40
+#define TEST_QUERIES 200
+
+/**
+ * Rows collected by one scan
+ */
+typedef struct {
+    Appointment* rows;
+    long long count;
+} RowList;
+
+/**
+ * Filter shared by both scans
+ */
+typedef struct {
+    const ArchiveQuery* query;
+    RowList* list;
+} CsvFilter;
+
+static int rows_push(RowList* list, int id, int patient, int doctor, int start, int end) {
+    if (list->count >= TEST_ROWS) {
+        return 0;
+    }
+    Appointment* row = &list->rows[list->count++];
+    row->appointment_id = id;
+    row->patient_id = patient;
+    row->doctor_id = doctor;
+    row->start_time = start;
+    row->end_time = end;
+    return 1;
+}
+
+static int collect_archive(const ArchiveBatch* batch, void* context) {
+    RowList* list = (RowList*)context;
+    for (int i = 0; i < batch->count; i++) {
+        if (!rows_push(list, batch->appointment_id[i], batch->patient_id[i], batch->doctor_id[i],
+                       batch->start_time[i], batch->end_time[i])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int collect_csv(const Appointment* appointment, void* context) {
+    CsvFilter* filter = (CsvFilter*)context;
+    const ArchiveQuery* query = filter->query;
+    if (appointment->start_time < query->min_start_time ||
+        appointment->start_time > query->max_start_time ||
+        (query->doctor_id != 0 && appointment->doctor_id != query->doctor_id)) {
+        return 1;
+    }
+    return rows_push(filter->list, appointment->appointment_id, appointment->patient_id,
+                     appointment->doctor_id, appointment->start_time, appointment->end_time);
+}
+
+/**
+ * Writes the CSV: IDs ascending, start times rising through the file in
+ * runs (so the block index can skip), random doctors and durations
+ */
+static int write_csv(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (file == NULL) {
+        return 0;
+    }
+    fprintf(file, "appointment_id,patient_id,doctor_id,start_time,end_time\n");
+    for (int i = 0; i < TEST_ROWS; i++) {
+        int start = (int)((long long)i * 1380 / TEST_ROWS) + rand() % 60;
+        int end = start + 5 + rand() % 55;
+        char start_text[6];
+        char end_text[6];
+        format_time_string(start, start_text);
+        format_time_string(end > 1439 ? 1439 : end, end_text);
+        fprintf(file, "%d,%d,%d,%s,%s\n", i + 1, 1 + rand() % 5000, 1 + rand() % TEST_DOCTORS,
+                start_text, end_text);
+    }
+    return fclose(file) == 0;
+}
+
+int main(int argc, char* argv[]) {
+    const char* dir = argc > 1 ? argv[1] : ".";
+    char csv_path[512];
+    char archive_path[512];
+    snprintf(csv_path, sizeof(csv_path), "%s/test_archive.csv", dir);
+    snprintf(archive_path, sizeof(archive_path), "%s/test_archive.arc", dir);
+
+    srand(12345);
+    long long archived = 0;
+    if (!write_csv(csv_path) || !archive_write_csv(archive_path, csv_path, &archived) ||
+        archived != TEST_ROWS) {
+        printf("FAIL archive: could not write %s (%lld rows)\n", archive_path, archived);
+        return 1;
+    }
+
+    RowList expected = { (Appointment*)malloc(TEST_ROWS * sizeof(Appointment)), 0 };
+    RowList actual = { (Appointment*)malloc(TEST_ROWS * sizeof(Appointment)), 0 };
+    if (expected.rows == NULL || actual.rows == NULL) {
+        printf("FAIL archive: out of memory\n");
+        return 1;
+    }
+
+    int failures = 0;
+    long long skipped = 0;
+    for (int q = 0; q < TEST_QUERIES && failures == 0; q++) {
+        ArchiveQuery query;
+        archive_query_init(&query, ARCHIVE_COLUMN_ALL);
+        if (q % 4 != 3) {
+            query.doctor_id = (q % 8 == 0) ? TEST_DOCTORS + 1 : 1 + rand() % TEST_DOCTORS;
+        }
+        if (q % 3 != 2) {
+            int a = rand() % 1440;
+            int b = rand() % 1440;
+            query.min_start_time = a < b ? a : b;
+            query.max_start_time = a < b ? b : a;
+        }
+
+        expected.count = 0;
+        actual.count = 0;
+        CsvFilter filter = { &query, &expected };
+        ArchiveScanReport report;
+        if (!visit_appointments_csv(csv_path, collect_csv, &filter, NULL) ||
+            !archive_scan(archive_path, &query, collect_archive, &actual, &report)) {
+            printf("FAIL archive: scan failed (query %d)\n", q);
+            failures++;
+            break;
+        }
+        skipped += report.blocks_skipped;
+
+        if (actual.count != expected.count || report.rows_matched != expected.count ||
+            memcmp(actual.rows, expected.rows, (size_t)expected.count * sizeof(Appointment)) != 0) {
+            printf("FAIL archive: query %d (doctor=%d, %d-%d): %lld rows, expected %lld\n", q,
+                   query.doctor_id, query.min_start_time, query.max_start_time,
+                   actual.count, expected.count);
+            failures++;
+        }
+    }
+
+    free(expected.rows);
+    free(actual.rows);
+    remove(csv_path);
+    remove(archive_path);
+    if (failures > 0) {
+        return 1;
+    }
+    printf("ok   archive: %d queries match the CSV scan (%lld blocks skipped)\n",
+           TEST_QUERIES, skipped);
+    return 0;
+}
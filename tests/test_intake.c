@@ -0,0 +1,190 @@
+/**
+ * Intake Scheduler Stress Test
+ * 
+ * Several producer threads submit bookings to a running scheduler through a
+ * deliberately small intake queue (so producers hit the full-queue path).
+ * Producer p first books a full day for doctor p + 1; all its later requests
+ * conflict with it and go to the waiting list in the order they were applied.
+ * Checks that every handle is completed with the expected status and ID,
+ * that each producer's requests reach the waiting list in submit order and
+ * that the scheduler counted every request.
+ * 
+ * Usage: test_intake [work directory]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "scheduler.h"
+#include "thread.h"
+
+#define TEST_PRODUCERS 8
+#define TEST_PER_PRODUCER 4000
+#define TEST_QUEUE_CAPACITY 64
+
+/**
+ * One producer thread and its completion handles
+ */
+typedef struct {
+    Scheduler* scheduler;
+    int producer;
+    IntakeHandle* handles;  // TEST_PER_PRODUCER handles
+    Thread thread;
+} Producer;
+
+static int request_id(int producer, int index) {
+    return producer * TEST_PER_PRODUCER + index + 1;
+}
+
+static void producer_main(void* arg) {
+    Producer* producer = (Producer*)arg;
+    for (int i = 0; i < TEST_PER_PRODUCER; i++) {
+        IntakeRequest request;
+        memset(&request, 0, sizeof(request));
+        request.type = INTAKE_CREATE_APPOINTMENT;
+        request.appointment_id = request_id(producer->producer, i);
+        request.patient_id = producer->producer + 1;
+        request.doctor_id = producer->producer + 1;
+        if (i == 0) {
+            // Whole day; start minutes differ per producer (the tree is keyed by start)
+            request.start_time = producer->producer;
+            request.end_time = 1439;
+        } else {
+            request.start_time = 600;
+            request.end_time = 660;
+        }
+        request.handle = &producer->handles[i];
+
+        while (!scheduler_submit(producer->scheduler, &request)) {
+            thread_yield(); // Queue full
+        }
+    }
+}
+
+static int check_handles(Producer* producers) {
+    for (int p = 0; p < TEST_PRODUCERS; p++) {
+        for (int i = 0; i < TEST_PER_PRODUCER; i++) {
+            IntakeStatus status = intake_handle_wait(&producers[p].handles[i]);
+            IntakeStatus expected = i == 0 ? INTAKE_APPLIED : INTAKE_WAITLISTED;
+            if (status != expected ||
+                producers[p].handles[i].appointment_id != request_id(p, i)) {
+                printf("FAIL handles: producer %d request %d status %d (expected %d), ID %d\n",
+                       p, i, (int)status, (int)expected, producers[p].handles[i].appointment_id);
+                return 0;
+            }
+        }
+    }
+    printf("ok   handles: %d requests completed\n", TEST_PRODUCERS * TEST_PER_PRODUCER);
+    return 1;
+}
+
+static int check_fifo(const Waitlist* waitlist) {
+    int total = TEST_PRODUCERS * (TEST_PER_PRODUCER - 1);
+    const WaitlistEntry** entries = malloc(sizeof(WaitlistEntry*) * total);
+    if (entries == NULL) {
+        printf("FAIL fifo: out of memory\n");
+        return 0;
+    }
+    int count = waitlist_arrival_order(waitlist, entries, total);
+    int last[TEST_PRODUCERS] = { 0 };
+    int seen[TEST_PRODUCERS] = { 0 };
+    int ok = count == total;
+
+    for (int i = 0; ok && i < count; i++) {
+        const Appointment* appointment = entries[i]->appointment;
+        int p = appointment->doctor_id - 1;
+        if (p < 0 || p >= TEST_PRODUCERS || appointment->appointment_id <= last[p]) {
+            printf("FAIL fifo: appointment %d out of order\n", appointment->appointment_id);
+            ok = 0;
+            break;
+        }
+        last[p] = appointment->appointment_id;
+        seen[p]++;
+    }
+    for (int p = 0; ok && p < TEST_PRODUCERS; p++) {
+        ok = seen[p] == TEST_PER_PRODUCER - 1;
+    }
+    free(entries);
+
+    if (!ok) {
+        printf("FAIL fifo: %d of %d waitlisted requests in producer order\n", count, total);
+        return 0;
+    }
+    printf("ok   fifo: %d waitlisted requests, each producer's in submit order\n", count);
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    const char* dir = argc > 1 ? argv[1] : ".";
+    char journal_path[512];
+    snprintf(journal_path, sizeof(journal_path), "%s/test_intake_journal.bin", dir);
+    remove(journal_path);
+
+    AVLTree avl_tree;
+    MinHeap heap;
+    Waitlist waitlist;
+    Journal journal;
+    AppointmentVector appointments;
+    avl_init(&avl_tree);
+    waitlist_init(&waitlist, WAITLIST_MODE_FIFO);
+    appointment_vector_init(&appointments);
+    journal_open(&journal, journal_path, 0);
+    if (!heap_init(&heap, TEST_PRODUCERS)) {
+        printf("FAIL setup: heap\n");
+        return 1;
+    }
+
+    // Existence checks are skipped without patient/doctor vectors
+    IntakeBookingContext booking = { &avl_tree, &heap, &waitlist, &journal, NULL, NULL,
+                                     &appointments, NULL, { 0, 0 } };
+    Scheduler scheduler;
+    if (!scheduler_start(&scheduler, &booking, TEST_QUEUE_CAPACITY)) {
+        printf("FAIL setup: scheduler\n");
+        return 1;
+    }
+
+    Producer producers[TEST_PRODUCERS];
+    for (int p = 0; p < TEST_PRODUCERS; p++) {
+        producers[p].scheduler = &scheduler;
+        producers[p].producer = p;
+        producers[p].handles = calloc(TEST_PER_PRODUCER, sizeof(IntakeHandle));
+        if (producers[p].handles == NULL ||
+            !thread_start(&producers[p].thread, producer_main, &producers[p])) {
+            printf("FAIL setup: producer %d\n", p);
+            return 1;
+        }
+    }
+    for (int p = 0; p < TEST_PRODUCERS; p++) {
+        thread_join(&producers[p].thread);
+    }
+
+    int ok = check_handles(producers);
+    scheduler_stop(&scheduler);
+
+    long long applied = scheduler_applied(&scheduler);
+    if (applied != (long long)TEST_PRODUCERS * TEST_PER_PRODUCER ||
+        appointments.count != TEST_PRODUCERS) {
+        printf("FAIL count: %lld applied, %d booked\n", applied, appointments.count);
+        ok = 0;
+    } else {
+        printf("ok   count: %lld applied, %d booked\n", applied, appointments.count);
+    }
+    ok = check_fifo(&waitlist) && ok;
+
+    for (int p = 0; p < TEST_PRODUCERS; p++) {
+        free(producers[p].handles);
+    }
+    while (!waitlist_is_empty(&waitlist)) {
+        free_appointment(waitlist_dequeue(&waitlist));
+    }
+    for (int i = 0; i < appointments.count; i++) {
+        free_appointment(appointments.items[i]);
+    }
+    journal_close(&journal);
+    remove(journal_path);
+    appointment_vector_destroy(&appointments);
+    waitlist_destroy(&waitlist);
+    heap_destroy(&heap);
+    avl_destroy(&avl_tree);
+    return ok ? 0 : 1;
+}
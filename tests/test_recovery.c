@@ -0,0 +1,403 @@
+/**
+ * Crash Recovery Test
+ * 
+ * Writes a write-ahead log and replays it into fresh structures, then
+ * damages it the way a crash or a bad disk would: the last record is cut
+ * off mid-write and a record's checksum is broken. Checks that replay
+ * stops at the damaged record, keeps everything before it and that new
+ * records are appended after the cut-off tail.
+ * A checkpoint interrupted after its marker was written (staged files not
+ * yet installed) must be rolled forward, a stale "<stage>.tmp" removed and
+ * the log replayed on top of the installed files; staged files of an
+ * uncommitted checkpoint must be discarded.
+ * 
+ * The checkpoint files live under "data/", so the test runs inside the
+ * work directory.
+ * 
+ * Usage: test_recovery [work directory]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "checkpoint.h"
+#include "file_io.h"
+#include "snapshot.h"
+#include "wal.h"
+
+#ifdef _WIN32
+#include <direct.h>
+#define test_chdir _chdir
+#define test_mkdir(path) _mkdir(path)
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#define test_chdir chdir
+#define test_mkdir(path) mkdir(path, 0755)
+#endif
+
+#define TEST_STALE_PATH DOCTORS_CSV_PATH CHECKPOINT_STAGE_SUFFIX ".tmp"
+
+/**
+ * Structures a replay or a load fills
+ */
+typedef struct {
+    AVLTree avl_tree;
+    MinHeap heap;
+    PatientVector patients;
+    DoctorVector doctors;
+    AppointmentVector appointments;
+    JournalContext context;
+} TestState;
+
+static int state_init(TestState* state) {
+    avl_init(&state->avl_tree);
+    patient_vector_init(&state->patients);
+    doctor_vector_init(&state->doctors);
+    appointment_vector_init(&state->appointments);
+    JournalContext context = { &state->avl_tree, &state->heap, &state->patients,
+                               &state->doctors, &state->appointments, NULL };
+    state->context = context;
+    return heap_init(&state->heap, 16);
+}
+
+static void state_destroy(TestState* state) {
+    for (int i = 0; i < state->patients.count; i++) {
+        free_patient(state->patients.items[i]);
+    }
+    for (int i = 0; i < state->doctors.count; i++) {
+        free_doctor(state->doctors.items[i]);
+    }
+    for (int i = 0; i < state->appointments.count; i++) {
+        free_appointment(state->appointments.items[i]);
+    }
+    patient_vector_destroy(&state->patients);
+    doctor_vector_destroy(&state->doctors);
+    appointment_vector_destroy(&state->appointments);
+    heap_destroy(&state->heap);
+    avl_destroy(&state->avl_tree);
+}
+
+/**
+ * Loads the CSV files the way startup does (before the log is replayed)
+ */
+static void state_load(TestState* state) {
+    load_patients_from_csv(PATIENTS_CSV_PATH, &state->patients);
+    load_doctors_from_csv(DOCTORS_CSV_PATH, &state->doctors);
+    load_appointments_from_csv(APPOINTMENTS_CSV_PATH, &state->appointments);
+    for (int i = 0; i < state->appointments.count; i++) {
+        avl_insert(&state->avl_tree, state->appointments.items[i],
+                   state->appointments.items[i]->doctor_id);
+    }
+    heap_build(&state->heap, state->appointments.items, state->appointments.count);
+}
+
+/**
+ * Compares the live records against the expected IDs (0-terminated arrays)
+ * and the single appointment's start time (appointment_id 0: none expected)
+ */
+static int state_matches(TestState* state, const int* patients, const int* doctors,
+                         int appointment_id, int start_time) {
+    int count = 0;
+    for (; patients[count] != 0; count++) {
+        if (count >= state->patients.count || state->patients.items[count]->id != patients[count]) {
+            return 0;
+        }
+    }
+    if (count != state->patients.count) {
+        return 0;
+    }
+    for (count = 0; doctors[count] != 0; count++) {
+        if (count >= state->doctors.count || state->doctors.items[count]->id != doctors[count]) {
+            return 0;
+        }
+    }
+    if (count != state->doctors.count) {
+        return 0;
+    }
+    if (appointment_id == 0) {
+        return state->appointments.count == 0 && avl_size(&state->avl_tree) == 0;
+    }
+    int index = appointment_vector_find(&state->appointments, appointment_id);
+    return state->appointments.count == 1 && index == 0 && avl_size(&state->avl_tree) == 1 &&
+           state->appointments.items[0]->start_time == start_time;
+}
+
+/**
+ * Opens the log over fresh structures
+ * @return: Records replayed, -1 on failure
+ */
+static int replay(TestState* state, unsigned long long snapshot_lsn, int load_csv) {
+    if (!state_init(state)) {
+        return -1;
+    }
+    if (load_csv) {
+        state_load(state);
+    }
+    int replayed = wal_open(WAL_DEFAULT_PATH, &state->context, snapshot_lsn);
+    wal_close();
+    return replayed;
+}
+
+static void log_patient(int id) {
+    Patient* patient = create_patient(id, "Ayse Yilmaz", 30 + id);
+    wal_log_patient_add(patient);
+    free_patient(patient);
+}
+
+static void log_doctor(int id) {
+    Doctor* doctor = create_doctor(id, "Mehmet Kaya", "Dahiliye");
+    wal_log_doctor_add(doctor);
+    free_doctor(doctor);
+}
+
+/**
+ * Reads a whole file
+ * @return: Buffer to free, NULL on failure
+ */
+static unsigned char* read_file(const char* path, long* size) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+    unsigned char* bytes = NULL;
+    if (fseek(file, 0, SEEK_END) == 0 && (*size = ftell(file)) > 0 && fseek(file, 0, SEEK_SET) == 0) {
+        bytes = malloc((size_t)*size);
+        if (bytes != NULL && fread(bytes, 1, (size_t)*size, file) != (size_t)*size) {
+            free(bytes);
+            bytes = NULL;
+        }
+    }
+    fclose(file);
+    return bytes;
+}
+
+static int write_file(const char* path, const unsigned char* bytes, long size) {
+    FILE* file = fopen(path, "wb");
+    if (file == NULL) {
+        return 0;
+    }
+    int ok = fwrite(bytes, 1, (size_t)size, file) == (size_t)size;
+    return fclose(file) == 0 && ok;
+}
+
+static int file_exists(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (file != NULL) {
+        fclose(file);
+    }
+    return file != NULL;
+}
+
+static void remove_files(void) {
+    const char* paths[] = { WAL_DEFAULT_PATH, CHECKPOINT_DEFAULT_PATH, PATIENTS_CSV_PATH,
+                            DOCTORS_CSV_PATH, APPOINTMENTS_CSV_PATH, SNAPSHOT_DEFAULT_PATH,
+                            PATIENTS_CSV_PATH CHECKPOINT_STAGE_SUFFIX,
+                            DOCTORS_CSV_PATH CHECKPOINT_STAGE_SUFFIX,
+                            APPOINTMENTS_CSV_PATH CHECKPOINT_STAGE_SUFFIX,
+                            SNAPSHOT_DEFAULT_PATH CHECKPOINT_STAGE_SUFFIX, TEST_STALE_PATH };
+    for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        remove(paths[i]);
+    }
+}
+
+/**
+ * Logs patients 1-3, doctor 1 and appointment 1 (booked, then rescheduled)
+ */
+static int check_replay(void) {
+    TestState state;
+    if (!state_init(&state) || wal_open(WAL_DEFAULT_PATH, &state.context, 0) != 0) {
+        printf("FAIL replay: cannot create the log\n");
+        state_destroy(&state);
+        return 0;
+    }
+    log_patient(1);
+    log_patient(2);
+    log_doctor(1);
+    Appointment* appointment = create_appointment(1, 1, 1, 600, 630);
+    wal_log_appointment_create(appointment);
+    appointment->start_time = 660;
+    appointment->end_time = 690;
+    wal_log_appointment_reschedule(appointment);
+    free_appointment(appointment);
+    log_patient(3);
+    wal_close();
+    state_destroy(&state);
+
+    int patients[] = { 1, 2, 3, 0 };
+    int doctors[] = { 1, 0 };
+    int replayed = replay(&state, 0, 0);
+    int ok = replayed == 6 && state_matches(&state, patients, doctors, 1, 660);
+    state_destroy(&state);
+    printf("%s replay: %d records replayed\n", ok ? "ok  " : "FAIL", replayed);
+    return ok;
+}
+
+/**
+ * Cuts the last record off mid-write; replay keeps the first five and the
+ * next record is appended after them
+ */
+static int check_torn_tail(void) {
+    long size = 0;
+    unsigned char* bytes = read_file(WAL_DEFAULT_PATH, &size);
+    int ok = bytes != NULL && write_file(WAL_DEFAULT_PATH, bytes, size - 5);
+    free(bytes);
+
+    TestState state;
+    int patients[] = { 1, 2, 0 };
+    int doctors[] = { 1, 0 };
+    int replayed = ok ? replay(&state, 0, 0) : -1;
+    ok = replayed == 5 && state_matches(&state, patients, doctors, 1, 660);
+    state_destroy(&state);
+    if (!ok) {
+        printf("FAIL torn: %d records replayed from the cut log\n", replayed);
+        return 0;
+    }
+
+    // The cut tail is dropped before appending, so the new record is readable
+    ok = state_init(&state) && wal_open(WAL_DEFAULT_PATH, &state.context, 0) == 5;
+    log_patient(4);
+    wal_close();
+    state_destroy(&state);
+    int appended[] = { 1, 2, 4, 0 };
+    replayed = ok ? replay(&state, 0, 0) : -1;
+    ok = replayed == 6 && state_matches(&state, appended, doctors, 1, 660);
+    state_destroy(&state);
+    printf("%s torn: cut record dropped, %d records after appending\n", ok ? "ok  " : "FAIL",
+           replayed);
+    return ok;
+}
+
+/**
+ * Breaks the third record's checksum; replay stops in front of it
+ */
+static int check_crc(void) {
+    long size = 0;
+    unsigned char* bytes = read_file(WAL_DEFAULT_PATH, &size);
+    long offset = WAL_HEADER_SIZE;
+    for (int record = 0; bytes != NULL && record < 2 && offset + 4 <= size; record++) {
+        unsigned long length = (unsigned long)bytes[offset] | ((unsigned long)bytes[offset + 1] << 8) |
+                               ((unsigned long)bytes[offset + 2] << 16) |
+                               ((unsigned long)bytes[offset + 3] << 24);
+        offset += WAL_RECORD_HEADER_SIZE + (long)length;
+    }
+    int ok = bytes != NULL && offset + WAL_RECORD_HEADER_SIZE + 4 < size;
+    if (ok) {
+        bytes[offset + WAL_RECORD_HEADER_SIZE + 4] ^= 0x5a; // Doctor ID byte
+        ok = write_file(WAL_DEFAULT_PATH, bytes, size);
+    }
+    free(bytes);
+
+    TestState state;
+    int patients[] = { 1, 2, 0 };
+    int doctors[] = { 0 };
+    int replayed = ok ? replay(&state, 0, 0) : -1;
+    ok = replayed == 2 && state_matches(&state, patients, doctors, 0, 0);
+    state_destroy(&state);
+    printf("%s crc: replay stopped at the bad record after %d records\n", ok ? "ok  " : "FAIL",
+           replayed);
+    return ok;
+}
+
+/**
+ * Writes a checkpoint marker the way the checkpointer commits one
+ */
+static int write_marker(unsigned long long lsn) {
+    unsigned char marker[16] = { 'R', 'C', 'K', 'P' };
+    for (int i = 0; i < 4; i++) {
+        marker[4 + i] = (unsigned char)((unsigned long)CHECKPOINT_VERSION >> (8 * i));
+    }
+    for (int i = 0; i < 8; i++) {
+        marker[8 + i] = (unsigned char)(lsn >> (8 * i));
+    }
+    return write_file(CHECKPOINT_DEFAULT_PATH, marker, sizeof(marker));
+}
+
+/**
+ * Stages the files of a checkpoint taken at LSN 3 (patient 1, doctor 1,
+ * appointment 1), commits its marker and stops before installing them;
+ * patient 2 is logged after the capture
+ */
+static int check_checkpoint(void) {
+    remove_files();
+    TestState state;
+    int ok = state_init(&state) && wal_open(WAL_DEFAULT_PATH, &state.context, 0) == 0;
+    log_patient(1);
+    log_doctor(1);
+    Appointment* appointment = create_appointment(1, 1, 1, 600, 630);
+    wal_log_appointment_create(appointment);
+    log_patient(2);
+    wal_close();
+    state_destroy(&state);
+
+    Patient* patient = create_patient(1, "Ayse Yilmaz", 31);
+    Doctor* doctor = create_doctor(1, "Mehmet Kaya", "Dahiliye");
+    ok = ok && patient != NULL && doctor != NULL && appointment != NULL &&
+         save_patients_to_csv(PATIENTS_CSV_PATH CHECKPOINT_STAGE_SUFFIX, &patient, 1) == 1 &&
+         save_doctors_to_csv(DOCTORS_CSV_PATH CHECKPOINT_STAGE_SUFFIX, &doctor, 1) == 1 &&
+         save_appointments_to_csv(APPOINTMENTS_CSV_PATH CHECKPOINT_STAGE_SUFFIX, &appointment, 1) == 1 &&
+         snapshot_save(SNAPSHOT_DEFAULT_PATH CHECKPOINT_STAGE_SUFFIX, 3, &patient, 1, &doctor, 1,
+                       &appointment, 1, &appointment, 1) &&
+         write_marker(3) && write_file(TEST_STALE_PATH, (const unsigned char*)"id,na", 5);
+    free_patient(patient);
+    free_doctor(doctor);
+    free_appointment(appointment);
+    if (!ok) {
+        printf("FAIL checkpoint: cannot stage the interrupted checkpoint\n");
+        return 0;
+    }
+
+    // Marker LSN 3 is past the log's base LSN 0: roll forward
+    unsigned long long snapshot_lsn = checkpoint_recover(CHECKPOINT_DEFAULT_PATH, WAL_DEFAULT_PATH);
+    ok = snapshot_lsn == 3 && file_exists(PATIENTS_CSV_PATH) && file_exists(SNAPSHOT_DEFAULT_PATH) &&
+         !file_exists(PATIENTS_CSV_PATH CHECKPOINT_STAGE_SUFFIX) &&
+         !file_exists(SNAPSHOT_DEFAULT_PATH CHECKPOINT_STAGE_SUFFIX) && !file_exists(TEST_STALE_PATH);
+    if (!ok) {
+        printf("FAIL checkpoint: staged files not installed (marker LSN %llu)\n", snapshot_lsn);
+        return 0;
+    }
+
+    // Only the record logged after the capture is replayed on top
+    int patients[] = { 1, 2, 0 };
+    int doctors[] = { 1, 0 };
+    int replayed = replay(&state, snapshot_lsn, 1);
+    ok = replayed == 1 && state_matches(&state, patients, doctors, 1, 600);
+    state_destroy(&state);
+    if (!ok) {
+        printf("FAIL checkpoint: %d records replayed over the installed files\n", replayed);
+        return 0;
+    }
+    printf("ok   checkpoint: rolled forward, stale temporary removed, %d record replayed\n",
+           replayed);
+
+    // The log now starts at LSN 3: a staged file without a newer marker is discarded
+    patient = create_patient(99, "Ali Demir", 40);
+    ok = patient != NULL && save_patients_to_csv(PATIENTS_CSV_PATH CHECKPOINT_STAGE_SUFFIX,
+                                                 &patient, 1) == 1;
+    free_patient(patient);
+    snapshot_lsn = checkpoint_recover(CHECKPOINT_DEFAULT_PATH, WAL_DEFAULT_PATH);
+    ok = ok && snapshot_lsn == 3 && !file_exists(PATIENTS_CSV_PATH CHECKPOINT_STAGE_SUFFIX);
+    replayed = ok ? replay(&state, snapshot_lsn, 1) : -1;
+    ok = replayed == 1 && state_matches(&state, patients, doctors, 1, 600);
+    state_destroy(&state);
+    printf("%s discard: uncommitted staged file removed\n", ok ? "ok  " : "FAIL");
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    const char* dir = argc > 1 ? argv[1] : ".";
+    if (test_chdir(dir) != 0) {
+        printf("FAIL setup: cannot enter %s\n", dir);
+        return 1;
+    }
+    test_mkdir("data");
+    remove_files();
+
+    int ok = check_replay();
+    ok = ok && check_torn_tail();
+    ok = ok && check_crc();
+    ok = check_checkpoint() && ok;
+
+    remove_files();
+    return ok ? 0 : 1;
+}
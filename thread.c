@@ -0,0 +1,232 @@
+/**
+ * Portable Threads Implementation
+ * 
+ * Win32: CreateThread, CRITICAL_SECTION, CONDITION_VARIABLE, QueryPerformanceCounter
+ * POSIX: pthreads, condition variables bound to CLOCK_MONOTONIC so timed
+ *        waits are not affected by wall clock changes
+ * 
+ * Time Complexity: O(1) per call
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdio.h>
+#include "thread.h"
+
+#ifndef _WIN32
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Internal helper: Native entry point, forwards to the stored ThreadFn
+ */
+#ifdef _WIN32
+static DWORD WINAPI thread_trampoline(LPVOID arg) {
+    Thread* thread = (Thread*)arg;
+    thread->fn(thread->arg);
+    return 0;
+}
+#else
+static void* thread_trampoline(void* arg) {
+    Thread* thread = (Thread*)arg;
+    thread->fn(thread->arg);
+    return NULL;
+}
+#endif
+
+/**
+ * Starts a thread
+ * Time Complexity: O(1)
+ * 
+ * @param thread: Handle to fill
+ * @param fn: Entry point
+ * @param arg: Entry point argument
+ * @return: 1 on success, 0 on failure
+ */
+int thread_start(Thread* thread, ThreadFn fn, void* arg) {
+    if (thread == NULL || fn == NULL) {
+        return 0;
+    }
+
+    thread->fn = fn;
+    thread->arg = arg;
+#ifdef _WIN32
+    thread->handle = CreateThread(NULL, 0, thread_trampoline, thread, 0, NULL);
+    return thread->handle != NULL;
+#else
+    return pthread_create(&thread->handle, NULL, thread_trampoline, thread) == 0;
+#endif
+}
+
+/**
+ * Waits for a thread to finish
+ * Time Complexity: O(1) (blocks)
+ * 
+ * @param thread: Thread started with thread_start
+ */
+void thread_join(Thread* thread) {
+    if (thread == NULL) {
+        return;
+    }
+#ifdef _WIN32
+    WaitForSingleObject(thread->handle, INFINITE);
+    CloseHandle(thread->handle);
+#else
+    pthread_join(thread->handle, NULL);
+#endif
+}
+
+void thread_mutex_init(ThreadMutex* mutex) {
+#ifdef _WIN32
+    InitializeCriticalSection(&mutex->lock);
+#else
+    pthread_mutex_init(&mutex->lock, NULL);
+#endif
+}
+
+void thread_mutex_destroy(ThreadMutex* mutex) {
+#ifdef _WIN32
+    DeleteCriticalSection(&mutex->lock);
+#else
+    pthread_mutex_destroy(&mutex->lock);
+#endif
+}
+
+void thread_mutex_lock(ThreadMutex* mutex) {
+#ifdef _WIN32
+    EnterCriticalSection(&mutex->lock);
+#else
+    pthread_mutex_lock(&mutex->lock);
+#endif
+}
+
+void thread_mutex_unlock(ThreadMutex* mutex) {
+#ifdef _WIN32
+    LeaveCriticalSection(&mutex->lock);
+#else
+    pthread_mutex_unlock(&mutex->lock);
+#endif
+}
+
+void thread_cond_init(ThreadCond* cond) {
+#ifdef _WIN32
+    InitializeConditionVariable(&cond->cond);
+#else
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&cond->cond, &attr);
+    pthread_condattr_destroy(&attr);
+#endif
+}
+
+void thread_cond_destroy(ThreadCond* cond) {
+#ifdef _WIN32
+    (void)cond; // Win32 condition variables need no cleanup
+#else
+    pthread_cond_destroy(&cond->cond);
+#endif
+}
+
+void thread_cond_wait(ThreadCond* cond, ThreadMutex* mutex) {
+#ifdef _WIN32
+    SleepConditionVariableCS(&cond->cond, &mutex->lock, INFINITE);
+#else
+    pthread_cond_wait(&cond->cond, &mutex->lock);
+#endif
+}
+
+/**
+ * Waits on a condition variable with a relative timeout
+ * Time Complexity: O(1) (blocks up to timeout_us)
+ * 
+ * @param cond: Condition variable
+ * @param mutex: Mutex protecting the condition
+ * @param timeout_us: Maximum wait in microseconds
+ */
+void thread_cond_timedwait(ThreadCond* cond, ThreadMutex* mutex, long long timeout_us) {
+    if (timeout_us < 0) {
+        timeout_us = 0;
+    }
+#ifdef _WIN32
+    SleepConditionVariableCS(&cond->cond, &mutex->lock, (DWORD)((timeout_us + 999) / 1000));
+#else
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += (time_t)(timeout_us / 1000000);
+    deadline.tv_nsec += (long)(timeout_us % 1000000) * 1000;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    pthread_cond_timedwait(&cond->cond, &mutex->lock, &deadline);
+#endif
+}
+
+void thread_cond_signal(ThreadCond* cond) {
+#ifdef _WIN32
+    WakeConditionVariable(&cond->cond);
+#else
+    pthread_cond_signal(&cond->cond);
+#endif
+}
+
+void thread_cond_broadcast(ThreadCond* cond) {
+#ifdef _WIN32
+    WakeAllConditionVariable(&cond->cond);
+#else
+    pthread_cond_broadcast(&cond->cond);
+#endif
+}
+
+/**
+ * Returns a monotonic timestamp in microseconds
+ * Time Complexity: O(1)
+ */
+long long thread_now_us(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER now;
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&now);
+    return (long long)(now.QuadPart / frequency.QuadPart) * 1000000LL +
+           (long long)(now.QuadPart % frequency.QuadPart) * 1000000LL / frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long long)now.tv_sec * 1000000LL + now.tv_nsec / 1000;
+#endif
+}
+
+/**
+ * Returns the number of online processors
+ * Time Complexity: O(1)
+ */
+int thread_cpu_count(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (info.dwNumberOfProcessors > 0) ? (int)info.dwNumberOfProcessors : 1;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? (int)count : 1;
+#endif
+}
+
+/**
+ * Lets another ready thread run
+ * Time Complexity: O(1)
+ */
+void thread_yield(void) {
+#ifdef _WIN32
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
@@ -0,0 +1,141 @@
+#ifndef THREAD_H
+#define THREAD_H
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+/**
+ * Portable Threads
+ * Minimal wrapper over Win32 threads and POSIX threads
+ *
+ * Provides what the background writers need: one worker thread, a mutex,
+ * condition variables with a relative timeout and a monotonic clock.
+ * Win32 uses CRITICAL_SECTION and CONDITION_VARIABLE (Vista and later).
+ */
+
+/**
+ * Thread entry point
+ */
+typedef void (*ThreadFn)(void* arg);
+
+/**
+ * Thread Handle
+ */
+typedef struct {
+#ifdef _WIN32
+    HANDLE handle;           // Win32 thread handle
+#else
+    pthread_t handle;        // POSIX thread
+#endif
+    ThreadFn fn;             // Entry point
+    void* arg;               // Entry point argument
+} Thread;
+
+/**
+ * Mutex
+ */
+typedef struct {
+#ifdef _WIN32
+    CRITICAL_SECTION lock;
+#else
+    pthread_mutex_t lock;
+#endif
+} ThreadMutex;
+
+/**
+ * Condition Variable
+ */
+typedef struct {
+#ifdef _WIN32
+    CONDITION_VARIABLE cond;
+#else
+    pthread_cond_t cond;     // Waits are timed against CLOCK_MONOTONIC
+#endif
+} ThreadCond;
+
+/**
+ * Thread Operations
+ * Time Complexity: O(1) each (waits block)
+ */
+
+/**
+ * Starts a thread
+ * @param thread: Handle to fill (fn and arg are stored in it, keep it alive until join)
+ * @param fn: Entry point
+ * @param arg: Entry point argument
+ * @return: 1 on success, 0 on failure
+ */
+int thread_start(Thread* thread, ThreadFn fn, void* arg);
+
+/**
+ * Waits for a thread to finish
+ * @param thread: Thread started with thread_start
+ */
+void thread_join(Thread* thread);
+
+/**
+ * Initializes / destroys a mutex
+ * @param mutex: Mutex
+ */
+void thread_mutex_init(ThreadMutex* mutex);
+void thread_mutex_destroy(ThreadMutex* mutex);
+
+/**
+ * Locks / unlocks a mutex
+ * @param mutex: Mutex
+ */
+void thread_mutex_lock(ThreadMutex* mutex);
+void thread_mutex_unlock(ThreadMutex* mutex);
+
+/**
+ * Initializes / destroys a condition variable
+ * @param cond: Condition variable
+ */
+void thread_cond_init(ThreadCond* cond);
+void thread_cond_destroy(ThreadCond* cond);
+
+/**
+ * Waits on a condition variable (mutex held on entry and on return)
+ * Spurious wakeups are possible, callers re-check their condition
+ * @param cond: Condition variable
+ * @param mutex: Mutex protecting the condition
+ */
+void thread_cond_wait(ThreadCond* cond, ThreadMutex* mutex);
+
+/**
+ * Waits on a condition variable for at most timeout_us microseconds
+ * Win32 rounds the timeout up to whole milliseconds
+ * @param cond: Condition variable
+ * @param mutex: Mutex protecting the condition
+ * @param timeout_us: Maximum wait in microseconds
+ */
+void thread_cond_timedwait(ThreadCond* cond, ThreadMutex* mutex, long long timeout_us);
+
+/**
+ * Wakes one / all waiters
+ * @param cond: Condition variable
+ */
+void thread_cond_signal(ThreadCond* cond);
+void thread_cond_broadcast(ThreadCond* cond);
+
+/**
+ * Returns a monotonic timestamp
+ * @return: Microseconds since an arbitrary fixed point
+ */
+long long thread_now_us(void);
+
+/**
+ * Returns the number of online processors
+ * @return: Processor count (at least 1)
+ */
+int thread_cpu_count(void);
+
+/**
+ * Lets another ready thread run (for spin-waits)
+ */
+void thread_yield(void);
+
+#endif // THREAD_H
@@ -0,0 +1,300 @@
+/**
+ * Growable Record Vectors Implementation
+ * 
+ * The three vector types share one growth routine; each typed wrapper
+ * only stores the reallocated array back into its own field.
+ * 
+ * The appointment vector's ID index stores position + 1 (0 = absent) and
+ * covers items[0..indexed); find extends it over newer items first. With
+ * duplicate IDs the first position is kept.
+ * 
+ * Time Complexity:
+ * - push: O(1) amortized (capacity doubles)
+ * - reserve: O(n) when the array moves
+ * - appointment find/remove: O(1) expected
+ */
+
+#include <limits.h>
+#include <stdint.h>
+#include "vector.h"
+
+/**
+ * Internal helper: Computes the capacity to grow to
+ * Doubles the current capacity until it covers needed
+ * @return: New capacity, 0 if needed cannot be represented
+ */
+static int vector_next_capacity(int capacity, int needed) {
+    if (needed <= 0) {
+        return 0;
+    }
+    long long next = (capacity > 0) ? capacity : VECTOR_INITIAL_CAPACITY;
+    while (next < needed) {
+        next *= 2;
+    }
+    if (next > INT_MAX) {
+        next = needed; // Last step would overflow, take exactly what is asked
+    }
+    return (int)next;
+}
+
+/**
+ * Internal helper: Reallocates a pointer array for a new capacity
+ * @return: New array, NULL if memory ran out (the old array stays valid)
+ */
+static void* vector_grow(void* items, int capacity, size_t element_size) {
+    if ((size_t)capacity > (size_t)-1 / element_size) {
+        return NULL;
+    }
+    return realloc(items, (size_t)capacity * element_size);
+}
+
+/**
+ * Patient Vector Operations
+ */
+
+void patient_vector_init(PatientVector* vector) {
+    if (vector == NULL) {
+        return;
+    }
+    vector->items = NULL;
+    vector->count = 0;
+    vector->capacity = 0;
+}
+
+int patient_vector_reserve(PatientVector* vector, int capacity) {
+    if (vector == NULL) {
+        return 0;
+    }
+    if (capacity <= vector->capacity) {
+        return 1;
+    }
+    Patient** items = (Patient**)vector_grow(vector->items, capacity, sizeof(Patient*));
+    if (items == NULL) {
+        return 0; // Memory allocation failed
+    }
+    vector->items = items;
+    vector->capacity = capacity;
+    return 1;
+}
+
+int patient_vector_push(PatientVector* vector, Patient* patient) {
+    if (vector == NULL || vector->count == INT_MAX) {
+        return 0;
+    }
+    if (vector->count == vector->capacity &&
+        !patient_vector_reserve(vector, vector_next_capacity(vector->capacity, vector->count + 1))) {
+        return 0;
+    }
+    vector->items[vector->count++] = patient;
+    return 1;
+}
+
+void patient_vector_destroy(PatientVector* vector) {
+    if (vector == NULL) {
+        return;
+    }
+    free(vector->items);
+    patient_vector_init(vector);
+}
+
+/**
+ * Doctor Vector Operations
+ */
+
+void doctor_vector_init(DoctorVector* vector) {
+    if (vector == NULL) {
+        return;
+    }
+    vector->items = NULL;
+    vector->count = 0;
+    vector->capacity = 0;
+}
+
+int doctor_vector_reserve(DoctorVector* vector, int capacity) {
+    if (vector == NULL) {
+        return 0;
+    }
+    if (capacity <= vector->capacity) {
+        return 1;
+    }
+    Doctor** items = (Doctor**)vector_grow(vector->items, capacity, sizeof(Doctor*));
+    if (items == NULL) {
+        return 0; // Memory allocation failed
+    }
+    vector->items = items;
+    vector->capacity = capacity;
+    return 1;
+}
+
+int doctor_vector_push(DoctorVector* vector, Doctor* doctor) {
+    if (vector == NULL || vector->count == INT_MAX) {
+        return 0;
+    }
+    if (vector->count == vector->capacity &&
+        !doctor_vector_reserve(vector, vector_next_capacity(vector->capacity, vector->count + 1))) {
+        return 0;
+    }
+    vector->items[vector->count++] = doctor;
+    return 1;
+}
+
+void doctor_vector_destroy(DoctorVector* vector) {
+    if (vector == NULL) {
+        return;
+    }
+    free(vector->items);
+    doctor_vector_init(vector);
+}
+
+/**
+ * Appointment Vector Operations
+ */
+
+void appointment_vector_init(AppointmentVector* vector) {
+    if (vector == NULL) {
+        return;
+    }
+    vector->items = NULL;
+    vector->count = 0;
+    vector->capacity = 0;
+    intmap_init(&vector->index);
+    vector->indexed = 0;
+}
+
+int appointment_vector_reserve(AppointmentVector* vector, int capacity) {
+    if (vector == NULL) {
+        return 0;
+    }
+    if (capacity <= vector->capacity) {
+        return 1;
+    }
+    Appointment** items = (Appointment**)vector_grow(vector->items, capacity, sizeof(Appointment*));
+    if (items == NULL) {
+        return 0; // Memory allocation failed
+    }
+    vector->items = items;
+    vector->capacity = capacity;
+    return 1;
+}
+
+int appointment_vector_push(AppointmentVector* vector, Appointment* appointment) {
+    if (vector == NULL || vector->count == INT_MAX) {
+        return 0;
+    }
+    if (vector->count == vector->capacity &&
+        !appointment_vector_reserve(vector, vector_next_capacity(vector->capacity, vector->count + 1))) {
+        return 0;
+    }
+    vector->items[vector->count++] = appointment;
+    return 1;
+}
+
+/**
+ * Internal helper: Adds items[indexed..count) to the ID index
+ * @return: 1 on success, 0 if memory ran out (the index is dropped)
+ */
+static int appointment_index_extend(AppointmentVector* vector) {
+    if (vector->indexed > vector->count) {
+        vector->indexed = vector->count;
+    }
+    if (vector->indexed < vector->count &&
+        !intmap_reserve(&vector->index, vector->count)) {
+        return 0;
+    }
+    for (int i = vector->indexed; i < vector->count; i++) {
+        Appointment* appointment = vector->items[i];
+        if (appointment != NULL && !intmap_contains(&vector->index, appointment->appointment_id) &&
+            !intmap_put(&vector->index, appointment->appointment_id, (void*)(intptr_t)(i + 1))) {
+            return 0;
+        }
+    }
+    vector->indexed = vector->count;
+    return 1;
+}
+
+/**
+ * Internal helper: Drops the ID index and builds it again from items
+ */
+static int appointment_index_rebuild(AppointmentVector* vector) {
+    intmap_destroy(&vector->index);
+    intmap_init(&vector->index);
+    vector->indexed = 0;
+    return appointment_index_extend(vector);
+}
+
+/**
+ * Internal helper: Position stored for an ID if items still agrees, else -1
+ */
+static int appointment_index_get(const AppointmentVector* vector, int appointment_id) {
+    int position = (int)(intptr_t)intmap_get(&vector->index, appointment_id) - 1;
+    if (position < 0 || position >= vector->count || vector->items[position] == NULL ||
+        vector->items[position]->appointment_id != appointment_id) {
+        return -1;
+    }
+    return position;
+}
+
+int appointment_vector_find(AppointmentVector* vector, int appointment_id) {
+    if (vector == NULL) {
+        return -1;
+    }
+    if (appointment_index_extend(vector)) {
+        int position = appointment_index_get(vector, appointment_id);
+        if (position >= 0 || !intmap_contains(&vector->index, appointment_id)) {
+            return position;
+        }
+        // Stale entry: items were rearranged without the index
+        if (appointment_index_rebuild(vector)) {
+            return appointment_index_get(vector, appointment_id);
+        }
+    }
+
+    // Index unavailable (out of memory): scan
+    appointment_index_rebuild(vector);
+    for (int i = 0; i < vector->count; i++) {
+        if (vector->items[i] != NULL && vector->items[i]->appointment_id == appointment_id) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+Appointment* appointment_vector_remove(AppointmentVector* vector, int position) {
+    if (vector == NULL || position < 0 || position >= vector->count) {
+        return NULL;
+    }
+
+    Appointment* appointment = vector->items[position];
+    int last = vector->count - 1;
+    if (appointment != NULL && appointment_index_get(vector, appointment->appointment_id) == position) {
+        intmap_remove(&vector->index, appointment->appointment_id);
+    }
+
+    // Move the last item into the hole and repoint its entry
+    Appointment* moved = vector->items[last];
+    vector->items[position] = moved;
+    vector->items[last] = NULL;
+    vector->count--;
+    if (position < last && moved != NULL) {
+        int stored = (int)(intptr_t)intmap_get(&vector->index, moved->appointment_id) - 1;
+        if (stored == last) {
+            intmap_put(&vector->index, moved->appointment_id, (void*)(intptr_t)(position + 1));
+        } else if (stored < 0 && position < vector->indexed) {
+            // Not indexed yet and now below indexed: index the tail instead
+            vector->indexed = position;
+        }
+    }
+    if (vector->indexed > vector->count) {
+        vector->indexed = vector->count;
+    }
+    return appointment;
+}
+
+void appointment_vector_destroy(AppointmentVector* vector) {
+    if (vector == NULL) {
+        return;
+    }
+    free(vector->items);
+    intmap_destroy(&vector->index);
+    appointment_vector_init(vector);
+}
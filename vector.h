@@ -0,0 +1,124 @@
+#ifndef VECTOR_H
+#define VECTOR_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "patient.h"
+#include "doctor.h"
+#include "appointment.h"
+#include "intmap.h"
+
+/**
+ * Growable Record Vectors
+ * Dynamic arrays of patient, doctor and appointment pointers
+ *
+ * The array doubles when full (amortized O(1) append) and never has a
+ * fixed ceiling. items and count can be read directly, and passed to
+ * functions that take a pointer array plus a count (sorting, searching,
+ * CSV saving). Removing is done in place by the owner (e.g. move the last
+ * element into the hole and decrement count).
+ *
+ * The appointment vector also keeps an appointment_id -> position index
+ * for undo/redo, replay and cancellation. It is extended lazily over
+ * appended items, so bulk loads may append to items directly; removals
+ * should go through appointment_vector_remove. Every lookup is checked
+ * against items, and a stale index (items rearranged by hand) is rebuilt.
+ *
+ * A vector owns its pointer array only; the records themselves are
+ * created and freed by the caller.
+ */
+
+/**
+ * Capacity allocated by the first append
+ */
+#define VECTOR_INITIAL_CAPACITY 16
+
+/**
+ * Patient Vector
+ */
+typedef struct {
+    Patient** items;  // Patient pointers
+    int count;        // Number of patients
+    int capacity;     // Slots allocated
+} PatientVector;
+
+/**
+ * Doctor Vector
+ */
+typedef struct {
+    Doctor** items;   // Doctor pointers
+    int count;        // Number of doctors
+    int capacity;     // Slots allocated
+} DoctorVector;
+
+/**
+ * Appointment Vector
+ */
+typedef struct {
+    Appointment** items;  // Appointment pointers
+    int count;            // Number of appointments
+    int capacity;         // Slots allocated
+    IntMap index;         // appointment_id -> position + 1
+    int indexed;          // items[0..indexed) are in the index
+} AppointmentVector;
+
+/**
+ * Vector Operations
+ * Time Complexity: O(1) amortized push, O(n) reserve
+ */
+
+/**
+ * Initializes an empty vector (no allocation until first push or reserve)
+ * @param vector: Pointer to vector to initialize
+ */
+void patient_vector_init(PatientVector* vector);
+void doctor_vector_init(DoctorVector* vector);
+void appointment_vector_init(AppointmentVector* vector);
+
+/**
+ * Makes room for at least capacity records
+ * @param vector: Pointer to vector
+ * @param capacity: Minimum capacity
+ * @return: 1 on success, 0 if memory ran out (the vector is unchanged)
+ */
+int patient_vector_reserve(PatientVector* vector, int capacity);
+int doctor_vector_reserve(DoctorVector* vector, int capacity);
+int appointment_vector_reserve(AppointmentVector* vector, int capacity);
+
+/**
+ * Appends a record, growing the array if needed
+ * @param vector: Pointer to vector
+ * @param record: Record to append
+ * @return: 1 on success, 0 if memory ran out
+ */
+int patient_vector_push(PatientVector* vector, Patient* patient);
+int doctor_vector_push(DoctorVector* vector, Doctor* doctor);
+int appointment_vector_push(AppointmentVector* vector, Appointment* appointment);
+
+/**
+ * Finds an appointment's position through the ID index
+ * Time Complexity: O(1) expected, O(n) after a bulk append or stale index
+ * @param vector: Pointer to vector
+ * @param appointment_id: Appointment ID
+ * @return: Position in items, -1 if absent
+ */
+int appointment_vector_find(AppointmentVector* vector, int appointment_id);
+
+/**
+ * Removes the appointment at a position (the last one moves into the hole)
+ * Time Complexity: O(1) expected
+ * @param vector: Pointer to vector
+ * @param position: Position in items
+ * @return: Removed appointment (not freed), NULL if position is invalid
+ */
+Appointment* appointment_vector_remove(AppointmentVector* vector, int position);
+
+/**
+ * Frees the pointer array (not the records) and leaves the vector empty
+ * @param vector: Pointer to vector
+ */
+void patient_vector_destroy(PatientVector* vector);
+void doctor_vector_destroy(DoctorVector* vector);
+void appointment_vector_destroy(AppointmentVector* vector);
+
+#endif // VECTOR_H
@@ -0,0 +1,446 @@
+/**
+ * Priority-Aware Waiting List Implementation
+ * 
+ * Bucketed priority queue keyed by virtual deadline
+ * - One FIFO bucket per triage level
+ * - Inside a bucket both keys (arrival sequence, virtual deadline) are
+ *   non-decreasing, so only bucket heads compete for the next slot
+ * - Aging is built into the deadline, no periodic re-prioritization pass
+ * - Entries are doubly linked and indexed by appointment and patient ID,
+ *   so any entry can be unlinked without walking its bucket
+ * 
+ * Time Complexity:
+ * - enqueue: O(1) expected (index inserts)
+ * - withdraw/find/patient lookup: O(1) expected
+ * - dequeue/peek: O(L) where L = WAITLIST_TRIAGE_LEVELS (constant)
+ * - aging: O(1) - implicit in the key
+ * - ordered listing: O(n * L)
+ */
+
+#include "waitlist.h"
+#include <time.h>
+
+/**
+ * Returns the current time in minutes since epoch
+ * 
+ * @return: Minutes since epoch
+ */
+long long waitlist_now_minutes(void) {
+    return (long long)time(NULL) / 60;
+}
+
+/**
+ * Initializes an empty waiting list
+ * Time Complexity: O(L)
+ * 
+ * @param waitlist: Pointer to waiting list to initialize
+ * @param mode: Ordering mode
+ */
+void waitlist_init(Waitlist* waitlist, WaitlistMode mode) {
+    if (waitlist == NULL) {
+        return;
+    }
+    waitlist->mode = mode;
+    for (int i = 0; i < WAITLIST_TRIAGE_LEVELS; i++) {
+        waitlist->buckets[i].head = NULL;
+        waitlist->buckets[i].tail = NULL;
+        waitlist->buckets[i].size = 0;
+    }
+    waitlist->next_sequence = 0;
+    waitlist->size = 0;
+    intmap_init(&waitlist->by_appointment);
+    intmap_init(&waitlist->by_patient);
+}
+
+/**
+ * Changes the ordering mode
+ * Time Complexity: O(1) - both keys are stored on every entry
+ * 
+ * @param waitlist: Pointer to waiting list
+ * @param mode: New ordering mode
+ */
+void waitlist_set_mode(Waitlist* waitlist, WaitlistMode mode) {
+    if (waitlist == NULL) {
+        return;
+    }
+    waitlist->mode = mode;
+}
+
+/**
+ * Internal helper: Returns 1 if entry a is served before entry b
+ */
+static int waitlist_entry_before(const Waitlist* waitlist,
+                                 const WaitlistEntry* a, const WaitlistEntry* b) {
+    if (waitlist->mode == WAITLIST_MODE_TRIAGE && a->deadline != b->deadline) {
+        return a->deadline < b->deadline;
+    }
+    return a->sequence < b->sequence; // FIFO, or tie-break on arrival
+}
+
+/**
+ * Internal helper: Index of the bucket whose head is served next
+ * Time Complexity: O(L)
+ * 
+ * @return: Bucket index, -1 if empty
+ */
+static int waitlist_next_bucket(const Waitlist* waitlist) {
+    int best = -1;
+    for (int i = 0; i < WAITLIST_TRIAGE_LEVELS; i++) {
+        const WaitlistEntry* head = waitlist->buckets[i].head;
+        if (head == NULL) {
+            continue;
+        }
+        if (best < 0 || waitlist_entry_before(waitlist, head, waitlist->buckets[best].head)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+/**
+ * Adds an appointment with an explicit arrival time
+ * Time Complexity: O(1) - append to the bucket tail
+ * 
+ * @param waitlist: Pointer to waiting list
+ * @param appointment: Appointment to add
+ * @param triage_level: 1..WAITLIST_TRIAGE_LEVELS (out of range -> default)
+ * @param enqueued_at: Arrival time in minutes since epoch
+ * @return: 1 on success, 0 on failure (including duplicate appointment ID)
+ */
+int waitlist_enqueue_at(Waitlist* waitlist, Appointment* appointment,
+                        int triage_level, long long enqueued_at) {
+    if (waitlist == NULL || appointment == NULL) {
+        return 0;
+    }
+
+    if (intmap_contains(&waitlist->by_appointment, appointment->appointment_id)) {
+        return 0; // Already waiting
+    }
+
+    if (triage_level < 1 || triage_level > WAITLIST_TRIAGE_LEVELS) {
+        triage_level = WAITLIST_DEFAULT_TRIAGE;
+    }
+
+    WaitlistEntry* entry = (WaitlistEntry*)malloc(sizeof(WaitlistEntry));
+    if (entry == NULL) {
+        return 0; // Memory allocation failed
+    }
+
+    WaitlistBucket* bucket = &waitlist->buckets[triage_level - 1];
+
+    // Keep deadlines non-decreasing inside the bucket (clock going backwards)
+    if (bucket->tail != NULL && enqueued_at < bucket->tail->enqueued_at) {
+        enqueued_at = bucket->tail->enqueued_at;
+    }
+
+    entry->appointment = appointment;
+    entry->triage_level = triage_level;
+    entry->enqueued_at = enqueued_at;
+    entry->sequence = waitlist->next_sequence++;
+    entry->deadline = enqueued_at + (long long)(triage_level - 1) * WAITLIST_AGING_MINUTES;
+    entry->prev = bucket->tail;
+    entry->next = NULL;
+
+    // Index by appointment, then push to the front of the patient's list
+    WaitlistEntry* patient_head = (WaitlistEntry*)intmap_get(&waitlist->by_patient,
+                                                             appointment->patient_id);
+    if (!intmap_put(&waitlist->by_appointment, appointment->appointment_id, entry)) {
+        free(entry);
+        return 0;
+    }
+    if (!intmap_put(&waitlist->by_patient, appointment->patient_id, entry)) {
+        intmap_remove(&waitlist->by_appointment, appointment->appointment_id);
+        free(entry);
+        return 0;
+    }
+    entry->patient_prev = NULL;
+    entry->patient_next = patient_head;
+    if (patient_head != NULL) {
+        patient_head->patient_prev = entry;
+    }
+
+    if (bucket->tail == NULL) {
+        bucket->head = entry;
+    } else {
+        bucket->tail->next = entry;
+    }
+    bucket->tail = entry;
+    bucket->size++;
+    waitlist->size++;
+
+    return 1; // Success
+}
+
+/**
+ * Adds an appointment with the current time as arrival time
+ * Time Complexity: O(1)
+ * 
+ * @param waitlist: Pointer to waiting list
+ * @param appointment: Appointment to add
+ * @param triage_level: 1..WAITLIST_TRIAGE_LEVELS (out of range -> default)
+ * @return: 1 on success, 0 on failure
+ */
+int waitlist_enqueue(Waitlist* waitlist, Appointment* appointment, int triage_level) {
+    return waitlist_enqueue_at(waitlist, appointment, triage_level, waitlist_now_minutes());
+}
+
+/**
+ * Internal helper: Unlinks an entry from its bucket and both indexes, then frees it
+ * Time Complexity: O(1) expected
+ * 
+ * @return: Appointment of the removed entry
+ */
+static Appointment* waitlist_unlink(Waitlist* waitlist, WaitlistEntry* entry) {
+    WaitlistBucket* bucket = &waitlist->buckets[entry->triage_level - 1];
+    if (entry->prev == NULL) {
+        bucket->head = entry->next;
+    } else {
+        entry->prev->next = entry->next;
+    }
+    if (entry->next == NULL) {
+        bucket->tail = entry->prev;
+    } else {
+        entry->next->prev = entry->prev;
+    }
+    bucket->size--;
+    waitlist->size--;
+
+    Appointment* appointment = entry->appointment;
+    intmap_remove(&waitlist->by_appointment, appointment->appointment_id);
+
+    // Patient list: a head change is the only case that touches the index
+    if (entry->patient_next != NULL) {
+        entry->patient_next->patient_prev = entry->patient_prev;
+    }
+    if (entry->patient_prev != NULL) {
+        entry->patient_prev->patient_next = entry->patient_next;
+    } else if (entry->patient_next != NULL) {
+        intmap_put(&waitlist->by_patient, appointment->patient_id, entry->patient_next);
+    } else {
+        intmap_remove(&waitlist->by_patient, appointment->patient_id);
+    }
+
+    free(entry); // Appointment is owned by the caller
+    return appointment;
+}
+
+/**
+ * Returns the entry that would be dequeued next
+ * Time Complexity: O(L)
+ * 
+ * @param waitlist: Pointer to waiting list
+ * @return: Next entry, NULL if empty
+ */
+const WaitlistEntry* waitlist_peek(const Waitlist* waitlist) {
+    if (waitlist == NULL || waitlist->size == 0) {
+        return NULL;
+    }
+    int best = waitlist_next_bucket(waitlist);
+    return (best < 0) ? NULL : waitlist->buckets[best].head;
+}
+
+/**
+ * Removes and returns the next appointment for the current mode
+ * Time Complexity: O(L)
+ * 
+ * @param waitlist: Pointer to waiting list
+ * @return: Appointment, NULL if empty
+ */
+Appointment* waitlist_dequeue(Waitlist* waitlist) {
+    if (waitlist == NULL || waitlist->size == 0) {
+        return NULL;
+    }
+
+    int best = waitlist_next_bucket(waitlist);
+    if (best < 0) {
+        return NULL;
+    }
+
+    return waitlist_unlink(waitlist, waitlist->buckets[best].head);
+}
+
+/**
+ * Finds the entry of a waiting appointment
+ * Time Complexity: O(1) expected
+ * 
+ * @param waitlist: Pointer to waiting list
+ * @param appointment_id: Appointment ID
+ * @return: Entry, NULL if the appointment is not waiting
+ */
+const WaitlistEntry* waitlist_find(const Waitlist* waitlist, int appointment_id) {
+    if (waitlist == NULL) {
+        return NULL;
+    }
+    return (const WaitlistEntry*)intmap_get(&waitlist->by_appointment, appointment_id);
+}
+
+/**
+ * Returns the first waiting entry of a patient
+ * Time Complexity: O(1) expected
+ * 
+ * @param waitlist: Pointer to waiting list
+ * @param patient_id: Patient ID
+ * @return: First entry, NULL if the patient is not waiting
+ */
+const WaitlistEntry* waitlist_patient_entries(const Waitlist* waitlist, int patient_id) {
+    if (waitlist == NULL) {
+        return NULL;
+    }
+    return (const WaitlistEntry*)intmap_get(&waitlist->by_patient, patient_id);
+}
+
+/**
+ * Removes a waiting appointment regardless of its position
+ * Time Complexity: O(1) expected
+ * 
+ * @param waitlist: Pointer to waiting list
+ * @param appointment_id: Appointment ID
+ * @return: Removed appointment (caller owns it), NULL if not waiting
+ */
+Appointment* waitlist_withdraw(Waitlist* waitlist, int appointment_id) {
+    if (waitlist == NULL) {
+        return NULL;
+    }
+    WaitlistEntry* entry = (WaitlistEntry*)intmap_get(&waitlist->by_appointment, appointment_id);
+    if (entry == NULL) {
+        return NULL;
+    }
+    return waitlist_unlink(waitlist, entry);
+}
+
+/**
+ * Internal helper: k-way merge of the bucket lists into an array
+ * by_arrival selects sequence order regardless of the current mode
+ * Time Complexity: O(n * L)
+ */
+static int waitlist_merge(const Waitlist* waitlist, int by_arrival,
+                          const WaitlistEntry** entries, int max_entries) {
+    if (waitlist == NULL || entries == NULL || max_entries <= 0) {
+        return 0;
+    }
+
+    const WaitlistEntry* cursor[WAITLIST_TRIAGE_LEVELS];
+    for (int i = 0; i < WAITLIST_TRIAGE_LEVELS; i++) {
+        cursor[i] = waitlist->buckets[i].head;
+    }
+
+    int count = 0;
+    while (count < max_entries) {
+        int best = -1;
+        for (int i = 0; i < WAITLIST_TRIAGE_LEVELS; i++) {
+            if (cursor[i] == NULL) {
+                continue;
+            }
+            if (best < 0 ||
+                (by_arrival ? cursor[i]->sequence < cursor[best]->sequence
+                            : waitlist_entry_before(waitlist, cursor[i], cursor[best]))) {
+                best = i;
+            }
+        }
+        if (best < 0) {
+            break; // All buckets consumed
+        }
+        entries[count++] = cursor[best];
+        cursor[best] = cursor[best]->next;
+    }
+
+    return count;
+}
+
+/**
+ * Fills an array with entries in service order
+ * The waiting list is not modified
+ * Time Complexity: O(n * L)
+ * 
+ * @param waitlist: Pointer to waiting list
+ * @param entries: Output array
+ * @param max_entries: Capacity of output array
+ * @return: Number of entries written
+ */
+int waitlist_ordered(const Waitlist* waitlist, const WaitlistEntry** entries, int max_entries) {
+    return waitlist_merge(waitlist, 0, entries, max_entries);
+}
+
+/**
+ * Fills an array with entries in arrival order (independent of mode)
+ * Time Complexity: O(n * L)
+ * 
+ * @param waitlist: Pointer to waiting list
+ * @param entries: Output array
+ * @param max_entries: Capacity of output array
+ * @return: Number of entries written
+ */
+int waitlist_arrival_order(const Waitlist* waitlist, const WaitlistEntry** entries, int max_entries) {
+    return waitlist_merge(waitlist, 1, entries, max_entries);
+}
+
+/**
+ * Returns the number of entries
+ * Time Complexity: O(1)
+ * 
+ * @param waitlist: Pointer to waiting list
+ * @return: Size of waiting list
+ */
+int waitlist_size(const Waitlist* waitlist) {
+    if (waitlist == NULL) {
+        return 0;
+    }
+    return waitlist->size;
+}
+
+/**
+ * Checks if waiting list is empty
+ * Time Complexity: O(1)
+ * 
+ * @param waitlist: Pointer to waiting list
+ * @return: 1 if empty, 0 otherwise
+ */
+int waitlist_is_empty(const Waitlist* waitlist) {
+    return waitlist_size(waitlist) == 0;
+}
+
+/**
+ * Returns a display name for a triage level
+ * 
+ * @param triage_level: Triage level
+ * @return: Static string
+ */
+const char* waitlist_triage_name(int triage_level) {
+    switch (triage_level) {
+        case 1: return "Kritik";
+        case 2: return "Acil";
+        case 3: return "Oncelikli";
+        case 4: return "Normal";
+        case 5: return "Rutin";
+        default: return "Bilinmiyor";
+    }
+}
+
+/**
+ * Frees all entries and indexes
+ * Time Complexity: O(n)
+ * 
+ * Note: Does not free appointments - they are managed elsewhere
+ * 
+ * @param waitlist: Pointer to waiting list to destroy
+ */
+void waitlist_destroy(Waitlist* waitlist) {
+    if (waitlist == NULL) {
+        return;
+    }
+
+    for (int i = 0; i < WAITLIST_TRIAGE_LEVELS; i++) {
+        WaitlistEntry* entry = waitlist->buckets[i].head;
+        while (entry != NULL) {
+            WaitlistEntry* next = entry->next;
+            free(entry);
+            entry = next;
+        }
+        waitlist->buckets[i].head = NULL;
+        waitlist->buckets[i].tail = NULL;
+        waitlist->buckets[i].size = 0;
+    }
+    waitlist->size = 0;
+    intmap_destroy(&waitlist->by_appointment);
+    intmap_destroy(&waitlist->by_patient);
+}
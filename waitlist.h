@@ -0,0 +1,222 @@
+#ifndef WAITLIST_H
+#define WAITLIST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "appointment.h"
+#include "intmap.h"
+
+/**
+ * Priority-Aware Waiting List
+ *
+ * Appointments that cannot be scheduled wait here. Two ordering modes:
+ * - FIFO (default): strict arrival order
+ * - Triage: ordered by (triage level, aged wait time)
+ *
+ * Aging is expressed as a virtual deadline fixed at insertion:
+ *     deadline = enqueued_at + (triage_level - 1) * WAITLIST_AGING_MINUTES
+ * Every WAITLIST_AGING_MINUTES of waiting is worth one triage level, so a
+ * routine patient eventually overtakes newer urgent ones. Because the key
+ * never changes after insertion, no entry is ever rescanned to age it.
+ *
+ * Entries are bucketed by triage level; each bucket is a FIFO list whose
+ * deadlines are non-decreasing, so the next entry is always one of the
+ * WAITLIST_TRIAGE_LEVELS bucket heads.
+ *
+ * Entries are intrusive doubly-linked nodes, indexed by appointment ID and
+ * by patient ID (each patient's entries form their own linked list), so a
+ * withdrawal unlinks a node in O(1) instead of scanning the list.
+ */
+
+/**
+ * Number of triage levels (1 = most urgent)
+ */
+#define WAITLIST_TRIAGE_LEVELS 5
+
+/**
+ * Triage level used when none is given (FIFO mode, imports)
+ */
+#define WAITLIST_DEFAULT_TRIAGE 4
+
+/**
+ * Minutes of waiting that are worth one triage level
+ */
+#define WAITLIST_AGING_MINUTES 30
+
+/**
+ * Waiting list ordering mode
+ */
+typedef enum {
+    WAITLIST_MODE_FIFO = 0,   // Arrival order (default)
+    WAITLIST_MODE_TRIAGE = 1  // Triage level with aging
+} WaitlistMode;
+
+/**
+ * Waiting List Entry
+ * Owned by the waiting list; the appointment is owned by the caller
+ */
+typedef struct WaitlistEntry {
+    Appointment* appointment;     // Waiting appointment
+    int triage_level;             // 1 (most urgent) .. WAITLIST_TRIAGE_LEVELS
+    long long enqueued_at;        // Minutes since epoch when added
+    long long sequence;           // Global arrival number (FIFO key)
+    long long deadline;           // Virtual deadline (triage key)
+    struct WaitlistEntry* prev;   // Previous entry in the same bucket
+    struct WaitlistEntry* next;   // Next entry in the same bucket
+    struct WaitlistEntry* patient_prev;  // Previous entry of the same patient
+    struct WaitlistEntry* patient_next;  // Next entry of the same patient
+} WaitlistEntry;
+
+/**
+ * FIFO bucket holding the entries of one triage level
+ */
+typedef struct {
+    WaitlistEntry* head;  // Oldest entry
+    WaitlistEntry* tail;  // Newest entry
+    int size;             // Entries in bucket
+} WaitlistBucket;
+
+/**
+ * Waiting List Structure
+ */
+typedef struct {
+    WaitlistMode mode;                               // Current ordering mode
+    WaitlistBucket buckets[WAITLIST_TRIAGE_LEVELS];  // One bucket per triage level
+    long long next_sequence;                         // Next arrival number
+    int size;                                        // Total entries
+    IntMap by_appointment;                           // appointment_id -> entry
+    IntMap by_patient;                               // patient_id -> first entry of patient
+} Waitlist;
+
+/**
+ * Waiting List Operations
+ * Time Complexity: O(1) enqueue/withdraw/lookup, O(L) dequeue/peek with L = triage levels
+ */
+
+/**
+ * Initializes an empty waiting list
+ * @param waitlist: Pointer to waiting list to initialize
+ * @param mode: Ordering mode
+ */
+void waitlist_init(Waitlist* waitlist, WaitlistMode mode);
+
+/**
+ * Changes the ordering mode (entries keep their keys, no rescan)
+ * @param waitlist: Pointer to waiting list
+ * @param mode: New ordering mode
+ */
+void waitlist_set_mode(Waitlist* waitlist, WaitlistMode mode);
+
+/**
+ * Adds an appointment with the current time as arrival time
+ * @param waitlist: Pointer to waiting list
+ * @param appointment: Appointment to add
+ * @param triage_level: 1..WAITLIST_TRIAGE_LEVELS (out of range -> default)
+ * @return: 1 on success, 0 on failure (including duplicate appointment ID)
+ */
+int waitlist_enqueue(Waitlist* waitlist, Appointment* appointment, int triage_level);
+
+/**
+ * Adds an appointment with an explicit arrival time (minutes since epoch)
+ * Arrival times within a triage level must be non-decreasing
+ * @param waitlist: Pointer to waiting list
+ * @param appointment: Appointment to add
+ * @param triage_level: 1..WAITLIST_TRIAGE_LEVELS (out of range -> default)
+ * @param enqueued_at: Arrival time in minutes since epoch
+ * @return: 1 on success, 0 on failure
+ */
+int waitlist_enqueue_at(Waitlist* waitlist, Appointment* appointment,
+                        int triage_level, long long enqueued_at);
+
+/**
+ * Returns the entry that would be dequeued next without removing it
+ * @param waitlist: Pointer to waiting list
+ * @return: Next entry, NULL if empty
+ */
+const WaitlistEntry* waitlist_peek(const Waitlist* waitlist);
+
+/**
+ * Removes and returns the next appointment for the current mode
+ * @param waitlist: Pointer to waiting list
+ * @return: Appointment, NULL if empty
+ */
+Appointment* waitlist_dequeue(Waitlist* waitlist);
+
+/**
+ * Finds the entry of a waiting appointment
+ * @param waitlist: Pointer to waiting list
+ * @param appointment_id: Appointment ID
+ * @return: Entry, NULL if the appointment is not waiting
+ */
+const WaitlistEntry* waitlist_find(const Waitlist* waitlist, int appointment_id);
+
+/**
+ * Returns the first waiting entry of a patient
+ * Further entries of the patient follow through patient_next
+ * @param waitlist: Pointer to waiting list
+ * @param patient_id: Patient ID
+ * @return: First entry, NULL if the patient is not waiting
+ */
+const WaitlistEntry* waitlist_patient_entries(const Waitlist* waitlist, int patient_id);
+
+/**
+ * Removes a waiting appointment regardless of its position
+ * @param waitlist: Pointer to waiting list
+ * @param appointment_id: Appointment ID
+ * @return: Removed appointment (caller owns it), NULL if not waiting
+ */
+Appointment* waitlist_withdraw(Waitlist* waitlist, int appointment_id);
+
+/**
+ * Fills an array with entries in service order (next first)
+ * @param waitlist: Pointer to waiting list
+ * @param entries: Output array
+ * @param max_entries: Capacity of output array
+ * @return: Number of entries written
+ */
+int waitlist_ordered(const Waitlist* waitlist, const WaitlistEntry** entries, int max_entries);
+
+/**
+ * Fills an array with entries in arrival order, whatever the mode
+ * Re-enqueueing them in this order rebuilds the same waiting list
+ * @param waitlist: Pointer to waiting list
+ * @param entries: Output array
+ * @param max_entries: Capacity of output array
+ * @return: Number of entries written
+ */
+int waitlist_arrival_order(const Waitlist* waitlist, const WaitlistEntry** entries, int max_entries);
+
+/**
+ * Returns the number of entries
+ * @param waitlist: Pointer to waiting list
+ * @return: Size of waiting list
+ */
+int waitlist_size(const Waitlist* waitlist);
+
+/**
+ * Checks if waiting list is empty
+ * @param waitlist: Pointer to waiting list
+ * @return: 1 if empty, 0 otherwise
+ */
+int waitlist_is_empty(const Waitlist* waitlist);
+
+/**
+ * Returns a display name for a triage level
+ * @param triage_level: Triage level
+ * @return: Static string
+ */
+const char* waitlist_triage_name(int triage_level);
+
+/**
+ * Returns the current time in minutes since epoch
+ * @return: Minutes since epoch
+ */
+long long waitlist_now_minutes(void);
+
+/**
+ * Frees all entries and indexes (appointments are not freed)
+ * @param waitlist: Pointer to waiting list to destroy
+ */
+void waitlist_destroy(Waitlist* waitlist);
+
+#endif // WAITLIST_H
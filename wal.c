@@ -0,0 +1,948 @@
+/**
+ * Write-Ahead Log Implementation
+ * 
+ * Append-only binary log of checksummed, variable-size records
+ * - Each mutation costs one small append (at most 16 + 256 bytes) into an
+ *   in-memory pending buffer
+ * - Group commit: a committer thread writes the pending buffer and fsyncs it
+ *   once per commit window, so back-to-back or concurrent mutations share a
+ *   single write+fsync; callers that must know a record is on disk wait for
+ *   its LSN to become durable
+ * - Replay is a single sequential pass; records are decoded into journal
+ *   entries and applied with the journal's own helpers
+ * - A torn tail or the records covered by a checkpoint are dropped by
+ *   copying the remaining records to a temp file and renaming it over the
+ *   log, so a crash during the rewrite keeps the old log
+ * 
+ * Time Complexity:
+ * - logging a mutation: O(1) amortized (no I/O on the caller's thread)
+ * - commit: one write+fsync per batch
+ * - open (replay): O(n) records, each applied like an interactive change
+ * - truncate: O(n) copy of the records after the checkpoint
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdint.h>
+#include <string.h>
+#include "wal.h"
+#include "crc32.h"
+#include "thread.h"
+
+#ifdef _WIN32
+#include <io.h>
+#define wal_fsync(file) _commit(_fileno(file))
+#else
+#include <unistd.h>
+#define wal_fsync(file) fsync(fileno(file))
+#endif
+
+static const unsigned char wal_magic[4] = { 'R', 'W', 'A', 'L' };
+
+// Process-wide log (NULL while closed, logging calls are then ignored)
+static FILE* wal_file = NULL;
+static char wal_path[512];
+static unsigned long long wal_lsn = 0;  // Last LSN assigned (written or replayed)
+static unsigned long long wal_changes[WAL_TABLE_COUNT]; // Mutations logged per table (open or not)
+
+/**
+ * Group commit state
+ * Everything below is guarded by wal_lock while the committer runs
+ */
+typedef struct {
+    unsigned char* data;     // Framed records
+    size_t size;             // Bytes used
+    size_t capacity;         // Bytes allocated
+    long long* appended_us;  // Append time of each record (commit latency)
+    int count;               // Records in the buffer
+    int count_capacity;      // Slots allocated in appended_us
+} WalBuffer;
+
+static ThreadMutex wal_lock;
+static ThreadMutex wal_io_lock;                // Held around file I/O (commit, truncate)
+static ThreadCond wal_work;                    // Committer: records pending or stop requested
+static ThreadCond wal_durable;                 // Waiters: durable LSN advanced
+static Thread wal_committer;
+static int wal_committer_running = 0;
+static int wal_stop = 0;
+static int wal_failed = 0;                     // A write or fsync failed (log no longer durable)
+static long long wal_window_us = WAL_DEFAULT_COMMIT_WINDOW_US;
+static unsigned long long wal_durable_lsn = 0; // Last LSN known to be on disk
+static int wal_last_batch = 0;                 // Records in the previous batch (expected group size)
+static WalBuffer wal_pending;                  // Filled by wal_append
+static WalBuffer wal_flushing;                 // Owned by the committer during I/O
+
+// Commit statistics (latency samples are a ring of the most recent records)
+static WalCommitStats wal_stats;
+static long long wal_latency_samples[WAL_LATENCY_SAMPLES];
+static long long wal_latency_total = 0;        // Samples ever taken
+static long long wal_fsync_total_us = 0;
+
+/**
+ * Internal helpers: Little-endian field encoding
+ */
+static void wal_put_u32(unsigned char* p, uint32_t v) {
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+}
+
+static uint32_t wal_get_u32(const unsigned char* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void wal_put_u64(unsigned char* p, uint64_t v) {
+    wal_put_u32(p, (uint32_t)v);
+    wal_put_u32(p + 4, (uint32_t)(v >> 32));
+}
+
+static uint64_t wal_get_u64(const unsigned char* p) {
+    return (uint64_t)wal_get_u32(p) | ((uint64_t)wal_get_u32(p + 4) << 32);
+}
+
+/**
+ * Internal helper: Checksum of a record (LSN bytes + payload)
+ */
+static uint32_t wal_record_crc(const unsigned char* lsn_bytes, const unsigned char* payload,
+                               size_t length) {
+    return crc32_update(crc32_update(0, lsn_bytes, 8), payload, length);
+}
+
+/**
+ * Internal helper: Writes a length-prefixed string (truncated to fit the field)
+ * @return: Bytes written
+ */
+static int wal_put_string(unsigned char* p, const char* text, int max_length) {
+    int n = (int)strlen(text);
+    if (n > max_length) {
+        n = max_length;
+    }
+    p[0] = (unsigned char)n;
+    memcpy(p + 1, text, n);
+    return n + 1;
+}
+
+/**
+ * Internal helper: Reads a length-prefixed string into a field
+ * @return: Bytes consumed, -1 if the string does not fit the payload or field
+ */
+static int wal_get_string(const unsigned char* p, int available, char* out, int out_size) {
+    if (available < 1) {
+        return -1;
+    }
+    int n = p[0];
+    if (n + 1 > available || n >= out_size) {
+        return -1;
+    }
+    memcpy(out, p + 1, n);
+    out[n] = '\0';
+    return n + 1;
+}
+
+/**
+ * Internal helper: Writes the file header
+ * @return: 1 on success, 0 on failure
+ */
+static int wal_write_header(FILE* file, unsigned long long base_lsn) {
+    unsigned char header[WAL_HEADER_SIZE];
+    memcpy(header, wal_magic, 4);
+    wal_put_u32(header + 4, WAL_VERSION);
+    wal_put_u64(header + 8, base_lsn);
+    return fwrite(header, 1, sizeof(header), file) == sizeof(header);
+}
+
+/**
+ * Internal helper: Makes room for one more record in a buffer
+ * @return: 1 on success, 0 if memory ran out
+ */
+static int wal_buffer_reserve(WalBuffer* buffer, size_t bytes) {
+    if (buffer->size + bytes > buffer->capacity) {
+        size_t capacity = buffer->capacity ? buffer->capacity : 4096;
+        while (capacity < buffer->size + bytes) {
+            capacity *= 2;
+        }
+        unsigned char* data = (unsigned char*)realloc(buffer->data, capacity);
+        if (data == NULL) {
+            return 0;
+        }
+        buffer->data = data;
+        buffer->capacity = capacity;
+    }
+    if (buffer->count == buffer->count_capacity) {
+        int count_capacity = buffer->count_capacity ? buffer->count_capacity * 2 : 64;
+        long long* appended_us = (long long*)realloc(buffer->appended_us,
+                                                     count_capacity * sizeof(long long));
+        if (appended_us == NULL) {
+            return 0;
+        }
+        buffer->appended_us = appended_us;
+        buffer->count_capacity = count_capacity;
+    }
+    return 1;
+}
+
+/**
+ * Internal helper: Frees a buffer
+ */
+static void wal_buffer_free(WalBuffer* buffer) {
+    free(buffer->data);
+    free(buffer->appended_us);
+    memset(buffer, 0, sizeof(*buffer));
+}
+
+/**
+ * Internal helper: Frames one payload into the pending buffer
+ * The committer thread writes it out with the rest of its batch
+ */
+static void wal_append(const unsigned char* payload, int length) {
+    if (!wal_committer_running) {
+        return;
+    }
+
+    thread_mutex_lock(&wal_lock);
+    size_t bytes = WAL_RECORD_HEADER_SIZE + (size_t)length;
+    if (wal_failed || !wal_buffer_reserve(&wal_pending, bytes)) {
+        wal_failed = 1; // The record cannot be made durable; wal_sync reports it
+        thread_cond_broadcast(&wal_durable);
+        thread_mutex_unlock(&wal_lock);
+        return;
+    }
+
+    unsigned char* record = wal_pending.data + wal_pending.size;
+    wal_lsn++;
+    wal_put_u32(record, (uint32_t)length);
+    wal_put_u64(record + 8, wal_lsn);
+    memcpy(record + WAL_RECORD_HEADER_SIZE, payload, length);
+    wal_put_u32(record + 4, wal_record_crc(record + 8, payload, length));
+    wal_pending.size += bytes;
+    wal_pending.appended_us[wal_pending.count++] = thread_now_us();
+
+    // The first record opens the commit window; reaching the expected group
+    // size or a full buffer closes it early
+    if (wal_pending.count == 1 || wal_pending.count == wal_last_batch ||
+        wal_pending.size >= WAL_GROUP_MAX_BYTES) {
+        thread_cond_signal(&wal_work);
+    }
+    thread_mutex_unlock(&wal_lock);
+}
+
+/**
+ * Internal helper: Folds a finished batch into the commit statistics
+ * Called with wal_lock held
+ */
+static void wal_record_batch(const WalBuffer* batch, long long done_us, long long fsync_us) {
+    wal_stats.batches++;
+    wal_stats.records += batch->count;
+    wal_stats.bytes += (long long)batch->size;
+    if (batch->count > wal_stats.max_batch) {
+        wal_stats.max_batch = batch->count;
+    }
+
+    // Bucket k holds batches of 2^k .. 2^(k+1)-1 records
+    int bucket = 0;
+    while (bucket < WAL_BATCH_BUCKETS - 1 && (batch->count >> (bucket + 1)) > 0) {
+        bucket++;
+    }
+    wal_stats.batch_histogram[bucket]++;
+    wal_fsync_total_us += fsync_us;
+
+    for (int i = 0; i < batch->count; i++) {
+        long long latency = done_us - batch->appended_us[i];
+        wal_latency_samples[wal_latency_total % WAL_LATENCY_SAMPLES] = latency;
+        wal_latency_total++;
+        if (latency > wal_stats.latency_max_us) {
+            wal_stats.latency_max_us = latency;
+        }
+    }
+}
+
+/**
+ * Internal helper: Committer thread
+ * Waits for the first pending record, lets the commit window fill, then
+ * writes and fsyncs the whole batch outside the lock so appends continue
+ */
+static void wal_commit_loop(void* arg) {
+    (void)arg;
+    thread_mutex_lock(&wal_lock);
+    for (;;) {
+        if (wal_pending.count == 0) {
+            if (wal_stop) {
+                break;
+            }
+            thread_cond_wait(&wal_work, &wal_lock);
+            continue;
+        }
+
+        // Commit window, measured from the oldest pending record. A lone
+        // writer (previous batch of one) gains nothing by waiting; otherwise
+        // the window closes once the previous batch size has been reached
+        long long window = (wal_last_batch > 1) ? wal_window_us : 0;
+        long long deadline = wal_pending.appended_us[0] + window;
+        long long now = thread_now_us();
+        while (!wal_stop && now < deadline && wal_pending.count < wal_last_batch &&
+               wal_pending.size < WAL_GROUP_MAX_BYTES) {
+            thread_cond_timedwait(&wal_work, &wal_lock, deadline - now);
+            now = thread_now_us();
+        }
+
+        WalBuffer batch = wal_pending;
+        wal_pending = wal_flushing;
+        wal_pending.size = 0;
+        wal_pending.count = 0;
+        unsigned long long batch_lsn = wal_lsn;
+        thread_mutex_unlock(&wal_lock);
+
+        thread_mutex_lock(&wal_io_lock);
+        long long write_start = thread_now_us();
+        int ok = wal_file != NULL &&
+                 fwrite(batch.data, 1, batch.size, wal_file) == batch.size &&
+                 fflush(wal_file) == 0 &&
+                 wal_fsync(wal_file) == 0;
+        long long done = thread_now_us();
+        thread_mutex_unlock(&wal_io_lock);
+
+        thread_mutex_lock(&wal_lock);
+        wal_flushing = batch;
+        wal_last_batch = batch.count;
+        if (ok) {
+            wal_durable_lsn = batch_lsn;
+            wal_record_batch(&batch, done, done - write_start);
+        } else {
+            wal_failed = 1;
+        }
+        thread_cond_broadcast(&wal_durable);
+    }
+    thread_mutex_unlock(&wal_lock);
+}
+
+/**
+ * Internal helper: Starts a payload with its op byte and counts the change
+ */
+static void wal_begin(unsigned char* payload, WalOp op) {
+    WalTable table = (op <= WAL_PATIENT_REMOVE) ? WAL_TABLE_PATIENTS
+                   : (op <= WAL_DOCTOR_REMOVE) ? WAL_TABLE_DOCTORS
+                   : WAL_TABLE_APPOINTMENTS;
+    wal_changes[table]++;
+    payload[0] = (unsigned char)op;
+    payload[1] = 0;
+    payload[2] = 0;
+    payload[3] = 0;
+}
+
+/**
+ * Internal helper: Appends a record carrying a single ID
+ */
+static void wal_log_id(WalOp op, int id) {
+    unsigned char payload[8];
+    wal_begin(payload, op);
+    wal_put_u32(payload + 4, (uint32_t)id);
+    wal_append(payload, sizeof(payload));
+}
+
+/**
+ * Internal helper: Decodes a payload into a journal entry
+ * @param forward: Receives the direction to apply the entry in
+ * @return: 1 on success, 0 if the payload is malformed or unknown
+ */
+static int wal_decode(const unsigned char* payload, int length, JournalEntry* entry, int* forward) {
+    if (length < 8) {
+        return 0;
+    }
+
+    memset(entry, 0, sizeof(*entry));
+    *forward = 1;
+    int id = (int32_t)wal_get_u32(payload + 4);
+    int used;
+
+    switch ((WalOp)payload[0]) {
+        case WAL_PATIENT_ADD:
+            if (length < 13) {
+                return 0;
+            }
+            entry->type = JOURNAL_ADD_PATIENT;
+            entry->data.patient.id = id;
+            entry->data.patient.age = (int32_t)wal_get_u32(payload + 8);
+            return wal_get_string(payload + 12, length - 12, entry->data.patient.name,
+                                  sizeof(entry->data.patient.name)) > 0;
+        case WAL_PATIENT_REMOVE:
+            entry->type = JOURNAL_ADD_PATIENT;
+            entry->data.patient.id = id;
+            *forward = 0;
+            return 1;
+        case WAL_DOCTOR_ADD:
+            entry->type = JOURNAL_ADD_DOCTOR;
+            entry->data.doctor.id = id;
+            used = wal_get_string(payload + 8, length - 8, entry->data.doctor.name,
+                                  sizeof(entry->data.doctor.name));
+            if (used < 0) {
+                return 0;
+            }
+            return wal_get_string(payload + 8 + used, length - 8 - used,
+                                  entry->data.doctor.department,
+                                  sizeof(entry->data.doctor.department)) > 0;
+        case WAL_DOCTOR_REMOVE:
+            entry->type = JOURNAL_ADD_DOCTOR;
+            entry->data.doctor.id = id;
+            *forward = 0;
+            return 1;
+        case WAL_APPOINTMENT_CREATE:
+            if (length < 24) {
+                return 0;
+            }
+            entry->type = JOURNAL_CREATE_APPOINTMENT;
+            entry->data.appointment.appointment_id = id;
+            entry->data.appointment.patient_id = (int32_t)wal_get_u32(payload + 8);
+            entry->data.appointment.doctor_id = (int32_t)wal_get_u32(payload + 12);
+            entry->data.appointment.start_time = (int32_t)wal_get_u32(payload + 16);
+            entry->data.appointment.end_time = (int32_t)wal_get_u32(payload + 20);
+            return 1;
+        case WAL_APPOINTMENT_CANCEL:
+            entry->type = JOURNAL_CANCEL_APPOINTMENT;
+            entry->data.appointment.appointment_id = id;
+            return 1;
+        case WAL_APPOINTMENT_RESCHEDULE:
+            if (length < 16) {
+                return 0;
+            }
+            entry->type = JOURNAL_RESCHEDULE_APPOINTMENT;
+            entry->data.appointment.appointment_id = id;
+            entry->data.appointment.start_time = (int32_t)wal_get_u32(payload + 8);
+            entry->data.appointment.end_time = (int32_t)wal_get_u32(payload + 12);
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Internal helper: Rewrites the log without the records up to cut_lsn
+ * Copies the later records (up to end_offset) to a temp file whose header
+ * starts at cut_lsn, fsyncs it and renames it over the log
+ * @param path: Log file path
+ * @param cut_lsn: Records with LSN <= cut_lsn are dropped (0 = keep all)
+ * @param end_offset: Offset just past the last valid record, -1 = end of file
+ * @return: 1 on success, 0 on failure (the log is left untouched)
+ */
+static int wal_rewrite(const char* path, unsigned long long cut_lsn, long end_offset) {
+    char tmp_path[520];
+    if (strlen(path) + 5 > sizeof(tmp_path)) {
+        return 0;
+    }
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+
+    FILE* in = fopen(path, "rb");
+    FILE* out = fopen(tmp_path, "wb");
+    int ok = (in != NULL && out != NULL);
+
+    unsigned char record[WAL_RECORD_HEADER_SIZE + WAL_MAX_PAYLOAD];
+    ok = ok && fread(record, 1, WAL_HEADER_SIZE, in) == WAL_HEADER_SIZE;
+    if (ok) {
+        unsigned long long base = wal_get_u64(record + 8);
+        ok = wal_write_header(out, (base > cut_lsn) ? base : cut_lsn);
+    }
+
+    long offset = WAL_HEADER_SIZE;
+    while (ok && (end_offset < 0 || offset < end_offset)) {
+        size_t got = fread(record, 1, WAL_RECORD_HEADER_SIZE, in);
+        if (got == 0 && end_offset < 0) {
+            break; // End of a log that is known to be intact
+        }
+        uint32_t length = wal_get_u32(record);
+        ok = got == WAL_RECORD_HEADER_SIZE && length <= WAL_MAX_PAYLOAD &&
+             fread(record + WAL_RECORD_HEADER_SIZE, 1, length, in) == length;
+        if (ok && wal_get_u64(record + 8) > cut_lsn) {
+            ok = fwrite(record, 1, WAL_RECORD_HEADER_SIZE + length, out) ==
+                 WAL_RECORD_HEADER_SIZE + length;
+        }
+        offset += WAL_RECORD_HEADER_SIZE + (long)length;
+    }
+    ok = ok && fflush(out) == 0 && wal_fsync(out) == 0;
+
+    if (in != NULL) {
+        fclose(in);
+    }
+    if (out != NULL && fclose(out) != 0) {
+        ok = 0;
+    }
+    if (!ok) {
+        remove(tmp_path);
+        return 0;
+    }
+
+    // rename does not replace on Windows
+#ifdef _WIN32
+    remove(path);
+#endif
+    if (rename(tmp_path, path) != 0) {
+        remove(tmp_path);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Internal helper: Replays an existing log file
+ * Time Complexity: O(n) in records
+ * 
+ * @param skip_lsn: Records up to this LSN are already in the snapshot (not applied)
+ * @param base_lsn: Receives the header's base LSN
+ * @param valid_end: Receives the offset just past the last valid record
+ * @param torn: Receives 1 if invalid bytes follow valid_end
+ * @return: Number of records applied, 0 if the file does not exist, -1 on bad header
+ */
+static int wal_replay(const char* path, const JournalContext* context, unsigned long long skip_lsn,
+                      unsigned long long* base_lsn, long* valid_end, int* torn) {
+    *base_lsn = 0;
+    *valid_end = 0;
+    *torn = 0;
+
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return 0; // No log yet
+    }
+
+    unsigned char header[WAL_HEADER_SIZE];
+    if (fread(header, 1, sizeof(header), file) != sizeof(header) ||
+        memcmp(header, wal_magic, 4) != 0 ||
+        wal_get_u32(header + 4) != WAL_VERSION) {
+        fclose(file);
+        return -1; // Not a write-ahead log (or unsupported version)
+    }
+    wal_lsn = wal_get_u64(header + 8);
+    *base_lsn = wal_lsn;
+    *valid_end = WAL_HEADER_SIZE;
+
+    unsigned char record[WAL_RECORD_HEADER_SIZE + WAL_MAX_PAYLOAD];
+    int replayed = 0;
+    size_t got;
+    while ((got = fread(record, 1, WAL_RECORD_HEADER_SIZE, file)) > 0) {
+        uint32_t length = wal_get_u32(record);
+        if (got != WAL_RECORD_HEADER_SIZE || length > WAL_MAX_PAYLOAD ||
+            fread(record + WAL_RECORD_HEADER_SIZE, 1, length, file) != length ||
+            wal_get_u32(record + 4) != wal_record_crc(record + 8, record + WAL_RECORD_HEADER_SIZE, length) ||
+            wal_get_u64(record + 8) != wal_lsn + 1) {
+            *torn = 1;
+            break;
+        }
+
+        wal_lsn++;
+        *valid_end += WAL_RECORD_HEADER_SIZE + (long)length;
+        if (wal_lsn <= skip_lsn) {
+            continue; // Checkpoint written, log not truncated yet
+        }
+
+        JournalEntry entry;
+        int forward;
+        if (wal_decode(record + WAL_RECORD_HEADER_SIZE, (int)length, &entry, &forward)) {
+            journal_apply_entry(context, &entry, forward);
+        }
+        replayed++;
+    }
+
+    fclose(file);
+    return replayed;
+}
+
+/**
+ * Replays the log on top of the loaded snapshot, then opens it for appending
+ * Time Complexity: O(n)
+ * 
+ * @param path: Log file path
+ * @param context: Structures holding the snapshot
+ * @param snapshot_lsn: LSN the snapshot was taken at
+ * @return: Number of records replayed, -1 if the log could not be opened
+ */
+int wal_open(const char* path, const JournalContext* context, unsigned long long snapshot_lsn) {
+    if (path == NULL || context == NULL || strlen(path) >= sizeof(wal_path)) {
+        return -1;
+    }
+
+    wal_close();
+    wal_lsn = 0;
+
+    unsigned long long base_lsn;
+    long valid_end;
+    int torn;
+    int replayed = wal_replay(path, context, snapshot_lsn, &base_lsn, &valid_end, &torn);
+    if (replayed < 0) {
+        return -1; // Keep the unknown file untouched
+    }
+    if (wal_lsn < snapshot_lsn) {
+        wal_lsn = snapshot_lsn; // Never reuse LSNs the snapshot already covers
+    }
+    if (replayed > 0 && context->heap != NULL) {
+        heap_build(context->heap, context->appointments->items, context->appointments->count);
+    }
+
+    if (valid_end == 0) {
+        // New log
+        FILE* file = fopen(path, "wb");
+        if (file == NULL) {
+            return -1;
+        }
+        int ok = wal_write_header(file, snapshot_lsn);
+        if (fclose(file) != 0 || !ok) {
+            return -1;
+        }
+    } else if ((torn || base_lsn < snapshot_lsn) && !wal_rewrite(path, snapshot_lsn, valid_end)) {
+        return -1; // Appending after garbage would hide the new records
+    }
+
+    wal_file = fopen(path, "ab");
+    if (wal_file == NULL) {
+        return -1;
+    }
+
+    // Start the committer; everything replayed is already on disk
+    strcpy(wal_path, path);
+    thread_mutex_init(&wal_lock);
+    thread_mutex_init(&wal_io_lock);
+    thread_cond_init(&wal_work);
+    thread_cond_init(&wal_durable);
+    wal_stop = 0;
+    wal_failed = 0;
+    wal_durable_lsn = wal_lsn;
+    wal_last_batch = 0;
+    memset(&wal_stats, 0, sizeof(wal_stats));
+    wal_latency_total = 0;
+    wal_fsync_total_us = 0;
+    if (!thread_start(&wal_committer, wal_commit_loop, NULL)) {
+        thread_cond_destroy(&wal_durable);
+        thread_cond_destroy(&wal_work);
+        thread_mutex_destroy(&wal_io_lock);
+        thread_mutex_destroy(&wal_lock);
+        fclose(wal_file);
+        wal_file = NULL;
+        return -1;
+    }
+    wal_committer_running = 1;
+    return replayed;
+}
+
+/**
+ * Records an added patient
+ * Time Complexity: O(1)
+ * 
+ * @param patient: Patient that was added
+ */
+void wal_log_patient_add(const Patient* patient) {
+    if (patient == NULL) {
+        return;
+    }
+    unsigned char payload[WAL_MAX_PAYLOAD];
+    wal_begin(payload, WAL_PATIENT_ADD);
+    wal_put_u32(payload + 4, (uint32_t)patient->id);
+    wal_put_u32(payload + 8, (uint32_t)patient->age);
+    int length = 12 + wal_put_string(payload + 12, patient->name, sizeof(patient->name) - 1);
+    wal_append(payload, length);
+}
+
+/**
+ * Records a removed patient
+ * Time Complexity: O(1)
+ * 
+ * @param patient_id: Patient ID
+ */
+void wal_log_patient_remove(int patient_id) {
+    wal_log_id(WAL_PATIENT_REMOVE, patient_id);
+}
+
+/**
+ * Records an added doctor
+ * Time Complexity: O(1)
+ * 
+ * @param doctor: Doctor that was added
+ */
+void wal_log_doctor_add(const Doctor* doctor) {
+    if (doctor == NULL) {
+        return;
+    }
+    unsigned char payload[WAL_MAX_PAYLOAD];
+    wal_begin(payload, WAL_DOCTOR_ADD);
+    wal_put_u32(payload + 4, (uint32_t)doctor->id);
+    int length = 8;
+    length += wal_put_string(payload + length, doctor->name, sizeof(doctor->name) - 1);
+    length += wal_put_string(payload + length, doctor->department, sizeof(doctor->department) - 1);
+    wal_append(payload, length);
+}
+
+/**
+ * Records a removed doctor
+ * Time Complexity: O(1)
+ * 
+ * @param doctor_id: Doctor ID
+ */
+void wal_log_doctor_remove(int doctor_id) {
+    wal_log_id(WAL_DOCTOR_REMOVE, doctor_id);
+}
+
+/**
+ * Records a booked appointment
+ * Time Complexity: O(1)
+ * 
+ * @param appointment: Appointment that was added
+ */
+void wal_log_appointment_create(const Appointment* appointment) {
+    if (appointment == NULL) {
+        return;
+    }
+    unsigned char payload[24];
+    wal_begin(payload, WAL_APPOINTMENT_CREATE);
+    wal_put_u32(payload + 4, (uint32_t)appointment->appointment_id);
+    wal_put_u32(payload + 8, (uint32_t)appointment->patient_id);
+    wal_put_u32(payload + 12, (uint32_t)appointment->doctor_id);
+    wal_put_u32(payload + 16, (uint32_t)appointment->start_time);
+    wal_put_u32(payload + 20, (uint32_t)appointment->end_time);
+    wal_append(payload, sizeof(payload));
+}
+
+/**
+ * Records a removed appointment
+ * Time Complexity: O(1)
+ * 
+ * @param appointment_id: Appointment ID
+ */
+void wal_log_appointment_cancel(int appointment_id) {
+    wal_log_id(WAL_APPOINTMENT_CANCEL, appointment_id);
+}
+
+/**
+ * Records new appointment times
+ * Time Complexity: O(1)
+ * 
+ * @param appointment: Appointment with its new times
+ */
+void wal_log_appointment_reschedule(const Appointment* appointment) {
+    if (appointment == NULL) {
+        return;
+    }
+    unsigned char payload[16];
+    wal_begin(payload, WAL_APPOINTMENT_RESCHEDULE);
+    wal_put_u32(payload + 4, (uint32_t)appointment->appointment_id);
+    wal_put_u32(payload + 8, (uint32_t)appointment->start_time);
+    wal_put_u32(payload + 12, (uint32_t)appointment->end_time);
+    wal_append(payload, sizeof(payload));
+}
+
+/**
+ * Returns how many mutations of a table were logged since startup
+ * Time Complexity: O(1)
+ * 
+ * @param table: Table to query
+ * @return: Number of logged mutations
+ */
+unsigned long long wal_change_count(WalTable table) {
+    if (table < 0 || table >= WAL_TABLE_COUNT) {
+        return 0;
+    }
+    return wal_changes[table];
+}
+
+/**
+ * Sets the group commit window
+ * Time Complexity: O(1)
+ * 
+ * @param window_us: Microseconds to collect records before a commit (0 = no wait)
+ */
+void wal_set_commit_window(long long window_us) {
+    if (window_us < 0) {
+        window_us = 0;
+    }
+    if (wal_committer_running) {
+        thread_mutex_lock(&wal_lock);
+        wal_window_us = window_us;
+        thread_mutex_unlock(&wal_lock);
+    } else {
+        wal_window_us = window_us;
+    }
+}
+
+/**
+ * Waits until a record is written and fsynced
+ * Time Complexity: O(1) (blocks for at most one commit window plus the fsync)
+ * 
+ * @param lsn: LSN to wait for
+ * @return: 1 if the record is durable, 0 if the log is closed or failed
+ */
+int wal_wait_durable(unsigned long long lsn) {
+    if (!wal_committer_running) {
+        return 0;
+    }
+
+    thread_mutex_lock(&wal_lock);
+    while (wal_durable_lsn < lsn && !wal_failed) {
+        thread_cond_wait(&wal_durable, &wal_lock);
+    }
+    int ok = wal_durable_lsn >= lsn;
+    thread_mutex_unlock(&wal_lock);
+    return ok;
+}
+
+/**
+ * Waits until every record logged so far is durable
+ * Time Complexity: O(1) (blocks)
+ * 
+ * @return: 1 if durable, 0 if the log is closed or failed
+ */
+int wal_sync(void) {
+    if (!wal_committer_running) {
+        return 0;
+    }
+    thread_mutex_lock(&wal_lock);
+    unsigned long long lsn = wal_lsn;
+    thread_mutex_unlock(&wal_lock);
+    return wal_wait_durable(lsn);
+}
+
+/**
+ * Internal helper: qsort comparator for latency samples
+ */
+static int wal_compare_latency(const void* a, const void* b) {
+    long long x = *(const long long*)a;
+    long long y = *(const long long*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Returns group commit statistics since the log was opened
+ * Time Complexity: O(s log s) for s latency samples
+ * 
+ * @param stats: Receives the statistics
+ */
+void wal_commit_stats(WalCommitStats* stats) {
+    if (stats == NULL) {
+        return;
+    }
+
+    static long long sorted[WAL_LATENCY_SAMPLES];
+    if (wal_committer_running) {
+        thread_mutex_lock(&wal_lock);
+    }
+    *stats = wal_stats;
+    int samples = (wal_latency_total < WAL_LATENCY_SAMPLES) ? (int)wal_latency_total
+                                                             : WAL_LATENCY_SAMPLES;
+    memcpy(sorted, wal_latency_samples, samples * sizeof(long long));
+    if (stats->batches > 0) {
+        stats->fsync_mean_us = wal_fsync_total_us / stats->batches;
+    }
+    if (wal_committer_running) {
+        thread_mutex_unlock(&wal_lock);
+    }
+
+    if (samples > 0) {
+        // Nearest-rank percentiles over the most recent records
+        qsort(sorted, samples, sizeof(long long), wal_compare_latency);
+        stats->latency_p50_us = sorted[(samples - 1) * 50 / 100];
+        stats->latency_p90_us = sorted[(samples - 1) * 90 / 100];
+        stats->latency_p99_us = sorted[(samples - 1) * 99 / 100];
+    }
+}
+
+/**
+ * Drops the records a checkpoint has made redundant
+ * Appends continue into the pending buffer meanwhile; only commits wait
+ * Time Complexity: O(n) in the records kept
+ * 
+ * @param lsn: Checkpoint LSN (records up to it are dropped)
+ * @return: 1 on success, 0 on failure (the log keeps its records)
+ */
+int wal_truncate(unsigned long long lsn) {
+    if (!wal_committer_running || !wal_wait_durable(lsn)) {
+        return 0;
+    }
+
+    thread_mutex_lock(&wal_io_lock);
+    // Closed first: Windows cannot rename over an open file
+    fclose(wal_file);
+    int ok = wal_rewrite(wal_path, lsn, -1);
+    wal_file = fopen(wal_path, "ab");
+    thread_mutex_unlock(&wal_io_lock);
+
+    if (wal_file == NULL) {
+        thread_mutex_lock(&wal_lock);
+        wal_failed = 1; // Later records cannot be written; wal_sync reports it
+        thread_cond_broadcast(&wal_durable);
+        thread_mutex_unlock(&wal_lock);
+        return 0;
+    }
+    return ok;
+}
+
+/**
+ * Reads the base LSN from a log header without opening the log
+ * Time Complexity: O(1)
+ * 
+ * @param path: Log file path
+ * @param base_lsn: Receives the base LSN
+ * @return: 1 on success, 0 if the file is missing or not a log
+ */
+int wal_read_base_lsn(const char* path, unsigned long long* base_lsn) {
+    if (path == NULL || base_lsn == NULL) {
+        return 0;
+    }
+
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return 0;
+    }
+    unsigned char header[WAL_HEADER_SIZE];
+    int ok = fread(header, 1, sizeof(header), file) == sizeof(header) &&
+             memcmp(header, wal_magic, 4) == 0 &&
+             wal_get_u32(header + 4) == WAL_VERSION;
+    fclose(file);
+    if (ok) {
+        *base_lsn = wal_get_u64(header + 8);
+    }
+    return ok;
+}
+
+/**
+ * Returns the LSN of the last record written or replayed
+ * Time Complexity: O(1)
+ * 
+ * @return: Last LSN
+ */
+unsigned long long wal_last_lsn(void) {
+    return wal_lsn;
+}
+
+/**
+ * Returns whether the log is open for appending
+ * Time Complexity: O(1)
+ * 
+ * @return: 1 if open, 0 otherwise
+ */
+int wal_is_open(void) {
+    return wal_committer_running;
+}
+
+/**
+ * Commits pending records, stops the committer and closes the log
+ * Time Complexity: O(1) plus the final commit
+ */
+void wal_close(void) {
+    if (wal_committer_running) {
+        // The committer drains the pending buffer before it exits
+        thread_mutex_lock(&wal_lock);
+        wal_stop = 1;
+        thread_cond_signal(&wal_work);
+        thread_mutex_unlock(&wal_lock);
+        thread_join(&wal_committer);
+        wal_committer_running = 0;
+
+        thread_cond_destroy(&wal_durable);
+        thread_cond_destroy(&wal_work);
+        thread_mutex_destroy(&wal_io_lock);
+        thread_mutex_destroy(&wal_lock);
+        wal_buffer_free(&wal_pending);
+        wal_buffer_free(&wal_flushing);
+    }
+    if (wal_file != NULL) {
+        fclose(wal_file);
+        wal_file = NULL;
+    }
+}
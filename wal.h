@@ -0,0 +1,250 @@
+#ifndef WAL_H
+#define WAL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "patient.h"
+#include "doctor.h"
+#include "appointment.h"
+#include "journal.h"
+
+/**
+ * Write-Ahead Log (patients, doctors, appointments)
+ *
+ * Append-only binary log of every mutation since the last CSV snapshot.
+ * Startup loads the CSV files and replays the log on top of them, so a
+ * session survives a crash and a clean exit no longer rewrites the CSVs.
+ *
+ * File layout (all integers little-endian):
+ *   header: "RWAL" magic (4 bytes) + version (u32) + base LSN (u64)
+ *   records: 16-byte record header followed by the payload
+ *     u32 length          payload bytes
+ *     u32 crc             CRC-32 of the LSN and the payload
+ *     u64 lsn             base LSN + 1, + 2, ... (no gaps)
+ *     payload: u8 op + 3 reserved bytes + op-specific fields
+ *       WAL_PATIENT_ADD             i32 id, i32 age, u8 n, name[n]
+ *       WAL_DOCTOR_ADD              i32 id, u8 n, name[n], u8 m, department[m]
+ *       WAL_*_REMOVE / _CANCEL      i32 id
+ *       WAL_APPOINTMENT_CREATE      i32 id, patient_id, doctor_id, start, end
+ *       WAL_APPOINTMENT_RESCHEDULE  i32 id, start, end
+ *
+ * Replay stops at the first record that is short, fails its checksum or
+ * breaks the LSN sequence (a torn write from a crash); that tail is cut
+ * off before new records are appended.
+ *
+ * A checkpoint (checkpoint.h) writes a snapshot taken at some LSN and then
+ * truncates the log up to it: the kept records are copied behind a header
+ * whose base LSN is the checkpoint LSN, so replay stays bounded. Records the
+ * snapshot already covers are skipped if a crash hit before the truncation.
+ *
+ * Records are written through the operation journal (journal.h): every
+ * operation it records, undoes or redoes is appended here as its net
+ * effect, so replay never needs the undo history.
+ *
+ * Group commit: logging calls only frame the record into a pending buffer.
+ * A committer thread writes and fsyncs the buffer once per commit window,
+ * so a burst of mutations - an undo of many operations, a drained intake
+ * batch, concurrent writers - costs a single fsync. The window
+ * (WAL_DEFAULT_COMMIT_WINDOW_US after the oldest pending record) is an
+ * upper bound: it is skipped after a single-record batch (a lone writer
+ * has nobody to wait for) and closes early once as many records are
+ * pending as the previous batch held, or WAL_GROUP_MAX_BYTES.
+ * wal_sync / wal_wait_durable block until a record is on disk; batch sizes
+ * and commit latencies are reported by wal_commit_stats.
+ *
+ * The log is a single process-wide instance, like the state log; logging
+ * calls are no-ops while no log is open (e.g. during replay).
+ */
+
+/**
+ * Default write-ahead log path
+ */
+#define WAL_DEFAULT_PATH "data/wal.log"
+
+/**
+ * Format version and limits
+ */
+#define WAL_VERSION 1
+#define WAL_HEADER_SIZE 16
+#define WAL_RECORD_HEADER_SIZE 16
+#define WAL_MAX_PAYLOAD 256
+
+/**
+ * Group commit tuning
+ */
+#define WAL_DEFAULT_COMMIT_WINDOW_US 2000   // Latency window (microseconds)
+#define WAL_GROUP_MAX_BYTES (64 * 1024)     // Pending bytes that end the window early
+#define WAL_BATCH_BUCKETS 12                // Batch size histogram: 1, 2-3, 4-7, ... 2048+
+#define WAL_LATENCY_SAMPLES 4096            // Most recent record latencies kept for percentiles
+
+/**
+ * Logged mutations
+ */
+typedef enum {
+    WAL_PATIENT_ADD = 1,             // Patient added
+    WAL_PATIENT_REMOVE = 2,          // Patient removed (undo of add)
+    WAL_DOCTOR_ADD = 3,              // Doctor added
+    WAL_DOCTOR_REMOVE = 4,           // Doctor removed (undo of add)
+    WAL_APPOINTMENT_CREATE = 5,      // Appointment booked (or cancel undone)
+    WAL_APPOINTMENT_CANCEL = 6,      // Appointment removed (or create undone)
+    WAL_APPOINTMENT_RESCHEDULE = 7   // Appointment moved to new times
+} WalOp;
+
+/**
+ * Tables counted by wal_change_count
+ */
+typedef enum {
+    WAL_TABLE_PATIENTS = 0,
+    WAL_TABLE_DOCTORS = 1,
+    WAL_TABLE_APPOINTMENTS = 2,
+    WAL_TABLE_COUNT = 3
+} WalTable;
+
+/**
+ * Group Commit Statistics
+ * Latency is measured per record, from the logging call until its batch
+ * has been fsynced
+ */
+typedef struct {
+    long long batches;                              // Commits (write + fsync)
+    long long records;                              // Records committed
+    long long bytes;                                // Bytes committed
+    int max_batch;                                  // Largest batch (records)
+    long long batch_histogram[WAL_BATCH_BUCKETS];   // Bucket k: 2^k .. 2^(k+1)-1 records
+    long long fsync_mean_us;                        // Mean write + fsync time per batch
+    long long latency_p50_us;                       // Commit latency percentiles
+    long long latency_p90_us;
+    long long latency_p99_us;
+    long long latency_max_us;                       // Worst latency since open
+} WalCommitStats;
+
+/**
+ * Write-Ahead Log Operations
+ * Time Complexity: O(1) per logged mutation, one write+fsync per batch, O(n) replay
+ */
+
+/**
+ * Replays the log on top of the loaded snapshot, then opens it for appending
+ * and starts the committer thread
+ * A missing file starts an empty log
+ * @param path: Log file path
+ * @param context: Structures holding the snapshot (AVL filled, heap is rebuilt)
+ * @param snapshot_lsn: LSN the loaded snapshot was taken at (records up to it
+ *                      are skipped and dropped from the file)
+ * @return: Number of records replayed, -1 if the log could not be opened
+ */
+int wal_open(const char* path, const JournalContext* context, unsigned long long snapshot_lsn);
+
+/**
+ * Records an added patient
+ * @param patient: Patient that was added
+ */
+void wal_log_patient_add(const Patient* patient);
+
+/**
+ * Records a removed patient
+ * @param patient_id: Patient ID
+ */
+void wal_log_patient_remove(int patient_id);
+
+/**
+ * Records an added doctor
+ * @param doctor: Doctor that was added
+ */
+void wal_log_doctor_add(const Doctor* doctor);
+
+/**
+ * Records a removed doctor
+ * @param doctor_id: Doctor ID
+ */
+void wal_log_doctor_remove(int doctor_id);
+
+/**
+ * Records a booked appointment
+ * @param appointment: Appointment that was added
+ */
+void wal_log_appointment_create(const Appointment* appointment);
+
+/**
+ * Records a removed appointment
+ * @param appointment_id: Appointment ID
+ */
+void wal_log_appointment_cancel(int appointment_id);
+
+/**
+ * Records new appointment times
+ * @param appointment: Appointment with its new times
+ */
+void wal_log_appointment_reschedule(const Appointment* appointment);
+
+/**
+ * Returns how many mutations of a table were logged since startup
+ * Counted even while no log is open, so a save without the log can skip
+ * tables that did not change (replayed records count as changes too)
+ * @param table: Table to query
+ * @return: Number of logged mutations
+ */
+unsigned long long wal_change_count(WalTable table);
+
+/**
+ * Sets the group commit window (takes effect from the next batch)
+ * @param window_us: Microseconds to collect records before a commit (0 = no wait)
+ */
+void wal_set_commit_window(long long window_us);
+
+/**
+ * Waits until a record has been written and fsynced
+ * @param lsn: LSN to wait for (e.g. wal_last_lsn() after logging)
+ * @return: 1 if the record is durable, 0 if the log is closed or a write failed
+ */
+int wal_wait_durable(unsigned long long lsn);
+
+/**
+ * Waits until every record logged so far is durable
+ * @return: 1 if durable, 0 if the log is closed or a write failed
+ */
+int wal_sync(void);
+
+/**
+ * Returns group commit statistics since the log was opened
+ * Still available after wal_close
+ * @param stats: Receives the statistics
+ */
+void wal_commit_stats(WalCommitStats* stats);
+
+/**
+ * Drops the records up to a checkpoint LSN (safe to call from any thread)
+ * Waits until they are durable, then rewrites the log without them; logging
+ * continues meanwhile, commits wait for the rewrite
+ * @param lsn: Checkpoint LSN
+ * @return: 1 on success, 0 on failure (the log keeps its records)
+ */
+int wal_truncate(unsigned long long lsn);
+
+/**
+ * Reads the base LSN from a log header without opening the log
+ * @param path: Log file path
+ * @param base_lsn: Receives the base LSN (the last completed checkpoint)
+ * @return: 1 on success, 0 if the file is missing or not a log
+ */
+int wal_read_base_lsn(const char* path, unsigned long long* base_lsn);
+
+/**
+ * Returns the LSN of the last record logged or replayed (may not be durable yet)
+ * @return: Last LSN, 0 if the log is empty
+ */
+unsigned long long wal_last_lsn(void);
+
+/**
+ * Returns whether the log is open for appending
+ * @return: 1 if open, 0 otherwise
+ */
+int wal_is_open(void);
+
+/**
+ * Commits pending records, stops the committer and closes the log
+ * (further logging calls are ignored)
+ */
+void wal_close(void);
+
+#endif // WAL_H